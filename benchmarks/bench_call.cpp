@@ -0,0 +1,108 @@
+#include "runtime/pyobject.h"
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Call overhead benchmark: a two-argument function called the way
+// PyFunction used to be - a std::function over a std::vector of
+// std::shared_ptr arguments built per call - against vectorcall, the
+// direct call2() entry point and a std::function closure behind
+// vectorcall. The body only hands back its first argument, so the
+// timings are the calling convention itself.
+
+using namespace aithon::runtime;
+
+template<typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char* name, size_t calls, double ms, double baseline_ms) {
+    std::cout << name << (ms * 1e6 / calls) << " ns/call";
+    if (baseline_ms > 0) std::cout << " (" << (baseline_ms / ms) << "x)";
+    std::cout << "\n";
+}
+
+static PyObject* first(PyObject* a, PyObject*) {
+    a->incref();
+    return a;
+}
+
+int main() {
+    std::cout << "Running Call Overhead Benchmark\n";
+    std::cout << "===============================\n";
+
+    const size_t calls = 10'000'000;
+    auto* a = new PyInt(1);
+    auto* b = new PyInt(2);
+    int64_t checksum = 0;
+
+    // Before: shared_ptr arguments in a fresh vector, type-erased call.
+    // The shared_ptrs borrow the objects, as the old callers' did.
+    double vector_ms;
+    {
+        using OldFunction = std::function<std::shared_ptr<PyObject>(const std::vector<std::shared_ptr<PyObject>>&)>;
+        OldFunction func = [](const std::vector<std::shared_ptr<PyObject>>& args) { return args[0]; };
+        std::shared_ptr<PyObject> sa(a, [](PyObject*) {});
+        std::shared_ptr<PyObject> sb(b, [](PyObject*) {});
+        vector_ms = time_ms([&] {
+            for (size_t i = 0; i < calls; i++) {
+                std::shared_ptr<PyObject> result = func({sa, sb});
+                checksum += result->refcount();
+            }
+        });
+        report("std::function + vector<shared_ptr>: ", calls, vector_ms, 0);
+    }
+
+    auto* fixed = new PyFunction("first", first);
+    {
+        PyObject* args[] = {a, b};
+        double ms = time_ms([&] {
+            for (size_t i = 0; i < calls; i++) {
+                PyObject* result = fixed->vectorcall(args, 2);
+                checksum += result->refcount();
+                result->decref();
+            }
+        });
+        report("vectorcall:                         ", calls, ms, vector_ms);
+    }
+    {
+        double ms = time_ms([&] {
+            for (size_t i = 0; i < calls; i++) {
+                PyObject* result = fixed->call2(a, b);
+                checksum += result->refcount();
+                result->decref();
+            }
+        });
+        report("call2():                            ", calls, ms, vector_ms);
+    }
+
+    auto* closure = new PyFunction("first", PyFunction::NativeFn(
+        [](PyObject* const* args, size_t) -> PyObject* {
+            args[0]->incref();
+            return args[0];
+        }));
+    {
+        double ms = time_ms([&] {
+            for (size_t i = 0; i < calls; i++) {
+                PyObject* result = closure->call2(a, b);
+                checksum += result->refcount();
+                result->decref();
+            }
+        });
+        report("std::function closure, vectorcall:  ", calls, ms, vector_ms);
+    }
+
+    fixed->decref();
+    closure->decref();
+    a->decref();
+    b->decref();
+    std::cout << "Calls: " << calls << " (checksum " << checksum << ")\n";
+    return 0;
+}
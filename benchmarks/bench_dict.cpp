@@ -0,0 +1,113 @@
+#include "runtime/compact_dict.h"
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Dict get/set benchmark: the node-based std::unordered_map the dicts used
+// to be, looked up by const char* through a std::string the way
+// runtime_dict_get_* did, against CompactDict with string_view lookups,
+// and the runtime's dict C API on top of it, keyed by runtime strings.
+
+extern "C" {
+    void* runtime_string_from_cstr(const char* str);
+    void runtime_string_release(void* str);
+    void* runtime_dict_create();
+    void runtime_dict_set_int(void* dict_ptr, void* key, int64_t value);
+    int64_t runtime_dict_get_int(void* dict_ptr, void* key);
+    void runtime_dict_free(void* dict_ptr);
+}
+
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view str) const { return std::hash<std::string_view>{}(str); }
+};
+
+template<typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char* name, size_t ops, double set_ms, double get_ms) {
+    std::cout << name << " set " << (set_ms * 1e6 / ops) << " ns/op, get "
+              << (get_ms * 1e6 / ops) << " ns/op\n";
+}
+
+int main() {
+    std::cout << "Running Dict Benchmark\n";
+    std::cout << "======================\n";
+
+    const size_t keys = 100'000;
+    const size_t rounds = 20;
+    const size_t ops = keys * rounds;
+
+    std::vector<std::string> names;
+    for (size_t i = 0; i < keys; i++) names.push_back("field_" + std::to_string(i));
+    std::vector<const char*> cnames;
+    for (auto& name : names) cnames.push_back(name.c_str());
+
+    int64_t checksum = 0;
+
+    // Before: node per entry, std::string per lookup
+    {
+        std::unordered_map<std::string, int64_t> map;
+        double set_ms = time_ms([&] {
+            for (size_t r = 0; r < rounds; r++) {
+                for (size_t i = 0; i < keys; i++) map[std::string(cnames[i])] = i + r;
+            }
+        });
+        double get_ms = time_ms([&] {
+            for (size_t r = 0; r < rounds; r++) {
+                for (size_t i = 0; i < keys; i++) checksum += map.find(std::string(cnames[i]))->second;
+            }
+        });
+        report("unordered_map<string>:", ops, set_ms, get_ms);
+    }
+
+    {
+        aithon::runtime::CompactDict<std::string, int64_t, StringHash, std::equal_to<>> dict;
+        double set_ms = time_ms([&] {
+            for (size_t r = 0; r < rounds; r++) {
+                for (size_t i = 0; i < keys; i++) {
+                    dict.insert_or_assign(std::string_view(cnames[i]), static_cast<int64_t>(i + r));
+                }
+            }
+        });
+        double get_ms = time_ms([&] {
+            for (size_t r = 0; r < rounds; r++) {
+                for (size_t i = 0; i < keys; i++) checksum += *dict.find(std::string_view(cnames[i]));
+            }
+        });
+        report("CompactDict:           ", ops, set_ms, get_ms);
+    }
+
+    {
+        std::vector<void*> keys_rt;
+        for (const char* name : cnames) keys_rt.push_back(runtime_string_from_cstr(name));
+
+        void* dict = runtime_dict_create();
+        double set_ms = time_ms([&] {
+            for (size_t r = 0; r < rounds; r++) {
+                for (size_t i = 0; i < keys; i++) runtime_dict_set_int(dict, keys_rt[i], i + r);
+            }
+        });
+        double get_ms = time_ms([&] {
+            for (size_t r = 0; r < rounds; r++) {
+                for (size_t i = 0; i < keys; i++) checksum += runtime_dict_get_int(dict, keys_rt[i]);
+            }
+        });
+        runtime_dict_free(dict);
+        for (void* key : keys_rt) runtime_string_release(key);
+        report("runtime_dict C API:    ", ops, set_ms, get_ms);
+    }
+
+    std::cout << "Keys: " << keys << ", rounds: " << rounds
+              << " (checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+
+// Field access benchmark: the runtime_class_*_field calls compiled code
+// used to make for every read and write, against the inline loads and
+// stores it now emits through the class's struct type.
+
+extern "C" {
+    void* runtime_class_create(const char* class_name, int64_t num_fields,
+                               const uint8_t* pointer_map);
+    void runtime_release(void* ptr);
+    void runtime_class_set_field_int(void* ptr, int64_t field_idx, int64_t value);
+    void runtime_class_set_field_float(void* ptr, int64_t field_idx, double value);
+    int64_t runtime_class_get_field_int(void* ptr, int64_t field_idx);
+    double runtime_class_get_field_float(void* ptr, int64_t field_idx);
+}
+
+// class Particle: x: int, velocity: float - %class.Particle as codegen
+// emits it: { %HeapObject.header, i64, double }
+struct ParticleLayout {
+    uint64_t header[7];
+    int64_t x;
+    double velocity;
+};
+
+template<typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    std::cout << "Running Field Access Benchmark\n";
+    std::cout << "==============================\n";
+
+    const size_t objects = 100'000;
+    const size_t passes = 100;
+
+    std::vector<void*> particles;
+    for (size_t i = 0; i < objects; i++) {
+        void* p = runtime_class_create("Particle", 2, nullptr);
+        runtime_class_set_field_int(p, 0, static_cast<int64_t>(i));
+        runtime_class_set_field_float(p, 1, 0.5);
+        particles.push_back(p);
+    }
+
+    // p.x = p.x + int(p.velocity), two reads and a write per object
+    int64_t call_sum = 0;
+    double call_ms = time_ms([&] {
+        for (size_t pass = 0; pass < passes; pass++) {
+            for (void* p : particles) {
+                int64_t x = runtime_class_get_field_int(p, 0) +
+                            static_cast<int64_t>(runtime_class_get_field_float(p, 1) * 2);
+                runtime_class_set_field_int(p, 0, x);
+                call_sum += x;
+            }
+        }
+    });
+
+    int64_t inline_sum = 0;
+    double inline_ms = time_ms([&] {
+        for (size_t pass = 0; pass < passes; pass++) {
+            for (void* p : particles) {
+                auto* particle = static_cast<ParticleLayout*>(p);
+                int64_t x = particle->x + static_cast<int64_t>(particle->velocity * 2);
+                particle->x = x;
+                inline_sum += x;
+            }
+        }
+    });
+
+    for (void* p : particles) runtime_release(p);
+
+    const double accesses = static_cast<double>(objects) * passes * 3;
+    std::cout << "Objects: " << objects << ", passes: " << passes << "\n";
+    std::cout << "Runtime calls: " << call_ms << " ms ("
+              << (call_ms * 1e6 / accesses) << " ns/access)\n";
+    std::cout << "Inline GEP:    " << inline_ms << " ms ("
+              << (inline_ms * 1e6 / accesses) << " ns/access)\n";
+    std::cout << "Speedup: " << (call_ms / inline_ms) << "x\n";
+    std::cout << "Checksum: " << (call_sum + inline_sum) << "\n";
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include "runtime/pyobject.h"
+#include <iostream>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+
+// Generator iteration benchmark: summing range(n) through a generator.
+// A plain loop is what a compiled `for x in gen()` becomes once CoroElide
+// has put the frame on the caller's stack and the resumes are inlined; a
+// bare coroutine with an int promise is the same generator when its frame
+// stays on the heap and every step is an indirect resume; PyGenerator adds
+// a boxed value per step; and building a runtime list first is what a
+// program without generators does instead.
+
+using namespace aithon::runtime;
+
+extern "C" {
+    void* runtime_list_create();
+    void runtime_list_append_int(void* list_ptr, int64_t value);
+    int64_t runtime_list_get_int(void* list_ptr, int64_t index);
+    void runtime_list_free(void* list_ptr);
+}
+
+template<typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char* name, size_t values, double ms, double baseline_ms) {
+    std::cout << name << (ms * 1e6 / values) << " ns/value";
+    if (baseline_ms > 0) std::cout << " (" << (ms / baseline_ms) << "x plain loop)";
+    std::cout << "\n";
+}
+
+// The frame a compiled generator has: resume/destroy, then an i64 promise
+struct IntGenerator {
+    struct promise_type {
+        int64_t value = 0;
+
+        IntGenerator get_return_object() {
+            return IntGenerator{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(int64_t v) noexcept {
+            value = v;
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { throw; }
+    };
+
+    std::coroutine_handle<promise_type> frame;
+};
+
+static IntGenerator int_range(int64_t n) {
+    for (int64_t i = 0; i < n; i++) co_yield i;
+}
+
+static PyGenerator::Body boxed_range(int64_t n) {
+    for (int64_t i = 0; i < n; i++) co_yield new PyInt(i);
+}
+
+int main() {
+    std::cout << "Running Generator Benchmark\n";
+    std::cout << "===========================\n";
+
+    // Read at run time, so no loop is summed at compile time
+    volatile int64_t n_source = 10'000'000;
+    const int64_t n = n_source;
+    int64_t checksum = 0;
+
+    double loop_ms = time_ms([&] {
+        int64_t sum = 0;
+        for (int64_t i = 0; i < n; i++) sum += i;
+        checksum += sum;
+    });
+    report("plain loop (elided generator): ", n, loop_ms, 0);
+
+    double list_ms = time_ms([&] {
+        void* list = runtime_list_create();
+        for (int64_t i = 0; i < n; i++) runtime_list_append_int(list, i);
+        int64_t sum = 0;
+        for (int64_t i = 0; i < n; i++) sum += runtime_list_get_int(list, i);
+        runtime_list_free(list);
+        checksum += sum;
+    });
+    report("materialized list:             ", n, list_ms, loop_ms);
+
+    double coroutine_ms = time_ms([&] {
+        auto frame = int_range(n).frame;
+        int64_t sum = 0;
+        for (;;) {
+            frame.resume();
+            if (frame.done()) break;
+            sum += frame.promise().value;
+        }
+        frame.destroy();
+        checksum += sum;
+    });
+    report("heap frame, int promise:       ", n, coroutine_ms, loop_ms);
+
+    double boxed_ms = time_ms([&] {
+        auto* gen = new PyGenerator(boxed_range(n));
+        int64_t sum = 0;
+        try {
+            for (;;) {
+                PyObject* value = gen->next();
+                sum += static_cast<PyInt*>(value)->value();
+                value->decref();
+            }
+        } catch (const std::runtime_error&) {
+            // StopIteration
+        }
+        gen->decref();
+        checksum += sum;
+    });
+    report("PyGenerator::next():           ", n, boxed_ms, loop_ms);
+
+    std::cout << "Values: " << n << " (checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "runtime/value.h"
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+// Integer arithmetic benchmark. The fast path first: a running sum in
+// plain wrapping int64 against the same sum with __builtin_add_overflow
+// (the check compiled code now does), Value::add on small ints and
+// PyInt::add, none of which ever overflows here. Then the slow path:
+// BigInt products at growing sizes, schoolbook against Karatsuba, and
+// 1000! built by PyInt multiplication promoting to BigInt on the way.
+
+using namespace aithon::runtime;
+
+template<typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char* name, size_t ops, double ms, double baseline_ms) {
+    std::cout << name << (ms * 1e6 / ops) << " ns/op";
+    if (baseline_ms > 0) std::cout << " (" << (ms / baseline_ms) << "x wrapping add)";
+    std::cout << "\n";
+}
+
+static BigInt random_big(std::mt19937_64& rng, size_t limbs) {
+    BigInt result;
+    BigInt base(int64_t(1) << 32);
+    for (size_t i = 0; i < limbs; i++) {
+        result = result * base + BigInt(static_cast<int64_t>(rng() & 0xFFFFFFFF));
+    }
+    return result;
+}
+
+int main() {
+    std::cout << "Running Integer Benchmark\n";
+    std::cout << "=========================\n";
+
+    // Read at run time, so no sum is folded at compile time
+    volatile int64_t n_source = 20'000'000;
+    const int64_t n = n_source;
+    int64_t checksum = 0;
+
+    // Opaque to the optimizer, so the loops add instead of closing the form
+    volatile int64_t step_source = 3;
+
+    double wrapping_ms = time_ms([&] {
+        int64_t sum = 0;
+        for (int64_t i = 0; i < n; i++) sum += step_source;
+        checksum += sum;
+    });
+    report("int64 add, wrapping:         ", n, wrapping_ms, 0);
+
+    double checked_ms = time_ms([&] {
+        int64_t sum = 0;
+        for (int64_t i = 0; i < n; i++) {
+            if (__builtin_add_overflow(sum, step_source, &sum)) __builtin_trap();
+        }
+        checksum += sum;
+    });
+    report("int64 add, overflow checked: ", n, checked_ms, wrapping_ms);
+
+    double value_ms = time_ms([&] {
+        Value sum = Value::from_int(0);
+        for (int64_t i = 0; i < n; i++) sum = sum.add(Value::from_int(step_source));
+        checksum += sum.as_int();
+    });
+    report("Value::add, small ints:      ", n, value_ms, wrapping_ms);
+
+    double pyint_ms = time_ms([&] {
+        PyObject* sum = new PyInt(0);
+        for (int64_t i = 0; i < n; i++) {
+            PyInt step(step_source);
+            PyObject* next = sum->add(&step);
+            sum->decref();
+            sum = next;
+        }
+        checksum += static_cast<PyInt*>(sum)->value();
+        sum->decref();
+    });
+    report("PyInt::add, int64:           ", n, pyint_ms, wrapping_ms);
+
+    // Multiplication: equal-size operands, milliseconds per product
+    std::cout << "\nBigInt multiply (limbs: schoolbook / Karatsuba)\n";
+    std::mt19937_64 rng(1);
+    for (size_t limbs : {32, 64, 256, 1024, 4096}) {
+        BigInt a = random_big(rng, limbs), b = random_big(rng, limbs);
+        const int reps = static_cast<int>(20'000'000 / (limbs * limbs)) + 2;
+        BigInt product;
+        double school_ms = time_ms([&] {
+            for (int r = 0; r < reps; r++) product = BigInt::mul_schoolbook(a, b);
+        }) / reps;
+        double karatsuba_ms = time_ms([&] {
+            for (int r = 0; r < reps; r++) product = a * b;
+        }) / reps;
+        checksum += static_cast<int64_t>(product.limb_count());
+        std::cout << "  " << limbs << ": " << school_ms << " ms / " << karatsuba_ms
+                  << " ms (" << (school_ms / karatsuba_ms) << "x)\n";
+    }
+
+    // Promotion: 1000! in PyInt, int64 for the first twenty factors
+    size_t digits = 0;
+    double factorial_ms = time_ms([&] {
+        PyObject* product = new PyInt(1);
+        for (int64_t i = 2; i <= 1000; i++) {
+            PyInt factor(i);
+            PyObject* next = product->mul(&factor);
+            product->decref();
+            product = next;
+        }
+        digits = product->to_string().size();
+        product->decref();
+    });
+    std::cout << "\n1000! through PyInt::mul: " << factorial_ms << " ms (" << digits << " digits)\n";
+
+    std::cout << "Checksum " << checksum << "\n";
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "runtime/pyobject.h"
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Attribute-lookup and dict benchmark. An instance-style PyDict keyed by
+// attribute names is read with a PyString built for each access - hashing
+// and comparing the text every time, as lookups did before interning -
+// and with the interned names, whose hash is cached and whose comparison
+// is a pointer check. Then the runtime dict C API with string keys made at
+// run time against interned ones, as compiled literals are.
+
+using namespace aithon::runtime;
+
+extern "C" {
+    void* runtime_string_from_cstr(const char* str);
+    void* runtime_string_intern(void* str);
+    void runtime_string_release(void* str);
+    void* runtime_dict_create();
+    void runtime_dict_set_int(void* dict_ptr, void* key, int64_t value);
+    int64_t runtime_dict_get_int(void* dict_ptr, void* key);
+    void runtime_dict_free(void* dict_ptr);
+}
+
+template<typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    std::cout << "Running String Interning Benchmark\n";
+    std::cout << "==================================\n";
+
+    const size_t attrs = 16;          // Fields of a typical instance
+    const size_t lookups = 2'000'000;
+    const size_t ops = attrs * lookups;
+
+    std::vector<std::string> names;
+    for (size_t i = 0; i < attrs; i++) names.push_back("attribute_name_" + std::to_string(i));
+
+    InternTable& table = InternTable::current();
+    std::vector<PyString*> interned;
+    for (auto& name : names) interned.push_back(table.intern(name));
+
+    auto* instance = new PyDict();
+    for (size_t i = 0; i < attrs; i++) {
+        auto* value = new PyInt(static_cast<int64_t>(i));
+        instance->set(interned[i], value);
+        value->decref();
+    }
+
+    int64_t checksum = 0;
+
+    double fresh_ms = time_ms([&] {
+        for (size_t r = 0; r < lookups; r++) {
+            for (size_t i = 0; i < attrs; i++) {
+                PyString key(names[i]);
+                checksum += static_cast<PyInt*>(instance->get(&key))->value();
+            }
+        }
+    });
+
+    double interned_ms = time_ms([&] {
+        for (size_t r = 0; r < lookups; r++) {
+            for (size_t i = 0; i < attrs; i++) {
+                checksum += static_cast<PyInt*>(instance->get(interned[i]))->value();
+            }
+        }
+    });
+    instance->decref();
+
+    // Compiled code: the same keys through the C API
+    std::vector<void*> plain_keys, literal_keys;
+    for (auto& name : names) {
+        plain_keys.push_back(runtime_string_from_cstr(name.c_str()));
+        literal_keys.push_back(runtime_string_intern(plain_keys.back()));
+    }
+
+    void* dict = runtime_dict_create();
+    for (size_t i = 0; i < attrs; i++) runtime_dict_set_int(dict, literal_keys[i], i);
+
+    double plain_ms = time_ms([&] {
+        for (size_t r = 0; r < lookups; r++) {
+            for (size_t i = 0; i < attrs; i++) checksum += runtime_dict_get_int(dict, plain_keys[i]);
+        }
+    });
+    double literal_ms = time_ms([&] {
+        for (size_t r = 0; r < lookups; r++) {
+            for (size_t i = 0; i < attrs; i++) checksum += runtime_dict_get_int(dict, literal_keys[i]);
+        }
+    });
+    runtime_dict_free(dict);
+    for (void* key : plain_keys) runtime_string_release(key);
+
+    std::cout << "Lookups: " << ops << " over " << attrs << " attributes\n";
+    std::cout << "PyDict, new key per access: " << (fresh_ms * 1e6 / ops) << " ns/op\n";
+    std::cout << "PyDict, interned key:       " << (interned_ms * 1e6 / ops) << " ns/op\n";
+    std::cout << "C API, run-time key:        " << (plain_ms * 1e6 / ops) << " ns/op\n";
+    std::cout << "C API, interned literal:    " << (literal_ms * 1e6 / ops) << " ns/op\n";
+    std::cout << "Speedup: " << (fresh_ms / interned_ms) << "x (PyDict), "
+              << (plain_ms / literal_ms) << "x (C API) (checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Summing an int list: the 16-byte tagged RuntimeValue per element the
+// list used to store, read through a bounds-checked copy the way
+// runtime_list_get_int did, against the unboxed list read through
+// runtime_list_get_int and through its data pointer, as compiled loops do.
+
+extern "C" {
+    void* runtime_list_create();
+    void runtime_list_append_int(void* list_ptr, int64_t value);
+    int64_t runtime_list_get_int(void* list_ptr, int64_t index);
+    int64_t* runtime_list_int_data(void* list_ptr);
+    void runtime_list_free(void* list_ptr);
+}
+
+struct BoxedValue {
+    uint8_t type;
+    union {
+        int64_t int_val;
+        double float_val;
+        void* ptr_val;
+    } data;
+};
+
+[[gnu::noinline]] static BoxedValue boxed_get(const std::vector<BoxedValue>& items, size_t index) {
+    if (index >= items.size()) {
+        std::cerr << "IndexError: list index out of range\n";
+        return BoxedValue{};
+    }
+    return items[index];
+}
+
+template<typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    std::cout << "Running List Benchmark\n";
+    std::cout << "======================\n";
+
+    const int64_t count = 10'000'000;
+    const int rounds = 10;
+    const double ops = static_cast<double>(count) * rounds;
+
+    int64_t checksum = 0;
+
+    std::vector<BoxedValue> boxed;
+    for (int64_t i = 0; i < count; i++) boxed.push_back(BoxedValue{0, {i}});
+
+    void* list = runtime_list_create();
+    for (int64_t i = 0; i < count; i++) runtime_list_append_int(list, i);
+
+    double boxed_ms = time_ms([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (int64_t i = 0; i < count; i++) {
+                BoxedValue val = boxed_get(boxed, i);
+                if (val.type == 0) checksum += val.data.int_val;
+            }
+        }
+    });
+
+    double call_ms = time_ms([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (int64_t i = 0; i < count; i++) checksum += runtime_list_get_int(list, i);
+        }
+    });
+
+    double data_ms = time_ms([&] {
+        for (int r = 0; r < rounds; r++) {
+            const int64_t* data = runtime_list_int_data(list);
+            for (int64_t i = 0; i < count; i++) checksum += data[i];
+        }
+    });
+    runtime_list_free(list);
+
+    std::cout << "Elements: " << count << ", rounds: " << rounds << "\n";
+    std::cout << "Boxed, checked get:    " << (boxed_ms * 1e6 / ops) << " ns/element ("
+              << sizeof(BoxedValue) << " bytes each)\n";
+    std::cout << "Unboxed, get_int call: " << (call_ms * 1e6 / ops) << " ns/element ("
+              << sizeof(int64_t) << " bytes each)\n";
+    std::cout << "Unboxed, data pointer: " << (data_ms * 1e6 / ops) << " ns/element\n";
+    std::cout << "Speedup: " << (boxed_ms / data_ms) << "x (checksum " << checksum << ")\n";
+    return 0;
+}
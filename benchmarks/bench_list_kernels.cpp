@@ -0,0 +1,91 @@
+#include "runtime/list_kernels.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// List kernels at 1K, 1M and 100M elements: the scalar loops against each
+// instruction set this CPU supports, for int64 and double lists. Small
+// lists are repeated so every row covers about 200M elements. The
+// searches look for a value that is not there, so they scan everything.
+
+using namespace aithon::runtime;
+
+template<typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+static volatile double sink;
+
+template<typename T, typename Run>
+static void row(const char* op, const std::vector<const ListKernels*>& kernels,
+                int64_t n, int64_t reps, Run&& run) {
+    std::cout << "  " << std::left << std::setw(6) << op << std::right;
+    double scalar_ns = 0;
+    for (const ListKernels* k : kernels) {
+        double ms = time_ms([&] {
+            for (int64_t r = 0; r < reps; r++) sink = static_cast<double>(run(*k));
+        });
+        double ns = ms * 1e6 / (static_cast<double>(n) * reps);
+        if (k == kernels.front()) scalar_ns = ns;
+        std::cout << std::setw(10) << std::fixed << std::setprecision(3) << ns;
+        if (k != kernels.front()) std::cout << " (" << std::setprecision(1) << scalar_ns / ns << "x)";
+    }
+    std::cout << "  ns/element\n";
+}
+
+template<typename T>
+static void run_size(const char* type, int64_t n, const std::vector<const ListKernels*>& kernels) {
+    const int64_t reps = std::max<int64_t>(1, 200'000'000 / n);
+    std::vector<T> data(n), out(n);
+    for (int64_t i = 0; i < n; i++) data[i] = static_cast<T>((i * 7919) % 1000);
+    const T missing = static_cast<T>(-1);
+
+    std::cout << type << " x " << n << " (" << reps << " reps):";
+    for (const ListKernels* k : kernels) std::cout << std::setw(10) << k->name;
+    std::cout << "\n";
+
+    if constexpr (std::is_same_v<T, int64_t>) {
+        bool overflow = false;
+        row<T>("sum",   kernels, n, reps, [&](const ListKernels& k) { return k.sum_i64(data.data(), n, &overflow); });
+        row<T>("min",   kernels, n, reps, [&](const ListKernels& k) { return k.min_i64(data.data(), n); });
+        row<T>("max",   kernels, n, reps, [&](const ListKernels& k) { return k.max_i64(data.data(), n); });
+        row<T>("count", kernels, n, reps, [&](const ListKernels& k) { return k.count_i64(data.data(), n, 5); });
+        row<T>("index", kernels, n, reps, [&](const ListKernels& k) { return k.find_i64(data.data(), n, missing); });
+        row<T>("add",   kernels, n, reps, [&](const ListKernels& k) { k.add_i64(data.data(), n, 3, out.data()); return out[0]; });
+        row<T>("mul",   kernels, n, reps, [&](const ListKernels& k) { k.mul_i64(data.data(), n, 3, out.data()); return out[0]; });
+    } else {
+        row<T>("sum",   kernels, n, reps, [&](const ListKernels& k) { return k.sum_f64(data.data(), n); });
+        row<T>("min",   kernels, n, reps, [&](const ListKernels& k) { return k.min_f64(data.data(), n); });
+        row<T>("max",   kernels, n, reps, [&](const ListKernels& k) { return k.max_f64(data.data(), n); });
+        row<T>("count", kernels, n, reps, [&](const ListKernels& k) { return k.count_f64(data.data(), n, 5.0); });
+        row<T>("index", kernels, n, reps, [&](const ListKernels& k) { return k.find_f64(data.data(), n, missing); });
+        row<T>("add",   kernels, n, reps, [&](const ListKernels& k) { k.add_f64(data.data(), n, 3.0, out.data()); return out[0]; });
+        row<T>("mul",   kernels, n, reps, [&](const ListKernels& k) { k.mul_f64(data.data(), n, 3.0, out.data()); return out[0]; });
+    }
+}
+
+int main() {
+    std::cout << "Running List Kernel Benchmark\n";
+    std::cout << "=============================\n";
+
+    std::vector<const ListKernels*> kernels;
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::NEON, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (const ListKernels* k = list_kernels_for(level)) kernels.push_back(k);
+    }
+    std::cout << "Selected: " << list_kernels().name << "\n\n";
+
+    for (int64_t n : {int64_t(1'000), int64_t(1'000'000), int64_t(100'000'000)}) {
+        run_size<int64_t>("int64", n, kernels);
+        run_size<double>("double", n, kernels);
+        std::cout << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include "runtime/pyobject.h"
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Method dispatch benchmark: obj.method() and obj.field on an instance
+// whose method is inherited two classes up. Lookups the way the classes
+// used to do them - a std::string-keyed unordered_map per class, walking
+// the bases on a miss, fields in a per-instance map - against
+// PyInstance::get_attr through shapes and the resolved method table, and
+// against an inline cache at the call site, for one shape (monomorphic)
+// and for four shapes taking turns (polymorphic).
+
+using namespace aithon::runtime;
+
+template<typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char* name, size_t ops, double ms, double baseline_ms) {
+    std::cout << name << (ms * 1e6 / ops) << " ns/op";
+    if (baseline_ms > 0) std::cout << " (" << (baseline_ms / ms) << "x)";
+    std::cout << "\n";
+}
+
+static PyObject* identity(PyObject* self) {
+    self->incref();
+    return self;
+}
+
+// The class layout PyClass had before shapes
+struct MapClass {
+    std::vector<MapClass*> bases;
+    std::unordered_map<std::string, std::shared_ptr<PyFunction>> methods;
+
+    PyFunction* get_method(const std::string& name) {
+        auto it = methods.find(name);
+        if (it != methods.end()) return it->second.get();
+        for (MapClass* base : bases) {
+            if (PyFunction* method = base->get_method(name)) return method;
+        }
+        return nullptr;
+    }
+};
+
+int main() {
+    std::cout << "Running Method Dispatch Benchmark\n";
+    std::cout << "=================================\n";
+
+    const size_t ops = 10'000'000;
+    const char* field_names[] = {"x", "y", "z", "w"};
+
+    // Read per lookup, so the lookups can't hash their name once up front.
+    // Cached sites use literals, as compiled code would.
+    const char* volatile method_name = "method";
+    const char* volatile field_name = "z";
+    int64_t checksum = 0;
+
+    auto method = std::make_shared<PyFunction>("method", identity);
+    auto* value = new PyInt(1);
+
+    // Before: maps all the way
+    double map_method_ms, map_field_ms;
+    {
+        MapClass root, middle, leaf;
+        root.methods["method"] = method;
+        middle.bases.push_back(&root);
+        leaf.bases.push_back(&middle);
+        for (const char* name : {"__init__", "__repr__", "helper", "other"}) {
+            leaf.methods[name] = std::make_shared<PyFunction>(name, identity);
+        }
+        std::unordered_map<std::string, PyObject*> fields;
+        for (const char* name : field_names) fields[name] = value;
+
+        map_method_ms = time_ms([&] {
+            for (size_t i = 0; i < ops; i++) {
+                PyObject* result = leaf.get_method(method_name)->call1(value);
+                checksum += result->refcount();
+                result->decref();
+            }
+        });
+        map_field_ms = time_ms([&] {
+            for (size_t i = 0; i < ops; i++) checksum += fields.find(field_name)->second->refcount();
+        });
+        report("maps:         obj.method() ", ops, map_method_ms, 0);
+        report("maps:         obj.field    ", ops, map_field_ms, 0);
+    }
+
+    auto root = std::make_shared<PyClass>("Root");
+    root->add_method("method", method);
+    auto middle = std::make_shared<PyClass>("Middle");
+    middle->add_base(root);
+    auto leaf = std::make_shared<PyClass>("Leaf");
+    leaf->add_base(middle);
+    for (const char* name : {"__init__", "__repr__", "helper", "other"}) {
+        leaf->add_method(name, std::make_shared<PyFunction>(name, identity));
+    }
+
+    // Four shapes: the same fields added in rotated orders
+    std::vector<PyInstance*> instances;
+    for (int order = 0; order < 4; order++) {
+        auto* obj = new PyInstance(leaf);
+        for (int i = 0; i < 4; i++) obj->set_attr(field_names[(order + i) % 4], value);
+        instances.push_back(obj);
+    }
+    PyInstance* obj = instances[0];
+
+    {
+        double method_ms = time_ms([&] {
+            for (size_t i = 0; i < ops; i++) {
+                auto* target = static_cast<PyFunction*>(obj->get_attr(method_name));
+                PyObject* result = target->call1(obj);
+                checksum += result->refcount();
+                result->decref();
+            }
+        });
+        double field_ms = time_ms([&] {
+            for (size_t i = 0; i < ops; i++) checksum += obj->get_attr(field_name)->refcount();
+        });
+        report("get_attr:     obj.method() ", ops, method_ms, map_method_ms);
+        report("get_attr:     obj.field    ", ops, field_ms, map_field_ms);
+    }
+
+    {
+        AttrCache method_site, field_site;
+        double method_ms = time_ms([&] {
+            for (size_t i = 0; i < ops; i++) {
+                PyObject* result = method_site.call_method(obj, "method", nullptr, 0);
+                checksum += result->refcount();
+                result->decref();
+            }
+        });
+        double field_ms = time_ms([&] {
+            for (size_t i = 0; i < ops; i++) checksum += field_site.load(obj, "z")->refcount();
+        });
+        report("monomorphic:  obj.method() ", ops, method_ms, map_method_ms);
+        report("monomorphic:  obj.field    ", ops, field_ms, map_field_ms);
+    }
+
+    {
+        AttrCache method_site, field_site;
+        double method_ms = time_ms([&] {
+            for (size_t i = 0; i < ops; i++) {
+                PyObject* result = method_site.call_method(instances[i & 3], "method", nullptr, 0);
+                checksum += result->refcount();
+                result->decref();
+            }
+        });
+        double field_ms = time_ms([&] {
+            for (size_t i = 0; i < ops; i++) checksum += field_site.load(instances[i & 3], "z")->refcount();
+        });
+        report("polymorphic:  obj.method() ", ops, method_ms, map_method_ms);
+        report("polymorphic:  obj.field    ", ops, field_ms, map_field_ms);
+    }
+
+    for (auto* instance : instances) instance->decref();
+    value->decref();
+    std::cout << "Ops: " << ops << " (checksum " << checksum << ")\n";
+    return 0;
+}
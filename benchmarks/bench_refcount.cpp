@@ -0,0 +1,95 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+// Retain/release benchmark: the previous always-atomic scheme against
+// biased counting on the owner thread, and the shared path under
+// contention once an object has been handed to other threads.
+
+extern "C" {
+    void* runtime_class_create(const char* class_name, int64_t num_fields,
+                               const uint8_t* pointer_map);
+    void* runtime_retain(void* ptr);
+    void runtime_release(void* ptr);
+    void runtime_share(void* ptr);
+}
+
+// The old HeapObject count, behind a call boundary like the runtime's
+struct AtomicCounted {
+    std::atomic<int64_t> ref_count{1};
+};
+
+__attribute__((noinline)) void atomic_retain(AtomicCounted* obj) {
+    obj->ref_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+__attribute__((noinline)) void atomic_release(AtomicCounted* obj) {
+    if (obj->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete obj;
+    }
+}
+
+template<typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    std::cout << "Running Retain/Release Benchmark\n";
+    std::cout << "================================\n";
+
+    const size_t pairs = 100'000'000;
+
+    auto* counted = new AtomicCounted();
+    double atomic_ms = time_ms([&] {
+        for (size_t i = 0; i < pairs; i++) {
+            atomic_retain(counted);
+            atomic_release(counted);
+        }
+    });
+    atomic_release(counted);
+
+    void* obj = runtime_class_create("Bench", 2, nullptr);
+    double biased_ms = time_ms([&] {
+        for (size_t i = 0; i < pairs; i++) {
+            runtime_retain(obj);
+            runtime_release(obj);
+        }
+    });
+
+    // Hand the object to other threads; from here on counting is atomic
+    const size_t threads = 4;
+    const size_t shared_pairs = pairs / 10;
+    runtime_share(obj);
+    double shared_ms = time_ms([&] {
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; t++) {
+            runtime_retain(obj);
+            workers.emplace_back([obj, shared_pairs] {
+                for (size_t i = 0; i < shared_pairs; i++) {
+                    runtime_retain(obj);
+                    runtime_release(obj);
+                }
+                runtime_release(obj);
+            });
+        }
+        for (auto& worker : workers) worker.join();
+    });
+    runtime_release(obj);  // Last reference - freed here
+
+    std::cout << "Pairs: " << pairs << "\n";
+    std::cout << "Atomic (old):   " << atomic_ms << " ms ("
+              << (atomic_ms * 1e6 / pairs) << " ns/pair)\n";
+    std::cout << "Biased (owner): " << biased_ms << " ms ("
+              << (biased_ms * 1e6 / pairs) << " ns/pair)\n";
+    std::cout << "Speedup: " << (atomic_ms / biased_ms) << "x\n";
+    std::cout << "Shared, " << threads << " threads x " << shared_pairs << " pairs: "
+              << shared_ms << " ms\n";
+    return 0;
+}
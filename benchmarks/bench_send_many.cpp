@@ -0,0 +1,83 @@
+#include "runtime/scheduler.h"
+#include "runtime/actor_process.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <atomic>
+
+using namespace aithon::runtime;
+
+// Burst-send benchmark: one producer sends bursts to a few destination
+// actors, once with send_message per message and once with send_many.
+
+static std::atomic<uint64_t> received{0};
+
+void sink_behavior(ActorProcess* self, void* args) {
+    while (self->receive()) {
+        received.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+static double run(Scheduler& scheduler, const std::vector<int>& pids,
+                  size_t bursts, size_t burst_size, bool batched) {
+    int payload = 42;
+    uint64_t expected = received.load() + bursts * burst_size;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t b = 0; b < bursts; ++b) {
+        if (batched) {
+            std::vector<Scheduler::OutgoingMessage> batch;
+            batch.reserve(burst_size);
+            for (size_t i = 0; i < burst_size; ++i) {
+                batch.push_back({pids[i % pids.size()], &payload, sizeof(payload)});
+            }
+            scheduler.send_many(-1, batch);
+        } else {
+            for (size_t i = 0; i < burst_size; ++i) {
+                scheduler.send_message(-1, pids[i % pids.size()], &payload, sizeof(payload));
+            }
+        }
+    }
+
+    auto sent = std::chrono::steady_clock::now();
+
+    while (received.load() < expected) {
+        std::this_thread::yield();
+    }
+
+    return std::chrono::duration<double, std::milli>(sent - start).count();
+}
+
+int main() {
+    std::cout << "Running Burst-Send Benchmark\n";
+    std::cout << "============================\n";
+
+    Scheduler scheduler(4);
+
+    std::vector<int> pids;
+    for (int i = 0; i < 4; ++i) {
+        pids.push_back(scheduler.spawn(sink_behavior, nullptr, 64 * 1024 * 1024));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    const size_t bursts = 2000;
+    const size_t burst_size = 64;
+    const double total = static_cast<double>(bursts * burst_size);
+
+    double single_ms = run(scheduler, pids, bursts, burst_size, false);
+    double batch_ms = run(scheduler, pids, bursts, burst_size, true);
+
+    std::cout << "Messages per mode: " << bursts * burst_size
+              << " (" << bursts << " bursts x " << burst_size
+              << " to " << pids.size() << " actors)\n";
+    std::cout << "send_message: " << single_ms << " ms ("
+              << (total / single_ms * 1000.0) << " msg/s)\n";
+    std::cout << "send_many:    " << batch_ms << " ms ("
+              << (total / batch_ms * 1000.0) << " msg/s)\n";
+    std::cout << "Speedup: " << (single_ms / batch_ms) << "x\n";
+
+    scheduler.dump_stats();
+    scheduler.shutdown();
+    return 0;
+}
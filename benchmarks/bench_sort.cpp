@@ -0,0 +1,137 @@
+#include "runtime/sort.h"
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+// Sort benchmark: std::sort against pdq_sort and radix_sort on int64 keys,
+// on doubles, and through the runtime's list.sort(), at sizes from a cache-
+// resident 1K up to 10M elements. The parallel merge sort runs on plain
+// threads standing in for the scheduler's workers.
+
+using namespace aithon::runtime;
+
+extern "C" {
+    void* runtime_list_create();
+    void runtime_list_append_int(void* list_ptr, int64_t value);
+    int64_t runtime_list_get_int(void* list_ptr, int64_t index);
+    void runtime_list_sort(void* list_ptr, bool reverse);
+    void runtime_list_free(void* list_ptr);
+}
+
+template<typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char* name, size_t n, double ms, double baseline_ms) {
+    std::cout << "  " << name << (ms * 1e6 / n) << " ns/element";
+    if (baseline_ms > 0) std::cout << " (" << (baseline_ms / ms) << "x std::sort)";
+    std::cout << "\n";
+}
+
+static void thread_runner(void*, ParallelTask task, void* ctx, size_t count) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < count; i++) threads.emplace_back(task, ctx, i);
+    for (auto& thread : threads) thread.join();
+}
+
+int main() {
+    std::cout << "Running Sort Benchmark\n";
+    std::cout << "======================\n";
+
+    std::mt19937_64 rng(1);
+    int64_t checksum = 0;
+    size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (size_t n : {1'000, 100'000, 1'000'000, 10'000'000}) {
+        size_t rounds = std::max<size_t>(10'000'000 / n, 1);
+        std::vector<int64_t> keys(n);
+        for (auto& key : keys) key = static_cast<int64_t>(rng());
+        std::vector<double> reals(n);
+        for (auto& real : reals) real = static_cast<double>(rng()) / 3;
+        std::vector<int64_t> work(n), scratch(n);
+        std::vector<double> real_work(n);
+
+        std::cout << n << " random elements (" << rounds << " rounds):\n";
+        double std_ms = 0, pdq_ms = 0, radix_ms = 0, std_real_ms = 0, pdq_real_ms = 0;
+        for (size_t r = 0; r < rounds; r++) {
+            work = keys;
+            std_ms += time_ms([&] { std::sort(work.begin(), work.end()); });
+            checksum += work[n / 2];
+            work = keys;
+            pdq_ms += time_ms([&] {
+                pdq_sort(work.data(), work.data() + n, [](int64_t a, int64_t b) { return a < b; });
+            });
+            checksum += work[n / 2];
+            work = keys;
+            radix_ms += time_ms([&] { radix_sort(work.data(), n, scratch.data()); });
+            checksum += work[n / 2];
+
+            real_work = reals;
+            std_real_ms += time_ms([&] { std::sort(real_work.begin(), real_work.end()); });
+            real_work = reals;
+            pdq_real_ms += time_ms([&] {
+                pdq_sort(real_work.data(), real_work.data() + n, [](double a, double b) { return a < b; });
+            });
+            checksum += static_cast<int64_t>(real_work[n / 2]);
+        }
+        report("int64  std::sort:   ", n * rounds, std_ms, 0);
+        report("int64  pdq_sort:    ", n * rounds, pdq_ms, std_ms);
+        report("int64  radix_sort:  ", n * rounds, radix_ms, std_ms);
+        report("double std::sort:   ", n * rounds, std_real_ms, 0);
+        report("double pdq_sort:    ", n * rounds, pdq_real_ms, std_real_ms);
+
+        // Already sorted input: pdqsort notices, std::sort does not
+        double std_sorted_ms = 0, pdq_sorted_ms = 0;
+        std::sort(work.begin(), work.end());
+        for (size_t r = 0; r < rounds; r++) {
+            std_sorted_ms += time_ms([&] { std::sort(work.begin(), work.end()); });
+            pdq_sorted_ms += time_ms([&] {
+                pdq_sort(work.data(), work.data() + n, [](int64_t a, int64_t b) { return a < b; });
+            });
+        }
+        report("sorted std::sort:   ", n * rounds, std_sorted_ms, 0);
+        report("sorted pdq_sort:    ", n * rounds, pdq_sorted_ms, std_sorted_ms);
+
+        if (n >= 1'000'000 && threads > 1) {
+            const ParallelRunner runner{thread_runner, nullptr, threads};
+            parallel_runner.store(&runner);
+            double parallel_ms = 0;
+            for (size_t r = 0; r < rounds; r++) {
+                work = keys;
+                parallel_ms += time_ms([&] {
+                    parallel_merge_sort(work.data(), n, scratch.data(),
+                                        [](int64_t a, int64_t b) { return a < b; },
+                                        [](int64_t* begin, int64_t* end, int64_t* chunk_scratch) {
+                                            radix_sort(begin, end - begin, chunk_scratch);
+                                        });
+                });
+                checksum += work[n / 2];
+            }
+            parallel_runner.store(nullptr);
+            report("int64  parallel:    ", n * rounds, parallel_ms, std_ms);
+        }
+
+        // list.sort() on an unboxed int list, copy-in excluded
+        double list_ms = 0;
+        for (size_t r = 0; r < rounds; r++) {
+            void* list = runtime_list_create();
+            for (int64_t key : keys) runtime_list_append_int(list, key);
+            list_ms += time_ms([&] { runtime_list_sort(list, false); });
+            checksum += runtime_list_get_int(list, n / 2);
+            runtime_list_free(list);
+        }
+        report("list.sort():        ", n * rounds, list_ms, std_ms);
+    }
+
+    std::cout << "Threads: " << threads << " (checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// String-building benchmark. The old C API copied every string it stored
+// with strlen + malloc + strcpy and had no length to go on; runtime strings
+// carry their length and are shared by the containers that hold them.
+
+extern "C" {
+    void* runtime_string_from_cstr(const char* str);
+    void* runtime_string_concat(void* a, void* b);
+    int64_t runtime_string_length(void* str);
+    void runtime_string_release(void* str);
+    void* runtime_list_create();
+    void runtime_list_append_string(void* list_ptr, void* str);
+    void runtime_list_free(void* list_ptr);
+}
+
+template<typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+static char* copy_cstr(const char* str) {
+    size_t len = strlen(str);
+    auto* copy = static_cast<char*>(malloc(len + 1));
+    memcpy(copy, str, len + 1);
+    return copy;
+}
+
+int main() {
+    std::cout << "Running String Benchmark\n";
+    std::cout << "========================\n";
+
+    const char* word = "a moderately long string value, past the inline size";
+    int64_t checksum = 0;
+
+    // Storing the same string in a list, 1M times
+    const size_t appends = 1'000'000;
+    double copy_store_ms = time_ms([&] {
+        std::vector<char*> items;
+        for (size_t i = 0; i < appends; i++) items.push_back(copy_cstr(word));
+        checksum += items.size();
+        for (char* item : items) free(item);
+    });
+    void* shared = runtime_string_from_cstr(word);
+    double shared_store_ms = time_ms([&] {
+        void* list = runtime_list_create();
+        for (size_t i = 0; i < appends; i++) runtime_list_append_string(list, shared);
+        runtime_list_free(list);
+    });
+    runtime_string_release(shared);
+
+    // Building a string out of 20K short pieces
+    const size_t pieces = 20'000;
+    double cstr_build_ms = time_ms([&] {
+        char* text = copy_cstr("");
+        for (size_t i = 0; i < pieces; i++) {
+            auto* next = static_cast<char*>(malloc(strlen(text) + strlen("piece") + 1));
+            strcpy(next, text);
+            strcat(next, "piece");
+            free(text);
+            text = next;
+        }
+        checksum += strlen(text);
+        free(text);
+    });
+    double runtime_build_ms = time_ms([&] {
+        void* piece = runtime_string_from_cstr("piece");
+        void* text = runtime_string_from_cstr("");
+        for (size_t i = 0; i < pieces; i++) {
+            void* next = runtime_string_concat(text, piece);
+            runtime_string_release(text);
+            text = next;
+        }
+        checksum += runtime_string_length(text);
+        runtime_string_release(text);
+        runtime_string_release(piece);
+    });
+
+    // len() of a 1 MB string
+    const size_t queries = 10'000;
+    std::string big(1 << 20, 'x');
+    void* big_str = runtime_string_from_cstr(big.c_str());
+    double strlen_ms = time_ms([&] {
+        for (size_t i = 0; i < queries; i++) {
+            asm volatile("" ::: "memory");  // Keep strlen in the loop
+            checksum += strlen(big.c_str());
+        }
+    });
+    double length_ms = time_ms([&] {
+        for (size_t i = 0; i < queries; i++) {
+            asm volatile("" ::: "memory");
+            checksum += runtime_string_length(big_str);
+        }
+    });
+    runtime_string_release(big_str);
+
+    std::cout << "List append x" << appends << ": copied " << copy_store_ms
+              << " ms, shared " << shared_store_ms << " ms ("
+              << (copy_store_ms / shared_store_ms) << "x)\n";
+    std::cout << "Concat x" << pieces << ":      char* " << cstr_build_ms
+              << " ms, runtime " << runtime_build_ms << " ms ("
+              << (cstr_build_ms / runtime_build_ms) << "x)\n";
+    std::cout << "len() x" << queries << " on 1 MB: strlen " << strlen_ms
+              << " ms, length " << length_ms << " ms\n";
+    std::cout << "(checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "runtime/pyobject.h"
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Builds a 1M-character string by repeated s = s + piece. PyString::add
+// used to copy the whole left side on every +, making the loop quadratic;
+// that is reproduced with std::string copies and set against the builder.
+// Compiled code: runtime_string_concat, which copies the same way, against
+// the in-place runtime_string_append the compiler lowers loops to.
+
+using namespace aithon::runtime;
+
+extern "C" {
+    void* runtime_string_from_cstr(const char* str);
+    int64_t runtime_string_length(void* str);
+    void* runtime_string_concat(void* a, void* b);
+    void* runtime_string_append(void* s, void* x);
+    void runtime_string_seal(void* str);
+    void runtime_string_release(void* str);
+}
+
+template<typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    std::cout << "Running String Build Benchmark\n";
+    std::cout << "==============================\n";
+
+    const size_t target = 1'000'000;
+    const std::string piece_text = "0123456789";
+    const size_t pieces = target / piece_text.size();
+
+    size_t checksum = 0;
+
+    // Before: a fresh string of the combined length per +
+    double copy_ms = time_ms([&] {
+        std::string s;
+        for (size_t i = 0; i < pieces; i++) s = s + piece_text;
+        checksum += s.size();
+    });
+
+    double builder_ms = time_ms([&] {
+        auto* piece = new PyString(piece_text);
+        PyObject* s = new PyString("");
+        for (size_t i = 0; i < pieces; i++) {
+            PyObject* next = s->add(piece);
+            s->decref();
+            s = next;
+        }
+        checksum += static_cast<PyString*>(s)->value().size();
+        s->decref();
+        piece->decref();
+    });
+
+    void* piece = runtime_string_from_cstr(piece_text.c_str());
+
+    double concat_ms = time_ms([&] {
+        void* s = runtime_string_from_cstr("");
+        for (size_t i = 0; i < pieces; i++) {
+            void* next = runtime_string_concat(s, piece);
+            runtime_string_release(s);
+            s = next;
+        }
+        checksum += runtime_string_length(s);
+        runtime_string_release(s);
+    });
+
+    double append_ms = time_ms([&] {
+        void* start = runtime_string_from_cstr("");
+        void* s = start;
+        for (size_t i = 0; i < pieces; i++) s = runtime_string_append(s, piece);
+        runtime_string_seal(s);
+        checksum += runtime_string_length(s);
+        runtime_string_release(s);
+        runtime_string_release(start);
+    });
+    runtime_string_release(piece);
+
+    std::cout << "Built " << target << " characters from " << pieces << " pieces\n";
+    std::cout << "PyString, copy per +:         " << copy_ms << " ms\n";
+    std::cout << "PyString, builder:            " << builder_ms << " ms\n";
+    std::cout << "C API, runtime_string_concat: " << concat_ms << " ms\n";
+    std::cout << "C API, runtime_string_append: " << append_ms << " ms\n";
+    std::cout << "Speedup: " << (copy_ms / builder_ms) << "x (PyString), "
+              << (concat_ms / append_ms) << "x (C API) (checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "runtime/value.h"
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// Arithmetic loop benchmark: total = total + i * 3 - 1 with boxed PyInt
+// objects, where every step allocates, against NaN-boxed Values, where
+// small ints and floats stay in the word. Counts heap allocations made
+// inside each loop.
+
+using namespace aithon::runtime;
+
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+template<typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    std::cout << "Running Value Arithmetic Benchmark\n";
+    std::cout << "==================================\n";
+
+    const int64_t iterations = 5'000'000;  // Keeps the total in the small-int range
+
+    // PyObject: each operation returns a new PyInt
+    int64_t boxed_result = 0;
+    size_t boxed_allocs = allocations;
+    double boxed_ms = time_ms([&] {
+        PyObject* total = new PyInt(0);
+        PyInt three(3), one(1);
+        for (int64_t i = 0; i < iterations; i++) {
+            PyInt index(i);
+            PyObject* product = index.mul(&three);
+            PyObject* sum = total->add(product);
+            PyObject* next = sum->sub(&one);
+            product->decref();
+            sum->decref();
+            total->decref();
+            total = next;
+        }
+        boxed_result = static_cast<PyInt*>(total)->value();
+        total->decref();
+    });
+    boxed_allocs = allocations - boxed_allocs;
+
+    // Value: no allocation while the total stays in the small range
+    int64_t value_result = 0;
+    size_t value_allocs = allocations;
+    double value_ms = time_ms([&] {
+        Value total = Value::from_int(0);
+        Value three = Value::from_int(3), one = Value::from_int(1);
+        for (int64_t i = 0; i < iterations; i++) {
+            total = total.add(Value::from_int(i).mul(three)).sub(one);
+        }
+        value_result = total.as_int();
+    });
+    value_allocs = allocations - value_allocs;
+
+    // Same loop in floats
+    size_t float_allocs = allocations;
+    double float_result = 0.0;
+    double float_ms = time_ms([&] {
+        Value total = Value::from_double(0.0);
+        Value half = Value::from_double(0.5);
+        for (int64_t i = 0; i < iterations; i++) {
+            total = total.add(Value::from_double(static_cast<double>(i)).mul(half));
+        }
+        float_result = total.as_double();
+    });
+    float_allocs = allocations - float_allocs;
+
+    std::cout << "Iterations: " << iterations << " (3 operations each)\n";
+    std::cout << "PyInt objects: " << boxed_ms << " ms, "
+              << boxed_allocs << " allocations\n";
+    std::cout << "Value (int):   " << value_ms << " ms, "
+              << value_allocs << " allocations\n";
+    std::cout << "Value (float): " << float_ms << " ms, "
+              << float_allocs << " allocations\n";
+    std::cout << "Speedup: " << (boxed_ms / value_ms) << "x\n";
+    std::cout << "Results match: " << (boxed_result == value_result ? "yes" : "NO")
+              << " (float total " << float_result << ")\n";
+    return 0;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Instructions.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace aithon::codegen {
+
+    // Struct type of each class instance - header, then one slot per field -
+    // from LLVMCodeGen's ClassInfo
+    using ClassLayouts = std::unordered_map<std::string, llvm::StructType*>;
+
+    // Escape analysis for class instances. An instance from
+    // runtime_class_create that never leaves its function is replaced by
+    // one stack slot per field, promoted to registers where possible: no
+    // heap allocation and no retain/release. An instance does not escape
+    // when it is only used through field loads and stores (inline GEPs or
+    // the runtime_class_* field calls) and retain/release, lives in at
+    // most one local variable, and is never passed, returned or stored
+    // into another object. Instances of classes with object fields always
+    // escape - their fields hold references the runtime must release.
+    class EscapeAnalysis {
+    public:
+        struct Stats {
+            size_t allocations = 0;     // runtime_class_create calls seen
+            size_t eliminated = 0;      // Replaced by stack slots
+        };
+
+        explicit EscapeAnalysis(const ClassLayouts& layouts) : layouts_(layouts) {}
+
+        Stats run(llvm::Module& module);
+
+    private:
+        // One instance and every instruction that touches it
+        struct Candidate {
+            llvm::CallInst* create = nullptr;
+            llvm::AllocaInst* variable = nullptr;           // Local holding it, if any
+            std::vector<llvm::Instruction*> aliases;        // Loads of the variable, retains
+            std::vector<llvm::Type*> types;                 // Field slot types
+            std::vector<llvm::CallInst*> accesses;          // Field gets and sets
+            std::vector<llvm::GetElementPtrInst*> slots;    // Inline field addresses
+            std::vector<llvm::Instruction*> dead;           // Everything else to delete
+        };
+
+        const ClassLayouts& layouts_;
+
+        bool analyze(Candidate& c) const;
+        bool track_slot(Candidate& c, llvm::GetElementPtrInst* gep) const;
+        bool track_variable(Candidate& c, llvm::AllocaInst* variable,
+                            std::vector<llvm::Value*>& worklist) const;
+        std::vector<llvm::AllocaInst*> scalar_replace(Candidate& c) const;
+    };
+
+}
@@ -15,6 +15,7 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <set>
 #include <unordered_map>
 
 namespace aithon::codegen {
@@ -39,6 +40,7 @@ private:
         STRING,
         LIST,
         DICT,
+        OBJECT,     // Class instance (refcounted HeapObject)
         UNKNOWN
     };
 
@@ -47,6 +49,7 @@ private:
         llvm::Type*       type     = nullptr;
         VarType           var_type = VarType::UNKNOWN;
         std::string       type_name;  // ← ADD THIS (e.g., "Point", "Circle")
+        VarType           element_type = VarType::UNKNOWN;  // LIST: type of every element, if one (FLOAT for ints and floats)
     };
 
     std::unordered_map<std::string, VarInfo> variables_;
@@ -82,6 +85,7 @@ private:
     llvm::AllocaInst* create_entry_block_alloca(llvm::Function* func,
                                                  const std::string& var_name,
                                                  llvm::Type* type = nullptr);
+    void emit_gc_root(llvm::AllocaInst* alloca);
 
     // Code generation for statements
     void codegen_stmt(parser::ast::Stmt* stmt);
@@ -94,6 +98,28 @@ private:
     void codegen_for(parser::ast::ForStmt* stmt);
     void codegen_return(parser::ast::ReturnStmt* stmt);
 
+    // Generators are switch-resumed LLVM coroutines yielding i64 through
+    // their promise; `for x in gen()` resumes them in place
+    struct GeneratorInfo {
+        llvm::Value*      id         = nullptr;  // llvm.coro.id token
+        llvm::Value*      handle     = nullptr;  // Frame, from llvm.coro.begin
+        llvm::AllocaInst* promise    = nullptr;  // Last yielded value
+        llvm::BasicBlock* final_bb   = nullptr;  // Final suspend; returns branch here
+        llvm::BasicBlock* cleanup_bb = nullptr;  // Frees the frame
+        llvm::BasicBlock* suspend_bb = nullptr;  // Back to the caller
+    };
+    std::set<std::string> generators_;             // Functions containing a yield
+    GeneratorInfo* current_generator_ = nullptr;   // Set while emitting one
+    std::vector<llvm::Value*> live_generators_;    // Frames of the enclosing for loops
+
+    void begin_generator(llvm::Function* func, GeneratorInfo& gen);
+    void suspend_generator();
+    void end_generator(GeneratorInfo& gen);
+    void codegen_yield(parser::ast::YieldStmt* stmt);
+    void codegen_for_generator(parser::ast::ForStmt* stmt, parser::ast::CallExpr* call);
+    void destroy_live_generators();
+    void lower_generators();
+
     llvm::Value* codegen_identifier(parser::ast::Identifier* expr);
     void codegen_assignment(parser::ast::Assignment* stmt);
     void codegen_expr_stmt(parser::ast::ExprStmt* stmt);
@@ -102,18 +128,33 @@ private:
     llvm::Value* codegen_expr(parser::ast::Expr* expr);
     llvm::Value* codegen_integer(const parser::ast::IntegerLiteral* expr) const;
     llvm::Value* codegen_float(const parser::ast::FloatLiteral* expr) const;
-    llvm::Value* codegen_string(const parser::ast::StringLiteral* expr) const;
+    llvm::Value* codegen_string(const parser::ast::StringLiteral* expr);
     llvm::Value* codegen_bool(const parser::ast::BoolLiteral* expr) const;
     llvm::Value* codegen_none(parser::ast::NoneLiteral* expr) const;
     llvm::Value* codegen_identifier(const parser::ast::Identifier* expr);
     llvm::Value* codegen_binary_op(const parser::ast::BinaryOp* expr);
     llvm::Value* codegen_unary_op(const parser::ast::UnaryOp* expr);
+    // Int + - * through a *.with.overflow intrinsic, trapping on overflow
+    llvm::Value* codegen_checked_int_op(llvm::Intrinsic::ID id, llvm::Value* left,
+                                        llvm::Value* right, const char* name);
     // llvm::Value* codegen_call(parser::ast::CallExpr *expr);
 
     llvm::Value* codegen_list(parser::ast::ListExpr* expr);
     llvm::Value* codegen_dict(parser::ast::DictExpr* expr);
     llvm::Value* codegen_index(parser::ast::IndexExpr* expr);
 
+    // Lists of ints and floats are read and written in place (RuntimeList)
+    llvm::StructType* runtime_list_type();
+    VarType infer_list_element_type(parser::ast::Expr* expr);
+    static VarType merge_element_types(VarType a, VarType b);
+    bool is_user_function(const std::string& name) const;
+    llvm::Value* list_element_guard(llvm::Value* list, llvm::Value* index,
+                                    llvm::Type* element, llvm::Value*& element_ptr);
+    llvm::Value* codegen_list_load(llvm::Value* list, llvm::Value* index,
+                                   llvm::Type* element, llvm::Function* slow_fn);
+    void codegen_list_store(llvm::Value* list, llvm::Value* index,
+                            llvm::Value* value, llvm::Function* slow_fn);
+
     // Special function generation
     [[nodiscard]] llvm::Function* generate_main_wrapper() const;
 
@@ -131,16 +172,36 @@ private:
         std::vector<VarType>           field_types;
         std::map<std::string, size_t>  field_indices;
         std::vector<llvm::Function*>   methods;
+        llvm::StructType*              llvm_type = nullptr;  // { header, fields... }
     };
 
     std::unordered_map<std::string, StructInfo> struct_types_;
     std::unordered_map<std::string, ClassInfo>  class_types_;
     std::string current_class_name_;  // for 'self' resolution
+    bool report_escapes_ = false;
 
     // Methods
     void codegen_struct_decl(parser::ast::StructDecl*);
     void codegen_class_decl(parser::ast::ClassDecl*);
     VarType parse_type_annotation(const std::string&);
+    llvm::Value* class_pointer_map(const ClassInfo& info);
+    llvm::StructType* heap_object_header_type();
+    llvm::Type* class_field_type(VarType type);
+    llvm::Value* load_class_field(const ClassInfo& info, llvm::Value* obj_ptr,
+                                  size_t field_idx, const std::string& name);
+    void store_class_field(const ClassInfo& info, llvm::Value* obj_ptr,
+                           size_t field_idx, llvm::Value* value);
+    void eliminate_class_allocations();
+
+    // String literals, interned once at module load (see intern_literal)
+    std::map<std::string, llvm::GlobalVariable*> interned_literals_;
+    llvm::StructType* runtime_string_type();
+
+    // String variables appended to in place by the loop being generated
+    std::set<std::string> string_accumulators_;
+    std::set<std::string> find_string_accumulators(parser::ast::WhileStmt* loop);
+    llvm::Value* intern_literal(const std::string& text);
+    void emit_literal_interning();
 
     llvm::Value* codegen_struct_init(const std::string& struct_name,
                                      const std::vector<llvm::Value*>& field_values);
@@ -191,6 +252,9 @@ public:
     // Optimization
     void optimize() const;
 
+    // Print how many class allocations escape analysis removed
+    void set_report_escapes(bool enabled) { report_escapes_ = enabled; }
+
 };
 
 }
\ No newline at end of file
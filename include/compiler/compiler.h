@@ -9,9 +9,11 @@ namespace aithon::compiler {
         Compiler();
         ~Compiler();
 
-        // Compile Python file to executable
+        // Compile Python file to executable. report_escapes prints how
+        // many class allocations escape analysis moved to the stack.
         static bool compile_file(const std::string& input_file,
-                         const std::string& output_file);
+                         const std::string& output_file,
+                         bool report_escapes = false);
 
 
 
@@ -28,6 +28,7 @@ enum class TokenType {
     RETURN,
     BREAK,
     CONTINUE,
+    YIELD,
     AND,
     OR,
     NOT,
@@ -176,6 +176,13 @@ namespace aithon::parser::ast {
         explicit ReturnStmt(std::unique_ptr<Expr> v = nullptr);
     };
 
+    // `yield value` - makes the enclosing function a generator
+    class YieldStmt : public Stmt {
+    public:
+        std::unique_ptr<Expr> value;
+        explicit YieldStmt(std::unique_ptr<Expr> v = nullptr);
+    };
+
     class BreakStmt : public Stmt {};
 
     class ContinueStmt : public Stmt {};
@@ -190,6 +197,7 @@ namespace aithon::parser::ast {
         std::vector<Parameter> parameters;
         std::unique_ptr<Block> body;
         bool is_async;
+        bool is_generator = false;  // Body contains a yield
 
         FunctionDecl(std::string n, std::vector<Parameter> params,
                      std::unique_ptr<Block> b, bool async = false);
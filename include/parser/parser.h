@@ -14,6 +14,7 @@ private:
     std::vector<lexer::Token> tokens_;
     utils::ErrorReporter& error_reporter_;
     size_t current_;
+    bool function_yields_ = false;  // A yield was seen in the function being parsed
     
     // Small inline helper functions (performance-critical)
     [[nodiscard]] const lexer::Token& current() const { return tokens_[current_]; }
@@ -42,6 +43,7 @@ private:
     std::unique_ptr<ast::WhileStmt> parse_while_stmt();
     std::unique_ptr<ast::ForStmt> parse_for_stmt();
     std::unique_ptr<ast::ReturnStmt> parse_return_stmt();
+    std::unique_ptr<ast::YieldStmt> parse_yield_stmt();
     std::unique_ptr<ast::Stmt> parse_assignment_or_expr();
     
     // Expression parsing
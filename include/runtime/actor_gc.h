@@ -3,27 +3,43 @@
 #include <cstddef>
 #include <cstdint>
 #include <vector>
-#include <unordered_set>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <memory>
+#include <functional>
+#include <unordered_map>
+#include <new>
 
 namespace aithon::runtime {
 
 // Object header for GC tracking
 struct alignas(16) GCObjectHeader {
+    // generation values
+    static constexpr uint16_t YOUNG = 0;
+    static constexpr uint16_t OLD = 1;
+    static constexpr uint16_t LARGE = 2;    // Large-object space, never moved
+    static constexpr uint16_t FREE = 3;     // Free block in the old generation
+    static constexpr uint16_t MALLOC = 4;   // gc_alloc_pinned's malloc fallback, no collector
+    
     uint32_t size;              // Object size in bytes
-    uint16_t generation;        // 0 = young, 1 = old
+    uint16_t generation;        // YOUNG, OLD, LARGE or FREE
     uint8_t marked : 1;         // Mark bit for GC
-    uint8_t pinned : 1;         // Pinned objects not moved
+    uint8_t pinned : 1;         // Pinned objects are never moved or collected
     uint8_t has_refs : 1;       // Contains references to other objects
-    uint8_t reserved : 5;
+    uint8_t forwarded : 1;      // Copied out of the nursery; see forward
+    uint8_t age : 4;            // Minor collections survived
     uint8_t type_id;            // Object type for scanning
+    void* forward;              // New data address once forwarded; next free block for FREE;
+                                // owning collector for pinned objects
     
     void* get_data() {
         return reinterpret_cast<void*>(reinterpret_cast<uint8_t*>(this) + sizeof(GCObjectHeader));
     }
 };
 
+static_assert(sizeof(GCObjectHeader) == 16, "GC header must stay two words");
+
 // Generational Garbage Collector for single actor
 class ActorGC {
 public:
@@ -36,11 +52,26 @@ public:
         uint64_t bytes_allocated;
         uint64_t bytes_freed;
         uint64_t promotions;  // Young → Old
+        uint64_t bytes_copied;  // Survivors copied within the nursery
+        uint64_t cards_scanned;
+        uint64_t free_list_allocations;  // Old objects placed in swept holes
+        uint64_t large_objects_allocated;
+        size_t pinned_bytes;            // Live pinned allocations
+        uint64_t large_bytes;            // Currently mapped for large objects
+        uint64_t old_free_bytes;         // Free in the old generation after the last sweep
+        uint64_t largest_free_block;
+        double fragmentation;            // 1 - largest free block / old free bytes
+        double throughput;               // Fraction of wall time outside GC pauses
         std::chrono::microseconds total_pause_time;
         std::chrono::microseconds avg_pause_time;
         std::chrono::microseconds max_pause_time;
     };
     
+    // Root scanning beyond the registered slots: the scanner reports every
+    // slot that may hold an object pointer; moved objects are written back
+    using RootVisitor = std::function<void(void** slot)>;
+    using RootScanner = std::function<void(const RootVisitor&)>;
+    
     enum class CollectionReason {
         YOUNG_FULL,
         OLD_FULL,
@@ -76,32 +107,78 @@ private:
         }
     };
     
-    // Young generation (nursery) - small, collected frequently
+    // Young generation (nursery) - a semispace pair collected by copying.
+    // young_gen_ is allocated into; survivors are copied to survivor_space_
+    // and the two are swapped after every minor collection.
     std::unique_ptr<Generation> young_gen_;
+    std::unique_ptr<Generation> survivor_space_;
     
     // Old generation - larger, collected less frequently
     std::unique_ptr<Generation> old_gen_;
     
     // Root set - stack references, registers, etc.
     std::vector<void**> roots_;
+    RootScanner root_scanner_;
+    
+    // Old generation free lists, rebuilt by every sweep. Classes 0-15 hold
+    // exact sizes 16..256; the rest hold power-of-two ranges, the last one
+    // everything from 64KB up. Blocks are linked through header->forward.
+    static constexpr size_t NUM_SMALL_CLASSES = 16;
+    static constexpr size_t NUM_SIZE_CLASSES = 25;
+    std::array<GCObjectHeader*, NUM_SIZE_CLASSES> free_lists_;
+    uint32_t free_classes_;     // Bit per non-empty class
+    
+    // Large-object space: one mapping per object, keyed by data address
+    std::unordered_map<void*, size_t> large_objects_;
+    
+    // Promoted during the current minor collection, still to be scanned
+    std::vector<GCObjectHeader*> promoted_;
     
-    // Write barrier - track old→young references
-    std::unordered_set<GCObjectHeader*> remembered_set_;
+    // Refcounted runtime objects that may be part of a garbage cycle
+    std::vector<void*> cycle_candidates_;
+    
+    // Card table over the old generation. The write barrier dirties the card
+    // holding a slot that receives a young pointer; minor collections scan
+    // dirty cards only. card_first_object_ records where the first object
+    // starting in each card begins, so a dirty card can be walked.
+    std::vector<uint8_t> cards_;
+    std::vector<uint16_t> card_first_object_;
     
     // Statistics
     GCStats stats_;
     
     // Thresholds
-    static constexpr size_t YOUNG_GEN_SIZE = 512 * 1024;      // 512KB
+    static constexpr size_t YOUNG_GEN_SIZE = 512 * 1024;      // 512KB per semispace
     static constexpr size_t OLD_GEN_SIZE = 8 * 1024 * 1024;   // 8MB
     static constexpr size_t PROMOTION_AGE = 3;                // Survive 3 collections
     static constexpr double YOUNG_THRESHOLD = 0.8;            // Collect at 80% full
     static constexpr double OLD_THRESHOLD = 0.9;              // Collect at 90% full
+    static constexpr double YOUNG_PRESSURE = 0.7;             // Worth collecting while idle
+    static constexpr double OLD_PRESSURE = 0.8;
+    
+    static constexpr size_t CARD_SHIFT = 9;                   // 512-byte cards
+    static constexpr size_t CARD_SIZE = size_t(1) << CARD_SHIFT;
+    static constexpr uint8_t CARD_CLEAN = 0;
+    static constexpr uint8_t CARD_DIRTY = 1;
+    static constexpr uint16_t NO_OBJECT = 0xFFFF;
+    
+    static constexpr size_t LARGE_OBJECT_THRESHOLD = 32 * 1024;   // 32KB
+    static constexpr size_t LARGE_SPACE_SIZE = 64 * 1024 * 1024;  // Collect beyond 64MB mapped
     
-    // Allocation tracking
-    std::unordered_map<GCObjectHeader*, uint16_t> allocation_age_;
+    std::chrono::steady_clock::time_point created_;
+    
+    // One for the actor while it lives, one per object in this heap that
+    // other actors or threads may reference (see hold)
+    std::atomic<size_t> holds_;
+    
+    // Pinned blocks freed on other threads, linked through header->forward
+    // until the owner drains them
+    std::atomic<GCObjectHeader*> remote_frees_;
     
 public:
+    // Processes a batch of cycle candidates, returns the objects freed
+    using CycleCollector = size_t (*)(std::vector<void*>& candidates);
+    
     ActorGC();
     ~ActorGC();
     
@@ -109,24 +186,77 @@ public:
     void* allocate(size_t size, uint8_t type_id = 0, bool has_refs = false);
     void* allocate_old(size_t size, uint8_t type_id = 0, bool has_refs = false);
     
+    // Pinned allocation for memory the collector cannot trace (runtime
+    // objects referenced from compiled code). Lives in the old generation or
+    // the large-object space, is never moved or collected, and is released
+    // by free_pinned or with the collector itself. Returns nullptr when full.
+    void* allocate_pinned(size_t size);
+    void free_pinned(void* ptr);
+    bool owns(void* ptr) const { return header_of(ptr) != nullptr; }
+    
+    // The collector a pinned block came from; nullptr for the malloc
+    // fallback. Reads the block's header, so any thread may ask.
+    static ActorGC* owner_of(void* ptr);
+    
+    // free_pinned for threads other than the owner's: the block is queued
+    // and goes back to the free lists when the owner next becomes current
+    void free_remote(void* ptr);
+    void drain_remote_frees();
+    
+    // A dead actor's heap is freed in bulk, but objects it shared may still
+    // be referenced from elsewhere. Each such object holds the collector;
+    // retire drops the actor's own hold instead of deleting it, and the
+    // last unhold - on whichever thread - deletes it.
+    void hold() { holds_.fetch_add(1, std::memory_order_relaxed); }
+    void unhold();
+    static void retire(std::unique_ptr<ActorGC> gc);
+    
     // Root management
     void add_root(void** root);
     void remove_root(void** root);
+    void set_root_scanner(RootScanner scanner) { root_scanner_ = std::move(scanner); }
     
     // Collection
     void collect_young();  // Minor GC - only young generation
     void collect_full();   // Major GC - both generations
     void collect_if_needed();  // Automatic collection
     
-    // Write barrier (for incremental GC)
-    void write_barrier(void* old_value, void* new_value);
+    // The collections allocation would soon need, run ahead of time for an
+    // idle actor: minor once the nursery is under pressure, major once the
+    // old generation is
+    void collect_pressured();
+    
+    // Cycle detection for the runtime's refcounted objects, which this
+    // collector only holds pinned. The runtime queues the objects that may
+    // be garbage cycles and installs the collector that processes them.
+    // collect_cycles must run with this collector current (ActorGCScope).
+    static void set_cycle_collector(CycleCollector collector);
+    void add_cycle_candidate(void* obj) { cycle_candidates_.push_back(obj); }
+    size_t cycle_candidates() const { return cycle_candidates_.size(); }
+    size_t collect_cycles();
+    
+    // Card-marking write barrier - call after storing new_value into field
+    void write_barrier(void** field, void* new_value) {
+        if (old_gen_->contains(field) && is_young(new_value)) {
+            cards_[card_index(field)] = CARD_DIRTY;
+        }
+    }
     
     // Statistics
     const GCStats& statistics() const { return stats_; }
     size_t young_used() const { return young_gen_->used; }
+    bool is_young(void* ptr) const {
+        return young_gen_->contains(ptr) || survivor_space_->contains(ptr);
+    }
     size_t old_used() const { return old_gen_->used; }
     size_t total_used() const { return young_used() + old_used(); }
     
+    // Nursery, old generation and large-object space together
+    size_t used_bytes() const { return total_used() + stats_.large_bytes; }
+    size_t reserved_bytes() const {
+        return young_gen_->size + survivor_space_->size + old_gen_->size + stats_.large_bytes;
+    }
+    
     // Memory pressure check
     bool is_memory_pressure() const;
     
@@ -139,21 +269,37 @@ private:
     void mark_object(GCObjectHeader* obj);
     void sweep_young();
     void sweep_old();
-    void evacuate_survivors();  // Copy surviving young objects
+    void sweep_large();
+    GCObjectHeader* header_of(void* obj) const;
     
-    // Promotion
-    void promote_to_old(GCObjectHeader* obj);
-    bool should_promote(GCObjectHeader* obj);
+    // Copying nursery (Cheney scan)
+    void* evacuate(void* obj);          // Copy or promote; returns new address
+    void scan_copied(GCObjectHeader* obj);
+    void scan_dirty_cards(uint8_t* old_limit);
+    
+    // Card table
+    size_t card_index(const void* ptr) const {
+        return static_cast<size_t>(static_cast<const uint8_t*>(ptr) - old_gen_->start) >> CARD_SHIFT;
+    }
+    void record_old_object(GCObjectHeader* obj);
+    void forget_object_starts(uint8_t* from, uint8_t* to, bool to_is_object);
     
     // Allocation helpers
     void* allocate_in_generation(Generation& gen, size_t size, uint8_t type_id, bool has_refs);
+    void* allocate_in_old(size_t size, uint8_t type_id, bool has_refs);
+    void* allocate_from_free_list(size_t aligned_size, uint8_t type_id, bool has_refs);
+    void* allocate_large(size_t size, uint8_t type_id, bool has_refs);
+    void make_free_block(uint8_t* start, size_t total_size);
+    static void init_header(GCObjectHeader* header, size_t size, uint16_t generation,
+                            uint8_t type_id, bool has_refs);
+    
+    // Size classes
+    static size_t block_class(size_t size);     // Class a free block is filed under
+    static size_t request_class(size_t size);   // Smallest class whose blocks all fit
     
     // Object scanning
     void scan_object_references(GCObjectHeader* obj, std::function<void(void**)> callback);
     
-    // Compaction (optional)
-    void compact_old_generation();
-    
     // Update statistics
     void record_collection(CollectionReason reason, std::chrono::microseconds duration);
 };
@@ -161,14 +307,82 @@ private:
 // Thread-local GC instance
 extern thread_local ActorGC* current_actor_gc;
 
+// Shadow-stack frames pushed by compiled code. Functions using LLVM's
+// "shadow-stack" GC strategy mark pointer locals with llvm.gcroot; LLVM
+// lowers them into one StackEntry per activation, linked from
+// llvm_gc_root_chain, whose roots[] are the locals themselves. Codegen
+// declares the head thread-local to match, so every worker thread has
+// its own chain.
+struct ShadowStackFrameMap {
+    int32_t num_roots;
+    int32_t num_meta;           // Roots with metadata come first
+    const void* meta[];
+};
+
+struct ShadowStackEntry {
+    ShadowStackEntry* next;     // Caller's frame
+    const ShadowStackFrameMap* map;
+    void* roots[];
+};
+
+extern "C" thread_local ShadowStackEntry* llvm_gc_root_chain;
+
+// Report every root slot of every live compiled frame on the calling
+// thread's chain, from the innermost ActorGCScope out - frames outside it
+// belong to another actor.
+void visit_shadow_stack_roots(const ActorGC::RootVisitor& visit);
+
+// Makes an actor's collector current for the calling thread and takes back
+// the blocks other threads freed meanwhile. The collector is created on the
+// first allocation, so actors that never allocate from compiled code do not
+// pay for one.
+class ActorGCScope {
+private:
+    ActorGC* prev_gc_;
+    std::unique_ptr<ActorGC>* prev_slot_;
+    ShadowStackEntry* prev_chain_;  // Frames of the enclosing actor, if any
+
+public:
+    explicit ActorGCScope(std::unique_ptr<ActorGC>& slot);
+    ~ActorGCScope();
+
+    ActorGCScope(const ActorGCScope&) = delete;
+    ActorGCScope& operator=(const ActorGCScope&) = delete;
+};
+
 // Allocation helpers for generated code
 extern "C" {
     void* gc_alloc(size_t size);
     void* gc_alloc_array(size_t elem_size, size_t count);
+    
+    // Pinned allocation from the current actor's collector; plain malloc
+    // outside actor context. gc_free may run anywhere: blocks from another
+    // actor's heap are handed back to it (ActorGC::free_remote).
+    void* gc_alloc_pinned(size_t size);
+    void gc_free(void* ptr);
     void gc_add_root(void** root);
     void gc_remove_root(void** root);
     void gc_write_barrier(void* obj, void* field, void* new_value);
     void gc_collect();
 }
 
+// Standard allocator over gc_alloc_pinned, for runtime containers whose
+// storage must live in the actor's heap
+template<typename T>
+struct ActorAllocator {
+    using value_type = T;
+    
+    ActorAllocator() = default;
+    template<typename U> ActorAllocator(const ActorAllocator<U>&) {}
+    
+    T* allocate(size_t n) {
+        void* ptr = gc_alloc_pinned(n * sizeof(T));
+        if (!ptr) throw std::bad_alloc();
+        return static_cast<T*>(ptr);
+    }
+    void deallocate(T* ptr, size_t) { gc_free(ptr); }
+    
+    template<typename U> bool operator==(const ActorAllocator<U>&) const { return true; }
+};
+
 } // namespace pyvm::runtime
\ No newline at end of file
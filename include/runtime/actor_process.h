@@ -4,9 +4,12 @@
 
 
 #include "heap.h"
+#include "actor_gc.h"
+#include "intern.h"
 #include "lockfree_queue.h"
 #include "message.h"
 #include <atomic>
+#include <mutex>
 #include <functional>
 #include <vector>
 #include <string>
@@ -16,6 +19,9 @@ namespace aithon::runtime {
 // Reduction budget per scheduling quantum
 constexpr int REDUCTIONS_PER_SLICE = 2000;
 
+// Heap usage (fraction of the maximum) at which receive() collects
+constexpr double ACTOR_GC_THRESHOLD = 0.75;
+
 enum class ActorState {
     RUNNABLE,      // Ready to run
     WAITING,       // Waiting for message
@@ -25,6 +31,18 @@ enum class ActorState {
     DEAD           // Crashed or terminated
 };
 
+// Snapshot of an actor's heap, taken under its heap lock, and of its
+// runtime-object collector as of its last quantum or idle collection
+struct HeapUsage {
+    size_t used;
+    size_t reserved;
+    size_t max;
+    size_t live_after_gc;
+    size_t runtime_used;        // ActorGC: nursery, old generation, large objects
+    size_t runtime_reserved;
+    bool runtime_pressure;      // ActorGC::is_memory_pressure()
+};
+
 class ActorProcess {
 public:
     // Behavior function type (compiled from Python async def)
@@ -34,8 +52,19 @@ private:
     // Process ID
     int pid_;
     
-    // Isolated heap for this actor only
+    // Isolated heap for this actor only. Senders copy payloads in under
+    // heap_mutex_ but never collect; only the owner runs the GC.
     ActorHeap heap_;
+    std::mutex heap_mutex_;
+    
+    // Heap for runtime objects created by compiled code (lists, dicts,
+    // strings, class instances). Current while the behavior runs, created on
+    // first use and released in bulk when the actor dies (ActorGC::retire).
+    std::unique_ptr<ActorGC> runtime_gc_;
+
+    // Interned strings of the actor's Python objects, current alongside
+    // runtime_gc_ and created the same way
+    InternSlot interned_;
     
     // Mailbox - lock-free MPSC queue
     LockFreeQueue<Message> mailbox_;
@@ -61,22 +90,48 @@ private:
     // Continuation - where to resume execution
     void* continuation_state_;
     
+    // Last message handed out by receive() - a GC root until the next one
+    Message* current_message_;
+    
     // Behavior function (compiled from Python async def)
     BehaviorFn behavior_;
     
     // Initial arguments
     void* initial_args_;
     
+    // Worker this actor was last queued on (wakeups go back there)
+    std::atomic<size_t> home_worker_;
+    
+    // Run token: held from the moment the actor is queued until its quantum
+    // has ended, so at most one worker runs it. Whoever wakes it takes the
+    // token to queue it; a wake that finds it held leaves the requeue to
+    // the worker running the quantum (end_quantum).
+    std::atomic<bool> scheduled_;
+    
+    // Idle tracking for hibernation
+    std::atomic<bool> hibernated_;
+    std::atomic<uint64_t> idle_since_;  // Monotonic ms of the last WAITING transition
+    std::atomic<size_t> cycle_candidates_;  // Queued in runtime_gc_ as of the last quantum
+    std::atomic<size_t> runtime_used_;      // runtime_gc_ as of the last quantum
+    std::atomic<size_t> runtime_reserved_;
+    std::atomic<bool> runtime_pressure_;
+    
 public:
-    ActorProcess(int pid, size_t heap_size = 1024 * 1024);
+    ActorProcess(int pid, size_t heap_size = ActorHeap::DEFAULT_MAX_SIZE);
     ~ActorProcess();
     
     // Prevent copying
     ActorProcess(const ActorProcess&) = delete;
     ActorProcess& operator=(const ActorProcess&) = delete;
     
-    // Send message to this actor
-    bool send(Message msg);
+    // Send message to this actor. If woken is given, it is set to true
+    // when this send moved the actor from WAITING to RUNNABLE and took its
+    // run token - the caller must then queue it.
+    bool send(Message msg, bool* woken = nullptr);
+    
+    // Send a burst of messages with one mailbox splice and at most one
+    // state transition. Returns the number of messages delivered.
+    size_t send_batch(std::vector<Message>& batch, bool* woken = nullptr);
     
     // Receive message (returns nullptr if no message available)
     Message* receive();
@@ -84,12 +139,35 @@ public:
     // Non-blocking receive with timeout
     Message* receive_timeout(uint64_t timeout_ms);
     
-    // Execute one scheduling quantum
+    // Allocate on this actor's heap from its own behavior. Heap pointers
+    // kept in locals across an allocation must be registered (HeapRoot).
+    void* allocate(size_t size, uint32_t type_id = HeapType::RAW);
+    
+    // Execute one scheduling quantum. Called by the holder of the run
+    // token (the worker that dequeued the actor); true if the actor is
+    // runnable again and the caller, still holding the token, must requeue it.
     bool execute_quantum();
     
     // Called by compiled code to check if we should yield
     bool should_yield();
     
+    // Shrink the heap of an actor parked in receive() to its live data and
+    // return the rest to the OS, large runtime objects included. Fails
+    // (returns false) unless the actor is WAITING with its quantum over.
+    // woken is set when messages that arrived meanwhile require the actor
+    // to be requeued.
+    bool hibernate(size_t* bytes_released = nullptr, bool* woken = nullptr);
+    
+    // Collect the heap of an actor parked in receive(), any garbage cycles
+    // among its runtime objects and whichever runtime generations are under
+    // pressure, on the caller's thread, so the actor does not pay for it in
+    // its next quantum. Same
+    // preconditions and woken semantics as hibernate().
+    bool collect_idle(size_t* bytes_reclaimed = nullptr, bool* woken = nullptr);
+    
+    // Safe from any thread
+    HeapUsage heap_usage();
+    
     // Crash handling
     void handle_crash(const std::string& reason);
     
@@ -97,6 +175,9 @@ public:
     int pid() const { return pid_; }
     ActorState state() const { return state_.load(); }
     bool is_alive() const;
+    bool is_hibernated() const { return hibernated_.load(std::memory_order_relaxed); }
+    uint64_t idle_since() const { return idle_since_.load(std::memory_order_relaxed); }
+    size_t cycle_candidates() const { return cycle_candidates_.load(std::memory_order_relaxed); }
     
     void set_behavior(BehaviorFn fn) { behavior_ = fn; }
     void set_supervisor(int pid) { supervisor_pid_ = pid; }
@@ -104,13 +185,49 @@ public:
     void set_caller(int pid) { caller_pid_ = pid; }
     void set_initial_args(void* args) { initial_args_ = args; }
     
+    void* continuation() const { return continuation_state_; }
+    void set_continuation(void* state) { continuation_state_ = state; }
+    
+    size_t home_worker() const { return home_worker_.load(std::memory_order_relaxed); }
+    void set_home_worker(size_t worker_id) { home_worker_.store(worker_id, std::memory_order_relaxed); }
+    
     ActorHeap& heap() { return heap_; }
+    ActorGC* runtime_gc() { return runtime_gc_.get(); }
     
     // For debugging
     void dump_state() const;
     
-private:
     static uint64_t get_monotonic_time();
+    
+private:
+    
+    // Run the behavior, isolating crashes
+    bool run_behavior();
+    
+    // Copy a message payload into this actor's heap
+    void* copy_payload(const Message& msg);
+    
+    // Dequeue the next message into the heap (owner only)
+    Message* take_message();
+    
+    // Report mailbox payloads, the continuation and the current message
+    void scan_roots(const ActorHeap::RootVisitor& visit);
+    
+    // WAITING -> RUNNABLE; true if this call performed the transition and
+    // took the run token
+    bool wake();
+    
+    // Release the run token at the end of a quantum unless the actor is
+    // runnable again; true if the caller keeps it and must requeue
+    bool end_quantum();
+    
+    // Publish runtime_gc_'s size for heap_usage() (owner only)
+    void record_runtime_usage();
+    
+    // Run fn on the heap of an actor parked in receive(), with senders
+    // kept from waking it meanwhile; false if the actor was not parked
+    template<typename Fn>
+    bool with_parked_heap(Fn&& fn, bool* woken);
 };
 
 } // namespace pyvm::runtime
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aithon::runtime {
+
+// Arbitrary-precision integer: a sign and a magnitude in 32-bit limbs,
+// least significant first, with no leading zero limbs (zero has none).
+// PyInt only falls back to one when an int64 result would overflow, so
+// these operations are the slow path and favour simplicity over speed -
+// except multiplication, which switches to Karatsuba for large operands.
+//
+// Division and modulo round toward negative infinity, as Python's do.
+// Errors are thrown as std::runtime_error with the Python exception name.
+class BigInt {
+public:
+    // Operands at least this many limbs long on both sides are multiplied
+    // with Karatsuba; below it schoolbook is faster
+    static constexpr size_t KARATSUBA_THRESHOLD = 40;
+
+    BigInt() = default;  // Zero
+    explicit BigInt(int64_t value);
+
+    // Decimal digits with an optional sign; ValueError otherwise
+    static BigInt from_string(std::string_view text);
+
+    bool is_zero() const { return limbs_.empty(); }
+    bool is_negative() const { return negative_; }
+    bool is_odd() const { return !limbs_.empty() && (limbs_[0] & 1); }
+    size_t limb_count() const { return limbs_.size(); }
+
+    bool fits_int64() const;
+    int64_t to_int64() const;  // The caller has checked fits_int64()
+    double to_double() const;  // OverflowError past the double range
+
+    std::string to_string() const;
+    int64_t hash() const;
+
+    // Negative, zero or positive as this is less than, equal to or greater
+    // than other
+    int compare(const BigInt& other) const;
+
+    BigInt operator-() const;
+    friend BigInt operator+(const BigInt& a, const BigInt& b);
+    friend BigInt operator-(const BigInt& a, const BigInt& b);
+    friend BigInt operator*(const BigInt& a, const BigInt& b);
+
+    // Floor division: a == quotient * b + remainder, with the remainder
+    // taking b's sign. ZeroDivisionError when b is zero.
+    static void divmod(const BigInt& a, const BigInt& b, BigInt& quotient, BigInt& remainder);
+
+    BigInt pow(uint64_t exponent) const;
+
+    // The quadratic product at any size - to check and time Karatsuba against
+    static BigInt mul_schoolbook(const BigInt& a, const BigInt& b);
+
+private:
+    std::vector<uint32_t> limbs_;
+    bool negative_ = false;
+
+    void trim();
+};
+
+// int64 operations with Python's rounding, for the paths before BigInt
+
+// base ** exponent by squaring; false on overflow
+inline bool checked_pow(int64_t base, uint64_t exponent, int64_t& result) {
+    result = 1;
+    while (exponent > 0) {
+        if ((exponent & 1) && __builtin_mul_overflow(result, base, &result)) return false;
+        exponent >>= 1;
+        if (exponent > 0 && __builtin_mul_overflow(base, base, &base)) return false;
+    }
+    return true;
+}
+
+// a % b with the sign of b; b is non-zero
+inline int64_t floor_mod(int64_t a, int64_t b) {
+    if (b == -1) return 0;  // INT64_MIN % -1 traps
+    int64_t result = a % b;
+    return result != 0 && (result < 0) != (b < 0) ? result + b : result;
+}
+
+}
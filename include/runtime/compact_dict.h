@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace aithon::runtime {
+
+// Compact, insertion-ordered hash table in the style of CPython's dict.
+// Entries - cached hash, key, value - are appended to a dense array in
+// insertion order; a separate open-addressing table of 32-bit indices
+// points into it. Probing touches only the small index table and compares
+// cached hashes before keys, and iteration walks the dense array.
+//
+// Hash and KeyEqual may be transparent (is_transparent), in which case
+// find/contains/erase accept anything they can hash and compare - a
+// string_view against string keys, say - without building a Key.
+template<typename Key, typename Value,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>,
+         typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class CompactDict {
+public:
+    struct Entry {
+        size_t hash;
+        Key key;
+        Value value;
+        bool live;      // False once erased; compacted away on resize
+    };
+
+private:
+    template<typename T>
+    using Rebind = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+    static constexpr int32_t EMPTY = -1;
+    static constexpr int32_t DUMMY = -2;  // Erased - probing continues past it
+    static constexpr size_t MIN_SLOTS = 8;
+
+    std::vector<int32_t, Rebind<int32_t>> indices_;
+    std::vector<Entry, Rebind<Entry>> entries_;
+    size_t size_ = 0;
+    Hash hash_;
+    KeyEqual equal_;
+
+    // CPython's probe sequence: linear in the low bits at first, then
+    // mixing in the higher hash bits so clustered hashes spread out
+    template<typename Fn>
+    size_t probe(size_t hash, Fn&& visit) const {
+        size_t mask = indices_.size() - 1;
+        size_t perturb = hash;
+        size_t slot = hash & mask;
+        while (!visit(slot)) {
+            perturb >>= 5;
+            slot = (slot * 5 + perturb + 1) & mask;
+        }
+        return slot;
+    }
+
+    template<typename K>
+    int32_t lookup(const K& key, size_t hash) const {
+        if (indices_.empty()) return EMPTY;
+
+        int32_t found = EMPTY;
+        probe(hash, [&](size_t slot) {
+            int32_t index = indices_[slot];
+            if (index == EMPTY) return true;
+            if (index != DUMMY) {
+                const Entry& entry = entries_[index];
+                if (entry.hash == hash && equal_(entry.key, key)) {
+                    found = index;
+                    return true;
+                }
+            }
+            return false;
+        });
+        return found;
+    }
+
+    // First empty slot for a hash known not to be present
+    size_t free_slot(size_t hash) const {
+        return probe(hash, [this](size_t slot) { return indices_[slot] < 0; });
+    }
+
+    // Grow to keep the table at most 2/3 full, dropping erased entries
+    void rehash(size_t min_entries) {
+        size_t slots = MIN_SLOTS;
+        while (slots * 2 < min_entries * 3) slots *= 2;
+
+        if (size_ < entries_.size()) {
+            // Entries before the first erased one are already in place
+            // (moving one onto itself would empty a std::string key)
+            size_t live = 0;
+            for (size_t i = 0; i < entries_.size(); i++) {
+                if (!entries_[i].live) continue;
+                if (live != i) entries_[live] = std::move(entries_[i]);
+                live++;
+            }
+            entries_.erase(entries_.begin() + live, entries_.end());
+        }
+
+        indices_.assign(slots, EMPTY);
+        for (size_t i = 0; i < entries_.size(); i++) {
+            indices_[free_slot(entries_[i].hash)] = static_cast<int32_t>(i);
+        }
+    }
+
+public:
+    CompactDict() = default;
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void reserve(size_t count) {
+        if (count * 3 > indices_.size() * 2) rehash(count);
+        entries_.reserve(count);
+    }
+
+    template<typename K>
+    Value* find(const K& key) {
+        int32_t index = lookup(key, hash_(key));
+        return index >= 0 ? &entries_[index].value : nullptr;
+    }
+
+    template<typename K>
+    const Value* find(const K& key) const {
+        int32_t index = lookup(key, hash_(key));
+        return index >= 0 ? &entries_[index].value : nullptr;
+    }
+
+    template<typename K>
+    bool contains(const K& key) const {
+        return lookup(key, hash_(key)) >= 0;
+    }
+
+    // Inserts or overwrites; returns the stored value and whether the key
+    // was new. Only builds a Key when it is inserted.
+    template<typename K, typename V>
+    std::pair<Value*, bool> insert_or_assign(K&& key, V&& value) {
+        size_t hash = hash_(key);
+        int32_t index = lookup(key, hash);
+        if (index >= 0) {
+            entries_[index].value = std::forward<V>(value);
+            return {&entries_[index].value, false};
+        }
+
+        if ((entries_.size() + 1) * 3 > indices_.size() * 2) {
+            rehash(size_ + 1 > size_ * 2 ? size_ + 1 : size_ * 2);
+        }
+
+        indices_[free_slot(hash)] = static_cast<int32_t>(entries_.size());
+        entries_.push_back(Entry{hash, Key(std::forward<K>(key)), std::forward<V>(value), true});
+        size_++;
+        return {&entries_.back().value, true};
+    }
+
+    // The erased entry stays in place, dead, until the next resize; its
+    // key and value are released now
+    template<typename K>
+    bool erase(const K& key) {
+        size_t hash = hash_(key);
+        if (indices_.empty()) return false;
+
+        bool erased = false;
+        probe(hash, [&](size_t slot) {
+            int32_t index = indices_[slot];
+            if (index == EMPTY) return true;
+            if (index != DUMMY) {
+                Entry& entry = entries_[index];
+                if (entry.hash == hash && equal_(entry.key, key)) {
+                    indices_[slot] = DUMMY;
+                    entry.live = false;
+                    entry.key = Key();
+                    entry.value = Value();
+                    erased = true;
+                    return true;
+                }
+            }
+            return false;
+        });
+
+        if (erased) size_--;
+        return erased;
+    }
+
+    void clear() {
+        indices_.clear();
+        entries_.clear();
+        size_ = 0;
+    }
+
+    // Iteration in insertion order over live entries
+    template<typename EntryT, typename It>
+    class Iterator {
+        It it_, end_;
+        void skip() { while (it_ != end_ && !it_->live) ++it_; }
+
+    public:
+        Iterator(It it, It end) : it_(it), end_(end) { skip(); }
+        EntryT& operator*() const { return *it_; }
+        EntryT* operator->() const { return &*it_; }
+        Iterator& operator++() { ++it_; skip(); return *this; }
+        bool operator==(const Iterator& other) const { return it_ == other.it_; }
+        bool operator!=(const Iterator& other) const { return it_ != other.it_; }
+    };
+
+    using iterator = Iterator<Entry, typename decltype(entries_)::iterator>;
+    using const_iterator = Iterator<const Entry, typename decltype(entries_)::const_iterator>;
+
+    iterator begin() { return {entries_.begin(), entries_.end()}; }
+    iterator end() { return {entries_.end(), entries_.end()}; }
+    const_iterator begin() const { return {entries_.begin(), entries_.end()}; }
+    const_iterator end() const { return {entries_.end(), entries_.end()}; }
+};
+
+}
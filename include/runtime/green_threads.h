@@ -6,6 +6,11 @@
 #include <atomic>
 #include <chrono>
 #include <thread>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <string>
 
 namespace aithon::runtime {
 
@@ -56,7 +61,7 @@ private:
     void* initial_args_;
     
 public:
-    explicit GreenThread(int id, size_t heap_size = 2 * 1024 * 1024);  // 2MB default
+    explicit GreenThread(int id, size_t heap_size = 2 * 1024 * 1024);  // 2MB heap maximum
     ~GreenThread();
     
     // Prevent copying
@@ -4,49 +4,195 @@
 #include <cstdint>
 #include <vector>
 #include <cstring>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <functional>
 
 namespace aithon::runtime {
 
+    // Process-wide cache of heap segments. Segments are page aligned and
+    // sized in powers of two so they can be recycled between actors.
+    class HeapSegmentPool {
+    private:
+        std::mutex mutex_;
+        std::unordered_map<size_t, std::vector<uint8_t*>> free_segments_;
+        std::atomic<size_t> cached_bytes_{0};
+
+        static constexpr size_t MAX_CACHED_PER_SIZE = 64;
+
+    public:
+        static constexpr size_t SEGMENT_ALIGNMENT = 4096;
+
+        ~HeapSegmentPool();
+
+        static HeapSegmentPool& instance();
+
+        uint8_t* acquire(size_t size);
+
+        // With decommit, the segment's pages are handed back to the OS
+        // (MADV_DONTNEED) before it is cached; they fault back in on reuse
+        void release(uint8_t* segment, size_t size, bool decommit = false);
+
+        size_t cached_bytes() const { return cached_bytes_.load(std::memory_order_relaxed); }
+    };
+
+    // Layout of an object type stored on an ActorHeap. The collector is
+    // precise: it only follows the pointer fields listed here.
+    struct HeapTypeInfo {
+        const char* name;
+        std::vector<uint32_t> pointer_offsets;  // Byte offsets of pointer fields
+        bool all_pointers;                      // Every word is a pointer (arrays)
+    };
+
+    // Built-in heap types
+    namespace HeapType {
+        constexpr uint32_t RAW = 0;             // Plain bytes, never traced
+        constexpr uint32_t MESSAGE = 1;         // Message - payload is traced
+        constexpr uint32_t POINTER_ARRAY = 2;   // Array of heap pointers
+    }
+
     class ActorHeap {
+    public:
+        static constexpr size_t DEFAULT_INITIAL_SIZE = 4 * 1024;           // 4KB
+        static constexpr size_t DEFAULT_MAX_SIZE = 64 * 1024 * 1024;       // 64MB
+        static constexpr uint32_t MAX_TYPES = 256;
+
+        // Root scanning: the owner reports every slot that may hold a heap
+        // pointer; the collector rewrites the slots when objects move
+        using RootVisitor = std::function<void(void** slot)>;
+        using RootScanner = std::function<void(const RootVisitor&)>;
+
     private:
-        // Bump allocator for fast allocation
-        uint8_t* heap_start_;
-        uint8_t* heap_end_;
-        uint8_t* allocation_ptr_;
+        // Bump allocator over a chain of segments; each new segment
+        // doubles the previous one until the per-actor maximum is reached
+        struct Segment {
+            uint8_t* start;
+            uint8_t* end;
+            uint8_t* alloc_ptr;
 
-        size_t total_size_;
+            size_t size() const { return end - start; }
+            size_t used() const { return alloc_ptr - start; }
+        };
+
+        std::vector<Segment> segments_;
+        size_t current_;            // Segment currently bump allocating
+
+        size_t initial_size_;
+        size_t max_size_;
+        size_t total_size_;         // Bytes reserved across all segments
         size_t used_size_;
+        size_t peak_size_;
+
+        uint64_t growth_events_;
+        uint64_t shrink_events_;
 
         // Object header for GC
         struct alignas(8) ObjectHeader {
             size_t size;
+            uint8_t* forward;       // New payload address while compacting
+            uint32_t type_id;
             bool marked;
         };
 
+        // GC roots and statistics
+        std::vector<void**> roots_;
+        RootScanner root_scanner_;
+        std::vector<ObjectHeader*> mark_stack_;
+
+        uint64_t collections_;
+        size_t bytes_reclaimed_;
+        size_t live_after_gc_;      // Used bytes right after the last collection
+        uint64_t last_pause_us_;
+        uint64_t max_pause_us_;
+        uint64_t total_pause_us_;
+
     public:
-        explicit ActorHeap(size_t size);
+        explicit ActorHeap(size_t max_size = DEFAULT_MAX_SIZE,
+                           size_t initial_size = DEFAULT_INITIAL_SIZE);
         ~ActorHeap();
 
         // Prevent copying
         ActorHeap(const ActorHeap&) = delete;
         ActorHeap& operator=(const ActorHeap&) = delete;
 
-        // Fast bump allocation
-        void* allocate(size_t size);
+        // Fast bump allocation; collects when the heap is at its maximum
+        void* allocate(size_t size, uint32_t type_id = HeapType::RAW);
+
+        // Allocation that never collects - for threads other than the owner,
+        // which may hold unregistered pointers into the heap
+        void* try_allocate(size_t size, uint32_t type_id = HeapType::RAW);
 
-        // Mark-and-sweep GC
+        // Precise mark-compact GC. Objects not reachable from the roots are
+        // reclaimed and survivors slide down; every root slot and traced
+        // field is updated to the new addresses.
         void collect_garbage();
 
+        // Collect, compact the survivors into one minimal segment and return
+        // every other segment's memory to the OS. The heap grows again on
+        // the next allocation. Returns the bytes released.
+        size_t hibernate();
+
+        // Roots. Registered slots must stay valid until removed.
+        void add_root(void** slot) { roots_.push_back(slot); }
+        void remove_root(void** slot);
+        void set_root_scanner(RootScanner scanner) { root_scanner_ = std::move(scanner); }
+
+        // Type registry shared by all heaps
+        static uint32_t register_type(const HeapTypeInfo& info);
+        static const HeapTypeInfo& type_info(uint32_t type_id);
+
         // Memory info
         size_t used() const { return used_size_; }
         size_t available() const { return total_size_ - used_size_; }
         size_t total() const { return total_size_; }
+        size_t max_size() const { return max_size_; }
+        size_t peak() const { return peak_size_; }
+        size_t num_segments() const { return segments_.size(); }
+        uint64_t growth_events() const { return growth_events_; }
+        uint64_t shrink_events() const { return shrink_events_; }
+        uint64_t collections() const { return collections_; }
+        size_t bytes_reclaimed() const { return bytes_reclaimed_; }
+        size_t live_after_gc() const { return live_after_gc_; }
+        uint64_t last_pause_us() const { return last_pause_us_; }
+        uint64_t max_pause_us() const { return max_pause_us_; }
 
         // For debugging
         void dump_stats() const;
 
     private:
-        void compact_heap();
+        void* bump(Segment& segment, size_t size, size_t total, uint32_t type_id);
+        void* allocate_without_gc(size_t size, size_t total, uint32_t type_id);
+        bool grow(size_t min_bytes);
+        void release_empty_segments();
+        void release_segments_from(size_t index, bool decommit);
+        void collect(bool hibernating);
+
+        ObjectHeader* header_of(void* ptr) const;
+        std::vector<void**> gather_roots();
+        template<typename Fn> static void for_each_field(ObjectHeader* header, Fn&& fn);
+        void mark_object(void* ptr, size_t& live_bytes);
+        size_t mark_from_roots(const std::vector<void**>& roots);
+        void update_slot(void** slot) const;
+        void compact_heap(const std::vector<void**>& roots);
+    };
+
+    // Registers a local variable as a GC root for the lifetime of the scope
+    class HeapRoot {
+    private:
+        ActorHeap& heap_;
+        void** slot_;
+
+    public:
+        template<typename T>
+        HeapRoot(ActorHeap& heap, T** slot)
+            : heap_(heap), slot_(reinterpret_cast<void**>(slot)) {
+            heap_.add_root(slot_);
+        }
+        ~HeapRoot() { heap_.remove_root(slot_); }
+
+        HeapRoot(const HeapRoot&) = delete;
+        HeapRoot& operator=(const HeapRoot&) = delete;
     };
 
-} // namespace pyvm::runtime
\ No newline at end of file
+} // namespace pyvm::runtime
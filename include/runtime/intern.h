@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+
+namespace aithon::runtime {
+
+class InternTable;  // pyobject.h
+
+// Owner of an actor's intern table. The deleter comes from whoever creates
+// the table, so holding a slot does not pull in the object model.
+using InternSlot = std::unique_ptr<InternTable, void (*)(InternTable*)>;
+
+// Slot of the actor running on this thread, if any
+inline thread_local InternSlot* current_intern_slot = nullptr;
+
+// Makes an actor's intern table current for the calling thread. Like the
+// collector, the table is created on first use (InternTable::current).
+class InternScope {
+private:
+    InternSlot* prev_slot_;
+
+public:
+    explicit InternScope(InternSlot& slot) : prev_slot_(current_intern_slot) {
+        current_intern_slot = &slot;
+    }
+    ~InternScope() { current_intern_slot = prev_slot_; }
+
+    InternScope(const InternScope&) = delete;
+    InternScope& operator=(const InternScope&) = delete;
+};
+
+}
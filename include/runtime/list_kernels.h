@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+namespace aithon::runtime {
+
+// Vectorized loops over the flat int64_t and double arrays of unboxed
+// lists (RuntimeList). Each instruction set gets its own table; the best
+// one the CPU supports is picked on first use, with a scalar table as the
+// fallback everywhere.
+//
+// Integer arithmetic wraps; sum_i64 also reports whether a partial sum
+// overflowed, so the caller (runtime.cpp) can raise OverflowError as
+// compiled code's checked arithmetic does. Float sums add in lane order,
+// so their rounding can differ from a left-to-right sum in the last bits,
+// and min/max of a list holding NaN follow the instruction set rather
+// than Python's order-dependent result.
+struct ListKernels {
+    const char* name;
+
+    // Sets *overflow if a partial sum overflowed (the sum then wraps).
+    // Partial sums follow the lanes, so one may overflow where a
+    // left-to-right sum would not, and the other way round.
+    int64_t (*sum_i64)(const int64_t* data, int64_t n, bool* overflow);
+    double  (*sum_f64)(const double* data, int64_t n);
+
+    // n > 0
+    int64_t (*min_i64)(const int64_t* data, int64_t n);
+    int64_t (*max_i64)(const int64_t* data, int64_t n);
+    double  (*min_f64)(const double* data, int64_t n);
+    double  (*max_f64)(const double* data, int64_t n);
+
+    int64_t (*count_i64)(const int64_t* data, int64_t n, int64_t value);
+    int64_t (*count_f64)(const double* data, int64_t n, double value);
+
+    // Index of the first element equal to value, or -1
+    int64_t (*find_i64)(const int64_t* data, int64_t n, int64_t value);
+    int64_t (*find_f64)(const double* data, int64_t n, double value);
+
+    // out[i] = data[i] op value; out may be data
+    void (*add_i64)(const int64_t* data, int64_t n, int64_t value, int64_t* out);
+    void (*mul_i64)(const int64_t* data, int64_t n, int64_t value, int64_t* out);
+    void (*add_f64)(const double* data, int64_t n, double value, double* out);
+    void (*mul_f64)(const double* data, int64_t n, double value, double* out);
+};
+
+enum class SimdLevel {
+    SCALAR,
+    NEON,
+    AVX2,
+    AVX512
+};
+
+// Kernels for one instruction set, or null if this build or CPU lacks it
+const ListKernels* list_kernels_for(SimdLevel level);
+
+// The fastest kernels this CPU runs
+const ListKernels& list_kernels();
+
+}
@@ -47,7 +47,25 @@ public:
         Node* prev_tail = tail_.exchange(new_node, std::memory_order_acq_rel);
         prev_tail->next.store(new_node, std::memory_order_release);
     }
-    
+
+    // Enqueue a batch - links the nodes privately, then splices the whole
+    // chain onto the tail with a single atomic exchange
+    template<typename Iterator>
+    void enqueue_batch(Iterator first, Iterator last) {
+        if (first == last) return;
+
+        Node* chain_head = new Node(std::move(*first));
+        Node* chain_tail = chain_head;
+        for (++first; first != last; ++first) {
+            Node* node = new Node(std::move(*first));
+            chain_tail->next.store(node, std::memory_order_relaxed);
+            chain_tail = node;
+        }
+
+        Node* prev_tail = tail_.exchange(chain_tail, std::memory_order_acq_rel);
+        prev_tail->next.store(chain_head, std::memory_order_release);
+    }
+
     // Try dequeue - should only be called by owning actor
     std::optional<T> try_dequeue() {
         Node* head = head_.load(std::memory_order_relaxed);
@@ -69,6 +87,17 @@ public:
         return result;
     }
     
+    // Visit queued items in order - consumer side only; producers may keep
+    // appending while this runs and their new items may or may not be seen
+    template<typename Fn>
+    void for_each(Fn&& fn) {
+        Node* node = head_.load(std::memory_order_relaxed)->next.load(std::memory_order_acquire);
+        while (node) {
+            fn(*node->data);
+            node = node->next.load(std::memory_order_acquire);
+        }
+    }
+    
     bool is_empty() const {
         Node* head = head_.load(std::memory_order_relaxed);
         Node* next = head->next.load(std::memory_order_acquire);
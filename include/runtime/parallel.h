@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace aithon::runtime {
+
+// Fork-join over the scheduler's worker threads. run_parallel(task, ctx,
+// count) calls task(ctx, i) for every i in [0, count) and returns once all
+// of them have finished. A running Scheduler installs itself as the runner,
+// so runtime code can use its workers without linking it in; with no
+// runner, or while another job holds it, the tasks run on the caller.
+//
+// Tasks may run on threads with no actor of their own, so they must not
+// allocate from an actor heap (gc_alloc_pinned) - the caller sets up
+// whatever memory they need.
+using ParallelTask = void (*)(void* ctx, size_t index);
+
+struct ParallelRunner {
+    void (*run)(void* self, ParallelTask task, void* ctx, size_t count);
+    void* self;
+    size_t workers;     // Threads a job spreads over
+};
+
+inline std::atomic<const ParallelRunner*> parallel_runner{nullptr};
+
+inline size_t parallel_workers() {
+    const ParallelRunner* runner = parallel_runner.load(std::memory_order_acquire);
+    return runner ? runner->workers : 1;
+}
+
+inline void run_parallel(ParallelTask task, void* ctx, size_t count) {
+    const ParallelRunner* runner = parallel_runner.load(std::memory_order_acquire);
+    if (runner && count > 1) {
+        runner->run(runner->self, task, ctx, count);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) task(ctx, i);
+}
+
+// run_parallel for a lambda taking the index
+template<typename Fn>
+void parallel_for(size_t count, Fn&& fn) {
+    using F = std::remove_reference_t<Fn>;
+    run_parallel([](void* ctx, size_t i) { (*static_cast<F*>(ctx))(i); },
+                 const_cast<std::remove_const_t<F>*>(&fn), count);
+}
+
+}
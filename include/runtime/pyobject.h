@@ -5,10 +5,16 @@
 #include <unordered_map>
 #include <cstdint>
 #include <stdexcept>
+#include <string_view>
 
 #include <memory>
 #include <variant>
 #include <functional>
+#include <coroutine>
+
+#include "bigint.h"
+#include "compact_dict.h"
+#include "intern.h"
 
 namespace aithon::runtime {
 
@@ -151,14 +157,28 @@ public:
 };
 
 // Integer type
+// An int64 while the value fits one. Arithmetic checks each int64 result
+// for overflow and only then redoes it as a BigInt; results that fit an
+// int64 again go back to the plain form, so big_ is set exactly when the
+// value is outside the int64 range.
 class PyInt : public PyObject {
 private:
     int64_t value_;
+    std::unique_ptr<BigInt> big_;
 
 public:
     explicit PyInt(int64_t value) : PyObject(PyType::INT), value_(value) {}
+    explicit PyInt(BigInt value);
+
+    bool is_big() const { return big_ != nullptr; }
+    int64_t value() const { return value_; }  // The caller has checked !is_big()
+    const BigInt& big() const { return *big_; }
+
+    BigInt to_big() const { return big_ ? *big_ : BigInt(value_); }
+    double as_double() const { return big_ ? big_->to_double() : static_cast<double>(value_); }
 
-    int64_t value() const { return value_; }
+    // The value as a subscript; IndexError when it is a BigInt
+    int64_t as_index() const;
 
     PyObject* add(PyObject* other) override;
     PyObject* sub(PyObject* other) override;
@@ -203,18 +223,46 @@ public:
 
     std::string to_string() const override;
     bool to_bool() const override;
+    int64_t hash() const override;
 };
 
 // String type
+// A string built by concatenation starts out pending: its text is the
+// first length_ bytes of a builder buffer it shares with the strings it
+// was built from, and concatenating onto the newest of them appends to the
+// buffer in place. The first read of the text flattens it into value_.
 class PyString : public PyObject {
 private:
-    std::string value_;
+    mutable std::string value_;
+    mutable std::shared_ptr<std::string> builder_;  // Set while pending
+    size_t length_;
+    mutable int64_t hash_ = 0;
+    mutable bool hashed_ = false;   // Computed on first hash()
+    bool interned_ = false;         // Canonical copy owned by an InternTable
+
+    friend class InternTable;
+
+    // Below this, concatenation just copies
+    static constexpr size_t BUILDER_MIN_LENGTH = 256;
+
+    PyString(std::shared_ptr<std::string> builder, size_t length)
+        : PyObject(PyType::STRING), builder_(std::move(builder)), length_(length) {}
+
+    std::string_view text() const {
+        return builder_ ? std::string_view(*builder_).substr(0, length_) : std::string_view(value_);
+    }
+    void flatten() const;
 
 public:
     explicit PyString(const std::string& value)
-        : PyObject(PyType::STRING), value_(value) {}
+        : PyObject(PyType::STRING), value_(value), length_(value.size()) {}
 
-    const std::string& value() const { return value_; }
+    const std::string& value() const {
+        if (builder_) flatten();
+        return value_;
+    }
+    bool is_interned() const { return interned_; }
+    bool is_pending() const { return builder_ != nullptr; }
 
     PyObject* add(PyObject* other) override;
     PyObject* mul(PyObject* other) override;
@@ -223,7 +271,7 @@ public:
 
     std::string to_string() const override;
     bool to_bool() const override;
-    size_t length() const;
+    size_t length() const { return length_; }
     int64_t hash() const override;
 };
 
@@ -257,25 +305,47 @@ public:
     const std::vector<PyObject*>& items() const { return items_; }
 };
 
-// Dictionary type
+// Dictionary keys hash through PyObject::hash and compare with eq(). A
+// string_view finds the matching str key directly: it hashes the same as
+// the PyString would.
+struct PyKeyHash {
+    using is_transparent = void;
+    size_t operator()(const PyObject* key) const { return static_cast<size_t>(key->hash()); }
+    size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+};
+
+struct PyKeyEqual {
+    using is_transparent = void;
+    bool operator()(PyObject* a, PyObject* b) const;
+    bool operator()(PyObject* a, std::string_view b) const;
+};
+
+// Dictionary type - insertion-ordered, any hashable key
 class PyDict : public PyObject {
+public:
+    using Table = CompactDict<PyObject*, PyObject*, PyKeyHash, PyKeyEqual>;
+
 private:
-    std::unordered_map<std::string, PyObject*> items_;
+    Table items_;
 
 public:
     PyDict() : PyObject(PyType::DICT) {}
 
     ~PyDict() {
-        for (auto& [key, value] : items_) {
-            if (value) value->decref();
+        for (auto& entry : items_) {
+            entry.key->decref();
+            if (entry.value) entry.value->decref();
         }
     }
 
-    void set(const std::string& key, PyObject* value);
-    PyObject* get(const std::string& key) const;
-    bool contains(const std::string& key) const {
-        return items_.find(key) != items_.end();
-    }
+    void set(PyObject* key, PyObject* value);
+    PyObject* get(PyObject* key) const;
+    bool contains(PyObject* key) const { return items_.contains(key); }
+
+    // String keys without building a PyString, unless one is inserted
+    void set(std::string_view key, PyObject* value);
+    PyObject* get(std::string_view key) const;
+    bool contains(std::string_view key) const { return items_.contains(key); }
 
     PyObject* get_item(PyObject* key) override;
     void set_item(PyObject* key, PyObject* value) override;
@@ -285,33 +355,123 @@ public:
     size_t length() const;
 
     // Iterator support
-    const std::unordered_map<std::string, PyObject*>& items() const { return items_; }
+    const Table& items() const { return items_; }
 };
 
-// Function type
+// Canonical strings for identifiers and literals, one table per actor.
+// Interned strings are owned by the table and live as long as it does; two
+// interned strings are equal only if they are the same object, so their
+// comparison is a pointer check, and their hash is computed once.
+class InternTable {
+private:
+    CompactDict<std::string_view, PyString*> strings_;  // Keys view the strings' own text
+
+public:
+    InternTable() = default;
+    ~InternTable();
+
+    InternTable(const InternTable&) = delete;
+    InternTable& operator=(const InternTable&) = delete;
+
+    // Canonical string for text; borrowed from the table
+    PyString* intern(std::string_view text);
+
+    // Canonical string equal to str - str itself if it becomes the
+    // canonical copy; borrowed from the table
+    PyString* intern(PyString* str);
+
+    size_t size() const { return strings_.size(); }
+
+    // The running actor's table, or a per-thread one outside actors
+    static InternTable& current();
+};
+
+// Function type. Calls follow the vectorcall convention: the arguments as
+// a pointer and a count, borrowed from the caller, and the result a new
+// reference. Every function has a Vectorcall entry point; native functions
+// of 0 to 3 parameters also keep a plain function pointer that call0() ..
+// call3() jump to directly. std::function is left to the functions that
+// need captured state.
 class PyFunction : public PyObject {
 public:
-    using FunctionPtr = std::function<std::shared_ptr<PyObject>(const std::vector<std::shared_ptr<PyObject>>&)>;
+    using Vectorcall = PyObject* (*)(PyFunction* self, PyObject* const* args, size_t nargs);
+    using Call0 = PyObject* (*)();
+    using Call1 = PyObject* (*)(PyObject* a);
+    using Call2 = PyObject* (*)(PyObject* a, PyObject* b);
+    using Call3 = PyObject* (*)(PyObject* a, PyObject* b, PyObject* c);
+    using NativeFn = std::function<PyObject*(PyObject* const* args, size_t nargs)>;
 
 private:
+    Vectorcall vectorcall_;
+    int arity_;             // Parameters of a fixed-arity function, or -1
+    union {
+        Call0 call0;
+        Call1 call1;
+        Call2 call2;
+        Call3 call3;
+    } direct_{};
+    NativeFn native_;
     std::string name_;
-    FunctionPtr func_;
     std::vector<std::string> param_names_;
     std::shared_ptr<PyDict> closure_;
 
-public:
-    PyFunction(const std::string& name, FunctionPtr func)
-        : PyObject(PyType::FUNCTION), name_(name), func_(func),
+    PyFunction(const std::string& name, Vectorcall vectorcall, int arity)
+        : PyObject(PyType::FUNCTION), vectorcall_(vectorcall), arity_(arity), name_(name),
           closure_(std::make_shared<PyDict>()) {}
 
+    static PyObject* vectorcall_fixed0(PyFunction* self, PyObject* const* args, size_t nargs);
+    static PyObject* vectorcall_fixed1(PyFunction* self, PyObject* const* args, size_t nargs);
+    static PyObject* vectorcall_fixed2(PyFunction* self, PyObject* const* args, size_t nargs);
+    static PyObject* vectorcall_fixed3(PyFunction* self, PyObject* const* args, size_t nargs);
+    static PyObject* vectorcall_native(PyFunction* self, PyObject* const* args, size_t nargs);
+
+    [[noreturn]] void arity_error(size_t nargs) const;
+
+public:
+    // Variadic, with the function itself for access to its closure
+    PyFunction(const std::string& name, Vectorcall func)
+        : PyFunction(name, func, -1) {}
+
+    PyFunction(const std::string& name, Call0 func)
+        : PyFunction(name, vectorcall_fixed0, 0) { direct_.call0 = func; }
+    PyFunction(const std::string& name, Call1 func)
+        : PyFunction(name, vectorcall_fixed1, 1) { direct_.call1 = func; }
+    PyFunction(const std::string& name, Call2 func)
+        : PyFunction(name, vectorcall_fixed2, 2) { direct_.call2 = func; }
+    PyFunction(const std::string& name, Call3 func)
+        : PyFunction(name, vectorcall_fixed3, 3) { direct_.call3 = func; }
+
+    // Closures over C++ state
+    PyFunction(const std::string& name, NativeFn func)
+        : PyFunction(name, vectorcall_native, -1) { native_ = std::move(func); }
+
     const std::string& name() const { return name_; }
+    int arity() const { return arity_; }
     std::string to_string() const override { return "<function " + name_ + ">"; }
 
-    // std::shared_ptr<PyObject> call(const std::vector<std::shared_ptr<PyObject>>& args) override {
-    //     return func_(args);
-    // }
-    std::shared_ptr<PyObject> call(const std::vector<std::shared_ptr<PyObject>>& args);
+    PyObject* vectorcall(PyObject* const* args, size_t nargs) { return vectorcall_(this, args, nargs); }
+    PyObject* call(PyObject** args, size_t nargs) override { return vectorcall_(this, args, nargs); }
 
+    // Fixed-arity entry points: a direct call when the arity matches,
+    // otherwise the arguments go through vectorcall
+    PyObject* call0() {
+        if (arity_ == 0) return direct_.call0();
+        return vectorcall_(this, nullptr, 0);
+    }
+    PyObject* call1(PyObject* a) {
+        if (arity_ == 1) return direct_.call1(a);
+        return vectorcall_(this, &a, 1);
+    }
+    PyObject* call2(PyObject* a, PyObject* b) {
+        if (arity_ == 2) return direct_.call2(a, b);
+        PyObject* args[] = {a, b};
+        return vectorcall_(this, args, 2);
+    }
+    PyObject* call3(PyObject* a, PyObject* b, PyObject* c) {
+        if (arity_ == 3) return direct_.call3(a, b, c);
+        PyObject* args[] = {a, b, c};
+        return vectorcall_(this, args, 3);
+    }
 
     void set_closure(std::shared_ptr<PyDict> closure) { closure_ = closure; }
     std::shared_ptr<PyDict> closure() { return closure_; }
@@ -341,54 +501,212 @@ public:
     }
 };
 
-// Class type
-class PyClass : public PyObject {
+// Hidden class: the attribute names an instance has, in the order they
+// were added, each mapped to a slot in the instance's slot array.
+// Instances that gained the same attributes in the same order share a
+// shape, so a cached (shape, slot) pair finds an attribute with one
+// compare and one indexed load. Shapes form a tree rooted at each class;
+// adding an attribute follows (or creates) the edge for its name.
+class Shape {
+private:
+    // Up to this many attributes a scan of the names beats hashing
+    static constexpr uint32_t LINEAR_LOOKUP_MAX = 8;
+
+    uint32_t id_;           // Unique for the process; 0 is never used
+    uint32_t size_;
+    Shape* parent_;
+    std::string name_;      // Attribute this shape added; empty at the root
+    // Names in slot order while there are few, a name -> slot table past
+    // that. Both view name_ here and in the ancestors, which outlive it.
+    std::vector<std::string_view> names_;
+    CompactDict<std::string_view, uint32_t> slots_;
+    std::vector<std::unique_ptr<Shape>> transitions_;
+
+    Shape(Shape* parent, std::string_view name);
+
+public:
+    Shape() : Shape(nullptr, {}) {}
+
+    Shape(const Shape&) = delete;
+    Shape& operator=(const Shape&) = delete;
+
+    uint32_t id() const { return id_; }
+    Shape* parent() const { return parent_; }
+    uint32_t size() const { return size_; }
+
+    // Slot of an attribute, or -1
+    int32_t lookup(std::string_view name) const {
+        if (size_ <= LINEAR_LOOKUP_MAX) {
+            for (uint32_t i = 0; i < size_; i++) {
+                if (names_[i] == name) return static_cast<int32_t>(i);
+            }
+            return -1;
+        }
+        const uint32_t* slot = slots_.find(name);
+        return slot ? static_cast<int32_t>(*slot) : -1;
+    }
+
+    // The shape after adding name (in slot size())
+    Shape* with(std::string_view name);
+};
+
+// Class type. Methods are resolved through the bases once and kept in a
+// flat table; any change to a class's methods or bases invalidates every
+// table and inline cache (method_epoch).
+class PyClass : public PyObject, public std::enable_shared_from_this<PyClass> {
 private:
     std::string name_;
     std::vector<std::shared_ptr<PyClass>> bases_;
     std::unordered_map<std::string, std::shared_ptr<PyFunction>> methods_;
+    CompactDict<std::string_view, PyFunction*> resolved_;   // Views methods_' keys
+    uint64_t resolved_epoch_ = 0;
+    Shape root_shape_;
+
+    static inline uint64_t method_epoch_ = 1;
+
+    void resolve_methods();
 
 public:
     explicit PyClass(const std::string& name)
         : PyObject(PyType::CLASS), name_(name) {}
 
     const std::string& name() const { return name_; }
-    void add_base(std::shared_ptr<PyClass> base) { bases_.push_back(base); }
+    void add_base(std::shared_ptr<PyClass> base) {
+        bases_.push_back(base);
+        method_epoch_++;
+    }
     void add_method(const std::string& name, std::shared_ptr<PyFunction> method) {
         methods_[name] = method;
+        method_epoch_++;
     }
 
-    std::shared_ptr<PyFunction> get_method(const std::string& name);
+    // Own or inherited method (depth-first through the bases, the first
+    // definition winning); borrowed, null if there is none
+    PyFunction* get_method(std::string_view name) {
+        if (resolved_epoch_ != method_epoch_) resolve_methods();
+        PyFunction* const* method = resolved_.find(name);
+        return method ? *method : nullptr;
+    }
+
+    // Bumped whenever any class's methods or bases change
+    static uint64_t method_epoch() { return method_epoch_; }
+
+    // Shape of a new instance
+    Shape* root_shape() { return &root_shape_; }
 
     std::string to_string() const override {
         return "<class '" + name_ + "'>";
     }
 
-    // Create instance
-    std::shared_ptr<PyObject> call(const std::vector<std::shared_ptr<PyObject>>& args);
-    // std::shared_ptr<PyObject> call(const std::vector<std::shared_ptr<PyObject>>& args) override;
-
+    // Create an instance, running __init__ if the class has one. Needs the
+    // class to be owned by a shared_ptr.
+    PyObject* call(PyObject** args, size_t nargs) override;
 };
 
-// Instance type
+// Instance type. Attributes live in slots laid out by the instance's shape.
 class PyInstance : public PyObject {
 private:
     std::shared_ptr<PyClass> class_;
+    Shape* shape_;
+    std::vector<PyObject*> slots_;      // One reference each
 
 public:
     explicit PyInstance(std::shared_ptr<PyClass> cls)
-        : PyObject(PyType::INSTANCE), class_(cls) {}
+        : PyObject(PyType::INSTANCE), class_(cls), shape_(cls->root_shape()) {}
+    ~PyInstance() override;
 
     std::shared_ptr<PyClass> py_class() { return class_; }
+    PyClass* get_class() const { return class_.get(); }
+    Shape* shape() const { return shape_; }
+    PyObject* slot(uint32_t index) const { return slots_[index]; }
 
     std::string to_string() const override {
         return "<instance of " + class_->name() + ">";
     }
 
-    std::shared_ptr<PyObject> get_attr(const std::string& name);
+    // Attribute, then method; borrowed. AttributeError if neither exists.
+    PyObject* get_attr(std::string_view name);
+
+    // Sets or adds an attribute; the instance takes its own reference
+    void set_attr(std::string_view name, PyObject* value);
 };
 
-// Generator type
+// Inline cache for one attribute access site (obj.name, obj.name(...)).
+// Starts empty, caches the first shape it sees (monomorphic), grows to
+// ENTRIES shapes (polymorphic), and past that stops caching new shapes
+// (megamorphic) rather than thrash. An entry is a field slot, or a method
+// that stays valid while method_epoch is unchanged. Keep one per site, for
+// the site's lifetime.
+struct AttrCache {
+    static constexpr size_t ENTRIES = 4;
+
+    struct Entry {
+        uint32_t shape_id = 0;
+        int32_t slot = -1;              // Field slot, or -1 for a method
+        PyFunction* method = nullptr;
+        uint64_t epoch = 0;
+    };
+
+    Entry entries[ENTRIES];
+    uint8_t used = 0;
+    bool megamorphic = false;
+
+    // Borrowed attribute, as PyInstance::get_attr
+    PyObject* load(PyInstance* obj, std::string_view name) {
+        uint32_t shape_id = obj->shape()->id();
+        for (size_t i = 0; i < used; i++) {
+            const Entry& entry = entries[i];
+            if (entry.shape_id != shape_id) continue;
+            if (entry.slot >= 0) return obj->slot(entry.slot);
+            if (entry.epoch == PyClass::method_epoch()) return entry.method;
+            break;
+        }
+        return load_slow(obj, name);
+    }
+
+    // obj.name(args...): a method gets obj as its first argument, a field
+    // is called as it is. Result is a new reference; args are borrowed.
+    PyObject* call_method(PyInstance* obj, std::string_view name, PyObject* const* args, size_t nargs) {
+        uint32_t shape_id = obj->shape()->id();
+        for (size_t i = 0; i < used; i++) {
+            const Entry& entry = entries[i];
+            if (entry.shape_id != shape_id) continue;
+            if (entry.slot < 0 && entry.epoch == PyClass::method_epoch()) {
+                return call_bound(entry.method, obj, args, nargs);
+            }
+            break;
+        }
+        return call_method_slow(obj, name, args, nargs);
+    }
+
+private:
+    // The entry for obj's shape, filling the cache on a miss; an empty
+    // entry (no slot, no method) if obj has no such attribute
+    Entry lookup(PyInstance* obj, std::string_view name);
+
+    PyObject* load_slow(PyInstance* obj, std::string_view name);
+    PyObject* call_method_slow(PyInstance* obj, std::string_view name, PyObject* const* args, size_t nargs);
+
+    static PyObject* call_bound(PyFunction* method, PyObject* self, PyObject* const* args, size_t nargs) {
+        switch (nargs) {
+            case 0: return method->call1(self);
+            case 1: return method->call2(self, args[0]);
+            case 2: return method->call3(self, args[0], args[1]);
+            default: return call_bound_many(method, self, args, nargs);
+        }
+    }
+    static PyObject* call_bound_many(PyFunction* method, PyObject* self, PyObject* const* args, size_t nargs);
+};
+
+// Generator type. The body is a C++20 coroutine: a switch-resumed frame
+// holding its locals, resumed in place by next()/send() - no thread, no
+// stack switch, no allocation per value. Compiled generators are the same
+// kind of frame, built with llvm.coro (see LLVMCodeGen::lower_generators).
+//
+//     static PyGenerator::Body count_to(int64_t n) {
+//         for (int64_t i = 0; i < n; i++) co_yield new PyInt(i);
+//     }
+//     auto* gen = new PyGenerator(count_to(3));
 class PyGenerator : public PyObject {
 public:
     enum class State {
@@ -398,22 +716,61 @@ public:
         COMPLETED
     };
 
+    // Return type of a generator body. co_yield hands over a new
+    // reference; `PyObject* sent = co_yield value;` receives what send()
+    // passed in (borrowed, None for next()).
+    struct Body {
+        struct promise_type {
+            PyObject* yielded = nullptr;
+            PyObject* sent = nullptr;
+
+            Body get_return_object() {
+                return Body{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+            // Nothing runs until the first next(), as in Python
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() { throw; }
+
+            struct YieldAwaiter {
+                promise_type* promise;
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<>) const noexcept {}
+                PyObject* await_resume() const noexcept { return promise->sent; }
+            };
+            YieldAwaiter yield_value(PyObject* value) noexcept {
+                yielded = value;
+                return YieldAwaiter{this};
+            }
+        };
+
+        std::coroutine_handle<promise_type> frame;
+    };
+
 private:
     State state_;
-    void* continuation_;  // Continuation for resuming
-    std::shared_ptr<PyObject> current_value_;
+    std::coroutine_handle<Body::promise_type> frame_;
+
+    PyObject* resume(PyObject* sent);
 
 public:
-    PyGenerator()
+    explicit PyGenerator(Body body)
         : PyObject(PyType::GENERATOR),
           state_(State::CREATED),
-          continuation_(nullptr) {}
+          frame_(body.frame) {}
+
+    ~PyGenerator() override;
+
+    PyGenerator(const PyGenerator&) = delete;
+    PyGenerator& operator=(const PyGenerator&) = delete;
 
     State state() const { return state_; }
-    void set_state(State state) { state_ = state; }
 
-    std::shared_ptr<PyObject> next();
-    void send(std::shared_ptr<PyObject> value);
+    // Next value as a new reference; StopIteration once the body returns
+    PyObject* next();
+    // Resume with value as the result of the pending yield
+    PyObject* send(PyObject* value);
 
     std::string to_string() const override { return "<generator>"; }
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "actor_process.h"
+#include "parallel.h"
 #include <thread>
 #include <vector>
 #include <deque>
@@ -14,6 +15,17 @@
 namespace aithon::runtime {
 
 class Scheduler {
+public:
+    static constexpr uint64_t DEFAULT_HIBERNATE_AFTER_MS = 5000;
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 1024 * 1024 * 1024;   // 1GB
+    
+    // One entry of a batched send
+    struct OutgoingMessage {
+        int to_pid;
+        void* data;
+        size_t size;
+    };
+    
 private:
     // Worker thread
     struct Worker {
@@ -43,11 +55,52 @@ private:
     std::atomic<uint64_t> total_messages_sent_{0};
     std::atomic<uint64_t> total_reductions_{0};
     std::atomic<uint64_t> total_actors_spawned_{0};
+    std::atomic<uint64_t> total_batches_sent_{0};
+    std::atomic<uint64_t> total_hibernations_{0};
+    std::atomic<uint64_t> hibernation_bytes_reclaimed_{0};
+    
+    // Idle policy: actors waiting longer than this are hibernated (0 = off)
+    std::atomic<uint64_t> hibernate_after_ms_{DEFAULT_HIBERNATE_AFTER_MS};
+    std::atomic<uint64_t> last_hibernate_scan_{0};
+    
+    // GC governor: idle workers collect waiting actors before their own
+    // allocations have to, and keep the heaps' total within the budget
+    std::atomic<size_t> memory_budget_{DEFAULT_MEMORY_BUDGET};
+    std::atomic<size_t> memory_footprint_{0};       // As of the last scan
+    std::atomic<uint64_t> last_governor_scan_{0};
+    std::atomic<uint64_t> governor_collections_{0};
+    std::atomic<uint64_t> governor_bytes_reclaimed_{0};
+    
+    // Fork-join jobs (parallel.h): one at a time, run by the caller and by
+    // the workers between actor quanta. parallel_open_ says the job still
+    // has unclaimed tasks; parallel_helpers_ counts workers that may hold
+    // a pointer to it.
+    struct ParallelJob;
+    std::atomic<ParallelJob*> parallel_job_{nullptr};
+    std::atomic<bool> parallel_open_{false};
+    std::atomic<size_t> parallel_helpers_{0};
+    std::mutex parallel_mutex_;
+    ParallelRunner parallel_runner_{};
     
     // Migration threshold
     static constexpr size_t MIGRATION_THRESHOLD = 100;
     static constexpr size_t STEAL_THRESHOLD = 10;
     
+    // How often idle workers look for actors to hibernate
+    static constexpr uint64_t HIBERNATE_SCAN_INTERVAL_MS = 100;
+    
+    // Governor: scan interval, the heap fill at which a waiting actor is
+    // collected ahead of time (below ACTOR_GC_THRESHOLD; runtime heaps use
+    // ActorGC's own pressure marks), the share of the heap that must be new
+    // since its last collection for that to be worth it, the queued cycle
+    // candidates that also warrant a collection, and a cap on the
+    // collections one scan runs, so an idle worker stays responsive
+    static constexpr uint64_t GOVERNOR_SCAN_INTERVAL_MS = 20;
+    static constexpr double GOVERNOR_PRESSURE = 0.5;
+    static constexpr double GOVERNOR_MIN_GARBAGE = 0.25;
+    static constexpr size_t GOVERNOR_CYCLE_CANDIDATES = 1000;
+    static constexpr size_t GOVERNOR_MAX_COLLECTIONS = 16;
+    
 public:
     explicit Scheduler(size_t num_threads = 0);
     ~Scheduler();
@@ -56,17 +109,34 @@ public:
     Scheduler(const Scheduler&) = delete;
     Scheduler& operator=(const Scheduler&) = delete;
     
-    // Spawn new actor
+    // Spawn new actor (heap_size is the actor's heap maximum; the heap
+    // itself starts small and grows on demand)
     int spawn(ActorProcess::BehaviorFn behavior, 
               void* initial_args = nullptr,
-              size_t heap_size = 1024 * 1024);
+              size_t heap_size = ActorHeap::DEFAULT_MAX_SIZE);
     
     // Send message from one actor to another
     bool send_message(int from_pid, int to_pid, void* data, size_t size);
     
+    // Send a burst of messages. Messages are grouped by destination (order
+    // within a destination is preserved), each group is spliced into the
+    // mailbox at once and each woken actor's worker is notified once.
+    // Returns the number of messages delivered.
+    size_t send_many(int from_pid, const std::vector<OutgoingMessage>& batch);
+    
     // Kill an actor
     void kill_actor(int pid);
     
+    // Hibernate an idle actor now. Returns the bytes returned to the OS.
+    size_t hibernate(int pid);
+    
+    // Idle time after which waiting actors are hibernated (0 disables)
+    void set_hibernate_after(uint64_t ms) { hibernate_after_ms_.store(ms, std::memory_order_relaxed); }
+    
+    // Total heap memory the actors may reserve before the governor starts
+    // shrinking waiting actors (0 = no budget, pressure collections only)
+    void set_memory_budget(size_t bytes) { memory_budget_.store(bytes, std::memory_order_relaxed); }
+    
     // Get actor by PID (for debugging)
     ActorProcess* get_actor(int pid);
     
@@ -79,8 +149,11 @@ public:
     // Statistics
     size_t num_actors() const;
     size_t num_alive_actors() const;
+    size_t num_hibernated_actors() const;
     uint64_t total_messages() const { return total_messages_sent_.load(); }
     uint64_t total_reductions() const { return total_reductions_.load(); }
+    size_t memory_footprint() const { return memory_footprint_.load(); }
+    uint64_t governor_collections() const { return governor_collections_.load(); }
     
     // Dump statistics
     void dump_stats() const;
@@ -94,6 +167,21 @@ private:
     
     // Schedule actor on specific worker
     void schedule_actor(int pid, size_t worker_id);
+    void enqueue_actor(ActorProcess* actor, size_t worker_id);
+    
+    // Requeue actors woken by a send on their home workers, one
+    // notification per worker
+    void wake_actors(const std::vector<ActorProcess*>& woken);
+    
+    // Idle policy, run by workers that have nothing to do
+    void hibernate_idle_actors();
+    size_t hibernate_actor(ActorProcess* actor, std::vector<ActorProcess*>& woken);
+    void govern_memory();
+    
+    // Fork-join: run a job across the workers, and lend a worker to the
+    // current one (false if there was nothing to claim)
+    void run_parallel(ParallelTask task, void* ctx, size_t count);
+    bool help_parallel();
     
     // Choose best worker for new actor
     size_t choose_worker();
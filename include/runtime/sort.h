@@ -0,0 +1,345 @@
+#pragma once
+
+#include "parallel.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace aithon::runtime {
+
+// Sorting for runtime lists: pattern-defeating quicksort for anything with
+// a comparison, LSD radix sort for int64 keys, and a parallel merge sort
+// that spreads either over the scheduler's workers for huge inputs.
+
+namespace sort_detail {
+
+constexpr ptrdiff_t INSERTION_SORT_THRESHOLD = 24;
+constexpr ptrdiff_t NINTHER_THRESHOLD = 128;
+constexpr ptrdiff_t PARTIAL_INSERTION_SORT_LIMIT = 8;
+
+template<typename T, typename Less>
+void insertion_sort(T* begin, T* end, Less& less) {
+    if (begin == end) return;
+    for (T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* sift_1 = cur - 1;
+        if (less(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (sift != begin && less(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+
+// Insertion sort for a range that is not the leftmost: *(begin - 1) is no
+// greater than anything in it and stops the inner loop
+template<typename T, typename Less>
+void unguarded_insertion_sort(T* begin, T* end, Less& less) {
+    if (begin == end) return;
+    for (T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* sift_1 = cur - 1;
+        if (less(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (less(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+
+// Insertion sort that gives up after a few moves; true if it finished
+template<typename T, typename Less>
+bool partial_insertion_sort(T* begin, T* end, Less& less) {
+    if (begin == end) return true;
+    ptrdiff_t moved = 0;
+    for (T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* sift_1 = cur - 1;
+        if (less(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (sift != begin && less(tmp, *--sift_1));
+            *sift = std::move(tmp);
+            moved += cur - sift;
+        }
+        if (moved > PARTIAL_INSERTION_SORT_LIMIT) return false;
+    }
+    return true;
+}
+
+template<typename T, typename Less>
+void sort2(T* a, T* b, Less& less) {
+    if (less(*b, *a)) std::iter_swap(a, b);
+}
+
+template<typename T, typename Less>
+void sort3(T* a, T* b, T* c, Less& less) {
+    sort2(a, b, less);
+    sort2(b, c, less);
+    sort2(a, b, less);
+}
+
+// Partitions around *begin: smaller elements left, the rest right.
+// Returns the pivot's final place and whether nothing had to move.
+template<typename T, typename Less>
+std::pair<T*, bool> partition_right(T* begin, T* end, Less& less) {
+    T pivot = std::move(*begin);
+    T* first = begin;
+    T* last = end;
+
+    // The median-of-3 pivot selection guarantees an element no smaller
+    // than the pivot on the right, and one no greater on the left unless
+    // the first element found is already out of place
+    while (less(*++first, pivot)) {}
+    if (first - 1 == begin) {
+        while (first < last && !less(*--last, pivot)) {}
+    } else {
+        while (!less(*--last, pivot)) {}
+    }
+
+    bool already_partitioned = first >= last;
+    while (first < last) {
+        std::iter_swap(first, last);
+        while (less(*++first, pivot)) {}
+        while (!less(*--last, pivot)) {}
+    }
+
+    T* pivot_pos = first - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return {pivot_pos, already_partitioned};
+}
+
+// Partitions around *begin with elements equal to it going left. Used when
+// the pivot equals the element before the range, so everything on the left
+// is equal and needs no further sorting.
+template<typename T, typename Less>
+T* partition_left(T* begin, T* end, Less& less) {
+    T pivot = std::move(*begin);
+    T* first = begin;
+    T* last = end;
+
+    while (less(pivot, *--last)) {}
+    if (last + 1 == end) {
+        while (first < last && !less(pivot, *++first)) {}
+    } else {
+        while (!less(pivot, *++first)) {}
+    }
+
+    while (first < last) {
+        std::iter_swap(first, last);
+        while (less(pivot, *--last)) {}
+        while (!less(pivot, *++first)) {}
+    }
+
+    T* pivot_pos = last;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return pivot_pos;
+}
+
+template<typename T, typename Less>
+void pdqsort_loop(T* begin, T* end, Less& less, int bad_allowed, bool leftmost) {
+    while (true) {
+        ptrdiff_t size = end - begin;
+        if (size < INSERTION_SORT_THRESHOLD) {
+            if (leftmost) insertion_sort(begin, end, less);
+            else unguarded_insertion_sort(begin, end, less);
+            return;
+        }
+
+        // Median of 3, or Tukey's ninther for larger ranges, moved to *begin
+        ptrdiff_t half = size / 2;
+        if (size > NINTHER_THRESHOLD) {
+            sort3(begin, begin + half, end - 1, less);
+            sort3(begin + 1, begin + (half - 1), end - 2, less);
+            sort3(begin + 2, begin + (half + 1), end - 3, less);
+            sort3(begin + (half - 1), begin + half, begin + (half + 1), less);
+            std::iter_swap(begin, begin + half);
+        } else {
+            sort3(begin + half, begin, end - 1, less);
+        }
+
+        // A pivot equal to the element before the range: many duplicates,
+        // put them all left and skip them
+        if (!leftmost && !less(*(begin - 1), *begin)) {
+            begin = partition_left(begin, end, less) + 1;
+            continue;
+        }
+
+        auto [pivot_pos, already_partitioned] = partition_right(begin, end, less);
+        ptrdiff_t l_size = pivot_pos - begin;
+        ptrdiff_t r_size = end - (pivot_pos + 1);
+
+        if (l_size < size / 8 || r_size < size / 8) {
+            // A bad split: after too many, fall back to heapsort so the
+            // worst case stays O(n log n); otherwise break up the pattern
+            // that caused it by shuffling a few elements
+            if (--bad_allowed == 0) {
+                std::make_heap(begin, end, less);
+                std::sort_heap(begin, end, less);
+                return;
+            }
+            if (l_size >= INSERTION_SORT_THRESHOLD) {
+                std::iter_swap(begin, begin + l_size / 4);
+                std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                if (l_size > NINTHER_THRESHOLD) {
+                    std::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+                    std::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+                    std::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    std::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+            if (r_size >= INSERTION_SORT_THRESHOLD) {
+                std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                std::iter_swap(end - 1, end - r_size / 4);
+                if (r_size > NINTHER_THRESHOLD) {
+                    std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    std::iter_swap(end - 2, end - (1 + r_size / 4));
+                    std::iter_swap(end - 3, end - (2 + r_size / 4));
+                }
+            }
+        } else if (already_partitioned &&
+                   partial_insertion_sort(begin, pivot_pos, less) &&
+                   partial_insertion_sort(pivot_pos + 1, end, less)) {
+            // Nothing moved and both sides are (nearly) sorted
+            return;
+        }
+
+        // Recurse into the left side, loop on the right
+        pdqsort_loop(begin, pivot_pos, less, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+// Index in a of the split of the first k merged elements of a and b, with
+// ties taken from a first
+template<typename T, typename Less>
+size_t merge_split(const T* a, size_t a_size, const T* b, size_t b_size, size_t k, Less& less) {
+    size_t lo = k > b_size ? k - b_size : 0;
+    size_t hi = std::min(k, a_size);
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (less(b[k - mid - 1], a[mid])) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+}
+
+// Unstable, O(n log n) worst case, linear on sorted, reversed and
+// all-equal input. less must be a strict weak order.
+template<typename T, typename Less>
+void pdq_sort(T* begin, T* end, Less less) {
+    if (end - begin < 2) return;
+    int log2 = 0;
+    for (size_t n = end - begin; n >>= 1;) log2++;
+    sort_detail::pdqsort_loop(begin, end, less, log2, true);
+}
+
+// Below this, pdq_sort beats radix sort's fixed passes
+constexpr size_t RADIX_SORT_MIN = 256;
+
+// Stable LSD radix sort of n int64s through scratch (n elements): one
+// counting pass, then a scatter per byte with the sign bit flipped so
+// negatives come first. Bytes every key shares are skipped, so keys in a
+// small range take few passes.
+inline void radix_sort(int64_t* data, size_t n, int64_t* scratch) {
+    if (n < RADIX_SORT_MIN) {
+        pdq_sort(data, data + n, [](int64_t a, int64_t b) { return a < b; });
+        return;
+    }
+
+    constexpr uint64_t SIGN = uint64_t(1) << 63;
+    size_t counts[8][256] = {};
+    for (size_t i = 0; i < n; i++) {
+        uint64_t key = static_cast<uint64_t>(data[i]) ^ SIGN;
+        for (int pass = 0; pass < 8; pass++) {
+            counts[pass][(key >> (pass * 8)) & 0xff]++;
+        }
+    }
+
+    int64_t* from = data;
+    int64_t* to = scratch;
+    for (int pass = 0; pass < 8; pass++) {
+        size_t* count = counts[pass];
+        int shift = pass * 8;
+        uint64_t first = ((static_cast<uint64_t>(from[0]) ^ SIGN) >> shift) & 0xff;
+        if (count[first] == n) continue;
+
+        size_t offset = 0;
+        for (int digit = 0; digit < 256; digit++) {
+            size_t c = count[digit];
+            count[digit] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            uint64_t key = static_cast<uint64_t>(from[i]) ^ SIGN;
+            to[count[(key >> shift) & 0xff]++] = from[i];
+        }
+        std::swap(from, to);
+    }
+    if (from != data) std::memcpy(data, from, n * sizeof(int64_t));
+}
+
+// Sorts [data, data + n) over parallel_workers() threads: each sorts a
+// chunk with sort_chunk(begin, end, scratch) - scratch being that chunk's
+// share of the n-element scratch buffer - and then pairs of runs are
+// merged round by round, every merge split evenly across the workers.
+// Stable if sort_chunk is.
+template<typename T, typename Less, typename SortChunk>
+void parallel_merge_sort(T* data, size_t n, T* scratch, Less less, SortChunk sort_chunk) {
+    size_t workers = std::max<size_t>(parallel_workers(), 1);
+    size_t runs = 1;
+    while (runs < workers && runs * 2 <= n) runs *= 2;
+
+    auto bound = [n, runs](size_t run) { return n / runs * run + std::min(run, n % runs); };
+
+    parallel_for(runs, [&](size_t run) {
+        size_t lo = bound(run), hi = bound(run + 1);
+        sort_chunk(data + lo, data + hi, scratch + lo);
+    });
+
+    T* from = data;
+    T* to = scratch;
+    for (size_t width = 1; width < runs; width *= 2) {
+        size_t merges = runs / (width * 2);
+        size_t parts = std::max<size_t>(workers / merges, 1);
+        parallel_for(merges * parts, [&](size_t task) {
+            size_t merge = task / parts, part = task % parts;
+            size_t lo = bound(merge * width * 2);
+            size_t mid = bound(merge * width * 2 + width);
+            size_t hi = bound((merge + 1) * width * 2);
+            const T* a = from + lo;
+            const T* b = from + mid;
+            size_t a_size = mid - lo, b_size = hi - mid;
+
+            // This part's slice of the output, and where it starts in a and b
+            size_t k_lo = (hi - lo) * part / parts;
+            size_t k_hi = (hi - lo) * (part + 1) / parts;
+            size_t i_lo = sort_detail::merge_split(a, a_size, b, b_size, k_lo, less);
+            size_t i_hi = sort_detail::merge_split(a, a_size, b, b_size, k_hi, less);
+            std::merge(a + i_lo, a + i_hi, b + (k_lo - i_lo), b + (k_hi - i_hi),
+                       to + lo + k_lo, less);
+        });
+        std::swap(from, to);
+    }
+    if (from != data) {
+        parallel_for(workers, [&](size_t part) {
+            size_t lo = n * part / workers, hi = n * (part + 1) / workers;
+            std::copy(from + lo, from + hi, data + lo);
+        });
+    }
+}
+
+}
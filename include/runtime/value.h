@@ -0,0 +1,193 @@
+#pragma once
+
+#include "pyobject.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace aithon::runtime {
+
+// A Python value in one 64-bit word (NaN boxing). Doubles are stored as
+// themselves; everything else lives in the negative quiet-NaN space, which
+// no double uses once NaNs are canonicalized:
+//
+//   0xFFF9 | 48-bit pointer    PyObject* - strings, lists, promoted ints, ...
+//   0xFFFA | 48-bit integer    small int, -2^47 .. 2^47 - 1
+//   0xFFFB | 0 / 2 / 3         None / False / True
+//
+// Small ints, floats, bools and None never touch the heap. An int result
+// outside the small range is promoted to a boxed PyInt - an int64, or a
+// BigInt past that - so arithmetic in the common range allocates
+// nothing. Boxed values follow PyObject's manual reference counting;
+// retain() and release() do nothing for inline values.
+class Value {
+public:
+    static constexpr int64_t SMALL_INT_MIN = -(int64_t(1) << 47);
+    static constexpr int64_t SMALL_INT_MAX = (int64_t(1) << 47) - 1;
+
+    Value() : bits_(NONE_BITS) {}
+
+    static Value none() { return Value(NONE_BITS); }
+    static Value from_bool(bool value) { return Value(value ? TRUE_BITS : FALSE_BITS); }
+    static Value from_double(double value);
+    static Value from_object(PyObject* obj);  // Takes over the reference
+
+    // Boxes into a PyInt outside the small range
+    static Value from_int(int64_t value) {
+        if (value >= SMALL_INT_MIN && value <= SMALL_INT_MAX) {
+            return Value(TAG_INT | (static_cast<uint64_t>(value) & PAYLOAD_MASK));
+        }
+        return from_object(new PyInt(value));
+    }
+
+    // Type checking
+    bool is_double() const { return bits_ < TAG_OBJECT; }
+    bool is_object() const { return (bits_ & TAG_MASK) == TAG_OBJECT; }
+    bool is_small_int() const { return (bits_ & TAG_MASK) == TAG_INT; }
+    bool is_none() const { return bits_ == NONE_BITS; }
+    bool is_bool() const { return bits_ == TRUE_BITS || bits_ == FALSE_BITS; }
+    bool is_int() const { return is_small_int() || (is_object() && as_object()->is_int()); }
+    bool is_float() const { return is_double(); }
+
+    // Accessors - the caller has checked the type
+    double as_double() const {
+        double value;
+        std::memcpy(&value, &bits_, sizeof(value));
+        return value;
+    }
+    int64_t small_int() const { return shifted_int() >> 16; }
+    // Small or boxed, but not a BigInt
+    int64_t as_int() const {
+        return is_small_int() ? small_int() : static_cast<PyInt*>(as_object())->value();
+    }
+    bool as_bool() const { return bits_ == TRUE_BITS; }
+    PyObject* as_object() const { return reinterpret_cast<PyObject*>(bits_ & PAYLOAD_MASK); }
+    uint64_t bits() const { return bits_; }
+
+    // Reference counting of boxed values
+    void retain() const { if (is_object()) as_object()->incref(); }
+    void release() const { if (is_object()) as_object()->decref(); }
+
+    // Arithmetic operations - the same set as PyObject
+    Value add(Value other) const;
+    Value sub(Value other) const;
+    Value mul(Value other) const;
+    Value div(Value other) const;
+    Value mod(Value other) const;
+    Value pow(Value other) const;
+
+    // Comparison operations
+    Value eq(Value other) const;
+    Value ne(Value other) const;
+    Value lt(Value other) const;
+    Value le(Value other) const;
+    Value gt(Value other) const;
+    Value ge(Value other) const;
+
+    // Unary operations
+    Value neg() const;
+
+    // Conversions
+    std::string to_string() const;
+    bool to_bool() const;
+    int64_t hash() const;
+
+private:
+    static constexpr uint64_t TAG_MASK     = 0xFFFF'0000'0000'0000;
+    static constexpr uint64_t PAYLOAD_MASK = 0x0000'FFFF'FFFF'FFFF;
+    static constexpr uint64_t TAG_OBJECT   = 0xFFF9'0000'0000'0000;
+    static constexpr uint64_t TAG_INT      = 0xFFFA'0000'0000'0000;
+    static constexpr uint64_t TAG_SPECIAL  = 0xFFFB'0000'0000'0000;
+    static constexpr uint64_t NONE_BITS    = TAG_SPECIAL | 0;
+    static constexpr uint64_t FALSE_BITS   = TAG_SPECIAL | 2;
+    static constexpr uint64_t TRUE_BITS    = TAG_SPECIAL | 3;
+    static constexpr uint64_t CANONICAL_NAN = 0x7FF8'0000'0000'0000;
+
+    enum class CompareOp { EQ, NE, LT, LE, GT, GE };
+
+    uint64_t bits_;
+
+    explicit Value(uint64_t bits) : bits_(bits) {}
+
+    // A small int's payload in the top 48 bits: arithmetic on it overflows
+    // int64 exactly when the result leaves the small range
+    int64_t shifted_int() const { return static_cast<int64_t>(bits_ << 16); }
+    static Value from_shifted_int(int64_t shifted) {
+        return Value(TAG_INT | (static_cast<uint64_t>(shifted) >> 16));
+    }
+
+    // Everything but small ints and doubles of the same kind
+    Value add_slow(Value other) const;
+    Value sub_slow(Value other) const;
+    Value mul_slow(Value other) const;
+    Value compare_slow(Value other, CompareOp op) const;
+};
+
+static_assert(sizeof(Value) == sizeof(uint64_t), "Value must stay one word");
+
+inline Value Value::from_double(double value) {
+    if (value != value) return Value(CANONICAL_NAN);  // Keep NaNs out of the tag space
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return Value(bits);
+}
+
+inline Value Value::from_object(PyObject* obj) {
+    return Value(TAG_OBJECT | reinterpret_cast<uint64_t>(obj));
+}
+
+// Fast paths stay inline. On small ints each is one overflow-checked
+// operation on the shifted payloads and one branch; an overflow - a result
+// outside the small range - goes to the slow path, which boxes it.
+
+inline Value Value::add(Value other) const {
+    int64_t result;
+    if (is_small_int() && other.is_small_int() &&
+        !__builtin_add_overflow(shifted_int(), other.shifted_int(), &result)) {
+        return from_shifted_int(result);
+    }
+    if (is_double() && other.is_double()) {
+        return from_double(as_double() + other.as_double());
+    }
+    return add_slow(other);
+}
+
+inline Value Value::sub(Value other) const {
+    int64_t result;
+    if (is_small_int() && other.is_small_int() &&
+        !__builtin_sub_overflow(shifted_int(), other.shifted_int(), &result)) {
+        return from_shifted_int(result);
+    }
+    if (is_double() && other.is_double()) {
+        return from_double(as_double() - other.as_double());
+    }
+    return sub_slow(other);
+}
+
+inline Value Value::mul(Value other) const {
+    int64_t result;
+    if (is_small_int() && other.is_small_int() &&
+        !__builtin_mul_overflow(shifted_int(), other.small_int(), &result)) {
+        return from_shifted_int(result);
+    }
+    if (is_double() && other.is_double()) {
+        return from_double(as_double() * other.as_double());
+    }
+    return mul_slow(other);
+}
+
+inline Value Value::eq(Value other) const {
+    if (is_small_int() && other.is_small_int()) {
+        return from_bool(bits_ == other.bits_);
+    }
+    return compare_slow(other, CompareOp::EQ);
+}
+
+inline Value Value::lt(Value other) const {
+    if (is_small_int() && other.is_small_int()) {
+        return from_bool(small_int() < other.small_int());
+    }
+    return compare_slow(other, CompareOp::LT);
+}
+
+}
@@ -339,6 +339,20 @@ void SemanticAnalyzer::analyze_stmt(parser::ast::Stmt* stmt) {
         }
     }
     
+    else if (auto* yield_stmt = dynamic_cast<parser::ast::YieldStmt*>(stmt)) {
+        if (!in_function_) {
+            error_reporter_.syntax_error(
+                lexer::SourceLocation(0, 0),
+                "'yield' outside function"
+            );
+            return;
+        }
+        
+        if (yield_stmt->value) {
+            analyze_expr(yield_stmt->value.get());
+        }
+    }
+    
     else if (dynamic_cast<parser::ast::BreakStmt*>(stmt)) {
         if (!in_loop_) {
             error_reporter_.syntax_error(
@@ -381,7 +395,8 @@ void SemanticAnalyzer::analyze_stmt(parser::ast::Stmt* stmt) {
         
         analyze_stmt(func->body.get());
         
-        bool has_return = check_function_has_return(func->body.get());
+        // Calling a generator always produces a value: the generator
+        bool has_return = func->is_generator || check_function_has_return(func->body.get());
         function_has_return_[func->name] = has_return;
         
         symbol_table_.pop_scope();
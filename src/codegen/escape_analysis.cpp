@@ -0,0 +1,301 @@
+#include "../../include/codegen/escape_analysis.h"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/Analysis/ValueTracking.h>
+#include <llvm/Transforms/Utils/PromoteMemToReg.h>
+#include <algorithm>
+
+namespace aithon::codegen {
+
+// Fields are untyped 64-bit words in the runtime; convert through one
+// the same way its getters and setters do
+static llvm::Value* convert(llvm::IRBuilder<>& builder, llvm::Value* value, llvm::Type* to) {
+    llvm::Type* from = value->getType();
+    if (from == to) return value;
+
+    llvm::Type* i64 = builder.getInt64Ty();
+    llvm::Value* word = value;
+    if (from->isIntegerTy(1)) {
+        word = builder.CreateZExt(value, i64);
+    } else if (from->isDoubleTy()) {
+        word = builder.CreateBitCast(value, i64);
+    } else if (from->isPointerTy()) {
+        word = builder.CreatePtrToInt(value, i64);
+    } else if (from->isIntegerTy()) {
+        word = builder.CreateSExtOrTrunc(value, i64);
+    }
+
+    if (to->isIntegerTy(1)) {
+        return builder.CreateICmpNE(word, llvm::ConstantInt::get(i64, 0));
+    }
+    if (to->isDoubleTy()) {
+        return builder.CreateBitCast(word, to);
+    }
+    if (to->isPointerTy()) {
+        return builder.CreateIntToPtr(word, to);
+    }
+    return builder.CreateSExtOrTrunc(word, to);
+}
+
+EscapeAnalysis::Stats EscapeAnalysis::run(llvm::Module& module) {
+    Stats stats;
+    llvm::Function* create_fn = module.getFunction("runtime_class_create");
+    if (!create_fn) return stats;
+
+    std::vector<llvm::CallInst*> creates;
+    for (llvm::User* user : create_fn->users()) {
+        auto* call = llvm::dyn_cast<llvm::CallInst>(user);
+        if (call && call->getCalledFunction() == create_fn) {
+            creates.push_back(call);
+        }
+    }
+
+    std::unordered_map<llvm::Function*, std::vector<llvm::AllocaInst*>> field_slots;
+    for (llvm::CallInst* create : creates) {
+        stats.allocations++;
+
+        Candidate c;
+        c.create = create;
+        if (!analyze(c)) continue;
+
+        llvm::Function* func = create->getFunction();
+        std::vector<llvm::AllocaInst*> fields = scalar_replace(c);
+        auto& slots = field_slots[func];
+        slots.insert(slots.end(), fields.begin(), fields.end());
+        stats.eliminated++;
+    }
+
+    // Turn the field slots into SSA values where they allow it
+    for (auto& [func, slots] : field_slots) {
+        std::erase_if(slots, [](llvm::AllocaInst* slot) {
+            return !llvm::isAllocaPromotable(slot);
+        });
+        if (slots.empty()) continue;
+
+        llvm::DominatorTree dominators(*func);
+        llvm::PromoteMemToReg(slots, dominators);
+    }
+
+    return stats;
+}
+
+bool EscapeAnalysis::analyze(Candidate& c) const {
+    llvm::CallInst* create = c.create;
+
+    // Object fields hold counted references the runtime has to release
+    if (!llvm::isa<llvm::ConstantPointerNull>(create->getArgOperand(2))) return false;
+    auto* num_fields = llvm::dyn_cast<llvm::ConstantInt>(create->getArgOperand(1));
+    if (!num_fields) return false;
+
+    // Field types from the class layout; untyped words if it is unknown
+    llvm::StructType* layout = nullptr;
+    c.types.assign(num_fields->getZExtValue(), llvm::Type::getInt64Ty(create->getContext()));
+    llvm::StringRef class_name;
+    if (llvm::getConstantStringInfo(create->getArgOperand(0), class_name)) {
+        auto it = layouts_.find(class_name.str());
+        if (it != layouts_.end() && it->second->getNumElements() == c.types.size() + 1) {
+            layout = it->second;
+            c.types.assign(layout->element_begin() + 1, layout->element_end());
+        }
+    }
+
+    // Follow the instance through the local holding it and any retains
+    std::vector<llvm::Value*> worklist{create};
+    while (!worklist.empty()) {
+        llvm::Value* value = worklist.back();
+        worklist.pop_back();
+
+        for (llvm::User* user : value->users()) {
+            if (auto* store = llvm::dyn_cast<llvm::StoreInst>(user)) {
+                // Assigning it to a local is fine, storing through it is not
+                auto* variable = llvm::dyn_cast<llvm::AllocaInst>(store->getPointerOperand());
+                if (store->getValueOperand() != value || !variable) return false;
+                if (variable != c.variable &&
+                    (c.variable || !track_variable(c, variable, worklist))) {
+                    return false;
+                }
+                continue;
+            }
+
+            if (auto* gep = llvm::dyn_cast<llvm::GetElementPtrInst>(user)) {
+                if (gep->getPointerOperand() != value || gep->getSourceElementType() != layout ||
+                    !track_slot(c, gep)) {
+                    return false;
+                }
+                continue;
+            }
+
+            auto* call = llvm::dyn_cast<llvm::CallInst>(user);
+            if (!call || !call->getCalledFunction()) return false;
+
+            // It may only ever be the object operand
+            for (unsigned i = 1; i < call->arg_size(); i++) {
+                if (call->getArgOperand(i) == value) return false;
+            }
+
+            llvm::StringRef callee = call->getCalledFunction()->getName();
+            if (callee.starts_with("runtime_class_get_field_") ||
+                callee.starts_with("runtime_class_set_field_")) {
+                auto* index = llvm::dyn_cast<llvm::ConstantInt>(call->getArgOperand(1));
+                if (!index || index->getZExtValue() >= num_fields->getZExtValue()) return false;
+                c.accesses.push_back(call);
+            } else if (callee == "runtime_retain") {
+                c.aliases.push_back(call);
+                worklist.push_back(call);
+            } else if (callee == "runtime_release") {
+                c.dead.push_back(call);
+            } else {
+                return false;
+            }
+        }
+    }
+
+    if (!c.variable) return true;
+
+    // The local must hold this instance and nothing else
+    for (llvm::User* user : c.variable->users()) {
+        auto* store = llvm::dyn_cast<llvm::StoreInst>(user);
+        if (!store) continue;
+        llvm::Value* stored = store->getValueOperand();
+        if (stored != create &&
+            std::find(c.aliases.begin(), c.aliases.end(), stored) == c.aliases.end()) {
+            return false;
+        }
+    }
+
+    // Every construction at the same site reuses the same slots, so a value
+    // read from the local must be used up before the site runs again. Keep
+    // such values within their block, and not across the construction.
+    auto used_within = [create](llvm::Instruction* alias, llvm::Instruction* inst) {
+        if (inst->getParent() != alias->getParent()) return false;
+        return create->getParent() != alias->getParent() ||
+               !alias->comesBefore(create) || !create->comesBefore(inst);
+    };
+    for (llvm::Instruction* alias : c.aliases) {
+        for (llvm::User* user : alias->users()) {
+            auto* inst = llvm::cast<llvm::Instruction>(user);
+            if (!used_within(alias, inst)) return false;
+
+            // A field address counts as the instance itself
+            if (llvm::isa<llvm::GetElementPtrInst>(inst)) {
+                for (llvm::User* access : inst->users()) {
+                    if (!used_within(alias, llvm::cast<llvm::Instruction>(access))) return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool EscapeAnalysis::track_variable(Candidate& c, llvm::AllocaInst* variable,
+                                    std::vector<llvm::Value*>& worklist) const {
+    c.variable = variable;
+
+    for (llvm::User* user : variable->users()) {
+        if (auto* store = llvm::dyn_cast<llvm::StoreInst>(user)) {
+            if (store->getPointerOperand() != variable) return false;  // Address escapes
+            c.dead.push_back(store);
+        } else if (auto* load = llvm::dyn_cast<llvm::LoadInst>(user)) {
+            c.aliases.push_back(load);
+            worklist.push_back(load);
+        } else if (auto* intrinsic = llvm::dyn_cast<llvm::IntrinsicInst>(user);
+                   intrinsic && intrinsic->getIntrinsicID() == llvm::Intrinsic::gcroot) {
+            c.dead.push_back(intrinsic);  // No heap object left to report
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool EscapeAnalysis::track_slot(Candidate& c, llvm::GetElementPtrInst* gep) const {
+    // Only the address of a whole field: gep %class, %obj, 0, <field + 1>
+    if (gep->getNumIndices() != 2) return false;
+    auto* base = llvm::dyn_cast<llvm::ConstantInt>(gep->getOperand(1));
+    auto* slot = llvm::dyn_cast<llvm::ConstantInt>(gep->getOperand(2));
+    if (!base || !slot || !base->isZero() || slot->isZero() ||
+        slot->getZExtValue() > c.types.size()) {
+        return false;
+    }
+
+    // ... loaded from and stored to, never passed on
+    for (llvm::User* user : gep->users()) {
+        if (auto* load = llvm::dyn_cast<llvm::LoadInst>(user)) {
+            if (load->getType() != c.types[slot->getZExtValue() - 1]) return false;
+        } else if (auto* store = llvm::dyn_cast<llvm::StoreInst>(user)) {
+            if (store->getValueOperand() == gep ||
+                store->getValueOperand()->getType() != c.types[slot->getZExtValue() - 1]) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    c.slots.push_back(gep);
+    return true;
+}
+
+std::vector<llvm::AllocaInst*> EscapeAnalysis::scalar_replace(Candidate& c) const {
+    llvm::CallInst* create = c.create;
+    llvm::Function* func = create->getFunction();
+    const std::vector<llvm::Type*>& types = c.types;
+    uint64_t num_fields = types.size();
+
+    llvm::StringRef class_name;
+    if (!llvm::getConstantStringInfo(create->getArgOperand(0), class_name)) {
+        class_name = "object";
+    }
+
+    llvm::IRBuilder<> entry(&func->getEntryBlock(), func->getEntryBlock().begin());
+    std::vector<llvm::AllocaInst*> fields;
+    for (uint64_t i = 0; i < num_fields; i++) {
+        fields.push_back(entry.CreateAlloca(types[i], nullptr, class_name + ".field"));
+    }
+
+    // Construction zeroes the fields, as runtime_class_create does
+    llvm::IRBuilder<> builder(create);
+    for (uint64_t i = 0; i < num_fields; i++) {
+        builder.CreateStore(llvm::Constant::getNullValue(types[i]), fields[i]);
+    }
+
+    for (llvm::CallInst* call : c.accesses) {
+        builder.SetInsertPoint(call);
+        uint64_t index = llvm::cast<llvm::ConstantInt>(call->getArgOperand(1))->getZExtValue();
+        if (call->getCalledFunction()->getName().starts_with("runtime_class_set_field_")) {
+            builder.CreateStore(convert(builder, call->getArgOperand(2), types[index]), fields[index]);
+        } else {
+            llvm::Value* field = builder.CreateLoad(types[index], fields[index]);
+            call->replaceAllUsesWith(convert(builder, field, call->getType()));
+        }
+        call->eraseFromParent();
+    }
+
+    // Inline accesses now go straight to the field's slot
+    for (llvm::GetElementPtrInst* gep : c.slots) {
+        uint64_t index = llvm::cast<llvm::ConstantInt>(gep->getOperand(2))->getZExtValue();
+        gep->replaceAllUsesWith(fields[index - 1]);
+        gep->eraseFromParent();
+    }
+
+    // Nothing is left that needs the instance itself
+    auto erase = [](llvm::Instruction* inst) {
+        if (!inst->getType()->isVoidTy()) {
+            inst->replaceAllUsesWith(llvm::PoisonValue::get(inst->getType()));
+        }
+        inst->eraseFromParent();
+    };
+    for (llvm::Instruction* inst : c.dead) erase(inst);
+    for (auto it = c.aliases.rbegin(); it != c.aliases.rend(); ++it) erase(*it);
+    if (c.variable) erase(c.variable);
+    erase(create);
+
+    return fields;
+}
+
+}
@@ -1,4 +1,5 @@
 #include "../../include/codegen/llvm_codegen.h"
+#include "../../include/codegen/escape_analysis.h"
 #include <iostream>
 
 #include <llvm/IR/Verifier.h>
@@ -11,6 +12,20 @@
 #include <llvm/MC/TargetRegistry.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/IR/DataLayout.h>
+#include <llvm/IR/Intrinsics.h>
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/IR/BuiltinGCs.h>
+#include <llvm/Transforms/Utils/ModuleUtils.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Transforms/Coroutines/CoroCleanup.h>
+#include <llvm/Transforms/Coroutines/CoroEarly.h>
+#include <llvm/Transforms/Coroutines/CoroElide.h>
+#include <llvm/Transforms/Coroutines/CoroSplit.h>
+#include <llvm/Transforms/IPO/AlwaysInliner.h>
+#include <llvm/Transforms/InstCombine/InstCombine.h>
+#include <llvm/Transforms/Scalar/JumpThreading.h>
+#include <llvm/Transforms/Scalar/SROA.h>
+#include <llvm/Transforms/Scalar/SimplifyCFG.h>
 
 namespace aithon::codegen {
 
@@ -25,6 +40,9 @@ LLVMCodeGen::LLVMCodeGen(utils::ErrorReporter& reporter)
     llvm::InitializeNativeTarget();
     llvm::InitializeNativeTargetAsmPrinter();
     llvm::InitializeNativeTargetAsmParser();
+
+    // Pull in the shadow-stack GC strategy used for precise roots
+    llvm::linkAllBuiltinGCs();
 }
 
 LLVMCodeGen::~LLVMCodeGen() = default;
@@ -80,10 +98,58 @@ void LLVMCodeGen::declare_runtime_functions() {
     declare("runtime_print_bool",   void_ty, {i1_ty});
     declare("runtime_print_string", void_ty, {ptr_ty});
 
+    // Ints: raised when a checked + - * overflows, never returns
+    declare("runtime_int_overflow", void_ty, {});
+    llvm::Function* int_overflow = module_->getFunction("runtime_int_overflow");
+    int_overflow->setDoesNotReturn();
+    int_overflow->addFnAttr(llvm::Attribute::Cold);
+
+    // Strings
+    declare("runtime_string_intern", ptr_ty,  {ptr_ty});
+    declare("runtime_string_concat", ptr_ty,  {ptr_ty, ptr_ty});
+    declare("runtime_string_equals", i1_ty,   {ptr_ty, ptr_ty});
+    declare("runtime_string_length", i64_ty,  {ptr_ty});
+    declare("runtime_string_append", ptr_ty,  {ptr_ty, ptr_ty});
+    declare("runtime_string_seal",   void_ty, {ptr_ty});
+
     // Collections
+    declare("runtime_list_append_float",  void_ty, {ptr_ty, dbl_ty});
+    declare("runtime_list_append_bool",   void_ty, {ptr_ty, i1_ty});
+    declare("runtime_list_get_float",     dbl_ty,  {ptr_ty, i64_ty});
+    declare("runtime_list_get_bool",      i1_ty,   {ptr_ty, i64_ty});
+    declare("runtime_list_set_int",       void_ty, {ptr_ty, i64_ty, i64_ty});
+    declare("runtime_list_set_float",     void_ty, {ptr_ty, i64_ty, dbl_ty});
+    declare("runtime_list_set_string",    void_ty, {ptr_ty, i64_ty, ptr_ty});
     declare("runtime_list_print",   void_ty, {ptr_ty});
+
+    // List aggregates (vectorized in the runtime)
+    declare("runtime_list_sum_int",   i64_ty, {ptr_ty});
+    declare("runtime_list_sum_float", dbl_ty, {ptr_ty});
+    declare("runtime_list_min_int",   i64_ty, {ptr_ty});
+    declare("runtime_list_min_float", dbl_ty, {ptr_ty});
+    declare("runtime_list_max_int",   i64_ty, {ptr_ty});
+    declare("runtime_list_max_float", dbl_ty, {ptr_ty});
+    declare("runtime_list_sort",      void_ty, {ptr_ty, i1_ty});
+    declare("runtime_list_sorted",    ptr_ty,  {ptr_ty, i1_ty});
     declare("runtime_dict_print",   void_ty, {ptr_ty});
 
+    // Generator frames CoroElide could not move to the caller's stack
+    declare("malloc", ptr_ty,  {i64_ty});
+    declare("free",   void_ty, {ptr_ty});
+
+    // Classes
+    declare("runtime_class_create",          ptr_ty,  {ptr_ty, i64_ty, ptr_ty});
+    declare("runtime_retain",                ptr_ty,  {ptr_ty});
+    declare("runtime_release",               void_ty, {ptr_ty});
+    declare("runtime_class_set_field_int",   void_ty, {ptr_ty, i64_ty, i64_ty});
+    declare("runtime_class_set_field_float", void_ty, {ptr_ty, i64_ty, dbl_ty});
+    declare("runtime_class_set_field_bool",  void_ty, {ptr_ty, i64_ty, i1_ty});
+    declare("runtime_class_set_field_ptr",   void_ty, {ptr_ty, i64_ty, ptr_ty});
+    declare("runtime_class_get_field_int",   i64_ty,  {ptr_ty, i64_ty});
+    declare("runtime_class_get_field_float", dbl_ty,  {ptr_ty, i64_ty});
+    declare("runtime_class_get_field_bool",  i1_ty,   {ptr_ty, i64_ty});
+    declare("runtime_class_get_field_ptr",   ptr_ty,  {ptr_ty, i64_ty});
+
 
     // void runtime_print_int(i64)
     {
@@ -273,7 +339,260 @@ llvm::AllocaInst* LLVMCodeGen::create_entry_block_alloca(llvm::Function* func,
 
     llvm::IRBuilder<> tmp_builder(&func->getEntryBlock(),
                                    func->getEntryBlock().begin());
-    return tmp_builder.CreateAlloca(type, nullptr, var_name);
+    llvm::AllocaInst* alloca = tmp_builder.CreateAlloca(type, nullptr, var_name);
+
+    // Lists, dicts, strings and class instances are reached through
+    // pointer locals - every one of them is visible to the collector
+    if (type->isPointerTy()) {
+        emit_gc_root(alloca);
+    }
+    return alloca;
+}
+
+// Register a pointer local as a GC root. Functions with roots use LLVM's
+// shadow-stack strategy: on entry they push a frame holding their roots
+// onto llvm_gc_root_chain, which the runtime walks to find and update
+// every object pointer held by compiled code.
+void LLVMCodeGen::emit_gc_root(llvm::AllocaInst* alloca) {
+    llvm::Function* func = alloca->getFunction();
+
+    // A generator's locals move into its frame, which outlives any one
+    // shadow-stack entry, so they cannot be roots: a generator must not
+    // be the only holder of an object across a yield
+    if (func->isPresplitCoroutine()) return;
+    if (!func->hasGC()) {
+        func->setGC("shadow-stack");
+    }
+
+    // Actors run concurrently on the scheduler's workers, so the runtime
+    // keeps one chain per thread. The lowering adopts an existing head
+    // instead of creating a plain global, keeping it thread-local.
+    if (!module_->getGlobalVariable("llvm_gc_root_chain")) {
+        auto* head = new llvm::GlobalVariable(
+            *module_, llvm::PointerType::getUnqual(*context_), false,
+            llvm::GlobalValue::ExternalLinkage, nullptr, "llvm_gc_root_chain");
+        head->setThreadLocal(true);
+    }
+
+    llvm::Function* gcroot = llvm::Intrinsic::getOrInsertDeclaration(
+        module_.get(), llvm::Intrinsic::gcroot);
+    llvm::Value* no_metadata = llvm::ConstantPointerNull::get(
+        llvm::PointerType::getUnqual(*context_));
+
+    // llvm.gcroot must sit in the entry block; the lowering nulls the slot
+    // on entry so the collector never sees an uninitialized root
+    llvm::IRBuilder<> entry_builder(alloca->getParent(), std::next(alloca->getIterator()));
+    entry_builder.CreateCall(gcroot, {alloca, no_metadata});
+}
+
+// Layout of the runtime's RuntimeString: data, length, cached hash,
+// refcount, flags, then the buffer pointer / inline text union
+llvm::StructType* LLVMCodeGen::runtime_string_type() {
+    if (auto* existing = llvm::StructType::getTypeByName(*context_, "RuntimeString")) {
+        return existing;
+    }
+    llvm::Type* i32 = llvm::Type::getInt32Ty(*context_);
+    llvm::Type* i64 = llvm::Type::getInt64Ty(*context_);
+    return llvm::StructType::create(
+        *context_,
+        {llvm::PointerType::getUnqual(*context_), i64, i64, i32, i32,
+         llvm::ArrayType::get(llvm::Type::getInt8Ty(*context_), 24)},
+        "RuntimeString");
+}
+
+// Mirrors RuntimeList in runtime.cpp: { data, length, capacity, kind }
+llvm::StructType* LLVMCodeGen::runtime_list_type() {
+    if (auto* existing = llvm::StructType::getTypeByName(*context_, "RuntimeList")) {
+        return existing;
+    }
+    llvm::Type* i64 = llvm::Type::getInt64Ty(*context_);
+    return llvm::StructType::create(
+        *context_,
+        {llvm::PointerType::getUnqual(*context_), i64, i64, llvm::Type::getInt8Ty(*context_)},
+        "RuntimeList");
+}
+
+// ListKind in runtime.cpp for a list whose elements are all of type
+// element, or 0 if there is no unboxed form compiled code reads inline
+static uint8_t unboxed_list_kind(llvm::Type* element) {
+    constexpr uint8_t INT = 1, FLOAT = 2;
+    if (element->isIntegerTy(64)) return INT;
+    if (element->isDoubleTy()) return FLOAT;
+    return 0;
+}
+
+// Address of list[index] in the list's own storage, and the condition
+// under which it is valid: the list still stores element unboxed and index
+// is in [0, length). Anything else - negative indexes, errors, a list that
+// went generic - takes the runtime call.
+llvm::Value* LLVMCodeGen::list_element_guard(llvm::Value* list, llvm::Value* index,
+                                             llvm::Type* element, llvm::Value*& element_ptr) {
+    llvm::StructType* list_ty = runtime_list_type();
+    llvm::Type* ptr_ty = llvm::PointerType::getUnqual(*context_);
+
+    llvm::Value* kind = builder_->CreateLoad(
+        llvm::Type::getInt8Ty(*context_), builder_->CreateStructGEP(list_ty, list, 3), "list.kind");
+    llvm::Value* length = builder_->CreateLoad(
+        llvm::Type::getInt64Ty(*context_), builder_->CreateStructGEP(list_ty, list, 1), "list.len");
+    llvm::Value* data = builder_->CreateLoad(
+        ptr_ty, builder_->CreateStructGEP(list_ty, list, 0), "list.data");
+
+    element_ptr = builder_->CreateInBoundsGEP(element, data, index, "list.elem");
+    llvm::Value* same_kind = builder_->CreateICmpEQ(
+        kind, llvm::ConstantInt::get(kind->getType(), unboxed_list_kind(element)));
+    llvm::Value* in_range = builder_->CreateICmpULT(index, length);
+    return builder_->CreateAnd(same_kind, in_range, "list.fast");
+}
+
+// list[index] for an int or float list: a load when the guard holds
+llvm::Value* LLVMCodeGen::codegen_list_load(llvm::Value* list, llvm::Value* index,
+                                            llvm::Type* element, llvm::Function* slow_fn) {
+    llvm::Function* func = builder_->GetInsertBlock()->getParent();
+    llvm::BasicBlock* fast_bb  = llvm::BasicBlock::Create(*context_, "list.load", func);
+    llvm::BasicBlock* slow_bb  = llvm::BasicBlock::Create(*context_, "list.load.slow", func);
+    llvm::BasicBlock* merge_bb = llvm::BasicBlock::Create(*context_, "list.load.done", func);
+
+    llvm::Value* element_ptr = nullptr;
+    builder_->CreateCondBr(list_element_guard(list, index, element, element_ptr), fast_bb, slow_bb);
+
+    builder_->SetInsertPoint(fast_bb);
+    llvm::Value* fast = builder_->CreateLoad(element, element_ptr, "elem");
+    builder_->CreateBr(merge_bb);
+
+    builder_->SetInsertPoint(slow_bb);
+    llvm::Value* slow = builder_->CreateCall(slow_fn, {list, index}, "elem.slow");
+    builder_->CreateBr(merge_bb);
+
+    builder_->SetInsertPoint(merge_bb);
+    llvm::PHINode* result = builder_->CreatePHI(element, 2, "elem");
+    result->addIncoming(fast, fast_bb);
+    result->addIncoming(slow, slow_bb);
+    return result;
+}
+
+// list[index] = value for an int or float value: a store when the guard holds
+void LLVMCodeGen::codegen_list_store(llvm::Value* list, llvm::Value* index,
+                                     llvm::Value* value, llvm::Function* slow_fn) {
+    llvm::Function* func = builder_->GetInsertBlock()->getParent();
+    llvm::BasicBlock* fast_bb  = llvm::BasicBlock::Create(*context_, "list.store", func);
+    llvm::BasicBlock* slow_bb  = llvm::BasicBlock::Create(*context_, "list.store.slow", func);
+    llvm::BasicBlock* merge_bb = llvm::BasicBlock::Create(*context_, "list.store.done", func);
+
+    llvm::Value* element_ptr = nullptr;
+    builder_->CreateCondBr(
+        list_element_guard(list, index, value->getType(), element_ptr), fast_bb, slow_bb);
+
+    builder_->SetInsertPoint(fast_bb);
+    builder_->CreateStore(value, element_ptr);
+    builder_->CreateBr(merge_bb);
+
+    builder_->SetInsertPoint(slow_bb);
+    builder_->CreateCall(slow_fn, {list, index, value});
+    builder_->CreateBr(merge_bb);
+
+    builder_->SetInsertPoint(merge_bb);
+}
+
+// Whether the program defines name, rather than only having called it
+bool LLVMCodeGen::is_user_function(const std::string& name) const {
+    auto it = functions_.find(name);
+    return it != functions_.end() && it->second;
+}
+
+// Element type of a list holding both a and b: ints and floats together
+// read as floats, as the runtime promotes them; any other mix is unknown
+LLVMCodeGen::VarType LLVMCodeGen::merge_element_types(VarType a, VarType b) {
+    if (a == b) return a;
+    if ((a == VarType::INT && b == VarType::FLOAT) || (a == VarType::FLOAT && b == VarType::INT)) {
+        return VarType::FLOAT;
+    }
+    return VarType::UNKNOWN;
+}
+
+// Element type of a list expression, when every element has the same one
+// (or they are ints and floats)
+LLVMCodeGen::VarType LLVMCodeGen::infer_list_element_type(parser::ast::Expr* expr) {
+    if (auto* list = dynamic_cast<parser::ast::ListExpr*>(expr)) {
+        if (list->elements.empty()) return VarType::UNKNOWN;
+        VarType element = infer_var_type(list->elements[0].get());
+        for (auto& elem : list->elements) {
+            element = merge_element_types(element, infer_var_type(elem.get()));
+            if (element == VarType::UNKNOWN) return VarType::UNKNOWN;
+        }
+        return element;
+    }
+    if (auto* ident = dynamic_cast<parser::ast::Identifier*>(expr)) {
+        auto it = variables_.find(ident->name);
+        if (it != variables_.end() && it->second.var_type == VarType::LIST) {
+            return it->second.element_type;
+        }
+    }
+    if (auto* call = dynamic_cast<parser::ast::CallExpr*>(expr)) {
+        // sorted() keeps the element type
+        auto* callee = dynamic_cast<parser::ast::Identifier*>(call->callee.get());
+        if (callee && callee->name == "sorted" && call->arguments.size() == 1 &&
+            !is_user_function(callee->name)) {
+            return infer_list_element_type(call->arguments[0].get());
+        }
+    }
+    return VarType::UNKNOWN;
+}
+
+// A string literal is an immortal RuntimeString over constant text, read
+// through a per-module slot. A constructor run at load
+// (emit_literal_interning) replaces each slot with the runtime's canonical
+// copy, so the same literal is one object across modules and comparing
+// two literals is a pointer check.
+llvm::Value* LLVMCodeGen::intern_literal(const std::string& text) {
+    llvm::Type* ptr_ty = llvm::PointerType::getUnqual(*context_);
+
+    llvm::GlobalVariable*& slot = interned_literals_[text];
+    if (!slot) {
+        llvm::Constant* data = llvm::ConstantDataArray::getString(*context_, text);
+        auto* raw = new llvm::GlobalVariable(
+            *module_, data->getType(), true, llvm::GlobalValue::PrivateLinkage,
+            data, ".str");
+        raw->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+
+        // Written once by the runtime: the hash and the interned flag
+        constexpr uint32_t IMMORTAL = 2;
+        llvm::StructType* str_ty = runtime_string_type();
+        llvm::Constant* init = llvm::ConstantStruct::get(str_ty, {
+            raw,
+            llvm::ConstantInt::get(llvm::Type::getInt64Ty(*context_), text.size()),
+            llvm::ConstantInt::get(llvm::Type::getInt64Ty(*context_), 0),
+            llvm::ConstantInt::get(llvm::Type::getInt32Ty(*context_), 1),
+            llvm::ConstantInt::get(llvm::Type::getInt32Ty(*context_), IMMORTAL),
+            llvm::ConstantAggregateZero::get(str_ty->getElementType(5))});
+        auto* object = new llvm::GlobalVariable(
+            *module_, str_ty, false, llvm::GlobalValue::PrivateLinkage,
+            init, ".str.obj");
+        object->setAlignment(llvm::Align(8));
+
+        slot = new llvm::GlobalVariable(
+            *module_, ptr_ty, false, llvm::GlobalValue::InternalLinkage,
+            object, ".str.interned");
+    }
+    return builder_->CreateLoad(ptr_ty, slot, "str");
+}
+
+void LLVMCodeGen::emit_literal_interning() {
+    if (interned_literals_.empty()) return;
+
+    llvm::FunctionType* ft = llvm::FunctionType::get(
+        llvm::Type::getVoidTy(*context_), false);
+    llvm::Function* init = llvm::Function::Create(
+        ft, llvm::Function::InternalLinkage, "aithon.intern_literals", module_.get());
+
+    llvm::IRBuilder<> init_builder(llvm::BasicBlock::Create(*context_, "entry", init));
+    llvm::Function* intern_fn = module_->getFunction("runtime_string_intern");
+    for (auto& [text, slot] : interned_literals_) {
+        llvm::Value* canonical = init_builder.CreateCall(intern_fn, {slot->getInitializer()});
+        init_builder.CreateStore(canonical, slot);
+    }
+    init_builder.CreateRetVoid();
+
+    llvm::appendToGlobalCtors(*module_, init, 65535);
 }
 
 // ============================================================================
@@ -303,6 +622,12 @@ bool LLVMCodeGen::generate(parser::ast::Module* module, const std::string& modul
     // Generate main() wrapper that calls python_main()
     generate_main_wrapper();
 
+    // Class instances that never leave their function go on the stack
+    eliminate_class_allocations();
+
+    // Swap every string literal for its canonical copy before main runs
+    emit_literal_interning();
+
     // std::cerr << ">>> [5] Verifying\n";
     // Verify module
     std::string error_str;
@@ -312,6 +637,12 @@ bool LLVMCodeGen::generate(parser::ast::Module* module, const std::string& modul
         return false;
     }
 
+    // Split generators into their resume functions, and put the frames of
+    // those that never leave a for loop on the caller's stack
+    if (!generators_.empty()) {
+        lower_generators();
+    }
+
     // std::cerr << ">>> [6] Done!\n";
     return true;
 }
@@ -378,13 +709,29 @@ void LLVMCodeGen::codegen_field_assignment(aithon::parser::ast::FieldAssignment*
 
         // Determine if this is a list or dict
         // For now, assume list with integer index
-        llvm::Function* set_fn = module_->getFunction("runtime_list_set_int");
-        if (!set_fn) {
-            std::cerr << "ERROR: runtime_list_set_int not declared\n";
+        llvm::Type* value_ty = value->getType();
+        if (value_ty->isIntegerTy(64)) {
+            codegen_list_store(obj, index, value, module_->getFunction("runtime_list_set_int"));
+        } else if (value_ty->isDoubleTy()) {
+            codegen_list_store(obj, index, value, module_->getFunction("runtime_list_set_float"));
+        } else if (value_ty->isPointerTy()) {
+            builder_->CreateCall(module_->getFunction("runtime_list_set_string"), {obj, index, value});
+        } else {
+            std::cerr << "ERROR: Unsupported list element type in index assignment\n";
             return;
         }
 
-        builder_->CreateCall(set_fn, {obj, index, value});
+        // A store of another type changes what the list variable's reads
+        // and aggregates may assume about its elements
+        if (auto* ident = dynamic_cast<Identifier*>(stmt->object.get())) {
+            auto it = variables_.find(ident->name);
+            if (it != variables_.end() && it->second.var_type == VarType::LIST) {
+                VarType stored = value_ty->isIntegerTy(64) ? VarType::INT
+                               : value_ty->isDoubleTy()    ? VarType::FLOAT
+                                                           : VarType::STRING;
+                it->second.element_type = merge_element_types(it->second.element_type, stored);
+            }
+        }
 }
 
 
@@ -407,6 +754,8 @@ void LLVMCodeGen::codegen_stmt(parser::ast::Stmt* stmt) {
         codegen_for(for_stmt);
     } else if (auto* ret = dynamic_cast<parser::ast::ReturnStmt*>(stmt)) {
         codegen_return(ret);
+    } else if (auto* yield_stmt = dynamic_cast<parser::ast::YieldStmt*>(stmt)) {
+        codegen_yield(yield_stmt);
     } else if (auto* assign = dynamic_cast<parser::ast::Assignment*>(stmt)) {
         codegen_assignment(assign);
     } else if (auto* expr_stmt = dynamic_cast<parser::ast::ExprStmt*>(stmt)) {
@@ -429,11 +778,15 @@ void LLVMCodeGen::codegen_function(parser::ast::FunctionDecl* func) {
         func_name = "python_main";
     }
 
-    // Create function type (all parameters are i64 for simplicity)
+    // Create function type (all parameters are i64 for simplicity); a
+    // generator returns its frame
     std::vector<llvm::Type*> param_types(func->parameters.size(),
                                          llvm::Type::getInt64Ty(*context_));
+    llvm::Type* return_type = func->is_generator
+        ? static_cast<llvm::Type*>(llvm::PointerType::getUnqual(*context_))
+        : llvm::Type::getInt64Ty(*context_);
     llvm::FunctionType* func_type = llvm::FunctionType::get(
-        llvm::Type::getInt64Ty(*context_),
+        return_type,
         param_types,
         false
     );
@@ -457,15 +810,29 @@ void LLVMCodeGen::codegen_function(parser::ast::FunctionDecl* func) {
     llvm::BasicBlock* entry = llvm::BasicBlock::Create(*context_, "entry", llvm_func);
     builder_->SetInsertPoint(entry);
 
+    GeneratorInfo generator;
+    if (func->is_generator) {
+        generators_.insert(func->name);
+        begin_generator(llvm_func, generator);
+    }
+
     // Create allocas for parameters
     size_t idx = 0;
     for (auto& arg : llvm_func->args()) {
         std::string param_name = func->parameters[idx++].name;
-        llvm::AllocaInst* alloca = create_entry_block_alloca(llvm_func, param_name);
+        llvm::AllocaInst* alloca = create_entry_block_alloca(llvm_func, param_name, arg.getType());
         builder_->CreateStore(&arg, alloca);
         named_values_[param_name] = alloca;
-        variables_[param_name].alloca;
 
+        VarInfo& param = variables_[param_name];
+        param.alloca = alloca;
+        param.type = arg.getType();
+        param.var_type = VarType::INT;
+    }
+
+    // A generator's body waits for the first resume
+    if (func->is_generator) {
+        suspend_generator();
     }
 
     // Generate function body
@@ -473,7 +840,14 @@ void LLVMCodeGen::codegen_function(parser::ast::FunctionDecl* func) {
 
     // Add return if missing
     if (!builder_->GetInsertBlock()->getTerminator()) {
-        builder_->CreateRet(llvm::ConstantInt::get(*context_, llvm::APInt(64, 0)));
+        if (func->is_generator) {
+            builder_->CreateBr(generator.final_bb);
+        } else {
+            builder_->CreateRet(llvm::ConstantInt::get(*context_, llvm::APInt(64, 0)));
+        }
+    }
+    if (func->is_generator) {
+        end_generator(generator);
     }
 
     // Verify function
@@ -563,9 +937,146 @@ void LLVMCodeGen::codegen_if(parser::ast::IfStmt* stmt) {
     builder_->SetInsertPoint(merge_bb);
 }
 
+// ============================================================================
+// String Accumulation in Loops
+// ============================================================================
+
+// Whether expr reads the variable; anything unrecognised is assumed to
+static bool mentions(const parser::ast::Expr* expr, const std::string& name) {
+    using namespace parser::ast;
+    if (!expr) return false;
+
+    if (dynamic_cast<const IntegerLiteral*>(expr) || dynamic_cast<const FloatLiteral*>(expr) ||
+        dynamic_cast<const StringLiteral*>(expr) || dynamic_cast<const BoolLiteral*>(expr) ||
+        dynamic_cast<const NoneLiteral*>(expr) || dynamic_cast<const NoneExpr*>(expr)) {
+        return false;
+    }
+    if (auto* ident = dynamic_cast<const Identifier*>(expr)) return ident->name == name;
+    if (auto* binary = dynamic_cast<const BinaryOp*>(expr)) {
+        return mentions(binary->left.get(), name) || mentions(binary->right.get(), name);
+    }
+    if (auto* unary = dynamic_cast<const UnaryOp*>(expr)) return mentions(unary->operand.get(), name);
+    if (auto* call = dynamic_cast<const CallExpr*>(expr)) {
+        if (mentions(call->callee.get(), name)) return true;
+        for (auto& arg : call->arguments) {
+            if (mentions(arg.get(), name)) return true;
+        }
+        return false;
+    }
+    if (auto* index = dynamic_cast<const IndexExpr*>(expr)) {
+        return mentions(index->object.get(), name) || mentions(index->index.get(), name);
+    }
+    if (auto* member = dynamic_cast<const MemberExpr*>(expr)) return mentions(member->object.get(), name);
+    if (auto* list = dynamic_cast<const ListExpr*>(expr)) {
+        for (auto& elem : list->elements) {
+            if (mentions(elem.get(), name)) return true;
+        }
+        return false;
+    }
+    if (auto* dict = dynamic_cast<const DictExpr*>(expr)) {
+        for (auto& [key, value] : dict->pairs) {
+            if (mentions(key.get(), name) || mentions(value.get(), name)) return true;
+        }
+        return false;
+    }
+    if (auto* init = dynamic_cast<const InitializerExpr*>(expr)) {
+        for (auto& arg : init->arguments) {
+            if (mentions(arg.value.get(), name)) return true;
+        }
+        return false;
+    }
+    if (auto* some = dynamic_cast<const SomeExpr*>(expr)) return mentions(some->value.get(), name);
+    return true;
+}
+
+// `name = name + x` with x not reading name
+static bool is_string_append(const parser::ast::Assignment* stmt, const std::string& name) {
+    using namespace parser::ast;
+    if (stmt->name != name) return false;
+    auto* binary = dynamic_cast<const BinaryOp*>(stmt->value.get());
+    if (!binary || binary->op != BinaryOp::Op::ADD) return false;
+    auto* left = dynamic_cast<const Identifier*>(binary->left.get());
+    return left && left->name == name && !mentions(binary->right.get(), name);
+}
+
+// Whether stmt touches name only through is_string_append
+static bool only_appends_to(const parser::ast::Stmt* stmt, const std::string& name) {
+    using namespace parser::ast;
+    if (!stmt) return true;
+
+    if (auto* assign = dynamic_cast<const Assignment*>(stmt)) {
+        if (assign->name == name) return is_string_append(assign, name);
+        return !mentions(assign->value.get(), name);
+    }
+    if (auto* expr_stmt = dynamic_cast<const ExprStmt*>(stmt)) {
+        return !mentions(expr_stmt->expression.get(), name);
+    }
+    if (auto* block = dynamic_cast<const Block*>(stmt)) {
+        for (auto& inner : block->statements) {
+            if (!only_appends_to(inner.get(), name)) return false;
+        }
+        return true;
+    }
+    if (auto* if_stmt = dynamic_cast<const IfStmt*>(stmt)) {
+        return !mentions(if_stmt->condition.get(), name) &&
+               only_appends_to(if_stmt->then_block.get(), name) &&
+               only_appends_to(if_stmt->else_block.get(), name);
+    }
+    if (auto* while_stmt = dynamic_cast<const WhileStmt*>(stmt)) {
+        return !mentions(while_stmt->condition.get(), name) &&
+               only_appends_to(while_stmt->body.get(), name);
+    }
+    if (auto* ret = dynamic_cast<const ReturnStmt*>(stmt)) return !mentions(ret->value.get(), name);
+    if (auto* field = dynamic_cast<const FieldAssignment*>(stmt)) {
+        return !mentions(field->object.get(), name) && !mentions(field->value.get(), name);
+    }
+    if (auto* index = dynamic_cast<const IndexAssignment*>(stmt)) {
+        return !mentions(index->object.get(), name) && !mentions(index->index.get(), name) &&
+               !mentions(index->value.get(), name);
+    }
+    return dynamic_cast<const BreakStmt*>(stmt) || dynamic_cast<const ContinueStmt*>(stmt);
+}
+
+static void collect_assigned_names(const parser::ast::Stmt* stmt, std::set<std::string>& names) {
+    using namespace parser::ast;
+    if (auto* assign = dynamic_cast<const Assignment*>(stmt)) {
+        names.insert(assign->name);
+    } else if (auto* block = dynamic_cast<const Block*>(stmt)) {
+        for (auto& inner : block->statements) collect_assigned_names(inner.get(), names);
+    } else if (auto* if_stmt = dynamic_cast<const IfStmt*>(stmt)) {
+        if (if_stmt->then_block) collect_assigned_names(if_stmt->then_block.get(), names);
+        if (if_stmt->else_block) collect_assigned_names(if_stmt->else_block.get(), names);
+    } else if (auto* while_stmt = dynamic_cast<const WhileStmt*>(stmt)) {
+        collect_assigned_names(while_stmt->body.get(), names);
+    }
+}
+
+// String variables a loop only ever extends with `s = s + x`, and does not
+// otherwise read. No one else can see such a string while the loop runs,
+// so those appends can write into it in place.
+std::set<std::string> LLVMCodeGen::find_string_accumulators(parser::ast::WhileStmt* loop) {
+    std::set<std::string> assigned;
+    collect_assigned_names(loop->body.get(), assigned);
+
+    std::set<std::string> accumulators;
+    for (const std::string& name : assigned) {
+        auto it = variables_.find(name);
+        if (it != variables_.end() && it->second.var_type == VarType::STRING &&
+            !mentions(loop->condition.get(), name) && only_appends_to(loop->body.get(), name)) {
+            accumulators.insert(name);
+        }
+    }
+    return accumulators;
+}
+
 void LLVMCodeGen::codegen_while(parser::ast::WhileStmt* stmt) {
     llvm::Function* func = builder_->GetInsertBlock()->getParent();
 
+    // `s = s + x` in the body appends in place (runtime_string_append)
+    std::set<std::string> accumulators = find_string_accumulators(stmt);
+    std::set<std::string> outer_accumulators = string_accumulators_;
+    string_accumulators_.insert(accumulators.begin(), accumulators.end());
+
     llvm::BasicBlock* cond_bb = llvm::BasicBlock::Create(*context_, "whilecond", func);
     llvm::BasicBlock* body_bb = llvm::BasicBlock::Create(*context_, "whilebody", func);
     llvm::BasicBlock* end_bb = llvm::BasicBlock::Create(*context_, "whileend", func);
@@ -588,28 +1099,306 @@ void LLVMCodeGen::codegen_while(parser::ast::WhileStmt* stmt) {
     if (!builder_->GetInsertBlock()->getTerminator()) {
         builder_->CreateBr(cond_bb);
     }
+    string_accumulators_ = std::move(outer_accumulators);
 
-    // End block
+    // End block - the accumulated strings can be shared from here on
     builder_->SetInsertPoint(end_bb);
+    llvm::Function* seal_fn = module_->getFunction("runtime_string_seal");
+    for (const std::string& name : accumulators) {
+        const VarInfo& var = variables_[name];
+        builder_->CreateCall(seal_fn, {builder_->CreateLoad(var.type, var.alloca, name)});
+    }
 }
 
 void LLVMCodeGen::codegen_for(parser::ast::ForStmt* stmt) {
+    // for x in gen(...): resume the generator until it finishes
+    if (auto* call = dynamic_cast<parser::ast::CallExpr*>(stmt->iterable.get())) {
+        auto* callee = dynamic_cast<parser::ast::Identifier*>(call->callee.get());
+        if (callee && generators_.count(callee->name)) {
+            codegen_for_generator(stmt, call);
+            return;
+        }
+    }
+
     // For now, simplified for loop
     // In full implementation, would handle iterables properly
     std::cerr << "Warning: For loops not fully implemented yet\n";
 }
 
 void LLVMCodeGen::codegen_return(parser::ast::ReturnStmt* stmt) {
+    // Returning from a generator finishes it; the value is dropped
+    if (current_generator_) {
+        if (stmt->value) {
+            codegen_expr(stmt->value.get());
+        }
+        destroy_live_generators();
+        builder_->CreateBr(current_generator_->final_bb);
+        return;
+    }
+
     if (stmt->value) {
         llvm::Value* ret_val = codegen_expr(stmt->value.get());
         if (ret_val) {
+            destroy_live_generators();
             builder_->CreateRet(ret_val);
         }
     } else {
+        destroy_live_generators();
         builder_->CreateRet(llvm::ConstantInt::get(*context_, llvm::APInt(64, 0)));
     }
 }
 
+// ============================================================================
+// Generators
+// ============================================================================
+
+// Up to llvm.coro.begin. The frame is malloc'ed only when CoroElide could
+// not place it in the caller (llvm.coro.alloc says which).
+void LLVMCodeGen::begin_generator(llvm::Function* func, GeneratorInfo& gen) {
+    llvm::Type* ptr_ty = llvm::PointerType::getUnqual(*context_);
+    llvm::Value* null = llvm::ConstantPointerNull::get(llvm::PointerType::getUnqual(*context_));
+    auto intrinsic = [&](llvm::Intrinsic::ID id) {
+        return llvm::Intrinsic::getOrInsertDeclaration(module_.get(), id);
+    };
+
+    func->setPresplitCoroutine();
+    // The ramp only allocates and starts the frame; inlining it into the
+    // for loop is what lets CoroElide see the frame die with the loop
+    func->addFnAttr(llvm::Attribute::AlwaysInline);
+
+    gen.promise = create_entry_block_alloca(func, "promise");
+    gen.id = builder_->CreateCall(intrinsic(llvm::Intrinsic::coro_id),
+                                  {builder_->getInt32(8), gen.promise, null, null}, "id");
+    llvm::Value* need_alloc = builder_->CreateCall(intrinsic(llvm::Intrinsic::coro_alloc),
+                                                   {gen.id}, "need.alloc");
+
+    llvm::BasicBlock* entry_bb = builder_->GetInsertBlock();
+    llvm::BasicBlock* alloc_bb = llvm::BasicBlock::Create(*context_, "gen.alloc", func);
+    llvm::BasicBlock* begin_bb = llvm::BasicBlock::Create(*context_, "gen.begin", func);
+    builder_->CreateCondBr(need_alloc, alloc_bb, begin_bb);
+
+    builder_->SetInsertPoint(alloc_bb);
+    llvm::Function* size_fn = llvm::Intrinsic::getOrInsertDeclaration(
+        module_.get(), llvm::Intrinsic::coro_size, {builder_->getInt64Ty()});
+    llvm::Value* size = builder_->CreateCall(size_fn, {}, "frame.size");
+    llvm::Value* mem = builder_->CreateCall(module_->getFunction("malloc"), {size}, "frame.mem");
+    builder_->CreateBr(begin_bb);
+
+    builder_->SetInsertPoint(begin_bb);
+    llvm::PHINode* frame_mem = builder_->CreatePHI(ptr_ty, 2, "frame.mem");
+    frame_mem->addIncoming(null, entry_bb);
+    frame_mem->addIncoming(mem, alloc_bb);
+    gen.handle = builder_->CreateCall(intrinsic(llvm::Intrinsic::coro_begin),
+                                      {gen.id, frame_mem}, "frame");
+
+    gen.final_bb = llvm::BasicBlock::Create(*context_, "gen.final", func);
+    gen.cleanup_bb = llvm::BasicBlock::Create(*context_, "gen.cleanup", func);
+    gen.suspend_bb = llvm::BasicBlock::Create(*context_, "gen.suspend", func);
+    current_generator_ = &gen;
+}
+
+// Hand control back to the caller; code after this runs on the next resume.
+// Destroyed here instead, the generator first destroys the frames of the
+// for loops it is suspended in - a frame CoroElide could not place on its
+// stack would leak otherwise.
+void LLVMCodeGen::suspend_generator() {
+    llvm::Function* func = builder_->GetInsertBlock()->getParent();
+    llvm::Function* suspend_fn = llvm::Intrinsic::getOrInsertDeclaration(
+        module_.get(), llvm::Intrinsic::coro_suspend);
+
+    llvm::Value* state = builder_->CreateCall(
+        suspend_fn, {llvm::ConstantTokenNone::get(*context_), builder_->getFalse()}, "suspend");
+    llvm::BasicBlock* resume_bb = llvm::BasicBlock::Create(*context_, "gen.resume", func);
+    llvm::BasicBlock* cleanup_bb = current_generator_->cleanup_bb;
+    if (!live_generators_.empty()) {
+        cleanup_bb = llvm::BasicBlock::Create(*context_, "gen.unwind", func);
+    }
+    llvm::SwitchInst* dispatch = builder_->CreateSwitch(state, current_generator_->suspend_bb, 2);
+    dispatch->addCase(builder_->getInt8(0), resume_bb);
+    dispatch->addCase(builder_->getInt8(1), cleanup_bb);
+
+    if (cleanup_bb != current_generator_->cleanup_bb) {
+        builder_->SetInsertPoint(cleanup_bb);
+        destroy_live_generators();
+        builder_->CreateBr(current_generator_->cleanup_bb);
+    }
+
+    builder_->SetInsertPoint(resume_bb);
+}
+
+// Final suspend, frame cleanup and the return to the caller
+void LLVMCodeGen::end_generator(GeneratorInfo& gen) {
+    llvm::Function* func = gen.final_bb->getParent();
+    auto intrinsic = [&](llvm::Intrinsic::ID id) {
+        return llvm::Intrinsic::getOrInsertDeclaration(module_.get(), id);
+    };
+
+    // Done: the caller sees llvm.coro.done and never resumes again
+    builder_->SetInsertPoint(gen.final_bb);
+    llvm::Value* state = builder_->CreateCall(
+        intrinsic(llvm::Intrinsic::coro_suspend),
+        {llvm::ConstantTokenNone::get(*context_), builder_->getTrue()}, "final");
+    llvm::BasicBlock* finished_bb = llvm::BasicBlock::Create(*context_, "gen.finished", func);
+    llvm::SwitchInst* dispatch = builder_->CreateSwitch(state, gen.suspend_bb, 2);
+    dispatch->addCase(builder_->getInt8(0), finished_bb);
+    dispatch->addCase(builder_->getInt8(1), gen.cleanup_bb);
+    builder_->SetInsertPoint(finished_bb);
+    builder_->CreateUnreachable();
+
+    builder_->SetInsertPoint(gen.cleanup_bb);
+    llvm::Value* mem = builder_->CreateCall(intrinsic(llvm::Intrinsic::coro_free),
+                                            {gen.id, gen.handle}, "frame.mem");
+    llvm::BasicBlock* free_bb = llvm::BasicBlock::Create(*context_, "gen.free", func);
+    builder_->CreateCondBr(builder_->CreateIsNotNull(mem), free_bb, gen.suspend_bb);
+    builder_->SetInsertPoint(free_bb);
+    builder_->CreateCall(module_->getFunction("free"), {mem});
+    builder_->CreateBr(gen.suspend_bb);
+
+    builder_->SetInsertPoint(gen.suspend_bb);
+    builder_->CreateCall(intrinsic(llvm::Intrinsic::coro_end),
+                         {gen.handle, builder_->getFalse(), llvm::ConstantTokenNone::get(*context_)});
+    builder_->CreateRet(gen.handle);
+
+    current_generator_ = nullptr;
+}
+
+void LLVMCodeGen::codegen_yield(parser::ast::YieldStmt* stmt) {
+    if (!current_generator_) {
+        std::cerr << "ERROR: 'yield' outside a generator\n";
+        return;
+    }
+
+    llvm::Value* value = stmt->value
+        ? codegen_expr(stmt->value.get())
+        : llvm::ConstantInt::get(*context_, llvm::APInt(64, 0));
+    if (!value) return;
+    if (value->getType()->isIntegerTy(1)) {
+        value = builder_->CreateZExt(value, builder_->getInt64Ty());
+    }
+    if (!value->getType()->isIntegerTy(64)) {
+        std::cerr << "ERROR: Generators can only yield ints and bools\n";
+        return;
+    }
+
+    builder_->CreateStore(value, current_generator_->promise);
+    suspend_generator();
+}
+
+// The frame lives exactly as long as the loop: created before it,
+// destroyed after it (or on a return from inside it), never stored. With
+// the ramp inlined that is what CoroElide needs to put the frame on this
+// function's stack and call the resume function directly.
+void LLVMCodeGen::codegen_for_generator(parser::ast::ForStmt* stmt, parser::ast::CallExpr* call) {
+    llvm::Function* func = builder_->GetInsertBlock()->getParent();
+    llvm::Type* i64_ty = llvm::Type::getInt64Ty(*context_);
+    auto intrinsic = [&](llvm::Intrinsic::ID id) {
+        return llvm::Intrinsic::getOrInsertDeclaration(module_.get(), id);
+    };
+
+    VarInfo& var = variables_[stmt->variable];
+    if (var.alloca && var.type != i64_ty) {
+        std::cerr << "ERROR: Loop variable '" << stmt->variable << "' is not an int\n";
+        return;
+    }
+    if (!var.alloca) {
+        var.alloca = create_entry_block_alloca(func, stmt->variable);
+        var.type = i64_ty;
+        var.var_type = VarType::INT;
+    }
+
+    auto* callee = static_cast<parser::ast::Identifier*>(call->callee.get());
+    std::vector<llvm::Value*> args;
+    for (auto& arg : call->arguments) {
+        llvm::Value* val = codegen_expr(arg.get());
+        if (val) {
+            args.push_back(val);
+        }
+    }
+    llvm::Value* frame = builder_->CreateCall(functions_[callee->name], args, "gen");
+
+    llvm::BasicBlock* cond_bb = llvm::BasicBlock::Create(*context_, "forcond", func);
+    llvm::BasicBlock* body_bb = llvm::BasicBlock::Create(*context_, "forbody", func);
+    llvm::BasicBlock* end_bb = llvm::BasicBlock::Create(*context_, "forend", func);
+    builder_->CreateBr(cond_bb);
+
+    // Resume to the next yield, or to the end
+    builder_->SetInsertPoint(cond_bb);
+    builder_->CreateCall(intrinsic(llvm::Intrinsic::coro_resume), {frame});
+    llvm::Value* done = builder_->CreateCall(intrinsic(llvm::Intrinsic::coro_done), {frame}, "done");
+    builder_->CreateCondBr(done, end_bb, body_bb);
+
+    builder_->SetInsertPoint(body_bb);
+    llvm::Value* promise = builder_->CreateCall(
+        intrinsic(llvm::Intrinsic::coro_promise),
+        {frame, builder_->getInt32(8), builder_->getFalse()}, "promise");
+    builder_->CreateStore(builder_->CreateLoad(i64_ty, promise, stmt->variable), var.alloca);
+
+    live_generators_.push_back(frame);
+    codegen_block(stmt->body.get());
+    live_generators_.pop_back();
+    if (!builder_->GetInsertBlock()->getTerminator()) {
+        builder_->CreateBr(cond_bb);
+    }
+
+    builder_->SetInsertPoint(end_bb);
+    builder_->CreateCall(intrinsic(llvm::Intrinsic::coro_destroy), {frame});
+}
+
+// Before a return, or a generator's destruction at a suspend: the frames
+// of the for loops it leaves, innermost first
+void LLVMCodeGen::destroy_live_generators() {
+    llvm::Function* destroy_fn = llvm::Intrinsic::getOrInsertDeclaration(
+        module_.get(), llvm::Intrinsic::coro_destroy);
+    for (auto it = live_generators_.rbegin(); it != live_generators_.rend(); ++it) {
+        builder_->CreateCall(destroy_fn, {*it});
+    }
+}
+
+// CoroSplit turns each generator into its ramp plus resume/destroy
+// functions the frame points at. Inlining the (always-inline) ramps lets
+// CoroElide move frames that never leave a for loop onto the caller's
+// stack and turn the loop's indirect resumes into direct calls; the
+// second inlining round and SROA then fold those into the loop, leaving
+// the generator's state in registers, and jump threading takes the
+// resume-point switch off the loop's path.
+void LLVMCodeGen::lower_generators() {
+    llvm::LoopAnalysisManager lam;
+    llvm::FunctionAnalysisManager fam;
+    llvm::CGSCCAnalysisManager cgam;
+    llvm::ModuleAnalysisManager mam;
+    llvm::PassBuilder pb;
+    pb.registerModuleAnalyses(mam);
+    pb.registerCGSCCAnalyses(cgam);
+    pb.registerFunctionAnalyses(fam);
+    pb.registerLoopAnalyses(lam);
+    pb.crossRegisterProxies(lam, fam, cgam, mam);
+
+    auto simplify = [](bool elide) {
+        llvm::FunctionPassManager fpm;
+        if (elide) {
+            fpm.addPass(llvm::CoroElidePass());
+        }
+        fpm.addPass(llvm::SROAPass(llvm::SROAOptions::ModifyCFG));
+        fpm.addPass(llvm::InstCombinePass());
+        fpm.addPass(llvm::SimplifyCFGPass());
+        if (!elide) {
+            fpm.addPass(llvm::JumpThreadingPass());
+            fpm.addPass(llvm::SimplifyCFGPass());
+        }
+        return llvm::createModuleToFunctionPassAdaptor(std::move(fpm));
+    };
+
+    llvm::ModulePassManager mpm;
+    mpm.addPass(llvm::CoroEarlyPass());
+    mpm.addPass(llvm::createModuleToPostOrderCGSCCPassAdaptor(llvm::CoroSplitPass()));
+    mpm.addPass(llvm::AlwaysInlinerPass());
+    mpm.addPass(simplify(true));
+    mpm.addPass(llvm::AlwaysInlinerPass());
+    mpm.addPass(simplify(false));
+    mpm.addPass(llvm::CoroCleanupPass());
+    mpm.run(*module_, mam);
+}
+
 
 
 llvm::Value* LLVMCodeGen::codegen_initializer(aithon::parser::ast::InitializerExpr* expr) {
@@ -897,8 +1686,8 @@ llvm::Value* LLVMCodeGen::codegen_float(const parser::ast::FloatLiteral* expr) c
     return llvm::ConstantFP::get(*context_, llvm::APFloat(expr->value));
 }
 
-llvm::Value* LLVMCodeGen::codegen_string(const parser::ast::StringLiteral* expr) const {
-    return builder_->CreateGlobalString(expr->value);
+llvm::Value* LLVMCodeGen::codegen_string(const parser::ast::StringLiteral* expr) {
+    return intern_literal(expr->value);
 }
 
 llvm::Value* LLVMCodeGen::codegen_bool(const parser::ast::BoolLiteral* expr) const {
@@ -931,6 +1720,37 @@ llvm::Value* LLVMCodeGen::codegen_binary_op(const parser::ast::BinaryOp* expr) {
 
     if (!left || !right) return nullptr;
 
+    // Strings are RuntimeString objects: compare and concatenate by value
+    if (infer_var_type(expr->left.get()) == VarType::STRING &&
+        infer_var_type(expr->right.get()) == VarType::STRING) {
+        switch (expr->op) {
+            case parser::ast::BinaryOp::Op::ADD:
+                return builder_->CreateCall(
+                    module_->getFunction("runtime_string_concat"), {left, right}, "concat");
+            case parser::ast::BinaryOp::Op::EQUAL:
+                return builder_->CreateCall(
+                    module_->getFunction("runtime_string_equals"), {left, right}, "streq");
+            case parser::ast::BinaryOp::Op::NOT_EQUAL:
+                return builder_->CreateNot(builder_->CreateCall(
+                    module_->getFunction("runtime_string_equals"), {left, right}), "strne");
+            default:
+                break;
+        }
+    }
+
+    if (left->getType()->isIntegerTy(64) && right->getType()->isIntegerTy(64)) {
+        switch (expr->op) {
+            case parser::ast::BinaryOp::Op::ADD:
+                return codegen_checked_int_op(llvm::Intrinsic::sadd_with_overflow, left, right, "addtmp");
+            case parser::ast::BinaryOp::Op::SUB:
+                return codegen_checked_int_op(llvm::Intrinsic::ssub_with_overflow, left, right, "subtmp");
+            case parser::ast::BinaryOp::Op::MUL:
+                return codegen_checked_int_op(llvm::Intrinsic::smul_with_overflow, left, right, "multmp");
+            default:
+                break;
+        }
+    }
+
     switch (expr->op) {
         case parser::ast::BinaryOp::Op::ADD:
             return builder_->CreateAdd(left, right, "addtmp");
@@ -959,12 +1779,40 @@ llvm::Value* LLVMCodeGen::codegen_binary_op(const parser::ast::BinaryOp* expr) {
     }
 }
 
+// Compiled ints are unboxed i64s with nowhere to put a BigInt, so an
+// overflow stops the program with OverflowError instead of wrapping. The
+// intrinsic gives the result and the overflow flag from one instruction:
+// the common case stays one add and one never-taken branch.
+llvm::Value* LLVMCodeGen::codegen_checked_int_op(llvm::Intrinsic::ID id, llvm::Value* left,
+                                                 llvm::Value* right, const char* name) {
+    llvm::Value* checked = builder_->CreateBinaryIntrinsic(id, left, right);
+    llvm::Value* result = builder_->CreateExtractValue(checked, 0, name);
+    llvm::Value* overflowed = builder_->CreateExtractValue(checked, 1, "overflow");
+
+    llvm::Function* func = builder_->GetInsertBlock()->getParent();
+    llvm::BasicBlock* overflow_bb = llvm::BasicBlock::Create(*context_, "int.overflow", func);
+    llvm::BasicBlock* ok_bb       = llvm::BasicBlock::Create(*context_, "int.ok", func);
+    builder_->CreateCondBr(overflowed, overflow_bb, ok_bb,
+                           llvm::MDBuilder(*context_).createBranchWeights(1, (1U << 20) - 1));
+
+    builder_->SetInsertPoint(overflow_bb);
+    builder_->CreateCall(module_->getFunction("runtime_int_overflow"));
+    builder_->CreateUnreachable();
+
+    builder_->SetInsertPoint(ok_bb);
+    return result;
+}
+
 llvm::Value* LLVMCodeGen::codegen_unary_op(const parser::ast::UnaryOp* expr) {
     llvm::Value* operand = codegen_expr(expr->operand.get());
     if (!operand) return nullptr;
 
     switch (expr->op) {
         case parser::ast::UnaryOp::Op::NEG:
+            if (operand->getType()->isIntegerTy(64)) {
+                return codegen_checked_int_op(llvm::Intrinsic::ssub_with_overflow,
+                                              builder_->getInt64(0), operand, "negtmp");
+            }
             return builder_->CreateNeg(operand, "negtmp");
         case parser::ast::UnaryOp::Op::NOT:
             return builder_->CreateNot(operand, "nottmp");
@@ -974,6 +1822,17 @@ llvm::Value* LLVMCodeGen::codegen_unary_op(const parser::ast::UnaryOp* expr) {
 }
 
 llvm::Value* LLVMCodeGen::codegen_call(parser::ast::CallExpr *expr) {
+    // xs.sort() on a list sorts it in place
+    if (auto* method = dynamic_cast<parser::ast::MemberExpr*>(expr->callee.get())) {
+        if (method->member == "sort" && expr->arguments.empty() &&
+            infer_var_type(method->object.get()) == VarType::LIST) {
+            llvm::Value* list = codegen_expr(method->object.get());
+            if (!list) return nullptr;
+            builder_->CreateCall(module_->getFunction("runtime_list_sort"), {list, builder_->getFalse()});
+            return llvm::ConstantInt::get(*context_, llvm::APInt(64, 0));
+        }
+    }
+
     // Get function name
     auto* callee_ident = dynamic_cast<parser::ast::Identifier*>(expr->callee.get());
     if (!callee_ident) {
@@ -1045,6 +1904,35 @@ llvm::Value* LLVMCodeGen::codegen_call(parser::ast::CallExpr *expr) {
         return llvm::ConstantInt::get(*context_, llvm::APInt(64, 0));
     }
 
+    // sum/min/max of an int or float list: the runtime's vectorized kernels,
+    // unless the program defines its own
+    if ((func_name == "sum" || func_name == "min" || func_name == "max") &&
+        expr->arguments.size() == 1 && !is_user_function(func_name)) {
+        VarType element = infer_list_element_type(expr->arguments[0].get());
+        if (element == VarType::INT || element == VarType::FLOAT) {
+            llvm::Value* list = codegen_expr(expr->arguments[0].get());
+            if (!list) return nullptr;
+            std::string kernel = "runtime_list_" + func_name +
+                                 (element == VarType::INT ? "_int" : "_float");
+            return builder_->CreateCall(module_->getFunction(kernel), {list}, func_name);
+        }
+    }
+
+    // sorted(xs): a sorted copy of a list
+    if (func_name == "sorted" && expr->arguments.size() == 1 && !is_user_function(func_name) &&
+        infer_var_type(expr->arguments[0].get()) == VarType::LIST) {
+        llvm::Value* list = codegen_expr(expr->arguments[0].get());
+        if (!list) return nullptr;
+        return builder_->CreateCall(module_->getFunction("runtime_list_sorted"),
+                                    {list, builder_->getFalse()}, "sorted");
+    }
+
+    // A generator's frame is only ever owned by a for loop (codegen_for)
+    if (generators_.count(func_name)) {
+        std::cerr << "ERROR: Generator " << func_name << "() can only be iterated with for\n";
+        return nullptr;
+    }
+
     // Regular function call
     llvm::Function* callee = functions_[func_name];
     if (!callee) {
@@ -1195,7 +2083,7 @@ llvm::Value* LLVMCodeGen::codegen_dict(parser::ast::DictExpr* expr) {
             continue;
         }
 
-        llvm::Value* key = builder_->CreateGlobalString(key_str->value);
+        llvm::Value* key = intern_literal(key_str->value);
         llvm::Value* val = codegen_expr(val_expr.get());
 
         if (!val) continue;
@@ -1229,7 +2117,19 @@ llvm::Value* LLVMCodeGen::codegen_index(parser::ast::IndexExpr* expr) {
     if (!index) return nullptr;
 
     if (index->getType()->isIntegerTy(64)) {
-        // List access: list[index]
+        // List access: list[index]. Int and float lists are read in place.
+        switch (infer_list_element_type(expr->object.get())) {
+            case VarType::INT:
+                return codegen_list_load(obj, index, llvm::Type::getInt64Ty(*context_),
+                                         module_->getFunction("runtime_list_get_int"));
+            case VarType::FLOAT:
+                return codegen_list_load(obj, index, llvm::Type::getDoubleTy(*context_),
+                                         module_->getFunction("runtime_list_get_float"));
+            case VarType::BOOL:
+                return builder_->CreateCall(module_->getFunction("runtime_list_get_bool"), {obj, index});
+            default:
+                break;
+        }
         llvm::Function* get_fn = module_->getFunction("runtime_list_get_string");
         return builder_->CreateCall(get_fn, {obj, index});
     }
@@ -1257,6 +2157,14 @@ llvm::Value* LLVMCodeGen::codegen_list(parser::ast::ListExpr* expr) {
             llvm::Function* append_fn = module_->getFunction("runtime_list_append_int");
             builder_->CreateCall(append_fn, {list_ptr, val});
         }
+        else if (val->getType()->isDoubleTy()) {
+            llvm::Function* append_fn = module_->getFunction("runtime_list_append_float");
+            builder_->CreateCall(append_fn, {list_ptr, val});
+        }
+        else if (val->getType()->isIntegerTy(1)) {
+            llvm::Function* append_fn = module_->getFunction("runtime_list_append_bool");
+            builder_->CreateCall(append_fn, {list_ptr, val});
+        }
         else if (val->getType()->isPointerTy()) {
             // Assume it's a string
             llvm::Function* append_fn = module_->getFunction("runtime_list_append_string");
@@ -1292,6 +2200,14 @@ LLVMCodeGen::VarType LLVMCodeGen::infer_var_type(parser::ast::Expr* expr) {
     if (dynamic_cast<parser::ast::BoolLiteral*>(expr)) {
         return VarType::BOOL;
     }
+    if (auto* binary = dynamic_cast<parser::ast::BinaryOp*>(expr)) {
+        // String concatenation
+        if (binary->op == parser::ast::BinaryOp::Op::ADD &&
+            infer_var_type(binary->left.get()) == VarType::STRING &&
+            infer_var_type(binary->right.get()) == VarType::STRING) {
+            return VarType::STRING;
+        }
+    }
     if (auto* ident = dynamic_cast<parser::ast::Identifier*>(expr)) {
         // Propagate type from existing variable
         auto it = variables_.find(ident->name);
@@ -1299,6 +2215,25 @@ LLVMCodeGen::VarType LLVMCodeGen::infer_var_type(parser::ast::Expr* expr) {
             return it->second.var_type;
         }
     }
+    if (auto* index = dynamic_cast<parser::ast::IndexExpr*>(expr)) {
+        VarType element = infer_list_element_type(index->object.get());
+        if (element != VarType::UNKNOWN) return element;
+    }
+    if (auto* call = dynamic_cast<parser::ast::CallExpr*>(expr)) {
+        // sum/min/max of a list have its element type
+        auto* callee = dynamic_cast<parser::ast::Identifier*>(call->callee.get());
+        if (callee && call->arguments.size() == 1 && !is_user_function(callee->name) &&
+            (callee->name == "sum" || callee->name == "min" || callee->name == "max")) {
+            VarType element = infer_list_element_type(call->arguments[0].get());
+            if (element == VarType::INT || element == VarType::FLOAT) return element;
+        }
+        // and sorted() of a list is a list
+        if (callee && callee->name == "sorted" && call->arguments.size() == 1 &&
+            !is_user_function(callee->name) &&
+            infer_var_type(call->arguments[0].get()) == VarType::LIST) {
+            return VarType::LIST;
+        }
+    }
     return VarType::UNKNOWN;
 }
 
@@ -1336,6 +2271,20 @@ LLVMCodeGen::VarType LLVMCodeGen::infer_var_type(parser::ast::Expr* expr) {
 void LLVMCodeGen::codegen_assignment(aithon::parser::ast::Assignment* stmt) {
     std::cerr << ">>> codegen_assignment: " << stmt->name << "\n";
 
+    // s = s + x accumulating in a loop: append in place
+    if (string_accumulators_.count(stmt->name) && is_string_append(stmt, stmt->name)) {
+        auto* binary = static_cast<parser::ast::BinaryOp*>(stmt->value.get());
+        llvm::Value* piece = codegen_expr(binary->right.get());
+        if (!piece) return;
+
+        const VarInfo& var = variables_[stmt->name];
+        llvm::Value* current = builder_->CreateLoad(var.type, var.alloca, stmt->name);
+        llvm::Value* appended = builder_->CreateCall(
+            module_->getFunction("runtime_string_append"), {current, piece}, "appended");
+        builder_->CreateStore(appended, var.alloca);
+        return;
+    }
+
     llvm::Value* value = codegen_expr(stmt->value.get());
 
     if (!value) {
@@ -1377,14 +2326,9 @@ void LLVMCodeGen::codegen_assignment(aithon::parser::ast::Assignment* stmt) {
         llvm::Type* storage_type = value->getType();
         std::cerr << ">>> Storage type obtained\n";
 
-        llvm::IRBuilder<> entry_builder(
-            &current_function_->getEntryBlock(),
-            current_function_->getEntryBlock().begin()
-        );
-        std::cerr << ">>> Entry builder created\n";
-
-        llvm::AllocaInst* var_alloca = entry_builder.CreateAlloca(
-            storage_type, nullptr, stmt->name
+        // Rooted there when it holds a pointer
+        llvm::AllocaInst* var_alloca = create_entry_block_alloca(
+            current_function_, stmt->name, storage_type
         );
         std::cerr << ">>> Alloca created\n";
 
@@ -1397,6 +2341,7 @@ void LLVMCodeGen::codegen_assignment(aithon::parser::ast::Assignment* stmt) {
         info.type = storage_type;
         info.var_type = vt;
         info.type_name = type_name;
+        if (vt == VarType::LIST) info.element_type = infer_list_element_type(stmt->value.get());
 
         variables_[stmt->name] = info;
         std::cerr << ">>> Variable '" << stmt->name << "' stored in variables_\n";
@@ -1890,6 +2835,7 @@ void LLVMCodeGen::codegen_class_decl(aithon::parser::ast::ClassDecl* decl) {
 
     ClassInfo info;
     info.name = decl->name;
+    current_class_name_ = decl->name;  // Fields may refer to the class itself
 
     // Process fields
     for (size_t i = 0; i < decl->fields.size(); ++i) {
@@ -1906,6 +2852,13 @@ void LLVMCodeGen::codegen_class_decl(aithon::parser::ast::ClassDecl* decl) {
         info.field_types.push_back(field_type);
     }
 
+    // Instances are a HeapObject header followed by one typed slot per field
+    std::vector<llvm::Type*> llvm_field_types{heap_object_header_type()};
+    for (VarType type : info.field_types) {
+        llvm_field_types.push_back(class_field_type(type));
+    }
+    info.llvm_type = llvm::StructType::create(*context_, llvm_field_types, "class." + decl->name);
+
     class_types_[decl->name] = info;
 
     // ✅ GENERATE MEMBERWISE INITIALIZER
@@ -1997,7 +2950,7 @@ void LLVMCodeGen::generate_class_memberwise_init(
     builder_->SetInsertPoint(entry);
     current_function_ = init_func;
 
-    // Create class instance: runtime_class_create(name, num_fields)
+    // Create class instance: runtime_class_create(name, num_fields, pointer_map)
     llvm::Function* create_fn = module_->getFunction("runtime_class_create");
     if (!create_fn) {
         std::cerr << "ERROR: runtime_class_create not declared\n";
@@ -2009,38 +2962,14 @@ void LLVMCodeGen::generate_class_memberwise_init(
         llvm::Type::getInt64Ty(*context_), info.field_names.size()
     );
 
-    llvm::Value* obj_ptr = builder_->CreateCall(create_fn, {class_name, num_fields});
+    llvm::Value* obj_ptr = builder_->CreateCall(
+        create_fn, {class_name, num_fields, class_pointer_map(info)});
 
     // Set each field from parameters
     size_t idx = 0;
     for (auto& arg : init_func->args()) {
         arg.setName(info.field_names[idx]);
-
-        llvm::Value* field_idx_val = llvm::ConstantInt::get(
-            llvm::Type::getInt64Ty(*context_), idx
-        );
-
-        // Call appropriate setter
-        llvm::Function* set_fn = nullptr;
-        switch (info.field_types[idx]) {
-            case VarType::INT:
-                set_fn = module_->getFunction("runtime_class_set_field_int");
-                break;
-            case VarType::FLOAT:
-                set_fn = module_->getFunction("runtime_class_set_field_float");
-                break;
-            case VarType::BOOL:
-                set_fn = module_->getFunction("runtime_class_set_field_bool");
-                break;
-            default:
-                set_fn = module_->getFunction("runtime_class_set_field_ptr");
-                break;
-        }
-
-        if (set_fn) {
-            builder_->CreateCall(set_fn, {obj_ptr, field_idx_val, &arg});
-        }
-
+        store_class_field(info, obj_ptr, idx, &arg);
         idx++;
     }
 
@@ -2104,7 +3033,7 @@ llvm::Value* LLVMCodeGen::codegen_class_init(
 
     ClassInfo& info = it->second;
 
-    // runtime_class_create(name, num_fields) → ptr with ref_count=1
+    // runtime_class_create(name, num_fields, pointer_map) → ptr with ref_count=1
     llvm::Function* create_fn = module_->getFunction("runtime_class_create");
     if (!create_fn) {
         std::cerr << "ERROR: runtime_class_create not declared\n";
@@ -2116,38 +3045,12 @@ llvm::Value* LLVMCodeGen::codegen_class_init(
         llvm::Type::getInt64Ty(*context_), info.field_names.size()
     );
 
-    llvm::Value* obj_ptr = builder_->CreateCall(create_fn, {name_str, num_fields});
+    llvm::Value* obj_ptr = builder_->CreateCall(
+        create_fn, {name_str, num_fields, class_pointer_map(info)});
 
-    // Set each field using runtime_class_set_field_*
+    // Fields start zeroed; store the given ones inline
     for (size_t i = 0; i < field_values.size() && i < info.field_names.size(); ++i) {
-        llvm::Value* field_idx = llvm::ConstantInt::get(
-            llvm::Type::getInt64Ty(*context_), i
-        );
-
-        llvm::Function* set_fn = nullptr;
-        switch (info.field_types[i]) {
-            case VarType::INT:
-                set_fn = module_->getFunction("runtime_class_set_field_int");
-                break;
-            case VarType::FLOAT:
-                set_fn = module_->getFunction("runtime_class_set_field_float");
-                break;
-            case VarType::BOOL:
-                set_fn = module_->getFunction("runtime_class_set_field_bool");
-                break;
-            case VarType::STRING:
-            case VarType::LIST:
-            case VarType::DICT:
-                set_fn = module_->getFunction("runtime_class_set_field_ptr");
-                break;
-            default:
-                set_fn = module_->getFunction("runtime_class_set_field_int");
-                break;
-        }
-
-        if (set_fn) {
-            builder_->CreateCall(set_fn, {obj_ptr, field_idx, field_values[i]});
-        }
+        store_class_field(info, obj_ptr, i, field_values[i]);
     }
 
     return obj_ptr;  // ref_count=1
@@ -2203,37 +3106,7 @@ llvm::Value* LLVMCodeGen::codegen_class_field_access(
         return nullptr;
     }
 
-    size_t field_idx = field_it->second;
-    llvm::Value* idx = llvm::ConstantInt::get(llvm::Type::getInt64Ty(*context_), field_idx);
-
-    // runtime_class_get_field_*(obj, field_idx)
-    llvm::Function* get_fn = nullptr;
-    switch (info.field_types[field_idx]) {
-        case VarType::INT:
-            get_fn = module_->getFunction("runtime_class_get_field_int");
-            break;
-        case VarType::FLOAT:
-            get_fn = module_->getFunction("runtime_class_get_field_float");
-            break;
-        case VarType::BOOL:
-            get_fn = module_->getFunction("runtime_class_get_field_bool");
-            break;
-        case VarType::STRING:
-        case VarType::LIST:
-        case VarType::DICT:
-            get_fn = module_->getFunction("runtime_class_get_field_ptr");
-            break;
-        default:
-            get_fn = module_->getFunction("runtime_class_get_field_int");
-            break;
-    }
-
-    if (!get_fn) {
-        std::cerr << "ERROR: runtime_class_get_field not found\n";
-        return nullptr;
-    }
-
-    return builder_->CreateCall(get_fn, {obj_ptr, idx}, field_name);
+    return load_class_field(info, obj_ptr, field_it->second, field_name);
 }
 
 // ============================================================================
@@ -2293,37 +3166,150 @@ void LLVMCodeGen::codegen_class_field_assign(
         return;
     }
 
-    size_t field_idx = field_it->second;
-    llvm::Value* idx = llvm::ConstantInt::get(llvm::Type::getInt64Ty(*context_), field_idx);
+    store_class_field(info, obj_ptr, field_it->second, value);
+}
 
-    // runtime_class_set_field_*(obj, field_idx, value)
-    llvm::Function* set_fn = nullptr;
-    switch (info.field_types[field_idx]) {
-        case VarType::INT:
-            set_fn = module_->getFunction("runtime_class_set_field_int");
-            break;
+// ============================================================================
+// Pointer map — one byte per field, 1 where the field holds a class
+// instance. The runtime follows exactly these fields when it frees,
+// shares or collects cycles of an object; other pointer fields (strings,
+// collections) are not refcounted. Null when the class has none.
+// ============================================================================
+
+llvm::Value* LLVMCodeGen::class_pointer_map(const ClassInfo& info) {
+    std::vector<uint8_t> map;
+    bool has_objects = false;
+    for (VarType type : info.field_types) {
+        map.push_back(type == VarType::OBJECT);
+        has_objects |= type == VarType::OBJECT;
+    }
+
+    if (!has_objects) {
+        return llvm::ConstantPointerNull::get(llvm::PointerType::getUnqual(*context_));
+    }
+
+    std::string name = info.name + ".ptrmap";
+    if (llvm::GlobalVariable* existing = module_->getNamedGlobal(name)) {
+        return existing;
+    }
+
+    llvm::Constant* init = llvm::ConstantDataArray::get(*context_, map);
+    auto* global = new llvm::GlobalVariable(
+        *module_, init->getType(), true,
+        llvm::GlobalValue::PrivateLinkage, init, name
+    );
+    global->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+    return global;
+}
+
+// ============================================================================
+// Class layout — instances are %class.<Name> = { %HeapObject.header,
+// fields... }, one 64-bit slot per field so the runtime's by-index helpers
+// see the same object. Fields are read and written with inline GEPs; only
+// object fields go through the runtime, which counts their references.
+// ============================================================================
+
+llvm::StructType* LLVMCodeGen::heap_object_header_type() {
+    if (llvm::StructType* existing = llvm::StructType::getTypeByName(*context_, "HeapObject.header")) {
+        return existing;
+    }
+
+    // Mirrors HeapObject in runtime.cpp up to its fields
+    llvm::Type* i64 = llvm::Type::getInt64Ty(*context_);
+    llvm::Type* i8 = llvm::Type::getInt8Ty(*context_);
+    llvm::Type* ptr = llvm::PointerType::getUnqual(*context_);
+    return llvm::StructType::create(*context_,
+        {i64,   // owner
+         i64,   // biased_count
+         i64,   // shared_count
+         i8,    // in_actor_heap
+         i8,    // gc_flags
+         ptr,   // class_name
+         i64,   // num_fields
+         ptr},  // pointer_map
+        "HeapObject.header");
+}
+
+llvm::Type* LLVMCodeGen::class_field_type(VarType type) {
+    switch (type) {
         case VarType::FLOAT:
-            set_fn = module_->getFunction("runtime_class_set_field_float");
-            break;
-        case VarType::BOOL:
-            set_fn = module_->getFunction("runtime_class_set_field_bool");
-            break;
+            return llvm::Type::getDoubleTy(*context_);
         case VarType::STRING:
         case VarType::LIST:
         case VarType::DICT:
-            set_fn = module_->getFunction("runtime_class_set_field_ptr");
-            break;
+        case VarType::OBJECT:
+            return llvm::PointerType::getUnqual(*context_);
         default:
-            set_fn = module_->getFunction("runtime_class_set_field_int");
-            break;
+            return llvm::Type::getInt64Ty(*context_);  // int, and bool as a whole word
     }
+}
+
+llvm::Value* LLVMCodeGen::load_class_field(const ClassInfo& info, llvm::Value* obj_ptr,
+                                           size_t field_idx, const std::string& name) {
+    unsigned slot_idx = static_cast<unsigned>(field_idx + 1);
+    llvm::Type* slot_type = info.llvm_type->getElementType(slot_idx);
+    llvm::Value* slot = builder_->CreateStructGEP(info.llvm_type, obj_ptr, slot_idx, name + "_ptr");
+    llvm::Value* value = builder_->CreateLoad(slot_type, slot, name);
+
+    if (info.field_types[field_idx] == VarType::BOOL) {
+        return builder_->CreateICmpNE(value, llvm::ConstantInt::get(slot_type, 0), name);
+    }
+    return value;
+}
+
+void LLVMCodeGen::store_class_field(const ClassInfo& info, llvm::Value* obj_ptr,
+                                    size_t field_idx, llvm::Value* value) {
+    llvm::Type* i64 = llvm::Type::getInt64Ty(*context_);
 
-    if (!set_fn) {
-        std::cerr << "ERROR: runtime_class_set_field not found\n";
+    // Object fields own a reference; let the runtime retain and release
+    if (info.field_types[field_idx] == VarType::OBJECT) {
+        builder_->CreateCall(module_->getFunction("runtime_class_set_field_ptr"),
+                             {obj_ptr, llvm::ConstantInt::get(i64, field_idx), value});
         return;
     }
 
-    builder_->CreateCall(set_fn, {obj_ptr, idx, value});
+    unsigned slot_idx = static_cast<unsigned>(field_idx + 1);
+    llvm::Type* slot_type = info.llvm_type->getElementType(slot_idx);
+    llvm::Type* value_type = value->getType();
+    if (value_type != slot_type) {
+        if (value_type->isIntegerTy(1)) {
+            value = builder_->CreateZExt(value, slot_type);
+        } else if (value_type->isIntegerTy() && slot_type->isIntegerTy()) {
+            value = builder_->CreateSExtOrTrunc(value, slot_type);
+        } else if (value_type->isIntegerTy() && slot_type->isDoubleTy()) {
+            value = builder_->CreateSIToFP(value, slot_type);
+        } else if (value_type->isPointerTy() && slot_type->isIntegerTy()) {
+            value = builder_->CreatePtrToInt(value, slot_type);
+        } else {
+            std::cerr << "ERROR: Cannot store into field " << info.name << "."
+                      << info.field_names[field_idx] << "\n";
+            return;
+        }
+    }
+
+    llvm::Value* slot = builder_->CreateStructGEP(info.llvm_type, obj_ptr, slot_idx,
+                                                  info.field_names[field_idx] + "_ptr");
+    builder_->CreateStore(value, slot);
+}
+
+// ============================================================================
+// Escape analysis — hand the class layouts to the pass and report what it
+// moved to the stack
+// ============================================================================
+
+void LLVMCodeGen::eliminate_class_allocations() {
+    ClassLayouts layouts;
+    for (const auto& [name, info] : class_types_) {
+        layouts[name] = info.llvm_type;
+    }
+
+    EscapeAnalysis::Stats stats = EscapeAnalysis(layouts).run(*module_);
+
+    if (report_escapes_) {
+        std::cout << "Escape analysis (" << module_->getName().str() << "): "
+                  << stats.eliminated << " of " << stats.allocations
+                  << " class allocations moved to the stack\n";
+    }
 }
 
 // ============================================================================
@@ -2338,6 +3324,11 @@ LLVMCodeGen::VarType LLVMCodeGen::parse_type_annotation(const std::string& type_
     if (type_str == "list")   return VarType::LIST;
     if (type_str == "dict")   return VarType::DICT;
 
+    // Another class, or the one being declared
+    if (class_types_.count(type_str) || type_str == current_class_name_) {
+        return VarType::OBJECT;
+    }
+
     // Handle Option[T] — for now, just extract T
     if (type_str.find("Option[") == 0) {
         size_t start = type_str.find('[') + 1;
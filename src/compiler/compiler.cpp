@@ -24,7 +24,8 @@ Compiler::Compiler() = default;
 Compiler::~Compiler() = default;
 
 bool Compiler::compile_file(const std::string& input_file,
-                            const std::string& output_file) {
+                            const std::string& output_file,
+                            bool report_escapes) {
     try {
         // ========================================
         // STEP 1: Validate Project Structure
@@ -114,6 +115,7 @@ bool Compiler::compile_file(const std::string& input_file,
     // ========================================================================
     std::cout << "=== [4/5] LLVM IR Generation ===\n";
     codegen::LLVMCodeGen codegen(error_reporter);
+    codegen.set_report_escapes(report_escapes);
     bool success = codegen.generate(ast.get(), "aithon_module");
     if (!success) {
         std::cerr << "❌ Code generation failed\n";
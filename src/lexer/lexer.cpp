@@ -17,6 +17,7 @@ const std::unordered_map<std::string, TokenType> Lexer::keywords_ = {
     {"return", TokenType::RETURN},
     {"break", TokenType::BREAK},
     {"continue", TokenType::CONTINUE},
+    {"yield", TokenType::YIELD},
     {"and", TokenType::AND},
     {"or", TokenType::OR},
     {"not", TokenType::NOT},
@@ -20,6 +20,7 @@ const char* token_type_to_string(const TokenType type) {
         case TokenType::RETURN:         return "'return'";
         case TokenType::BREAK:          return "'break'";
         case TokenType::CONTINUE:       return "'continue'";
+        case TokenType::YIELD:          return "'yield'";
         case TokenType::AND:            return "'and'";
         case TokenType::OR:             return "'or'";
         case TokenType::NOT:            return "'not'";
@@ -20,6 +20,7 @@ void print_usage(const char* prog_name) {
     std::cout << "  -o <output>    Specify output file (default: a.out)\n";
     std::cout << "  --emit-llvm    Emit LLVM IR instead of executable\n";
     std::cout << "  --emit-obj     Emit object file only\n";
+    std::cout << "  --report-escapes  Report class allocations moved to the stack\n";
     std::cout << "  -h, --help     Show this help message\n";
     std::cout << "\nExamples:\n";
     std::cout << "  " << prog_name << " program.py\n";
@@ -37,6 +38,7 @@ int main(const int argc, char** argv) {
     std::string output_file = "a.out";
     bool emit_llvm = false;
     bool emit_obj = false;
+    bool report_escapes = false;
     
     // Parse arguments
     for (int i = 1; i < argc; i++) {
@@ -62,6 +64,8 @@ int main(const int argc, char** argv) {
             if (output_file == "a.out") {
                 output_file = "output.o";
             }
+        } else if (arg == "--report-escapes") {
+            report_escapes = true;
         } else if (arg[0] != '-') {
             input_file = arg;
         } else {
@@ -93,7 +97,7 @@ int main(const int argc, char** argv) {
     // }
 
     std::cout << "Compiling " << input_file << " to executable...\n";
-    success = aithon::compiler::Compiler::compile_file(input_file, output_file);
+    success = aithon::compiler::Compiler::compile_file(input_file, output_file, report_escapes);
     
     if (success) {
         std::cout << "\nCompilation successful!\n";
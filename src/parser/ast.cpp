@@ -64,6 +64,8 @@ ForStmt::ForStmt(std::string var, std::unique_ptr<Expr> iter, std::unique_ptr<Bl
 
 ReturnStmt::ReturnStmt(std::unique_ptr<Expr> v) : value(std::move(v)) {}
 
+YieldStmt::YieldStmt(std::unique_ptr<Expr> v) : value(std::move(v)) {}
+
 FunctionDecl::FunctionDecl(std::string n, std::vector<Parameter> params, 
                            std::unique_ptr<Block> b, bool async)
     : name(std::move(n)), parameters(std::move(params)), 
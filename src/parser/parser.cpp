@@ -70,6 +70,7 @@ std::unique_ptr<ast::Stmt> Parser::parse_statement() {
     if (match(lexer::TokenType::WHILE)) return parse_while_stmt();
     if (match(lexer::TokenType::FOR)) return parse_for_stmt();
     if (match(lexer::TokenType::RETURN)) return parse_return_stmt();
+    if (match(lexer::TokenType::YIELD)) return parse_yield_stmt();
     if (match(lexer::TokenType::BREAK)) return std::make_unique<ast::BreakStmt>();
     if (match(lexer::TokenType::CONTINUE)) return std::make_unique<ast::ContinueStmt>();
     
@@ -95,10 +96,15 @@ std::unique_ptr<ast::FunctionDecl> Parser::parse_function_decl() {
     consume(lexer::TokenType::RPAREN, "Expected ')' after parameters");
     skip_newlines();
     
+    bool outer_yields = function_yields_;
+    function_yields_ = false;
     auto body = parse_block();
     
-    return std::make_unique<ast::FunctionDecl>(name, std::move(params), 
-                                               std::move(body), false);
+    auto decl = std::make_unique<ast::FunctionDecl>(name, std::move(params), 
+                                                    std::move(body), false);
+    decl->is_generator = function_yields_;
+    function_yields_ = outer_yields;
+    return decl;
 }
 
 std::unique_ptr<ast::ClassDecl> Parser::parse_class_decl() {
@@ -255,6 +261,17 @@ std::unique_ptr<ast::ReturnStmt> Parser::parse_return_stmt() {
     return std::make_unique<ast::ReturnStmt>(std::move(value));
 }
 
+std::unique_ptr<ast::YieldStmt> Parser::parse_yield_stmt() {
+    function_yields_ = true;
+    std::unique_ptr<ast::Expr> value = nullptr;
+    
+    if (!check(lexer::TokenType::NEWLINE) && !check(lexer::TokenType::RBRACE) && !is_at_end()) {
+        value = parse_expression();
+    }
+    
+    return std::make_unique<ast::YieldStmt>(std::move(value));
+}
+
     std::unique_ptr<ast::Stmt> Parser::parse_assignment_or_expr() {
     // Parse the left-hand side (could be identifier or member access)
     auto expr = parse_expression();
@@ -1,25 +1,79 @@
 #include "../../include/runtime/actor_gc.h"
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <sys/mman.h>
 
 namespace aithon::runtime {
 
 thread_local ActorGC* current_actor_gc = nullptr;
 
+// Head of the compiled code's shadow stack, one per thread; LLVM emits a
+// weak definition in every module that uses the strategy, this one wins
+// at link time
+thread_local ShadowStackEntry* llvm_gc_root_chain = nullptr;
+
+// Owner of the current actor's collector, for creating it on first use
+static thread_local std::unique_ptr<ActorGC>* current_actor_gc_slot = nullptr;
+
+// Installed by the runtime when it is linked in
+static ActorGC::CycleCollector cycle_collector = nullptr;
+
 ActorGC::ActorGC()
     : young_gen_(std::make_unique<Generation>(YOUNG_GEN_SIZE)),
-      old_gen_(std::make_unique<Generation>(OLD_GEN_SIZE)) {
+      survivor_space_(std::make_unique<Generation>(YOUNG_GEN_SIZE)),
+      old_gen_(std::make_unique<Generation>(OLD_GEN_SIZE)),
+      cards_(OLD_GEN_SIZE >> CARD_SHIFT, CARD_CLEAN),
+      card_first_object_(OLD_GEN_SIZE >> CARD_SHIFT, NO_OBJECT),
+      created_(std::chrono::steady_clock::now()),
+      holds_(1),
+      remote_frees_(nullptr) {
     
     // Initialize statistics
     stats_ = {};
+    stats_.throughput = 1.0;
+    free_lists_.fill(nullptr);
+    free_classes_ = 0;
 }
 
 ActorGC::~ActorGC() {
-    // Cleanup handled by unique_ptr
+    // Generations are cleaned up by unique_ptr; large objects are mapped
+    for (auto& [data, mapping_size] : large_objects_) {
+        munmap(static_cast<uint8_t*>(data) - sizeof(GCObjectHeader), mapping_size);
+    }
+}
+
+void ActorGC::unhold() {
+    if (holds_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
+
+void ActorGC::retire(std::unique_ptr<ActorGC> gc) {
+    if (!gc) {
+        return;
+    }
+    
+    // Buffered candidates would keep shared objects from ever being freed
+    if (gc->cycle_candidates() > 0) {
+        ActorGCScope scope(gc);
+        gc->collect_cycles();
+    }
+    gc.release()->unhold();
 }
 
 void* ActorGC::allocate(size_t size, uint8_t type_id, bool has_refs) {
+    // Large objects bypass the nursery - copying them would dominate pauses
+    if (size >= LARGE_OBJECT_THRESHOLD) {
+        void* ptr = allocate_large(size, type_id, has_refs);
+        if (ptr) {
+            stats_.objects_allocated++;
+            stats_.bytes_allocated += size;
+        }
+        return ptr;
+    }
+    
     // Try young generation first (fast path)
     void* ptr = allocate_in_generation(*young_gen_, size, type_id, has_refs);
     
@@ -45,18 +99,107 @@ void* ActorGC::allocate(size_t size, uint8_t type_id, bool has_refs) {
 }
 
 void* ActorGC::allocate_old(size_t size, uint8_t type_id, bool has_refs) {
-    void* ptr = allocate_in_generation(*old_gen_, size, type_id, has_refs);
+    if (size >= LARGE_OBJECT_THRESHOLD) {
+        return allocate_large(size, type_id, has_refs);
+    }
+    
+    void* ptr = allocate_in_old(size, type_id, has_refs);
     
     if (!ptr) {
         // Old gen full - do major collection
         collect_full();
         
-        ptr = allocate_in_generation(*old_gen_, size, type_id, has_refs);
+        ptr = allocate_in_old(size, type_id, has_refs);
     }
     
     return ptr;
 }
 
+void* ActorGC::allocate_pinned(size_t size) {
+    void* ptr = allocate_old(size);
+    if (ptr) {
+        GCObjectHeader* header = header_of(ptr);
+        header->pinned = true;
+        header->forward = this;
+        stats_.pinned_bytes += header->size;
+    }
+    return ptr;
+}
+
+void ActorGC::free_pinned(void* ptr) {
+    GCObjectHeader* header = header_of(ptr);
+    stats_.pinned_bytes -= header->size;
+    stats_.objects_freed++;
+    stats_.bytes_freed += header->size;
+    
+    if (header->generation == GCObjectHeader::LARGE) {
+        auto it = large_objects_.find(ptr);
+        stats_.large_bytes -= it->second;
+        munmap(header, it->second);
+        large_objects_.erase(it);
+        return;
+    }
+    
+    // Straight back onto the free lists; the next sweep merges it with
+    // any dead neighbours
+    size_t total = sizeof(GCObjectHeader) + header->size;
+    old_gen_->used -= total;
+    make_free_block(reinterpret_cast<uint8_t*>(header), total);
+}
+
+ActorGC* ActorGC::owner_of(void* ptr) {
+    auto* header = reinterpret_cast<GCObjectHeader*>(
+        static_cast<uint8_t*>(ptr) - sizeof(GCObjectHeader));
+    if (header->generation == GCObjectHeader::MALLOC) {
+        return nullptr;
+    }
+    return static_cast<ActorGC*>(header->forward);
+}
+
+void ActorGC::free_remote(void* ptr) {
+    // Lock-free push; only the owner ever takes from the list, and it takes
+    // the whole list at once
+    auto* header = reinterpret_cast<GCObjectHeader*>(
+        static_cast<uint8_t*>(ptr) - sizeof(GCObjectHeader));
+    GCObjectHeader* head = remote_frees_.load(std::memory_order_relaxed);
+    do {
+        header->forward = head;
+    } while (!remote_frees_.compare_exchange_weak(head, header, std::memory_order_release,
+                                                  std::memory_order_relaxed));
+}
+
+void ActorGC::drain_remote_frees() {
+    if (!remote_frees_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    
+    GCObjectHeader* header = remote_frees_.exchange(nullptr, std::memory_order_acquire);
+    while (header) {
+        auto* next = static_cast<GCObjectHeader*>(header->forward);
+        free_pinned(header->get_data());
+        header = next;
+    }
+}
+
+void ActorGC::init_header(GCObjectHeader* header, size_t size, uint16_t generation,
+                          uint8_t type_id, bool has_refs) {
+    header->size = static_cast<uint32_t>(size);
+    header->generation = generation;
+    header->marked = false;
+    header->pinned = false;
+    header->has_refs = has_refs;
+    header->forwarded = false;
+    header->age = 0;
+    header->type_id = type_id;
+    header->forward = nullptr;
+    
+    // Reference slots are scanned precisely, so they must never hold stale
+    // data - including the alignment padding
+    if (has_refs) {
+        std::memset(header->get_data(), 0, size);
+    }
+}
+
 void* ActorGC::allocate_in_generation(Generation& gen, size_t size, 
                                       uint8_t type_id, bool has_refs) {
     // Align size
@@ -70,21 +213,119 @@ void* ActorGC::allocate_in_generation(Generation& gen, size_t size,
     
     // Allocate
     GCObjectHeader* header = reinterpret_cast<GCObjectHeader*>(gen.alloc_ptr);
-    header->size = aligned_size;
-    header->generation = (&gen == young_gen_.get()) ? 0 : 1;
-    header->marked = false;
-    header->pinned = false;
-    header->has_refs = has_refs;
-    header->type_id = type_id;
+    bool old = &gen == old_gen_.get();
+    init_header(header, aligned_size, old ? GCObjectHeader::OLD : GCObjectHeader::YOUNG,
+                type_id, has_refs);
     
     gen.alloc_ptr += total_size;
     gen.used += total_size;
     
-    // Track allocation age for young objects
-    if (header->generation == 0) {
-        allocation_age_[header] = 0;
+    if (old) {
+        record_old_object(header);
+    }
+    
+    return header->get_data();
+}
+
+void* ActorGC::allocate_in_old(size_t size, uint8_t type_id, bool has_refs) {
+    // Reuse swept holes before extending the bump region
+    size_t aligned_size = (size + 15) & ~15;
+    void* ptr = allocate_from_free_list(aligned_size, type_id, has_refs);
+    if (!ptr) {
+        ptr = allocate_in_generation(*old_gen_, aligned_size, type_id, has_refs);
+    }
+    return ptr;
+}
+
+size_t ActorGC::block_class(size_t size) {
+    if (size <= 256) {
+        return size / 16 - 1;
+    }
+    size_t log2 = 63 - __builtin_clzll(size);  // floor
+    return std::min(NUM_SMALL_CLASSES + log2 - 8, NUM_SIZE_CLASSES - 1);
+}
+
+size_t ActorGC::request_class(size_t size) {
+    if (size <= 256) {
+        return size / 16 - 1;
+    }
+    size_t log2 = 64 - __builtin_clzll(size - 1);  // ceil
+    return std::min(NUM_SMALL_CLASSES + log2 - 8, NUM_SIZE_CLASSES - 1);
+}
+
+void* ActorGC::allocate_from_free_list(size_t aligned_size, uint8_t type_id, bool has_refs) {
+    if (aligned_size == 0) {
+        return nullptr;  // Not worth a hole
+    }
+    
+    // Every block filed at or above the request class is big enough
+    uint32_t candidates = free_classes_ & (~0u << request_class(aligned_size));
+    if (!candidates) {
+        return nullptr;
     }
     
+    size_t cls = __builtin_ctz(candidates);
+    GCObjectHeader* block = free_lists_[cls];
+    free_lists_[cls] = static_cast<GCObjectHeader*>(block->forward);
+    if (!free_lists_[cls]) {
+        free_classes_ &= ~(1u << cls);
+    }
+    stats_.old_free_bytes -= sizeof(GCObjectHeader) + block->size;
+    
+    // Split off the tail when it can hold another object
+    size_t remainder = block->size - aligned_size;
+    size_t size = block->size;
+    if (remainder >= sizeof(GCObjectHeader) + 16) {
+        make_free_block(reinterpret_cast<uint8_t*>(block) + sizeof(GCObjectHeader) + aligned_size,
+                        remainder);
+        size = aligned_size;
+    }
+    
+    init_header(block, size, GCObjectHeader::OLD, type_id, has_refs);
+    old_gen_->used += sizeof(GCObjectHeader) + size;
+    stats_.free_list_allocations++;
+    return block->get_data();
+}
+
+void ActorGC::make_free_block(uint8_t* start, size_t total_size) {
+    auto* block = reinterpret_cast<GCObjectHeader*>(start);
+    init_header(block, total_size - sizeof(GCObjectHeader), GCObjectHeader::FREE, 0, false);
+    record_old_object(block);
+    
+    stats_.old_free_bytes += total_size;
+    
+    // Header-only holes stay walkable but are not worth listing
+    if (block->size >= 16) {
+        size_t cls = block_class(block->size);
+        block->forward = free_lists_[cls];
+        free_lists_[cls] = block;
+        free_classes_ |= 1u << cls;
+    }
+}
+
+void* ActorGC::allocate_large(size_t size, uint8_t type_id, bool has_refs) {
+    size_t aligned_size = (size + 15) & ~15;
+    size_t mapping_size = (sizeof(GCObjectHeader) + aligned_size + 4095) & ~size_t(4095);
+    
+    if (stats_.large_bytes + mapping_size > LARGE_SPACE_SIZE) {
+        collect_full();
+    }
+    
+    void* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+    
+    // Fresh mappings are zeroed, so no need to clear the reference slots
+    auto* header = static_cast<GCObjectHeader*>(mapping);
+    init_header(header, aligned_size, GCObjectHeader::LARGE, type_id, false);
+    header->has_refs = has_refs;
+    
+    large_objects_[header->get_data()] = mapping_size;
+    stats_.large_objects_allocated++;
+    stats_.large_bytes += mapping_size;
+    
     return header->get_data();
 }
 
@@ -99,31 +340,53 @@ void ActorGC::remove_root(void** root) {
 void ActorGC::collect_young() {
     auto start = std::chrono::high_resolution_clock::now();
     
-    // Minor GC - only collect young generation
-    // This is fast and happens frequently
+    // Minor GC - Cheney copy of the nursery. Survivors are copied to the
+    // other semispace, or promoted once they reach PROMOTION_AGE. Only
+    // live objects are touched, so the cost tracks the survivors.
+    size_t nursery_used = young_gen_->used;
+    size_t old_used_before = old_gen_->used;
+    uint8_t* young_scan = survivor_space_->start;
     
-    // 1. Mark phase - mark from roots
-    mark_from_roots();
+    // 1. Evacuate objects referenced from roots
+    for (void** root : roots_) {
+        *root = evacuate(*root);
+    }
+    if (root_scanner_) {
+        root_scanner_([this](void** slot) { *slot = evacuate(*slot); });
+    }
     
-    // 2. Check remembered set (old→young references)
-    for (auto* old_obj : remembered_set_) {
-        scan_object_references(old_obj, [this](void** ref) {
-            void* obj = *ref;
-            if (obj && young_gen_->contains(obj)) {
-                auto* header = reinterpret_cast<GCObjectHeader*>(
-                    static_cast<uint8_t*>(obj) - sizeof(GCObjectHeader)
-                );
-                mark_object(header);
-            }
-        });
+    // 2. Evacuate objects referenced from the old generation and from
+    //    large objects (which have no cards and are always scanned)
+    scan_dirty_cards(old_gen_->alloc_ptr);
+    for (auto& [data, mapping_size] : large_objects_) {
+        scan_copied(header_of(data));
     }
     
-    // 3. Evacuate survivors (copy to old gen if aged enough)
-    evacuate_survivors();
+    // 3. Scan the copies until no new objects are reached. Promotions can
+    //    land in any free block, so they are tracked on a worklist.
+    while (young_scan < survivor_space_->alloc_ptr || !promoted_.empty()) {
+        while (young_scan < survivor_space_->alloc_ptr) {
+            auto* header = reinterpret_cast<GCObjectHeader*>(young_scan);
+            scan_copied(header);
+            young_scan += sizeof(GCObjectHeader) + header->size;
+        }
+        while (!promoted_.empty()) {
+            GCObjectHeader* header = promoted_.back();
+            promoted_.pop_back();
+            scan_copied(header);
+        }
+    }
     
-    // 4. Reset young generation
+    // 4. Flip - the evacuated semispace is empty and becomes the next
+    //    survivor space
+    size_t copied = survivor_space_->used;
+    size_t promoted = old_gen_->used - old_used_before;
     young_gen_->alloc_ptr = young_gen_->start;
     young_gen_->used = 0;
+    std::swap(young_gen_, survivor_space_);
+    
+    stats_.bytes_copied += copied;
+    stats_.bytes_freed += nursery_used - copied - promoted;
     
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
@@ -132,23 +395,161 @@ void ActorGC::collect_young() {
     stats_.young_collections++;
 }
 
+void* ActorGC::evacuate(void* obj) {
+    if (!young_gen_->contains(obj)) {
+        return obj;  // Null, old or foreign
+    }
+    
+    auto* header = reinterpret_cast<GCObjectHeader*>(
+        static_cast<uint8_t*>(obj) - sizeof(GCObjectHeader)
+    );
+    if (header->forwarded) {
+        return header->forward;
+    }
+    
+    unsigned age = header->age + 1u;
+    void* new_data = nullptr;
+    
+    if (age >= PROMOTION_AGE) {
+        new_data = allocate_in_old(header->size, header->type_id, header->has_refs);
+        if (new_data) {
+            promoted_.push_back(reinterpret_cast<GCObjectHeader*>(
+                static_cast<uint8_t*>(new_data) - sizeof(GCObjectHeader)));
+            stats_.promotions++;
+        }
+    }
+    
+    if (!new_data) {
+        // Too young, or the old generation is full - stay in the nursery.
+        // The survivor space is as large as the nursery, so this fits.
+        new_data = allocate_in_generation(*survivor_space_, header->size, 
+                                          header->type_id, header->has_refs);
+    }
+    
+    std::memcpy(new_data, obj, header->size);
+    
+    auto* new_header = reinterpret_cast<GCObjectHeader*>(
+        static_cast<uint8_t*>(new_data) - sizeof(GCObjectHeader)
+    );
+    new_header->age = std::min(age, 15u);
+    
+    header->forwarded = true;
+    header->forward = new_data;
+    return new_data;
+}
+
+void ActorGC::scan_copied(GCObjectHeader* obj) {
+    if (!obj->has_refs) {
+        return;
+    }
+    
+    // Promoted objects may still point at survivors in the nursery; the
+    // card keeps that edge visible to the next minor collection
+    bool in_old = obj->generation == GCObjectHeader::OLD;
+    void** refs = static_cast<void**>(obj->get_data());
+    size_t num_refs = obj->size / sizeof(void*);
+    
+    for (size_t i = 0; i < num_refs; i++) {
+        refs[i] = evacuate(refs[i]);
+        if (in_old && is_young(refs[i])) {
+            cards_[card_index(&refs[i])] = CARD_DIRTY;
+        }
+    }
+}
+
+void ActorGC::scan_dirty_cards(uint8_t* old_limit) {
+    size_t num_cards = (old_limit - old_gen_->start + CARD_SIZE - 1) >> CARD_SHIFT;
+    
+    for (size_t card = 0; card < num_cards; card++) {
+        if (cards_[card] != CARD_DIRTY) {
+            continue;
+        }
+        cards_[card] = CARD_CLEAN;
+        stats_.cards_scanned++;
+        
+        uint8_t* card_start = old_gen_->start + (card << CARD_SHIFT);
+        uint8_t* card_end = std::min(card_start + CARD_SIZE, old_limit);
+        
+        // Walk back to the object that covers the start of the card
+        size_t first = card;
+        while (first > 0 && card_first_object_[first] == NO_OBJECT) {
+            first--;
+        }
+        if (card_first_object_[first] == NO_OBJECT) {
+            continue;
+        }
+        
+        uint8_t* scan = old_gen_->start + (first << CARD_SHIFT) + card_first_object_[first];
+        while (scan < card_end) {
+            auto* header = reinterpret_cast<GCObjectHeader*>(scan);
+            size_t obj_size = sizeof(GCObjectHeader) + header->size;
+            
+            if (header->has_refs && scan + obj_size > card_start) {
+                // Only the slots that lie on this card
+                void** refs = static_cast<void**>(header->get_data());
+                size_t num_refs = header->size / sizeof(void*);
+                for (size_t i = 0; i < num_refs; i++) {
+                    auto* slot = reinterpret_cast<uint8_t*>(&refs[i]);
+                    if (slot < card_start) continue;
+                    if (slot >= card_end) break;
+                    
+                    refs[i] = evacuate(refs[i]);
+                    if (is_young(refs[i])) {
+                        cards_[card] = CARD_DIRTY;
+                    }
+                }
+            }
+            
+            scan += obj_size;
+        }
+    }
+}
+
+void ActorGC::record_old_object(GCObjectHeader* obj) {
+    // Keep the lowest object start seen in each card
+    size_t card = card_index(obj);
+    auto offset = static_cast<uint16_t>(
+        (reinterpret_cast<uint8_t*>(obj) - old_gen_->start) & (CARD_SIZE - 1)
+    );
+    card_first_object_[card] = std::min(card_first_object_[card], offset);
+}
+
+void ActorGC::forget_object_starts(uint8_t* from, uint8_t* to, bool to_is_object) {
+    // Objects in [from, to) are gone. A card whose first object was among
+    // them now starts at `to` if that is an object in the same card;
+    // otherwise scans reach it by walking back to an earlier card.
+    if (from >= to) return;
+    
+    size_t last_card = card_index(to - 1);
+    for (size_t card = card_index(from); card <= last_card; card++) {
+        if (card_first_object_[card] == NO_OBJECT) continue;
+        
+        uint8_t* first = old_gen_->start + (card << CARD_SHIFT) + card_first_object_[card];
+        if (first >= from && first < to) {
+            bool same_card = to_is_object && card_index(to) == card;
+            card_first_object_[card] = same_card
+                ? static_cast<uint16_t>((to - old_gen_->start) & (CARD_SIZE - 1))
+                : NO_OBJECT;
+        }
+    }
+}
+
 void ActorGC::collect_full() {
     auto start = std::chrono::high_resolution_clock::now();
     
     // Major GC - collect both generations
     // This is slower but happens less frequently
     
+    // 0. Empty the nursery first so only survivors need marking
+    collect_young();
+    
     // 1. Mark phase - mark all reachable objects
     mark_from_roots();
     
-    // 2. Sweep both generations
+    // 2. Sweep - old objects never move, dead ones become free blocks
     sweep_young();
     sweep_old();
-    
-    // 3. Optional: compact old generation to reduce fragmentation
-    if (old_gen_->used > old_gen_->size * 0.7) {
-        compact_old_generation();
-    }
+    sweep_large();
     
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
@@ -172,28 +573,66 @@ void ActorGC::collect_if_needed() {
     }
 }
 
+void ActorGC::set_cycle_collector(CycleCollector collector) {
+    cycle_collector = collector;
+}
+
+void ActorGC::collect_pressured() {
+    double young_usage = static_cast<double>(young_gen_->used) / young_gen_->size;
+    double old_usage = static_cast<double>(old_gen_->used) / old_gen_->size;
+    
+    if (old_usage > OLD_PRESSURE) {
+        collect_full();  // Empties the nursery too
+    } else if (young_usage > YOUNG_PRESSURE) {
+        collect_young();
+    }
+}
+
+size_t ActorGC::collect_cycles() {
+    if (!cycle_collector || cycle_candidates_.empty()) {
+        return 0;
+    }
+    
+    // Objects queued while collecting go to a fresh batch
+    std::vector<void*> candidates;
+    candidates.swap(cycle_candidates_);
+    return cycle_collector(candidates);
+}
+
+GCObjectHeader* ActorGC::header_of(void* obj) const {
+    if (!obj) {
+        return nullptr;
+    }
+    
+    if (is_young(obj) || old_gen_->contains(obj)) {
+        return reinterpret_cast<GCObjectHeader*>(
+            static_cast<uint8_t*>(obj) - sizeof(GCObjectHeader)
+        );
+    }
+    
+    if (!large_objects_.empty() && large_objects_.count(obj)) {
+        return reinterpret_cast<GCObjectHeader*>(
+            static_cast<uint8_t*>(obj) - sizeof(GCObjectHeader)
+        );
+    }
+    
+    return nullptr;
+}
+
 void ActorGC::mark_from_roots() {
     // Mark all objects reachable from roots
-    for (void** root : roots_) {
-        if (*root) {
-            void* obj = *root;
-            GCObjectHeader* header = nullptr;
-            
-            // Determine which generation
-            if (young_gen_->contains(obj)) {
-                header = reinterpret_cast<GCObjectHeader*>(
-                    static_cast<uint8_t*>(obj) - sizeof(GCObjectHeader)
-                );
-            } else if (old_gen_->contains(obj)) {
-                header = reinterpret_cast<GCObjectHeader*>(
-                    static_cast<uint8_t*>(obj) - sizeof(GCObjectHeader)
-                );
-            }
-            
-            if (header) {
-                mark_object(header);
-            }
+    auto mark_slot = [this](void** slot) {
+        GCObjectHeader* header = header_of(*slot);
+        if (header) {
+            mark_object(header);
         }
+    };
+    
+    for (void** root : roots_) {
+        mark_slot(root);
+    }
+    if (root_scanner_) {
+        root_scanner_(mark_slot);
     }
 }
 
@@ -207,23 +646,9 @@ void ActorGC::mark_object(GCObjectHeader* obj) {
     // Recursively mark referenced objects
     if (obj->has_refs) {
         scan_object_references(obj, [this](void** ref) {
-            void* child = *ref;
-            if (child) {
-                GCObjectHeader* child_header = nullptr;
-                
-                if (young_gen_->contains(child)) {
-                    child_header = reinterpret_cast<GCObjectHeader*>(
-                        static_cast<uint8_t*>(child) - sizeof(GCObjectHeader)
-                    );
-                } else if (old_gen_->contains(child)) {
-                    child_header = reinterpret_cast<GCObjectHeader*>(
-                        static_cast<uint8_t*>(child) - sizeof(GCObjectHeader)
-                    );
-                }
-                
-                if (child_header) {
-                    mark_object(child_header);
-                }
+            GCObjectHeader* child_header = header_of(*ref);
+            if (child_header) {
+                mark_object(child_header);
             }
         });
     }
@@ -250,78 +675,83 @@ void ActorGC::sweep_young() {
 }
 
 void ActorGC::sweep_old() {
+    // Non-moving sweep. Runs of dead objects and old free blocks coalesce
+    // into one free block filed on the size-class lists; a dead run at the
+    // end of the generation is handed back to the bump pointer.
+    free_lists_.fill(nullptr);
+    free_classes_ = 0;
+    stats_.old_free_bytes = 0;
+    
     uint8_t* scan = old_gen_->start;
-    uint8_t* new_alloc_ptr = old_gen_->start;
-    size_t new_used = 0;
+    uint8_t* run_start = nullptr;
+    size_t live = 0;
     
     while (scan < old_gen_->alloc_ptr) {
         GCObjectHeader* header = reinterpret_cast<GCObjectHeader*>(scan);
         size_t obj_size = sizeof(GCObjectHeader) + header->size;
         
-        if (header->marked) {
-            // Keep this object - compact it if necessary
-            if (scan != new_alloc_ptr) {
-                std::memmove(new_alloc_ptr, scan, obj_size);
+        if (header->generation != GCObjectHeader::FREE && (header->marked || header->pinned)) {
+            if (run_start) {
+                forget_object_starts(run_start + sizeof(GCObjectHeader), scan, true);
+                make_free_block(run_start, scan - run_start);
+                run_start = nullptr;
             }
-            new_alloc_ptr += obj_size;
-            new_used += obj_size;
             
             // Reset mark bit
             header->marked = false;
+            live += obj_size;
         } else {
-            // Object is garbage
-            stats_.objects_freed++;
-            stats_.bytes_freed += header->size;
+            if (header->generation != GCObjectHeader::FREE) {
+                // Object is garbage
+                stats_.objects_freed++;
+                stats_.bytes_freed += header->size;
+            }
+            if (!run_start) {
+                run_start = scan;
+            }
         }
         
         scan += obj_size;
     }
     
-    old_gen_->alloc_ptr = new_alloc_ptr;
-    old_gen_->used = new_used;
-}
-
-void ActorGC::evacuate_survivors() {
-    // Scan young generation and promote aged survivors to old generation
-    uint8_t* scan = young_gen_->start;
-    
-    while (scan < young_gen_->alloc_ptr) {
-        GCObjectHeader* header = reinterpret_cast<GCObjectHeader*>(scan);
-        size_t obj_size = sizeof(GCObjectHeader) + header->size;
-        
-        if (header->marked && should_promote(header)) {
-            promote_to_old(header);
+    if (run_start) {
+        forget_object_starts(run_start, old_gen_->alloc_ptr, false);
+        old_gen_->alloc_ptr = run_start;
+    }
+    old_gen_->used = live;
+    
+    // Fragmentation: how much of the free space is unusable for the
+    // largest request that could still be satisfied
+    size_t largest = old_gen_->end - old_gen_->alloc_ptr;
+    if (free_classes_) {
+        // Only the highest non-empty class can hold the largest block
+        size_t cls = 31 - __builtin_clz(free_classes_);
+        for (GCObjectHeader* block = free_lists_[cls]; block;
+             block = static_cast<GCObjectHeader*>(block->forward)) {
+            largest = std::max<size_t>(largest, sizeof(GCObjectHeader) + block->size);
         }
-        
-        scan += obj_size;
     }
-}
-
-void ActorGC::promote_to_old(GCObjectHeader* obj) {
-    // Copy object from young to old generation
-    size_t total_size = sizeof(GCObjectHeader) + obj->size;
-    
-    void* new_location = allocate_in_generation(*old_gen_, obj->size, 
-                                                obj->type_id, obj->has_refs);
     
-    if (new_location) {
-        // Copy data
-        std::memcpy(new_location, obj->get_data(), obj->size);
-        
-        // Update references to point to new location
-        // (This requires cooperation with mutator or read barrier)
-        
-        stats_.promotions++;
-    }
+    size_t total_free = stats_.old_free_bytes + (old_gen_->end - old_gen_->alloc_ptr);
+    stats_.largest_free_block = largest;
+    stats_.fragmentation = total_free ? 1.0 - static_cast<double>(largest) / total_free : 0.0;
 }
 
-bool ActorGC::should_promote(GCObjectHeader* obj) {
-    auto it = allocation_age_.find(obj);
-    if (it != allocation_age_.end()) {
-        it->second++;
-        return it->second >= PROMOTION_AGE;
+void ActorGC::sweep_large() {
+    for (auto it = large_objects_.begin(); it != large_objects_.end();) {
+        GCObjectHeader* header = header_of(it->first);
+        if (header->marked || header->pinned) {
+            header->marked = false;
+            ++it;
+            continue;
+        }
+        
+        stats_.objects_freed++;
+        stats_.bytes_freed += header->size;
+        stats_.large_bytes -= it->second;
+        munmap(header, it->second);
+        it = large_objects_.erase(it);
     }
-    return false;
 }
 
 void ActorGC::scan_object_references(GCObjectHeader* obj, 
@@ -343,48 +773,11 @@ void ActorGC::scan_object_references(GCObjectHeader* obj,
     }
 }
 
-void ActorGC::write_barrier(void* old_value, void* new_value) {
-    // Track old→young references for generational GC
-    if (!new_value) return;
-    
-    // If new_value is in young gen and container is in old gen
-    if (young_gen_->contains(new_value)) {
-        // Find containing object
-        // Add to remembered set
-        // (Simplified - real implementation would track precisely)
-    }
-}
-
-void ActorGC::compact_old_generation() {
-    // Compact old generation to eliminate fragmentation
-    // This is an optional optimization
-    
-    uint8_t* scan = old_gen_->start;
-    uint8_t* compact_ptr = old_gen_->start;
-    
-    while (scan < old_gen_->alloc_ptr) {
-        GCObjectHeader* header = reinterpret_cast<GCObjectHeader*>(scan);
-        size_t obj_size = sizeof(GCObjectHeader) + header->size;
-        
-        if (header->marked) {
-            if (scan != compact_ptr) {
-                std::memmove(compact_ptr, scan, obj_size);
-            }
-            compact_ptr += obj_size;
-        }
-        
-        scan += obj_size;
-    }
-    
-    old_gen_->alloc_ptr = compact_ptr;
-    old_gen_->used = compact_ptr - old_gen_->start;
-}
-
 bool ActorGC::is_memory_pressure() const {
     double young_usage = static_cast<double>(young_gen_->used) / young_gen_->size;
     double old_usage = static_cast<double>(old_gen_->used) / old_gen_->size;
     
-    return young_usage > 0.7 || old_usage > 0.8;
+    return young_usage > YOUNG_PRESSURE || old_usage > OLD_PRESSURE;
 }
 
 void ActorGC::record_collection(CollectionReason reason, 
@@ -397,6 +790,12 @@ void ActorGC::record_collection(CollectionReason reason,
     }
     
     stats_.avg_pause_time = stats_.total_pause_time / stats_.total_collections;
+    
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - created_);
+    if (elapsed.count() > 0) {
+        stats_.throughput = 1.0 - static_cast<double>(stats_.total_pause_time.count()) / elapsed.count();
+    }
 }
 
 void ActorGC::dump_state() const {
@@ -411,10 +810,45 @@ void ActorGC::dump_state() const {
     std::cout << "  Objects Allocated: " << stats_.objects_allocated << "\n";
     std::cout << "  Objects Freed: " << stats_.objects_freed << "\n";
     std::cout << "  Promotions: " << stats_.promotions << "\n";
+    std::cout << "  Bytes Copied: " << stats_.bytes_copied << "\n";
+    std::cout << "  Cards Scanned: " << stats_.cards_scanned << "\n";
+    std::cout << "  Free-list Allocations: " << stats_.free_list_allocations << "\n";
+    std::cout << "  Old Free: " << stats_.old_free_bytes << " bytes in holes, largest block "
+              << stats_.largest_free_block << " bytes\n";
+    std::cout << "  Fragmentation: " << (stats_.fragmentation * 100.0) << "%\n";
+    std::cout << "  Large Objects: " << large_objects_.size() << " ("
+              << stats_.large_bytes << " bytes mapped)\n";
+    std::cout << "  Pinned: " << stats_.pinned_bytes << " bytes\n";
+    std::cout << "  Throughput: " << (stats_.throughput * 100.0) << "% outside GC\n";
     std::cout << "  Avg Pause: " << stats_.avg_pause_time.count() << " μs\n";
     std::cout << "  Max Pause: " << stats_.max_pause_time.count() << " μs\n";
 }
 
+void visit_shadow_stack_roots(const ActorGC::RootVisitor& visit) {
+    for (ShadowStackEntry* entry = llvm_gc_root_chain; entry; entry = entry->next) {
+        for (int32_t i = 0; i < entry->map->num_roots; i++) {
+            visit(&entry->roots[i]);
+        }
+    }
+}
+
+ActorGCScope::ActorGCScope(std::unique_ptr<ActorGC>& slot)
+    : prev_gc_(current_actor_gc), prev_slot_(current_actor_gc_slot),
+      prev_chain_(llvm_gc_root_chain) {
+    current_actor_gc = slot.get();
+    current_actor_gc_slot = &slot;
+    llvm_gc_root_chain = nullptr;
+    if (current_actor_gc) {
+        current_actor_gc->drain_remote_frees();
+    }
+}
+
+ActorGCScope::~ActorGCScope() {
+    current_actor_gc = prev_gc_;
+    current_actor_gc_slot = prev_slot_;
+    llvm_gc_root_chain = prev_chain_;
+}
+
 // C API for generated code
 extern "C" {
 
@@ -432,6 +866,44 @@ void* gc_alloc_array(size_t elem_size, size_t count) {
     return nullptr;
 }
 
+void* gc_alloc_pinned(size_t size) {
+    if (!current_actor_gc && current_actor_gc_slot) {
+        *current_actor_gc_slot = std::make_unique<ActorGC>();
+        current_actor_gc = current_actor_gc_slot->get();
+        current_actor_gc->set_root_scanner(visit_shadow_stack_roots);
+    }
+    
+    if (current_actor_gc) {
+        if (void* ptr = current_actor_gc->allocate_pinned(size)) {
+            return ptr;
+        }
+    }
+    
+    // Outside actor context, or the actor's heap is exhausted. The header
+    // tells gc_free the block is not any collector's.
+    auto* header = static_cast<GCObjectHeader*>(std::malloc(sizeof(GCObjectHeader) + size));
+    if (!header) {
+        return nullptr;
+    }
+    header->size = static_cast<uint32_t>(size);
+    header->generation = GCObjectHeader::MALLOC;
+    header->forward = nullptr;
+    return header->get_data();
+}
+
+void gc_free(void* ptr) {
+    if (!ptr) return;
+    
+    ActorGC* owner = ActorGC::owner_of(ptr);
+    if (!owner) {
+        std::free(static_cast<uint8_t*>(ptr) - sizeof(GCObjectHeader));
+    } else if (owner == current_actor_gc) {
+        owner->free_pinned(ptr);
+    } else {
+        owner->free_remote(ptr);
+    }
+}
+
 void gc_add_root(void** root) {
     if (current_actor_gc) {
         current_actor_gc->add_root(root);
@@ -446,8 +918,7 @@ void gc_remove_root(void** root) {
 
 void gc_write_barrier(void* obj, void* field, void* new_value) {
     if (current_actor_gc) {
-        void* old_value = *static_cast<void**>(field);
-        current_actor_gc->write_barrier(old_value, new_value);
+        current_actor_gc->write_barrier(static_cast<void**>(field), new_value);
     }
 }
 
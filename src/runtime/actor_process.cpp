@@ -3,6 +3,7 @@
 #include <chrono>
 #include <thread>
 #include <cstring>
+#include <algorithm>
 
 
 namespace aithon::runtime {
@@ -10,58 +11,166 @@ namespace aithon::runtime {
 ActorProcess::ActorProcess(int pid, size_t heap_size)
     : pid_(pid),
       heap_(heap_size),
+      interned_(nullptr, nullptr),
       state_(ActorState::RUNNABLE),
       reductions_(REDUCTIONS_PER_SLICE),
       supervisor_pid_(-1),
       caller_pid_(-1), exit_reason_(),
       continuation_state_(nullptr),
+      current_message_(nullptr),
       behavior_(nullptr),
-      initial_args_(nullptr) {
+      initial_args_(nullptr),
+      home_worker_(0),
+      scheduled_(true),  // The spawner queues it
+      hibernated_(false),
+      idle_since_(0),
+      cycle_candidates_(0),
+      runtime_used_(0),
+      runtime_reserved_(0),
+      runtime_pressure_(false) {
+    heap_.set_root_scanner([this](const ActorHeap::RootVisitor& visit) {
+        scan_roots(visit);
+    });
 }
 
 ActorProcess::~ActorProcess() {
-    // Cleanup will be handled by heap destructor
+    // Cleanup will be handled by heap destructor; the runtime heap may
+    // outlive us while other actors hold objects in it
+    ActorGC::retire(std::move(runtime_gc_));
 }
 
-bool ActorProcess::send(Message msg) {
-    // Copy message payload to our heap
-    void* local_payload = heap_.allocate(msg.size);
-    if (!local_payload) {
-        // Heap full - trigger GC
-        heap_.collect_garbage();
-        local_payload = heap_.allocate(msg.size);
+bool ActorProcess::send(Message msg, bool* woken) {
+    {
+        // Enqueue under the heap lock so a collection never sees a copied
+        // payload that is not in the mailbox yet
+        std::lock_guard<std::mutex> lock(heap_mutex_);
+        void* local_payload = copy_payload(msg);
         if (!local_payload) {
-            return false;  // Still no space
+            return false;  // No space until the owner collects
         }
+        
+        Message local_msg(local_payload, msg.size, msg.sender_pid);
+        mailbox_.enqueue(std::move(local_msg));
     }
     
-    std::memcpy(local_payload, msg.payload, msg.size);
+    // Wake up if waiting
+    bool did_wake = wake();
+    if (woken) *woken = did_wake;
     
-    Message local_msg(local_payload, msg.size, msg.sender_pid);
-    mailbox_.enqueue(std::move(local_msg));
+    return true;
+}
+
+size_t ActorProcess::send_batch(std::vector<Message>& batch, bool* woken) {
+    std::vector<Message> local_batch;
+    local_batch.reserve(batch.size());
     
-    // Wake up if waiting
+    {
+        std::lock_guard<std::mutex> lock(heap_mutex_);
+        for (Message& msg : batch) {
+            void* local_payload = copy_payload(msg);
+            if (!local_payload) {
+                break;  // Heap full - deliver the prefix, keep ordering
+            }
+            local_batch.emplace_back(local_payload, msg.size, msg.sender_pid);
+        }
+        
+        // One atomic exchange on the mailbox tail for the whole burst
+        mailbox_.enqueue_batch(local_batch.begin(), local_batch.end());
+    }
+    
+    bool did_wake = !local_batch.empty() && wake();
+    if (woken) *woken = did_wake;
+    
+    return local_batch.size();
+}
+
+void* ActorProcess::copy_payload(const Message& msg) {
+    // Copy message payload to our heap. The sender must not collect: the
+    // owner may be running with heap pointers the GC cannot see.
+    void* local_payload = heap_.try_allocate(msg.size);
+    if (!local_payload) {
+        return nullptr;
+    }
+    
+    std::memcpy(local_payload, msg.payload, msg.size);
+    return local_payload;
+}
+
+bool ActorProcess::wake() {
+    // Sequentially consistent against end_quantum(): either it sees
+    // RUNNABLE after releasing the token, or we see the token released
     ActorState expected = ActorState::WAITING;
-    state_.compare_exchange_strong(expected, ActorState::RUNNABLE,
-                                   std::memory_order_release,
-                                   std::memory_order_relaxed);
+    if (!state_.compare_exchange_strong(expected, ActorState::RUNNABLE)) {
+        return false;
+    }
+    return !scheduled_.exchange(true);
+}
+
+bool ActorProcess::end_quantum() {
+    // Yielded, or woken while the quantum ran
+    if (state_.load() == ActorState::RUNNABLE) return true;
     
-    return true;
+    scheduled_.store(false);
+    
+    // A wake between the check and the release found the token held and
+    // left the requeue to us
+    return state_.load() == ActorState::RUNNABLE && !scheduled_.exchange(true);
 }
 
-Message* ActorProcess::receive() {
+Message* ActorProcess::take_message() {
+    std::lock_guard<std::mutex> lock(heap_mutex_);
+    
+    // The previous message is dead once the next one is asked for, which
+    // also makes this a safe point to collect
+    current_message_ = nullptr;
+    if (heap_.used() > heap_.max_size() * ACTOR_GC_THRESHOLD) {
+        heap_.collect_garbage();
+    }
+    
     auto opt_msg = mailbox_.try_dequeue();
-    if (opt_msg.has_value()) {
-        // Allocate message on heap so it persists
-        Message* msg = static_cast<Message*>(heap_.allocate(sizeof(Message)));
-        if (msg) {
-            new (msg) Message(std::move(opt_msg.value()));
-            return msg;
-        }
+    if (!opt_msg.has_value()) {
+        return nullptr;
+    }
+    
+    // Allocate message on heap so it persists; the payload is off the
+    // mailbox now, so root it while the allocation may collect
+    HeapRoot payload_root(heap_, &opt_msg->payload);
+    Message* msg = static_cast<Message*>(heap_.allocate(sizeof(Message), HeapType::MESSAGE));
+    if (msg) {
+        new (msg) Message(std::move(opt_msg.value()));
+        current_message_ = msg;
+    }
+    return msg;
+}
+
+void ActorProcess::scan_roots(const ActorHeap::RootVisitor& visit) {
+    mailbox_.for_each([&visit](Message& msg) { visit(&msg.payload); });
+    visit(&continuation_state_);
+    visit(reinterpret_cast<void**>(&current_message_));
+}
+
+void* ActorProcess::allocate(size_t size, uint32_t type_id) {
+    std::lock_guard<std::mutex> lock(heap_mutex_);
+    return heap_.allocate(size, type_id);
+}
+
+Message* ActorProcess::receive() {
+    if (Message* msg = take_message()) {
+        return msg;
     }
     
     // No messages - suspend
-    state_.store(ActorState::WAITING, std::memory_order_release);
+    idle_since_.store(get_monotonic_time(), std::memory_order_relaxed);
+    state_.store(ActorState::WAITING, std::memory_order_seq_cst);
+
+    // A sender may have enqueued before it could observe WAITING; if so,
+    // take the wakeup back ourselves instead of losing it
+    if (!mailbox_.is_empty()) {
+        ActorState expected = ActorState::WAITING;
+        if (state_.compare_exchange_strong(expected, ActorState::RUNNING)) {
+            return receive();
+        }
+    }
     return nullptr;
 }
 
@@ -69,13 +178,8 @@ Message* ActorProcess::receive_timeout(uint64_t timeout_ms) {
     uint64_t start = get_monotonic_time();
     
     while (true) {
-        auto opt_msg = mailbox_.try_dequeue();
-        if (opt_msg.has_value()) {
-            Message* msg = static_cast<Message*>(heap_.allocate(sizeof(Message)));
-            if (msg) {
-                new (msg) Message(std::move(opt_msg.value()));
-                return msg;
-            }
+        if (Message* msg = take_message()) {
+            return msg;
         }
         
         if (get_monotonic_time() - start > timeout_ms) {
@@ -91,22 +195,51 @@ bool ActorProcess::execute_quantum() {
     if (!state_.compare_exchange_strong(expected, ActorState::RUNNING,
                                        std::memory_order_acquire,
                                        std::memory_order_relaxed)) {
-        return false;  // Not ready to run
+        return end_quantum();  // Not ready to run (killed while queued)
     }
     
     reductions_.store(REDUCTIONS_PER_SLICE, std::memory_order_relaxed);
+    hibernated_.store(false, std::memory_order_relaxed);
+    
+    {
+        ActorGCScope gc_scope(runtime_gc_);
+        InternScope intern_scope(interned_);
+        run_behavior();
+    }
     
+    // A dead actor's runtime objects are unreachable except for the ones
+    // it shared - free them in bulk once no other actor holds one
+    if (!is_alive()) {
+        ActorGC::retire(std::move(runtime_gc_));
+        interned_.reset();
+    }
+    record_runtime_usage();
+    
+    // Only now may another worker run the actor
+    return end_quantum();
+}
+
+void ActorProcess::record_runtime_usage() {
+    ActorGC* gc = runtime_gc_.get();
+    cycle_candidates_.store(gc ? gc->cycle_candidates() : 0, std::memory_order_relaxed);
+    runtime_used_.store(gc ? gc->used_bytes() : 0, std::memory_order_relaxed);
+    runtime_reserved_.store(gc ? gc->reserved_bytes() : 0, std::memory_order_relaxed);
+    runtime_pressure_.store(gc && gc->is_memory_pressure(), std::memory_order_relaxed);
+}
+
+bool ActorProcess::run_behavior() {
     try {
         // Call behavior function (compiled Python code)
         if (behavior_) {
             behavior_(this, initial_args_);
         }
         
-        // If we get here, actor yielded voluntarily or completed
-        ActorState current = state_.load(std::memory_order_acquire);
-        if (current == ActorState::RUNNING) {
-            state_.store(ActorState::RUNNABLE, std::memory_order_release);
-        }
+        // If we get here, actor yielded voluntarily or completed. Parked
+        // in receive() it stays WAITING, or a sender made it RUNNABLE.
+        ActorState expected = ActorState::RUNNING;
+        state_.compare_exchange_strong(expected, ActorState::RUNNABLE,
+                                       std::memory_order_release,
+                                       std::memory_order_relaxed);
         return true;
         
     } catch (const std::exception& e) {
@@ -119,6 +252,86 @@ bool ActorProcess::execute_quantum() {
     }
 }
 
+template<typename Fn>
+bool ActorProcess::with_parked_heap(Fn&& fn, bool* woken) {
+    // SUSPENDED keeps senders from waking the actor while its heap is
+    // being rearranged
+    ActorState expected = ActorState::WAITING;
+    if (!state_.compare_exchange_strong(expected, ActorState::SUSPENDED)) {
+        if (woken) *woken = false;
+        return false;
+    }
+    
+    // receive() goes WAITING before the behavior returns; until the
+    // quantum is over and the run token released, the behavior may still
+    // hold heap pointers the GC cannot see, and the worker still uses
+    // runtime_gc_
+    bool parked = false;
+    if (!scheduled_.load()) {
+        std::lock_guard<std::mutex> lock(heap_mutex_);
+        fn();
+        parked = true;
+    }
+    
+    state_.store(ActorState::WAITING, std::memory_order_seq_cst);
+    
+    // Messages that arrived meanwhile could not wake us - do it now
+    bool did_wake = !mailbox_.is_empty() && wake();
+    if (woken) *woken = did_wake;
+    
+    return parked;
+}
+
+bool ActorProcess::hibernate(size_t* bytes_released, bool* woken) {
+    return with_parked_heap([&] {
+        size_t released = heap_.hibernate();
+        
+        // The generations stay mapped; dead large objects are unmapped
+        if (runtime_gc_) {
+            ActorGCScope gc_scope(runtime_gc_);
+            size_t before = runtime_gc_->reserved_bytes();
+            runtime_gc_->collect_full();
+            released += before - runtime_gc_->reserved_bytes();
+            record_runtime_usage();
+        }
+        
+        if (bytes_released) *bytes_released = released;
+        hibernated_.store(true, std::memory_order_relaxed);
+    }, woken);
+}
+
+bool ActorProcess::collect_idle(size_t* bytes_reclaimed, bool* woken) {
+    return with_parked_heap([&] {
+        size_t before = heap_.used();
+        heap_.collect_garbage();
+        size_t reclaimed = before - heap_.used();
+        
+        if (runtime_gc_) {
+            ActorGCScope gc_scope(runtime_gc_);
+            size_t runtime_before = runtime_gc_->used_bytes();
+            
+            // Refcounted runtime objects only leak through cycles
+            if (runtime_gc_->cycle_candidates() > 0) {
+                runtime_gc_->collect_cycles();
+            }
+            
+            // Collect now what allocation would collect mid-quantum
+            runtime_gc_->collect_pressured();
+            reclaimed += runtime_before - std::min(runtime_before, runtime_gc_->used_bytes());
+            record_runtime_usage();
+        }
+        if (bytes_reclaimed) *bytes_reclaimed = reclaimed;
+    }, woken);
+}
+
+HeapUsage ActorProcess::heap_usage() {
+    std::lock_guard<std::mutex> lock(heap_mutex_);
+    return {heap_.used(), heap_.total(), heap_.max_size(), heap_.live_after_gc(),
+            runtime_used_.load(std::memory_order_relaxed),
+            runtime_reserved_.load(std::memory_order_relaxed),
+            runtime_pressure_.load(std::memory_order_relaxed)};
+}
+
 bool ActorProcess::should_yield() {
     int remaining = reductions_.fetch_sub(1, std::memory_order_relaxed);
     return remaining <= 0;
@@ -0,0 +1,446 @@
+#include "runtime/bigint.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace aithon::runtime {
+
+// ============================================================================
+// Magnitudes
+// ============================================================================
+
+namespace {
+
+using Limbs = std::vector<uint32_t>;
+
+constexpr uint64_t LIMB_BASE = uint64_t(1) << 32;
+
+void trim(Limbs& limbs) {
+    while (!limbs.empty() && limbs.back() == 0) limbs.pop_back();
+}
+
+int compare_magnitude(const Limbs& a, const Limbs& b) {
+    if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+    for (size_t i = a.size(); i-- > 0;) {
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+Limbs add_magnitude(const Limbs& a, const Limbs& b) {
+    const Limbs& longer = a.size() >= b.size() ? a : b;
+    const Limbs& shorter = a.size() >= b.size() ? b : a;
+    Limbs result(longer.size() + 1);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < longer.size(); i++) {
+        uint64_t sum = uint64_t(longer[i]) + (i < shorter.size() ? shorter[i] : 0) + carry;
+        result[i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+    }
+    result[longer.size()] = static_cast<uint32_t>(carry);
+    trim(result);
+    return result;
+}
+
+// a - b, for a >= b
+Limbs sub_magnitude(const Limbs& a, const Limbs& b) {
+    Limbs result(a.size());
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        int64_t diff = int64_t(a[i]) - (i < b.size() ? b[i] : 0) - borrow;
+        borrow = diff < 0;
+        result[i] = static_cast<uint32_t>(diff + (borrow ? int64_t(LIMB_BASE) : 0));
+    }
+    trim(result);
+    return result;
+}
+
+// out[0, n) += b[0, nb) for nb <= n; returns the carry out of the top
+uint32_t add_into(uint32_t* out, size_t n, const uint32_t* b, size_t nb) {
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < nb; i++) {
+        uint64_t sum = uint64_t(out[i]) + b[i] + carry;
+        out[i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+    }
+    for (; carry && i < n; i++) {
+        uint64_t sum = uint64_t(out[i]) + carry;
+        out[i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+    }
+    return static_cast<uint32_t>(carry);
+}
+
+// out[0, n) -= b[0, nb) for nb <= n; the result must not go negative
+void sub_from(uint32_t* out, size_t n, const uint32_t* b, size_t nb) {
+    int64_t borrow = 0;
+    size_t i = 0;
+    for (; i < nb; i++) {
+        int64_t diff = int64_t(out[i]) - b[i] - borrow;
+        borrow = diff < 0;
+        out[i] = static_cast<uint32_t>(diff + (borrow ? int64_t(LIMB_BASE) : 0));
+    }
+    for (; borrow && i < n; i++) {
+        borrow = out[i] == 0;
+        out[i]--;
+    }
+}
+
+// out[0, na + nb) = a * b; out overlaps neither operand
+void mul_schoolbook(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+    std::fill(out, out + na + nb, 0);
+    for (size_t i = 0; i < na; i++) {
+        uint64_t ai = a[i];
+        if (ai == 0) continue;
+        uint64_t carry = 0;
+        for (size_t j = 0; j < nb; j++) {
+            // At most (2^32 - 1)^2 + 2 (2^32 - 1) = 2^64 - 1
+            uint64_t product = ai * b[j] + out[i + j] + carry;
+            out[i + j] = static_cast<uint32_t>(product);
+            carry = product >> 32;
+        }
+        out[i + nb] = static_cast<uint32_t>(carry);
+    }
+}
+
+// out[0, na + nb) = a * b. Splitting both at half the longer length,
+//   a * b = z2 B^2h + ((a0 + a1)(b0 + b1) - z0 - z2) B^h + z0
+// for z0 = a0 b0 and z2 = a1 b1: three half-size products for four.
+void mul_karatsuba(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb < BigInt::KARATSUBA_THRESHOLD) {
+        mul_schoolbook(a, na, b, nb, out);
+        return;
+    }
+
+    size_t half = (na + 1) / 2;
+    if (nb <= half) {
+        // Lopsided: b times each nb-limb slice of a
+        std::fill(out, out + na + nb, 0);
+        Limbs part(2 * nb);
+        for (size_t i = 0; i < na; i += nb) {
+            size_t len = std::min(nb, na - i);
+            mul_karatsuba(a + i, len, b, nb, part.data());
+            add_into(out + i, na + nb - i, part.data(), len + nb);
+        }
+        return;
+    }
+
+    size_t na1 = na - half, nb1 = nb - half;
+    mul_karatsuba(a, half, b, half, out);                           // z0
+    mul_karatsuba(a + half, na1, b + half, nb1, out + 2 * half);    // z2
+
+    Limbs sum_a(a, a + half), sum_b(b, b + half);
+    sum_a.push_back(add_into(sum_a.data(), half, a + half, na1));
+    sum_b.push_back(add_into(sum_b.data(), half, b + half, nb1));
+
+    Limbs middle(2 * half + 2);
+    mul_karatsuba(sum_a.data(), half + 1, sum_b.data(), half + 1, middle.data());
+    sub_from(middle.data(), middle.size(), out, 2 * half);
+    sub_from(middle.data(), middle.size(), out + 2 * half, na1 + nb1);
+    trim(middle);
+    add_into(out + half, na + nb - half, middle.data(), middle.size());
+}
+
+// Divides in place by a single limb, returning the remainder
+uint32_t div_small(Limbs& limbs, uint32_t divisor) {
+    uint64_t rem = 0;
+    for (size_t i = limbs.size(); i-- > 0;) {
+        uint64_t cur = (rem << 32) | limbs[i];
+        limbs[i] = static_cast<uint32_t>(cur / divisor);
+        rem = cur % divisor;
+    }
+    trim(limbs);
+    return static_cast<uint32_t>(rem);
+}
+
+// limbs = limbs * factor + addend
+void mul_add_small(Limbs& limbs, uint32_t factor, uint32_t addend) {
+    uint64_t carry = addend;
+    for (uint32_t& limb : limbs) {
+        uint64_t cur = uint64_t(limb) * factor + carry;
+        limb = static_cast<uint32_t>(cur);
+        carry = cur >> 32;
+    }
+    if (carry) limbs.push_back(static_cast<uint32_t>(carry));
+}
+
+// Truncating division of magnitudes, v non-zero: Knuth's algorithm D
+void divmod_magnitude(const Limbs& u, const Limbs& v, Limbs& q, Limbs& r) {
+    if (compare_magnitude(u, v) < 0) {
+        q.clear();
+        r = u;
+        return;
+    }
+    if (v.size() == 1) {
+        q = u;
+        uint32_t rem = div_small(q, v[0]);
+        r.clear();
+        if (rem) r.push_back(rem);
+        return;
+    }
+
+    // Normalize so the divisor's top bit is set; the quotient digit
+    // estimates are then off by at most two
+    size_t n = v.size(), m = u.size() - n;
+    int shift = std::countl_zero(v.back());
+    Limbs vn(n), un(u.size() + 1);
+    for (size_t i = n - 1; i > 0; i--) {
+        vn[i] = (v[i] << shift) | (shift ? v[i - 1] >> (32 - shift) : 0);
+    }
+    vn[0] = v[0] << shift;
+    un[u.size()] = shift ? u.back() >> (32 - shift) : 0;
+    for (size_t i = u.size() - 1; i > 0; i--) {
+        un[i] = (u[i] << shift) | (shift ? u[i - 1] >> (32 - shift) : 0);
+    }
+    un[0] = u[0] << shift;
+
+    q.assign(m + 1, 0);
+    for (size_t j = m + 1; j-- > 0;) {
+        uint64_t top = (uint64_t(un[j + n]) << 32) | un[j + n - 1];
+        uint64_t qhat = top / vn[n - 1];
+        uint64_t rhat = top % vn[n - 1];
+        while (qhat >= LIMB_BASE || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+            qhat--;
+            rhat += vn[n - 1];
+            if (rhat >= LIMB_BASE) break;
+        }
+
+        // un[j, j + n] -= qhat * vn
+        int64_t borrow = 0, t;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t product = qhat * vn[i];
+            t = int64_t(un[i + j]) - borrow - int64_t(product & 0xFFFFFFFF);
+            un[i + j] = static_cast<uint32_t>(t);
+            borrow = int64_t(product >> 32) - (t >> 32);
+        }
+        t = int64_t(un[j + n]) - borrow;
+        un[j + n] = static_cast<uint32_t>(t);
+
+        // Estimate one too large: add the divisor back
+        if (t < 0) {
+            qhat--;
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; i++) {
+                uint64_t sum = uint64_t(un[i + j]) + vn[i] + carry;
+                un[i + j] = static_cast<uint32_t>(sum);
+                carry = sum >> 32;
+            }
+            un[j + n] += static_cast<uint32_t>(carry);
+        }
+        q[j] = static_cast<uint32_t>(qhat);
+    }
+    trim(q);
+
+    r.assign(n, 0);
+    for (size_t i = 0; i < n; i++) {
+        r[i] = (un[i] >> shift) | (shift ? un[i + 1] << (32 - shift) : 0);
+    }
+    trim(r);
+}
+
+}
+
+// ============================================================================
+// BigInt
+// ============================================================================
+
+BigInt::BigInt(int64_t value) : negative_(value < 0) {
+    uint64_t magnitude = negative_ ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    limbs_ = {static_cast<uint32_t>(magnitude), static_cast<uint32_t>(magnitude >> 32)};
+    trim();
+}
+
+BigInt BigInt::from_string(std::string_view text) {
+    std::string_view digits = text;
+    bool negative = false;
+    if (!digits.empty() && (digits[0] == '-' || digits[0] == '+')) {
+        negative = digits[0] == '-';
+        digits.remove_prefix(1);
+    }
+    if (digits.empty() || !std::all_of(digits.begin(), digits.end(),
+                                       [](char c) { return c >= '0' && c <= '9'; })) {
+        throw std::runtime_error("ValueError: invalid literal for int() with base 10: '" +
+                                 std::string(text) + "'");
+    }
+
+    // Nine digits at a time fit a limb
+    BigInt result;
+    for (size_t pos = 0; pos < digits.size(); pos += 9) {
+        size_t len = std::min<size_t>(9, digits.size() - pos);
+        uint32_t chunk = 0, scale = 1;
+        for (size_t i = 0; i < len; i++) {
+            chunk = chunk * 10 + (digits[pos + i] - '0');
+            scale *= 10;
+        }
+        mul_add_small(result.limbs_, scale, chunk);
+    }
+    result.trim();
+    result.negative_ = negative && !result.is_zero();
+    return result;
+}
+
+void BigInt::trim() {
+    aithon::runtime::trim(limbs_);
+    if (limbs_.empty()) negative_ = false;
+}
+
+bool BigInt::fits_int64() const {
+    if (limbs_.size() > 2) return false;
+    uint64_t magnitude = 0;
+    for (size_t i = limbs_.size(); i-- > 0;) magnitude = (magnitude << 32) | limbs_[i];
+    return magnitude <= (negative_ ? uint64_t(1) << 63 : uint64_t(INT64_MAX));
+}
+
+int64_t BigInt::to_int64() const {
+    uint64_t magnitude = 0;
+    for (size_t i = limbs_.size(); i-- > 0;) magnitude = (magnitude << 32) | limbs_[i];
+    return static_cast<int64_t>(negative_ ? 0 - magnitude : magnitude);
+}
+
+double BigInt::to_double() const {
+    size_t bits = limbs_.size() * 32 - (limbs_.empty() ? 0 : std::countl_zero(limbs_.back()));
+    double magnitude;
+    if (bits <= 64) {
+        uint64_t value = 0;
+        for (size_t i = limbs_.size(); i-- > 0;) value = (value << 32) | limbs_[i];
+        magnitude = static_cast<double>(value);
+    } else {
+        // The top 64 bits, with a sticky low bit for anything below them,
+        // round the same way the whole value would
+        size_t shift = bits - 64, limb = shift / 32, offset = shift % 32;
+        unsigned __int128 window = 0;
+        for (size_t k = 3; k-- > 0;) {
+            window = (window << 32) | (limb + k < limbs_.size() ? limbs_[limb + k] : 0);
+        }
+        uint64_t top = static_cast<uint64_t>(window >> offset);
+        bool sticky = (limbs_[limb] & ((uint32_t(1) << offset) - 1)) != 0 ||
+                      std::any_of(limbs_.begin(), limbs_.begin() + limb, [](uint32_t l) { return l != 0; });
+        magnitude = std::ldexp(static_cast<double>(top | (sticky ? 1 : 0)), static_cast<int>(shift));
+    }
+    if (std::isinf(magnitude)) {
+        throw std::runtime_error("OverflowError: int too large to convert to float");
+    }
+    return negative_ ? -magnitude : magnitude;
+}
+
+std::string BigInt::to_string() const {
+    if (is_zero()) return "0";
+
+    // Nine decimal digits per division, least significant chunk first
+    Limbs rest = limbs_;
+    std::vector<uint32_t> chunks;
+    while (!rest.empty()) chunks.push_back(div_small(rest, 1'000'000'000));
+
+    std::string result = negative_ ? "-" : "";
+    result += std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+        std::string chunk = std::to_string(chunks[i]);
+        result.append(9 - chunk.size(), '0');
+        result += chunk;
+    }
+    return result;
+}
+
+int64_t BigInt::hash() const {
+    // Reduced modulo the Mersenne prime 2^61 - 1, like Python's int hash
+    constexpr uint64_t MODULUS = (uint64_t(1) << 61) - 1;
+    uint64_t h = 0;
+    for (size_t i = limbs_.size(); i-- > 0;) {
+        h = static_cast<uint64_t>((((unsigned __int128)h << 32) | limbs_[i]) % MODULUS);
+    }
+    int64_t result = negative_ ? -static_cast<int64_t>(h) : static_cast<int64_t>(h);
+    return result == -1 ? -2 : result;
+}
+
+int BigInt::compare(const BigInt& other) const {
+    if (negative_ != other.negative_) return negative_ ? -1 : 1;
+    int magnitude = compare_magnitude(limbs_, other.limbs_);
+    return negative_ ? -magnitude : magnitude;
+}
+
+BigInt BigInt::operator-() const {
+    BigInt result = *this;
+    result.negative_ = !negative_ && !is_zero();
+    return result;
+}
+
+BigInt operator+(const BigInt& a, const BigInt& b) {
+    BigInt result;
+    if (a.negative_ == b.negative_) {
+        result.limbs_ = add_magnitude(a.limbs_, b.limbs_);
+        result.negative_ = a.negative_;
+    } else if (compare_magnitude(a.limbs_, b.limbs_) >= 0) {
+        result.limbs_ = sub_magnitude(a.limbs_, b.limbs_);
+        result.negative_ = a.negative_;
+    } else {
+        result.limbs_ = sub_magnitude(b.limbs_, a.limbs_);
+        result.negative_ = b.negative_;
+    }
+    result.trim();
+    return result;
+}
+
+BigInt operator-(const BigInt& a, const BigInt& b) {
+    return a + -b;
+}
+
+BigInt operator*(const BigInt& a, const BigInt& b) {
+    BigInt result;
+    if (a.is_zero() || b.is_zero()) return result;
+    result.limbs_.resize(a.limbs_.size() + b.limbs_.size());
+    mul_karatsuba(a.limbs_.data(), a.limbs_.size(), b.limbs_.data(), b.limbs_.size(),
+                  result.limbs_.data());
+    result.negative_ = a.negative_ != b.negative_;
+    result.trim();
+    return result;
+}
+
+BigInt BigInt::mul_schoolbook(const BigInt& a, const BigInt& b) {
+    BigInt result;
+    if (a.is_zero() || b.is_zero()) return result;
+    result.limbs_.resize(a.limbs_.size() + b.limbs_.size());
+    aithon::runtime::mul_schoolbook(a.limbs_.data(), a.limbs_.size(), b.limbs_.data(),
+                                    b.limbs_.size(), result.limbs_.data());
+    result.negative_ = a.negative_ != b.negative_;
+    result.trim();
+    return result;
+}
+
+void BigInt::divmod(const BigInt& a, const BigInt& b, BigInt& quotient, BigInt& remainder) {
+    if (b.is_zero()) {
+        throw std::runtime_error("ZeroDivisionError: integer division or modulo by zero");
+    }
+
+    BigInt q, r;
+    divmod_magnitude(a.limbs_, b.limbs_, q.limbs_, r.limbs_);
+    q.negative_ = a.negative_ != b.negative_;
+    r.negative_ = a.negative_;
+    q.trim();
+    r.trim();
+
+    // Truncated to floored: step the quotient down, the remainder to b's side
+    if (!r.is_zero() && a.negative_ != b.negative_) {
+        q = q - BigInt(1);
+        r = r + b;
+    }
+    quotient = std::move(q);
+    remainder = std::move(r);
+}
+
+BigInt BigInt::pow(uint64_t exponent) const {
+    BigInt result(1), base = *this;
+    while (exponent > 0) {
+        if (exponent & 1) result = result * base;
+        exponent >>= 1;
+        if (exponent > 0) base = base * base;
+    }
+    return result;
+}
+
+}
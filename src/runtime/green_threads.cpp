@@ -31,6 +31,11 @@ GreenThread::GreenThread(int id, size_t heap_size)
     gc_stats_.objects_freed = 0;
     gc_stats_.bytes_freed = 0;
     gc_stats_.total_gc_time = std::chrono::microseconds(0);
+    
+    // Queued message payloads stay live across collections
+    private_heap_->set_root_scanner([this](const ActorHeap::RootVisitor& visit) {
+        mailbox_.for_each([&visit](Message& msg) { visit(&msg.payload); });
+    });
 }
 
 GreenThread::~GreenThread() {
@@ -114,7 +119,8 @@ bool GreenThread::send_message(const Message& msg) {
 Message* GreenThread::receive_message() {
     auto opt_msg = mailbox_.try_dequeue();
     if (opt_msg.has_value()) {
-        Message* msg = static_cast<Message*>(private_heap_->allocate(sizeof(Message)));
+        HeapRoot payload_root(*private_heap_, &opt_msg->payload);
+        Message* msg = static_cast<Message*>(private_heap_->allocate(sizeof(Message), HeapType::MESSAGE));
         if (msg) {
             new (msg) Message(std::move(opt_msg.value()));
             return msg;
@@ -153,8 +159,8 @@ void GreenThread::run_gc() {
 }
 
 void GreenThread::auto_gc_check() {
-    // Run GC if heap is more than 80% full
-    double usage = static_cast<double>(private_heap_->used()) / private_heap_->total();
+    // Run GC if heap is more than 80% of its maximum
+    double usage = static_cast<double>(private_heap_->used()) / private_heap_->max_size();
     if (usage > 0.8) {
         run_gc();
     }
@@ -1,92 +1,498 @@
 #include "../../include/runtime/heap.h"
+#include "../../include/runtime/message.h"
 #include <iostream>
 #include <cstdlib>
+#include <cstddef>
+#include <new>
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <sys/mman.h>
 
 namespace aithon::runtime {
 
-ActorHeap::ActorHeap(size_t size) : total_size_(size), used_size_(0) {
-    heap_start_ = static_cast<uint8_t*>(std::aligned_alloc(8, size));
-    if (!heap_start_) {
+// ============================================================================
+// HeapSegmentPool
+// ============================================================================
+
+HeapSegmentPool& HeapSegmentPool::instance() {
+    static HeapSegmentPool pool;
+    return pool;
+}
+
+HeapSegmentPool::~HeapSegmentPool() {
+    for (auto& [size, segments] : free_segments_) {
+        for (uint8_t* segment : segments) {
+            std::free(segment);
+        }
+    }
+}
+
+uint8_t* HeapSegmentPool::acquire(size_t size) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = free_segments_.find(size);
+        if (it != free_segments_.end() && !it->second.empty()) {
+            uint8_t* segment = it->second.back();
+            it->second.pop_back();
+            cached_bytes_.fetch_sub(size, std::memory_order_relaxed);
+            return segment;
+        }
+    }
+
+    auto* segment = static_cast<uint8_t*>(std::aligned_alloc(SEGMENT_ALIGNMENT, size));
+    if (!segment) {
         throw std::bad_alloc();
     }
-    heap_end_ = heap_start_ + size;
-    allocation_ptr_ = heap_start_;
+    return segment;
+}
+
+void HeapSegmentPool::release(uint8_t* segment, size_t size, bool decommit) {
+    if (!segment) return;
+
+    if (decommit) {
+        // Segments are page aligned and page sized, so this never touches
+        // allocator metadata
+        madvise(segment, size, MADV_DONTNEED);
+    }
+
+    // Only power-of-two segments are worth keeping for reuse
+    if ((size & (size - 1)) == 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& cache = free_segments_[size];
+        if (cache.size() < MAX_CACHED_PER_SIZE) {
+            cache.push_back(segment);
+            cached_bytes_.fetch_add(size, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    std::free(segment);
+}
+
+// ============================================================================
+// Heap type registry
+// ============================================================================
+
+static std::array<HeapTypeInfo, ActorHeap::MAX_TYPES>& type_registry() {
+    static std::array<HeapTypeInfo, ActorHeap::MAX_TYPES> registry = [] {
+        std::array<HeapTypeInfo, ActorHeap::MAX_TYPES> types{};
+        types[HeapType::RAW] = {"raw", {}, false};
+        types[HeapType::MESSAGE] = {"message", {offsetof(Message, payload)}, false};
+        types[HeapType::POINTER_ARRAY] = {"pointer_array", {}, true};
+        return types;
+    }();
+    return registry;
+}
+
+static std::mutex type_registry_mutex;
+static std::atomic<uint32_t> registered_types{HeapType::POINTER_ARRAY + 1};
+
+uint32_t ActorHeap::register_type(const HeapTypeInfo& info) {
+    std::lock_guard<std::mutex> lock(type_registry_mutex);
+    uint32_t type_id = registered_types.load(std::memory_order_relaxed);
+    if (type_id >= MAX_TYPES) {
+        throw std::runtime_error("Too many heap types registered");
+    }
+    type_registry()[type_id] = info;
+    registered_types.store(type_id + 1, std::memory_order_release);
+    return type_id;
+}
+
+const HeapTypeInfo& ActorHeap::type_info(uint32_t type_id) {
+    // Unknown ids read as an empty layout, i.e. untraced bytes
+    return type_registry()[type_id < MAX_TYPES ? type_id : HeapType::RAW];
+}
+
+// ============================================================================
+// ActorHeap
+// ============================================================================
+
+static size_t round_up_pow2(size_t n) {
+    size_t p = HeapSegmentPool::SEGMENT_ALIGNMENT;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+ActorHeap::ActorHeap(size_t max_size, size_t initial_size)
+    : current_(0),
+      initial_size_(round_up_pow2(initial_size)),
+      max_size_(max_size),
+      total_size_(0),
+      used_size_(0),
+      peak_size_(0),
+      growth_events_(0),
+      shrink_events_(0),
+      collections_(0),
+      bytes_reclaimed_(0),
+      live_after_gc_(0),
+      last_pause_us_(0),
+      max_pause_us_(0),
+      total_pause_us_(0) {
+    // Segments are reserved lazily - an actor that never allocates holds
+    // no heap memory at all
 }
 
 ActorHeap::~ActorHeap() {
-    std::free(heap_start_);
+    for (auto& segment : segments_) {
+        HeapSegmentPool::instance().release(segment.start, segment.size());
+    }
 }
 
-void* ActorHeap::allocate(size_t size) {
-    // Align to 8 bytes
-    size = (size + 7) & ~7;
+void* ActorHeap::allocate(size_t size, uint32_t type_id) {
+    // Align to 8 bytes; empty objects still get a word so they have an address
+    size = (std::max<size_t>(size, 1) + 7) & ~size_t(7);
     size_t total = sizeof(ObjectHeader) + size;
-    
-    if (allocation_ptr_ + total > heap_end_) {
-        // Try GC first
-        collect_garbage();
-        
-        if (allocation_ptr_ + total > heap_end_) {
-            return nullptr;  // Out of memory even after GC
+
+    void* result = allocate_without_gc(size, total, type_id);
+    if (result) {
+        return result;
+    }
+
+    // At the per-actor maximum - try GC first
+    collect_garbage();
+    return allocate_without_gc(size, total, type_id);
+}
+
+void* ActorHeap::try_allocate(size_t size, uint32_t type_id) {
+    size = (std::max<size_t>(size, 1) + 7) & ~size_t(7);
+    return allocate_without_gc(size, sizeof(ObjectHeader) + size, type_id);
+}
+
+void* ActorHeap::allocate_without_gc(size_t size, size_t total, uint32_t type_id) {
+    // Fast path: bump in the current segment
+    if (current_ < segments_.size()) {
+        Segment& segment = segments_[current_];
+        if (segment.alloc_ptr + total <= segment.end) {
+            return bump(segment, size, total, type_id);
         }
     }
-    
-    ObjectHeader* header = reinterpret_cast<ObjectHeader*>(allocation_ptr_);
+
+    // Move on to a later segment that has room, or grow the chain
+    for (size_t i = current_ + 1; i < segments_.size(); ++i) {
+        if (segments_[i].alloc_ptr + total <= segments_[i].end) {
+            current_ = i;
+            return bump(segments_[i], size, total, type_id);
+        }
+    }
+
+    if (grow(total)) {
+        return bump(segments_[current_], size, total, type_id);
+    }
+
+    return nullptr;
+}
+
+void* ActorHeap::bump(Segment& segment, size_t size, size_t total, uint32_t type_id) {
+    ObjectHeader* header = reinterpret_cast<ObjectHeader*>(segment.alloc_ptr);
     header->size = size;
+    header->forward = nullptr;
+    header->type_id = type_id;
     header->marked = false;
-    
-    void* result = allocation_ptr_ + sizeof(ObjectHeader);
-    allocation_ptr_ += total;
+
+    void* result = segment.alloc_ptr + sizeof(ObjectHeader);
+    segment.alloc_ptr += total;
     used_size_ += total;
-    
+
     return result;
 }
 
+bool ActorHeap::grow(size_t min_bytes) {
+    // Double the last segment, but never below what the request needs
+    size_t next_size = segments_.empty() ? initial_size_ : segments_.back().size() * 2;
+    next_size = std::max(next_size, round_up_pow2(min_bytes));
+
+    if (total_size_ + next_size > max_size_) {
+        // Fall back to whatever budget is left, page rounded
+        size_t remaining = (max_size_ - std::min(max_size_, total_size_)) &
+                           ~(HeapSegmentPool::SEGMENT_ALIGNMENT - 1);
+        if (remaining < min_bytes) {
+            return false;
+        }
+        next_size = remaining;
+    }
+
+    uint8_t* start = HeapSegmentPool::instance().acquire(next_size);
+    segments_.push_back(Segment{start, start + next_size, start});
+    current_ = segments_.size() - 1;
+
+    total_size_ += next_size;
+    peak_size_ = std::max(peak_size_, total_size_);
+    growth_events_++;
+
+    return true;
+}
+
+void ActorHeap::release_segments_from(size_t index, bool decommit) {
+    while (segments_.size() > index) {
+        Segment& segment = segments_.back();
+        total_size_ -= segment.size();
+        HeapSegmentPool::instance().release(segment.start, segment.size(), decommit);
+        segments_.pop_back();
+        shrink_events_++;
+    }
+
+    if (current_ >= segments_.size()) {
+        current_ = segments_.empty() ? 0 : segments_.size() - 1;
+    }
+}
+
+void ActorHeap::release_empty_segments() {
+    // Give trailing empty segments back to the pool, keeping the first one
+    while (segments_.size() > 1 && segments_.back().used() == 0) {
+        Segment& segment = segments_.back();
+        total_size_ -= segment.size();
+        HeapSegmentPool::instance().release(segment.start, segment.size());
+        segments_.pop_back();
+        shrink_events_++;
+    }
+
+    if (current_ >= segments_.size()) {
+        current_ = segments_.empty() ? 0 : segments_.size() - 1;
+    }
+}
+
+void ActorHeap::remove_root(void** slot) {
+    // Roots are usually scoped, so the most recent one is the likely match
+    for (size_t i = roots_.size(); i-- > 0;) {
+        if (roots_[i] == slot) {
+            roots_.erase(roots_.begin() + i);
+            return;
+        }
+    }
+}
+
+ActorHeap::ObjectHeader* ActorHeap::header_of(void* ptr) const {
+    // Heap pointers address an object's payload; anything else (null,
+    // memory owned elsewhere) is not ours to trace
+    auto* p = static_cast<uint8_t*>(ptr);
+    for (const Segment& segment : segments_) {
+        if (p >= segment.start + sizeof(ObjectHeader) && p < segment.alloc_ptr) {
+            return reinterpret_cast<ObjectHeader*>(p - sizeof(ObjectHeader));
+        }
+    }
+    return nullptr;
+}
+
+std::vector<void**> ActorHeap::gather_roots() {
+    std::vector<void**> roots(roots_.begin(), roots_.end());
+    if (root_scanner_) {
+        root_scanner_([&roots](void** slot) { roots.push_back(slot); });
+    }
+
+    // A slot reported twice must only be forwarded once
+    std::sort(roots.begin(), roots.end());
+    roots.erase(std::unique(roots.begin(), roots.end()), roots.end());
+    return roots;
+}
+
+template<typename Fn>
+void ActorHeap::for_each_field(ObjectHeader* header, Fn&& fn) {
+    const HeapTypeInfo& info = type_info(header->type_id);
+    uint8_t* payload = reinterpret_cast<uint8_t*>(header + 1);
+
+    if (info.all_pointers) {
+        for (size_t offset = 0; offset + sizeof(void*) <= header->size; offset += sizeof(void*)) {
+            fn(reinterpret_cast<void**>(payload + offset));
+        }
+        return;
+    }
+
+    for (uint32_t offset : info.pointer_offsets) {
+        if (offset + sizeof(void*) <= header->size) {
+            fn(reinterpret_cast<void**>(payload + offset));
+        }
+    }
+}
+
+void ActorHeap::mark_object(void* ptr, size_t& live_bytes) {
+    if (!ptr) return;
+
+    ObjectHeader* header = header_of(ptr);
+    if (header && !header->marked) {
+        header->marked = true;
+        live_bytes += sizeof(ObjectHeader) + header->size;
+        mark_stack_.push_back(header);
+    }
+}
+
+size_t ActorHeap::mark_from_roots(const std::vector<void**>& roots) {
+    size_t live_bytes = 0;
+    for (void** slot : roots) {
+        mark_object(*slot, live_bytes);
+    }
+
+    // Explicit stack instead of recursion - long object chains are common
+    while (!mark_stack_.empty()) {
+        ObjectHeader* header = mark_stack_.back();
+        mark_stack_.pop_back();
+        for_each_field(header, [this, &live_bytes](void** field) {
+            mark_object(*field, live_bytes);
+        });
+    }
+    return live_bytes;
+}
+
+void ActorHeap::update_slot(void** slot) const {
+    ObjectHeader* header = header_of(*slot);
+    if (header && header->marked) {
+        *slot = header->forward;
+    }
+}
+
 void ActorHeap::collect_garbage() {
-    // Simple mark-and-compact GC
-    // In a real implementation, this would:
-    // 1. Mark all reachable objects from roots
-    // 2. Compact heap by moving live objects
-    // 3. Update all pointers
-    
-    // For now, just compact without proper marking
-    compact_heap();
-}
-
-void ActorHeap::compact_heap() {
-    uint8_t* scan = heap_start_;
-    uint8_t* new_allocation_ptr = heap_start_;
+    collect(false);
+}
+
+size_t ActorHeap::hibernate() {
+    size_t before = total_size_;
+    collect(true);
+    return before - total_size_;
+}
+
+void ActorHeap::collect(bool hibernating) {
+    // Precise mark-compact:
+    // 1. Mark all objects reachable from the roots, following type info
+    // 2. Compute forwarding addresses and update every reference
+    // 3. Slide live objects down and give empty segments back
+    auto start = std::chrono::steady_clock::now();
+    size_t before = used_size_;
+
+    std::vector<void**> roots = gather_roots();
+    size_t live_bytes = mark_from_roots(roots);
+
+    if (hibernating && live_bytes > 0) {
+        // Put a segment just big enough for the survivors at the front of
+        // the chain; compaction then moves everything into it
+        size_t target = round_up_pow2(live_bytes);
+        if (target < total_size_) {
+            uint8_t* segment = HeapSegmentPool::instance().acquire(target);
+            segments_.insert(segments_.begin(), Segment{segment, segment + target, segment});
+            total_size_ += target;
+            peak_size_ = std::max(peak_size_, total_size_);
+        }
+    }
+
+    compact_heap(roots);
+
+    if (hibernating) {
+        // Survivors are packed up to the current segment; the rest is empty
+        release_segments_from(live_bytes > 0 ? current_ + 1 : 0, true);
+    } else {
+        release_empty_segments();
+    }
+
+    auto pause = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    collections_++;
+    bytes_reclaimed_ += before - used_size_;
+    live_after_gc_ = used_size_;
+    last_pause_us_ = pause;
+    max_pause_us_ = std::max(max_pause_us_, last_pause_us_);
+    total_pause_us_ += pause;
+}
+
+void ActorHeap::compact_heap(const std::vector<void**>& roots) {
+    if (segments_.empty()) return;
+
+    // Pass 1: assign forwarding addresses. Survivors slide towards the
+    // front of the segment chain; objects never span segments, so one
+    // that does not fit in the rest of a segment moves on to the next.
+    std::vector<uint8_t*> new_alloc_ptrs;
+    new_alloc_ptrs.reserve(segments_.size());
+    for (const Segment& segment : segments_) {
+        new_alloc_ptrs.push_back(segment.start);
+    }
+
+    size_t dst_index = 0;
+    uint8_t* dst = segments_[0].start;
     size_t new_used_size = 0;
-    
-    while (scan < allocation_ptr_) {
-        ObjectHeader* header = reinterpret_cast<ObjectHeader*>(scan);
-        size_t obj_size = sizeof(ObjectHeader) + header->size;
-        
-        if (header->marked) {
-            // Keep this object - move it if necessary
-            if (scan != new_allocation_ptr) {
-                std::memmove(new_allocation_ptr, scan, obj_size);
+
+    for (Segment& segment : segments_) {
+        for (uint8_t* scan = segment.start; scan < segment.alloc_ptr;) {
+            ObjectHeader* header = reinterpret_cast<ObjectHeader*>(scan);
+            size_t obj_size = sizeof(ObjectHeader) + header->size;
+
+            if (header->marked) {
+                while (dst + obj_size > segments_[dst_index].end) {
+                    new_alloc_ptrs[dst_index] = dst;
+                    dst = segments_[++dst_index].start;
+                }
+                header->forward = dst + sizeof(ObjectHeader);
+                dst += obj_size;
+                new_used_size += obj_size;
+            }
+
+            scan += obj_size;
+        }
+    }
+    new_alloc_ptrs[dst_index] = dst;
+
+    // Pass 2: point roots and traced fields at the new addresses
+    for (void** slot : roots) {
+        update_slot(slot);
+    }
+    for (Segment& segment : segments_) {
+        for (uint8_t* scan = segment.start; scan < segment.alloc_ptr;) {
+            ObjectHeader* header = reinterpret_cast<ObjectHeader*>(scan);
+            if (header->marked) {
+                for_each_field(header, [this](void** field) { update_slot(field); });
             }
-            new_allocation_ptr += obj_size;
-            new_used_size += obj_size;
-            
-            // Reset mark for next GC
-            reinterpret_cast<ObjectHeader*>(new_allocation_ptr - obj_size)->marked = false;
+            scan += sizeof(ObjectHeader) + header->size;
         }
-        
-        scan += obj_size;
     }
-    
-    allocation_ptr_ = new_allocation_ptr;
+
+    // Pass 3: move. A destination never lies past its source, so the
+    // header of the next object to scan is never overwritten.
+    for (Segment& segment : segments_) {
+        for (uint8_t* scan = segment.start; scan < segment.alloc_ptr;) {
+            ObjectHeader* header = reinterpret_cast<ObjectHeader*>(scan);
+            size_t obj_size = sizeof(ObjectHeader) + header->size;
+
+            if (header->marked) {
+                uint8_t* target = header->forward - sizeof(ObjectHeader);
+                if (target != scan) {
+                    std::memmove(target, scan, obj_size);
+                }
+
+                // Reset mark for next GC
+                reinterpret_cast<ObjectHeader*>(target)->marked = false;
+            }
+
+            scan += obj_size;
+        }
+    }
+
+    for (size_t i = 0; i < segments_.size(); ++i) {
+        segments_[i].alloc_ptr = new_alloc_ptrs[i];
+    }
+
+    current_ = dst_index;
     used_size_ = new_used_size;
 }
 
 void ActorHeap::dump_stats() const {
     std::cout << "Heap Stats:\n";
-    std::cout << "  Total: " << total_size_ << " bytes\n";
+    std::cout << "  Reserved: " << total_size_ << " bytes in "
+              << segments_.size() << " segment(s)\n";
     std::cout << "  Used: " << used_size_ << " bytes\n";
     std::cout << "  Available: " << (total_size_ - used_size_) << " bytes\n";
-    std::cout << "  Usage: " << (100.0 * used_size_ / total_size_) << "%\n";
+    std::cout << "  Max: " << max_size_ << " bytes\n";
+    std::cout << "  Peak: " << peak_size_ << " bytes\n";
+    std::cout << "  Growth events: " << growth_events_ << "\n";
+    std::cout << "  Shrink events: " << shrink_events_ << "\n";
+    std::cout << "  Collections: " << collections_ << "\n";
+    std::cout << "  Bytes reclaimed: " << bytes_reclaimed_ << "\n";
+    if (collections_ > 0) {
+        std::cout << "  GC pause: last " << last_pause_us_ << "us, max "
+                  << max_pause_us_ << "us, avg "
+                  << (total_pause_us_ / collections_) << "us\n";
+    }
+    if (total_size_ > 0) {
+        std::cout << "  Usage: " << (100.0 * used_size_ / total_size_) << "%\n";
+    }
 }
 
-} // namespace pyvm::runtime
\ No newline at end of file
+} // namespace pyvm::runtime
@@ -0,0 +1,691 @@
+#include "../../include/runtime/list_kernels.h"
+#include <algorithm>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define AITHON_LIST_KERNELS_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define AITHON_LIST_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace aithon::runtime {
+
+// ============================================================================
+// Scalar - also finishes the tail the vector loops leave
+// ============================================================================
+
+namespace scalar {
+
+static int64_t sum_i64(const int64_t* data, int64_t n, bool* overflow) {
+    int64_t sum = 0;
+    bool over = false;
+    for (int64_t i = 0; i < n; i++) over |= __builtin_add_overflow(sum, data[i], &sum);
+    if (over) *overflow = true;
+    return sum;
+}
+
+// Adds the lanes' total, and the tail's, to sum
+static int64_t finish_sum_i64(const int64_t* lanes, int64_t count, const int64_t* tail,
+                              int64_t n, bool* overflow) {
+    int64_t sum = sum_i64(lanes, count, overflow);
+    if (__builtin_add_overflow(sum, sum_i64(tail, n, overflow), &sum)) *overflow = true;
+    return sum;
+}
+
+static double sum_f64(const double* data, int64_t n) {
+    double sum = 0.0;
+    for (int64_t i = 0; i < n; i++) sum += data[i];
+    return sum;
+}
+
+static int64_t min_i64(const int64_t* data, int64_t n) {
+    int64_t result = data[0];
+    for (int64_t i = 1; i < n; i++) result = std::min(result, data[i]);
+    return result;
+}
+
+static int64_t max_i64(const int64_t* data, int64_t n) {
+    int64_t result = data[0];
+    for (int64_t i = 1; i < n; i++) result = std::max(result, data[i]);
+    return result;
+}
+
+static double min_f64(const double* data, int64_t n) {
+    double result = data[0];
+    for (int64_t i = 1; i < n; i++) result = std::min(result, data[i]);
+    return result;
+}
+
+static double max_f64(const double* data, int64_t n) {
+    double result = data[0];
+    for (int64_t i = 1; i < n; i++) result = std::max(result, data[i]);
+    return result;
+}
+
+static int64_t count_i64(const int64_t* data, int64_t n, int64_t value) {
+    int64_t count = 0;
+    for (int64_t i = 0; i < n; i++) count += data[i] == value;
+    return count;
+}
+
+static int64_t count_f64(const double* data, int64_t n, double value) {
+    int64_t count = 0;
+    for (int64_t i = 0; i < n; i++) count += data[i] == value;
+    return count;
+}
+
+static int64_t find_i64(const int64_t* data, int64_t n, int64_t value) {
+    for (int64_t i = 0; i < n; i++) {
+        if (data[i] == value) return i;
+    }
+    return -1;
+}
+
+static int64_t find_f64(const double* data, int64_t n, double value) {
+    for (int64_t i = 0; i < n; i++) {
+        if (data[i] == value) return i;
+    }
+    return -1;
+}
+
+static void add_i64(const int64_t* data, int64_t n, int64_t value, int64_t* out) {
+    for (int64_t i = 0; i < n; i++) {
+        out[i] = static_cast<int64_t>(static_cast<uint64_t>(data[i]) + static_cast<uint64_t>(value));
+    }
+}
+
+static void mul_i64(const int64_t* data, int64_t n, int64_t value, int64_t* out) {
+    for (int64_t i = 0; i < n; i++) {
+        out[i] = static_cast<int64_t>(static_cast<uint64_t>(data[i]) * static_cast<uint64_t>(value));
+    }
+}
+
+static void add_f64(const double* data, int64_t n, double value, double* out) {
+    for (int64_t i = 0; i < n; i++) out[i] = data[i] + value;
+}
+
+static void mul_f64(const double* data, int64_t n, double value, double* out) {
+    for (int64_t i = 0; i < n; i++) out[i] = data[i] * value;
+}
+
+static const ListKernels kernels = {
+    "scalar",
+    sum_i64, sum_f64,
+    min_i64, max_i64, min_f64, max_f64,
+    count_i64, count_f64,
+    find_i64, find_f64,
+    add_i64, mul_i64, add_f64, mul_f64,
+};
+
+}
+
+#if AITHON_LIST_KERNELS_X86
+
+// ============================================================================
+// AVX2 - four lanes. No 64-bit min, max or multiply: built from compares
+// and 32-bit multiplies.
+// ============================================================================
+
+namespace avx2 {
+
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 static int64_t hsum(__m256i v) {
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return static_cast<int64_t>(static_cast<uint64_t>(_mm_cvtsi128_si64(sum)) +
+                                static_cast<uint64_t>(_mm_extract_epi64(sum, 1)));
+}
+
+AVX2 static double hsum(__m256d v) {
+    __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+}
+
+// acc + v, with the sign bit of overflowed set in lanes that overflowed
+AVX2 static __m256i add_checked(__m256i acc, __m256i v, __m256i& overflowed) {
+    __m256i sum = _mm256_add_epi64(acc, v);
+    __m256i lane = _mm256_and_si256(_mm256_xor_si256(acc, sum), _mm256_xor_si256(v, sum));
+    overflowed = _mm256_or_si256(overflowed, lane);
+    return sum;
+}
+
+AVX2 static int64_t sum_i64(const int64_t* data, int64_t n, bool* overflow) {
+    __m256i a = _mm256_setzero_si256(), b = _mm256_setzero_si256();
+    __m256i overflowed = _mm256_setzero_si256();
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        a = add_checked(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), overflowed);
+        b = add_checked(b, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 4)), overflowed);
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), add_checked(a, b, overflowed));
+    if (_mm256_movemask_pd(_mm256_castsi256_pd(overflowed))) *overflow = true;
+    return scalar::finish_sum_i64(lanes, 4, data + i, n - i, overflow);
+}
+
+AVX2 static double sum_f64(const double* data, int64_t n) {
+    __m256d a = _mm256_setzero_pd(), b = _mm256_setzero_pd();
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        a = _mm256_add_pd(a, _mm256_loadu_pd(data + i));
+        b = _mm256_add_pd(b, _mm256_loadu_pd(data + i + 4));
+    }
+    return hsum(_mm256_add_pd(a, b)) + scalar::sum_f64(data + i, n - i);
+}
+
+template<bool Max>
+AVX2 static int64_t extreme_i64(const int64_t* data, int64_t n) {
+    if (n < 4) return Max ? scalar::max_i64(data, n) : scalar::min_i64(data, n);
+
+    __m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    int64_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i take = Max ? _mm256_cmpgt_epi64(v, best) : _mm256_cmpgt_epi64(best, v);
+        best = _mm256_blendv_epi8(best, v, take);
+    }
+
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), best);
+    int64_t result = Max ? scalar::max_i64(lanes, 4) : scalar::min_i64(lanes, 4);
+    for (; i < n; i++) result = Max ? std::max(result, data[i]) : std::min(result, data[i]);
+    return result;
+}
+
+template<bool Max>
+AVX2 static double extreme_f64(const double* data, int64_t n) {
+    if (n < 4) return Max ? scalar::max_f64(data, n) : scalar::min_f64(data, n);
+
+    __m256d best = _mm256_loadu_pd(data);
+    int64_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(data + i);
+        best = Max ? _mm256_max_pd(best, v) : _mm256_min_pd(best, v);
+    }
+
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, best);
+    double result = Max ? scalar::max_f64(lanes, 4) : scalar::min_f64(lanes, 4);
+    for (; i < n; i++) result = Max ? std::max(result, data[i]) : std::min(result, data[i]);
+    return result;
+}
+
+AVX2 static int64_t min_i64(const int64_t* data, int64_t n) { return extreme_i64<false>(data, n); }
+AVX2 static int64_t max_i64(const int64_t* data, int64_t n) { return extreme_i64<true>(data, n); }
+AVX2 static double min_f64(const double* data, int64_t n) { return extreme_f64<false>(data, n); }
+AVX2 static double max_f64(const double* data, int64_t n) { return extreme_f64<true>(data, n); }
+
+AVX2 static int64_t count_i64(const int64_t* data, int64_t n, int64_t value) {
+    __m256i needle = _mm256_set1_epi64x(value);
+    __m256i count = _mm256_setzero_si256();
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        count = _mm256_sub_epi64(count, _mm256_cmpeq_epi64(v, needle));  // Matches are -1
+    }
+    return hsum(count) + scalar::count_i64(data + i, n - i, value);
+}
+
+AVX2 static int64_t count_f64(const double* data, int64_t n, double value) {
+    __m256d needle = _mm256_set1_pd(value);
+    int64_t count = 0;
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d eq = _mm256_cmp_pd(_mm256_loadu_pd(data + i), needle, _CMP_EQ_OQ);
+        count += __builtin_popcount(_mm256_movemask_pd(eq));
+    }
+    return count + scalar::count_f64(data + i, n - i, value);
+}
+
+AVX2 static int64_t find_i64(const int64_t* data, int64_t n, int64_t value) {
+    __m256i needle = _mm256_set1_epi64x(value);
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, needle)));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    int64_t found = scalar::find_i64(data + i, n - i, value);
+    return found < 0 ? -1 : i + found;
+}
+
+AVX2 static int64_t find_f64(const double* data, int64_t n, double value) {
+    __m256d needle = _mm256_set1_pd(value);
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(data + i), needle, _CMP_EQ_OQ));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    int64_t found = scalar::find_f64(data + i, n - i, value);
+    return found < 0 ? -1 : i + found;
+}
+
+AVX2 static void add_i64(const int64_t* data, int64_t n, int64_t value, int64_t* out) {
+    __m256i k = _mm256_set1_epi64x(value);
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi64(v, k));
+    }
+    scalar::add_i64(data + i, n - i, value, out + i);
+}
+
+// a * b mod 2^64 = lo(a)lo(b) + ((hi(a)lo(b) + lo(a)hi(b)) << 32)
+AVX2 static void mul_i64(const int64_t* data, int64_t n, int64_t value, int64_t* out) {
+    __m256i k = _mm256_set1_epi64x(value);
+    __m256i k_hi = _mm256_srli_epi64(k, 32);
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i low = _mm256_mul_epu32(v, k);
+        __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(v, 32), k),
+                                         _mm256_mul_epu32(v, k_hi));
+        __m256i product = _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), product);
+    }
+    scalar::mul_i64(data + i, n - i, value, out + i);
+}
+
+AVX2 static void add_f64(const double* data, int64_t n, double value, double* out) {
+    __m256d k = _mm256_set1_pd(value);
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(data + i), k));
+    scalar::add_f64(data + i, n - i, value, out + i);
+}
+
+AVX2 static void mul_f64(const double* data, int64_t n, double value, double* out) {
+    __m256d k = _mm256_set1_pd(value);
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(data + i), k));
+    scalar::mul_f64(data + i, n - i, value, out + i);
+}
+
+#undef AVX2
+
+static const ListKernels kernels = {
+    "avx2",
+    sum_i64, sum_f64,
+    min_i64, max_i64, min_f64, max_f64,
+    count_i64, count_f64,
+    find_i64, find_f64,
+    add_i64, mul_i64, add_f64, mul_f64,
+};
+
+}
+
+// ============================================================================
+// AVX-512 - eight lanes, mask registers, native 64-bit min/max/multiply
+// ============================================================================
+
+namespace avx512 {
+
+#define AVX512 __attribute__((target("avx512f,avx512dq")))
+
+// GCC's _mm512_reduce_* and unmasked min/max trip -Wuninitialized, so
+// reductions go through memory and min/max are compare-and-blend
+AVX512 static void spill(__m512i v, int64_t* lanes) { _mm512_storeu_si512(lanes, v); }
+AVX512 static void spill(__m512d v, double* lanes) { _mm512_storeu_pd(lanes, v); }
+
+// acc + v, with the sign bit of overflowed set in lanes that overflowed
+AVX512 static __m512i add_checked(__m512i acc, __m512i v, __m512i& overflowed) {
+    __m512i sum = _mm512_add_epi64(acc, v);
+    __m512i lane = _mm512_and_si512(_mm512_xor_si512(acc, sum), _mm512_xor_si512(v, sum));
+    overflowed = _mm512_or_si512(overflowed, lane);
+    return sum;
+}
+
+AVX512 static int64_t sum_i64(const int64_t* data, int64_t n, bool* overflow) {
+    __m512i a = _mm512_setzero_si512(), b = _mm512_setzero_si512();
+    __m512i overflowed = _mm512_setzero_si512();
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        a = add_checked(a, _mm512_loadu_si512(data + i), overflowed);
+        b = add_checked(b, _mm512_loadu_si512(data + i + 8), overflowed);
+    }
+    for (; i + 8 <= n; i += 8) a = add_checked(a, _mm512_loadu_si512(data + i), overflowed);
+    int64_t lanes[8];
+    spill(add_checked(a, b, overflowed), lanes);
+    if (_mm512_movepi64_mask(overflowed)) *overflow = true;
+    return scalar::finish_sum_i64(lanes, 8, data + i, n - i, overflow);
+}
+
+AVX512 static double sum_f64(const double* data, int64_t n) {
+    __m512d a = _mm512_setzero_pd(), b = _mm512_setzero_pd();
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        a = _mm512_add_pd(a, _mm512_loadu_pd(data + i));
+        b = _mm512_add_pd(b, _mm512_loadu_pd(data + i + 8));
+    }
+    for (; i + 8 <= n; i += 8) a = _mm512_add_pd(a, _mm512_loadu_pd(data + i));
+    double lanes[8];
+    spill(_mm512_add_pd(a, b), lanes);
+    return scalar::sum_f64(lanes, 8) + scalar::sum_f64(data + i, n - i);
+}
+
+AVX512 static int64_t min_i64(const int64_t* data, int64_t n) {
+    if (n < 8) return scalar::min_i64(data, n);
+    __m512i best = _mm512_loadu_si512(data);
+    int64_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        __m512i v = _mm512_loadu_si512(data + i);
+        best = _mm512_mask_mov_epi64(best, _mm512_cmplt_epi64_mask(v, best), v);
+    }
+    int64_t lanes[8];
+    spill(best, lanes);
+    int64_t result = scalar::min_i64(lanes, 8);
+    return i < n ? std::min(result, scalar::min_i64(data + i, n - i)) : result;
+}
+
+AVX512 static int64_t max_i64(const int64_t* data, int64_t n) {
+    if (n < 8) return scalar::max_i64(data, n);
+    __m512i best = _mm512_loadu_si512(data);
+    int64_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        __m512i v = _mm512_loadu_si512(data + i);
+        best = _mm512_mask_mov_epi64(best, _mm512_cmpgt_epi64_mask(v, best), v);
+    }
+    int64_t lanes[8];
+    spill(best, lanes);
+    int64_t result = scalar::max_i64(lanes, 8);
+    return i < n ? std::max(result, scalar::max_i64(data + i, n - i)) : result;
+}
+
+AVX512 static double min_f64(const double* data, int64_t n) {
+    if (n < 8) return scalar::min_f64(data, n);
+    __m512d best = _mm512_loadu_pd(data);
+    int64_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        __m512d v = _mm512_loadu_pd(data + i);
+        best = _mm512_mask_mov_pd(best, _mm512_cmp_pd_mask(v, best, _CMP_LT_OQ), v);
+    }
+    double lanes[8];
+    spill(best, lanes);
+    double result = scalar::min_f64(lanes, 8);
+    return i < n ? std::min(result, scalar::min_f64(data + i, n - i)) : result;
+}
+
+AVX512 static double max_f64(const double* data, int64_t n) {
+    if (n < 8) return scalar::max_f64(data, n);
+    __m512d best = _mm512_loadu_pd(data);
+    int64_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        __m512d v = _mm512_loadu_pd(data + i);
+        best = _mm512_mask_mov_pd(best, _mm512_cmp_pd_mask(v, best, _CMP_GT_OQ), v);
+    }
+    double lanes[8];
+    spill(best, lanes);
+    double result = scalar::max_f64(lanes, 8);
+    return i < n ? std::max(result, scalar::max_f64(data + i, n - i)) : result;
+}
+
+AVX512 static int64_t count_i64(const int64_t* data, int64_t n, int64_t value) {
+    __m512i needle = _mm512_set1_epi64(value);
+    int64_t count = 0;
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        count += __builtin_popcount(_mm512_cmpeq_epi64_mask(_mm512_loadu_si512(data + i), needle));
+    }
+    return count + scalar::count_i64(data + i, n - i, value);
+}
+
+AVX512 static int64_t count_f64(const double* data, int64_t n, double value) {
+    __m512d needle = _mm512_set1_pd(value);
+    int64_t count = 0;
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        count += __builtin_popcount(_mm512_cmp_pd_mask(_mm512_loadu_pd(data + i), needle, _CMP_EQ_OQ));
+    }
+    return count + scalar::count_f64(data + i, n - i, value);
+}
+
+AVX512 static int64_t find_i64(const int64_t* data, int64_t n, int64_t value) {
+    __m512i needle = _mm512_set1_epi64(value);
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __mmask8 mask = _mm512_cmpeq_epi64_mask(_mm512_loadu_si512(data + i), needle);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    int64_t found = scalar::find_i64(data + i, n - i, value);
+    return found < 0 ? -1 : i + found;
+}
+
+AVX512 static int64_t find_f64(const double* data, int64_t n, double value) {
+    __m512d needle = _mm512_set1_pd(value);
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __mmask8 mask = _mm512_cmp_pd_mask(_mm512_loadu_pd(data + i), needle, _CMP_EQ_OQ);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    int64_t found = scalar::find_f64(data + i, n - i, value);
+    return found < 0 ? -1 : i + found;
+}
+
+AVX512 static void add_i64(const int64_t* data, int64_t n, int64_t value, int64_t* out) {
+    __m512i k = _mm512_set1_epi64(value);
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) _mm512_storeu_si512(out + i, _mm512_add_epi64(_mm512_loadu_si512(data + i), k));
+    scalar::add_i64(data + i, n - i, value, out + i);
+}
+
+AVX512 static void mul_i64(const int64_t* data, int64_t n, int64_t value, int64_t* out) {
+    __m512i k = _mm512_set1_epi64(value);
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) _mm512_storeu_si512(out + i, _mm512_mullo_epi64(_mm512_loadu_si512(data + i), k));
+    scalar::mul_i64(data + i, n - i, value, out + i);
+}
+
+AVX512 static void add_f64(const double* data, int64_t n, double value, double* out) {
+    __m512d k = _mm512_set1_pd(value);
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) _mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_loadu_pd(data + i), k));
+    scalar::add_f64(data + i, n - i, value, out + i);
+}
+
+AVX512 static void mul_f64(const double* data, int64_t n, double value, double* out) {
+    __m512d k = _mm512_set1_pd(value);
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) _mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_loadu_pd(data + i), k));
+    scalar::mul_f64(data + i, n - i, value, out + i);
+}
+
+#undef AVX512
+
+static const ListKernels kernels = {
+    "avx512",
+    sum_i64, sum_f64,
+    min_i64, max_i64, min_f64, max_f64,
+    count_i64, count_f64,
+    find_i64, find_f64,
+    add_i64, mul_i64, add_f64, mul_f64,
+};
+
+}
+
+#endif // AITHON_LIST_KERNELS_X86
+
+#if AITHON_LIST_KERNELS_NEON
+
+// ============================================================================
+// NEON - two lanes; part of every AArch64 CPU, so never needs a check.
+// No 64-bit integer multiply: mul_i64 stays scalar.
+// ============================================================================
+
+namespace neon {
+
+// acc + v, with the sign bit of overflowed set in lanes that overflowed
+static int64x2_t add_checked(int64x2_t acc, int64x2_t v, int64x2_t& overflowed) {
+    int64x2_t sum = vaddq_s64(acc, v);
+    overflowed = vorrq_s64(overflowed, vandq_s64(veorq_s64(acc, sum), veorq_s64(v, sum)));
+    return sum;
+}
+
+static int64_t sum_i64(const int64_t* data, int64_t n, bool* overflow) {
+    int64x2_t a = vdupq_n_s64(0), b = vdupq_n_s64(0), overflowed = vdupq_n_s64(0);
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        a = add_checked(a, vld1q_s64(data + i), overflowed);
+        b = add_checked(b, vld1q_s64(data + i + 2), overflowed);
+    }
+    int64_t lanes[2];
+    vst1q_s64(lanes, add_checked(a, b, overflowed));
+    if ((vgetq_lane_s64(overflowed, 0) | vgetq_lane_s64(overflowed, 1)) < 0) *overflow = true;
+    return scalar::finish_sum_i64(lanes, 2, data + i, n - i, overflow);
+}
+
+static double sum_f64(const double* data, int64_t n) {
+    float64x2_t a = vdupq_n_f64(0.0), b = vdupq_n_f64(0.0);
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        a = vaddq_f64(a, vld1q_f64(data + i));
+        b = vaddq_f64(b, vld1q_f64(data + i + 2));
+    }
+    return vaddvq_f64(vaddq_f64(a, b)) + scalar::sum_f64(data + i, n - i);
+}
+
+template<bool Max>
+static int64_t extreme_i64(const int64_t* data, int64_t n) {
+    if (n < 2) return data[0];
+    int64x2_t best = vld1q_s64(data);
+    int64_t i = 2;
+    for (; i + 2 <= n; i += 2) {
+        int64x2_t v = vld1q_s64(data + i);
+        uint64x2_t take = Max ? vcgtq_s64(v, best) : vcltq_s64(v, best);
+        best = vbslq_s64(take, v, best);
+    }
+    int64_t a = vgetq_lane_s64(best, 0), b = vgetq_lane_s64(best, 1);
+    int64_t result = Max ? std::max(a, b) : std::min(a, b);
+    for (; i < n; i++) result = Max ? std::max(result, data[i]) : std::min(result, data[i]);
+    return result;
+}
+
+template<bool Max>
+static double extreme_f64(const double* data, int64_t n) {
+    if (n < 2) return data[0];
+    float64x2_t best = vld1q_f64(data);
+    int64_t i = 2;
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t v = vld1q_f64(data + i);
+        best = Max ? vmaxq_f64(best, v) : vminq_f64(best, v);
+    }
+    double result = Max ? vmaxvq_f64(best) : vminvq_f64(best);
+    for (; i < n; i++) result = Max ? std::max(result, data[i]) : std::min(result, data[i]);
+    return result;
+}
+
+static int64_t min_i64(const int64_t* data, int64_t n) { return extreme_i64<false>(data, n); }
+static int64_t max_i64(const int64_t* data, int64_t n) { return extreme_i64<true>(data, n); }
+static double min_f64(const double* data, int64_t n) { return extreme_f64<false>(data, n); }
+static double max_f64(const double* data, int64_t n) { return extreme_f64<true>(data, n); }
+
+static int64_t count_i64(const int64_t* data, int64_t n, int64_t value) {
+    int64x2_t needle = vdupq_n_s64(value);
+    uint64x2_t count = vdupq_n_u64(0);
+    int64_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        count = vsubq_u64(count, vceqq_s64(vld1q_s64(data + i), needle));  // Matches are all ones
+    }
+    return static_cast<int64_t>(vaddvq_u64(count)) + scalar::count_i64(data + i, n - i, value);
+}
+
+static int64_t count_f64(const double* data, int64_t n, double value) {
+    float64x2_t needle = vdupq_n_f64(value);
+    uint64x2_t count = vdupq_n_u64(0);
+    int64_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        count = vsubq_u64(count, vceqq_f64(vld1q_f64(data + i), needle));
+    }
+    return static_cast<int64_t>(vaddvq_u64(count)) + scalar::count_f64(data + i, n - i, value);
+}
+
+static int64_t find_i64(const int64_t* data, int64_t n, int64_t value) {
+    int64x2_t needle = vdupq_n_s64(value);
+    int64_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        uint64x2_t eq = vceqq_s64(vld1q_s64(data + i), needle);
+        if (vgetq_lane_u64(eq, 0)) return i;
+        if (vgetq_lane_u64(eq, 1)) return i + 1;
+    }
+    return i < n && data[i] == value ? i : -1;
+}
+
+static int64_t find_f64(const double* data, int64_t n, double value) {
+    float64x2_t needle = vdupq_n_f64(value);
+    int64_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        uint64x2_t eq = vceqq_f64(vld1q_f64(data + i), needle);
+        if (vgetq_lane_u64(eq, 0)) return i;
+        if (vgetq_lane_u64(eq, 1)) return i + 1;
+    }
+    return i < n && data[i] == value ? i : -1;
+}
+
+static void add_i64(const int64_t* data, int64_t n, int64_t value, int64_t* out) {
+    int64x2_t k = vdupq_n_s64(value);
+    int64_t i = 0;
+    for (; i + 2 <= n; i += 2) vst1q_s64(out + i, vaddq_s64(vld1q_s64(data + i), k));
+    scalar::add_i64(data + i, n - i, value, out + i);
+}
+
+static void add_f64(const double* data, int64_t n, double value, double* out) {
+    float64x2_t k = vdupq_n_f64(value);
+    int64_t i = 0;
+    for (; i + 2 <= n; i += 2) vst1q_f64(out + i, vaddq_f64(vld1q_f64(data + i), k));
+    scalar::add_f64(data + i, n - i, value, out + i);
+}
+
+static void mul_f64(const double* data, int64_t n, double value, double* out) {
+    float64x2_t k = vdupq_n_f64(value);
+    int64_t i = 0;
+    for (; i + 2 <= n; i += 2) vst1q_f64(out + i, vmulq_f64(vld1q_f64(data + i), k));
+    scalar::mul_f64(data + i, n - i, value, out + i);
+}
+
+static const ListKernels kernels = {
+    "neon",
+    sum_i64, sum_f64,
+    min_i64, max_i64, min_f64, max_f64,
+    count_i64, count_f64,
+    find_i64, find_f64,
+    add_i64, scalar::mul_i64, add_f64, mul_f64,
+};
+
+}
+
+#endif // AITHON_LIST_KERNELS_NEON
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+const ListKernels* list_kernels_for(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SCALAR:
+            return &scalar::kernels;
+#if AITHON_LIST_KERNELS_NEON
+        case SimdLevel::NEON:
+            return &neon::kernels;
+#endif
+#if AITHON_LIST_KERNELS_X86
+        case SimdLevel::AVX2:
+            return __builtin_cpu_supports("avx2") ? &avx2::kernels : nullptr;
+        case SimdLevel::AVX512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")
+                ? &avx512::kernels : nullptr;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+const ListKernels& list_kernels() {
+    static const ListKernels& best = [] () -> const ListKernels& {
+        for (SimdLevel level : {SimdLevel::AVX512, SimdLevel::AVX2, SimdLevel::NEON}) {
+            if (const ListKernels* kernels = list_kernels_for(level)) return *kernels;
+        }
+        return scalar::kernels;
+    }();
+    return best;
+}
+
+}
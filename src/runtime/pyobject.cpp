@@ -1,9 +1,27 @@
 #include "runtime/pyobject.h"
 #include <sstream>
 #include <cmath>
+#include <cstring>
+#include <atomic>
 
 namespace aithon::runtime {
 
+// count copies of text, doubling what is already written rather than
+// appending text count times
+static std::string repeat(std::string_view text, int64_t count) {
+    if (count <= 0 || text.empty()) return {};
+
+    std::string result(text.size() * count, '\0');
+    std::memcpy(result.data(), text.data(), text.size());
+    size_t filled = text.size();
+    while (filled < result.size()) {
+        size_t chunk = std::min(filled, result.size() - filled);
+        std::memcpy(result.data() + filled, result.data(), chunk);
+        filled += chunk;
+    }
+    return result;
+}
+
 // ============================================================================
 // PyObject Base Implementation
 // ============================================================================
@@ -144,42 +162,87 @@ PyObject* PyBool::eq(PyObject* other) {
 // PyInt Implementation
 // ============================================================================
 
+PyInt::PyInt(BigInt value) : PyObject(PyType::INT), value_(0) {
+    if (value.fits_int64()) {
+        value_ = value.to_int64();
+    } else {
+        big_ = std::make_unique<BigInt>(std::move(value));
+    }
+}
+
+int64_t PyInt::as_index() const {
+    if (big_) {
+        throw std::runtime_error("IndexError: cannot fit 'int' into an index-sized integer");
+    }
+    return value_;
+}
+
+// A sequence repeat count: a negative one repeats nothing, as in Python
+static int64_t repeat_count(const PyInt* count) {
+    if (!count->is_big()) return count->value();
+    if (count->big().is_negative()) return 0;
+    throw std::runtime_error("OverflowError: cannot fit 'int' into an index-sized integer");
+}
+
+// Negative, zero or positive, in int64 when both fit
+static int compare_ints(const PyInt* a, const PyInt* b) {
+    if (!a->is_big() && !b->is_big()) {
+        return (a->value() > b->value()) - (a->value() < b->value());
+    }
+    return a->to_big().compare(b->to_big());
+}
+
+// Arithmetic stays in int64 unless an operand is a BigInt already or the
+// checked operation overflows; only then is it redone as a BigInt
+
 PyObject* PyInt::add(PyObject* other) {
     if (other->is_int()) {
-        return new PyInt(value_ + static_cast<PyInt*>(other)->value());
+        auto* rhs = static_cast<PyInt*>(other);
+        int64_t result;
+        if (!big_ && !rhs->big_ && !__builtin_add_overflow(value_, rhs->value_, &result)) {
+            return new PyInt(result);
+        }
+        return new PyInt(to_big() + rhs->to_big());
     } else if (other->is_float()) {
-        return new PyFloat(value_ + static_cast<PyFloat*>(other)->value());
+        return new PyFloat(as_double() + static_cast<PyFloat*>(other)->value());
     }
     return PyObject::add(other);
 }
 
 PyObject* PyInt::sub(PyObject* other) {
     if (other->is_int()) {
-        return new PyInt(value_ - static_cast<PyInt*>(other)->value());
+        auto* rhs = static_cast<PyInt*>(other);
+        int64_t result;
+        if (!big_ && !rhs->big_ && !__builtin_sub_overflow(value_, rhs->value_, &result)) {
+            return new PyInt(result);
+        }
+        return new PyInt(to_big() - rhs->to_big());
     } else if (other->is_float()) {
-        return new PyFloat(value_ - static_cast<PyFloat*>(other)->value());
+        return new PyFloat(as_double() - static_cast<PyFloat*>(other)->value());
     }
     return PyObject::sub(other);
 }
 
 PyObject* PyInt::mul(PyObject* other) {
     if (other->is_int()) {
-        return new PyInt(value_ * static_cast<PyInt*>(other)->value());
+        auto* rhs = static_cast<PyInt*>(other);
+        int64_t result;
+        if (!big_ && !rhs->big_ && !__builtin_mul_overflow(value_, rhs->value_, &result)) {
+            return new PyInt(result);
+        }
+        return new PyInt(to_big() * rhs->to_big());
     } else if (other->is_float()) {
-        return new PyFloat(value_ * static_cast<PyFloat*>(other)->value());
+        return new PyFloat(as_double() * static_cast<PyFloat*>(other)->value());
     } else if (other->is_string()) {
         // String * int
         PyString* str = static_cast<PyString*>(other);
-        std::string result;
-        for (int64_t i = 0; i < value_; i++) {
-            result += str->value();
-        }
-        return new PyString(result);
+        return new PyString(repeat(str->value(), repeat_count(this)));
     } else if (other->is_list()) {
         // List * int
         PyList* list = static_cast<PyList*>(other);
         PyList* result = new PyList();
-        for (int64_t i = 0; i < value_; i++) {
+        int64_t count = repeat_count(this);
+        for (int64_t i = 0; i < count; i++) {
             for (size_t j = 0; j < list->size(); j++) {
                 result->append(list->get(j));
             }
@@ -191,111 +254,140 @@ PyObject* PyInt::mul(PyObject* other) {
 
 PyObject* PyInt::div(PyObject* other) {
     if (other->is_int()) {
-        int64_t divisor = static_cast<PyInt*>(other)->value();
-        if (divisor == 0) {
+        auto* rhs = static_cast<PyInt*>(other);
+        if (!rhs->big_ && rhs->value_ == 0) {
             throw std::runtime_error("ZeroDivisionError: division by zero");
         }
-        return new PyFloat(static_cast<double>(value_) / divisor);
+        return new PyFloat(as_double() / rhs->as_double());
     } else if (other->is_float()) {
         double divisor = static_cast<PyFloat*>(other)->value();
         if (divisor == 0.0) {
             throw std::runtime_error("ZeroDivisionError: division by zero");
         }
-        return new PyFloat(value_ / divisor);
+        return new PyFloat(as_double() / divisor);
     }
     return PyObject::div(other);
 }
 
 PyObject* PyInt::mod(PyObject* other) {
     if (other->is_int()) {
-        int64_t divisor = static_cast<PyInt*>(other)->value();
-        if (divisor == 0) {
+        auto* rhs = static_cast<PyInt*>(other);
+        if (!rhs->big_ && rhs->value_ == 0) {
             throw std::runtime_error("ZeroDivisionError: integer modulo by zero");
         }
-        return new PyInt(value_ % divisor);
+        if (!big_ && !rhs->big_) {
+            return new PyInt(floor_mod(value_, rhs->value_));
+        }
+        BigInt quotient, remainder;
+        BigInt::divmod(to_big(), rhs->to_big(), quotient, remainder);
+        return new PyInt(std::move(remainder));
     }
     return PyObject::mod(other);
 }
 
 PyObject* PyInt::pow(PyObject* other) {
     if (other->is_int()) {
-        int64_t exponent = static_cast<PyInt*>(other)->value();
-        return new PyInt(std::pow(value_, exponent));
+        auto* rhs = static_cast<PyInt*>(other);
+
+        // Negative exponents give a float, as in Python, and zero has none
+        if (rhs->big_ ? rhs->big_->is_negative() : rhs->value_ < 0) {
+            if (!big_ && value_ == 0) {
+                throw std::runtime_error("ZeroDivisionError: 0.0 cannot be raised to a negative power");
+            }
+            return new PyFloat(std::pow(as_double(), rhs->as_double()));
+        }
+        if (rhs->big_) {
+            // Only 0, 1 and -1 have powers this large that fit in memory
+            if (!big_ && (value_ == 0 || value_ == 1)) return new PyInt(value_);
+            if (!big_ && value_ == -1) return new PyInt(int64_t(rhs->big_->is_odd() ? -1 : 1));
+            throw std::runtime_error("OverflowError: exponent too large");
+        }
+
+        int64_t result;
+        if (!big_ && checked_pow(value_, rhs->value_, result)) {
+            return new PyInt(result);
+        }
+        return new PyInt(to_big().pow(rhs->value_));
     } else if (other->is_float()) {
         double exponent = static_cast<PyFloat*>(other)->value();
-        return new PyFloat(std::pow(value_, exponent));
+        if (!big_ && value_ == 0 && exponent < 0.0) {
+            throw std::runtime_error("ZeroDivisionError: 0.0 cannot be raised to a negative power");
+        }
+        return new PyFloat(std::pow(as_double(), exponent));
     }
     return PyObject::pow(other);
 }
 
 PyObject* PyInt::eq(PyObject* other) {
     if (other->is_int()) {
-        return PyBool::get(value_ == static_cast<PyInt*>(other)->value());
+        return PyBool::get(compare_ints(this, static_cast<PyInt*>(other)) == 0);
     } else if (other->is_float()) {
-        return PyBool::get(value_ == static_cast<PyFloat*>(other)->value());
+        return PyBool::get(as_double() == static_cast<PyFloat*>(other)->value());
     }
     return PyBool::get(false);
 }
 
 PyObject* PyInt::ne(PyObject* other) {
     if (other->is_int()) {
-        return PyBool::get(value_ != static_cast<PyInt*>(other)->value());
+        return PyBool::get(compare_ints(this, static_cast<PyInt*>(other)) != 0);
     } else if (other->is_float()) {
-        return PyBool::get(value_ != static_cast<PyFloat*>(other)->value());
+        return PyBool::get(as_double() != static_cast<PyFloat*>(other)->value());
     }
     return PyBool::get(true);
 }
 
 PyObject* PyInt::lt(PyObject* other) {
     if (other->is_int()) {
-        return PyBool::get(value_ < static_cast<PyInt*>(other)->value());
+        return PyBool::get(compare_ints(this, static_cast<PyInt*>(other)) < 0);
     } else if (other->is_float()) {
-        return PyBool::get(value_ < static_cast<PyFloat*>(other)->value());
+        return PyBool::get(as_double() < static_cast<PyFloat*>(other)->value());
     }
     return PyObject::lt(other);
 }
 
 PyObject* PyInt::le(PyObject* other) {
     if (other->is_int()) {
-        return PyBool::get(value_ <= static_cast<PyInt*>(other)->value());
+        return PyBool::get(compare_ints(this, static_cast<PyInt*>(other)) <= 0);
     } else if (other->is_float()) {
-        return PyBool::get(value_ <= static_cast<PyFloat*>(other)->value());
+        return PyBool::get(as_double() <= static_cast<PyFloat*>(other)->value());
     }
     return PyObject::le(other);
 }
 
 PyObject* PyInt::gt(PyObject* other) {
     if (other->is_int()) {
-        return PyBool::get(value_ > static_cast<PyInt*>(other)->value());
+        return PyBool::get(compare_ints(this, static_cast<PyInt*>(other)) > 0);
     } else if (other->is_float()) {
-        return PyBool::get(value_ > static_cast<PyFloat*>(other)->value());
+        return PyBool::get(as_double() > static_cast<PyFloat*>(other)->value());
     }
     return PyObject::gt(other);
 }
 
 PyObject* PyInt::ge(PyObject* other) {
     if (other->is_int()) {
-        return PyBool::get(value_ >= static_cast<PyInt*>(other)->value());
+        return PyBool::get(compare_ints(this, static_cast<PyInt*>(other)) >= 0);
     } else if (other->is_float()) {
-        return PyBool::get(value_ >= static_cast<PyFloat*>(other)->value());
+        return PyBool::get(as_double() >= static_cast<PyFloat*>(other)->value());
     }
     return PyObject::ge(other);
 }
 
 PyObject* PyInt::neg() {
+    if (big_) return new PyInt(-*big_);
+    if (value_ == INT64_MIN) return new PyInt(-BigInt(value_));
     return new PyInt(-value_);
 }
 
 std::string PyInt::to_string() const {
-    return std::to_string(value_);
+    return big_ ? big_->to_string() : std::to_string(value_);
 }
 
 bool PyInt::to_bool() const {
-    return value_ != 0;
+    return big_ || value_ != 0;
 }
 
 int64_t PyInt::hash() const {
-    return value_;
+    return big_ ? big_->hash() : value_;
 }
 
 // ============================================================================
@@ -306,7 +398,7 @@ PyObject* PyFloat::add(PyObject* other) {
     if (other->is_float()) {
         return new PyFloat(value_ + static_cast<PyFloat*>(other)->value());
     } else if (other->is_int()) {
-        return new PyFloat(value_ + static_cast<PyInt*>(other)->value());
+        return new PyFloat(value_ + static_cast<PyInt*>(other)->as_double());
     }
     return PyObject::add(other);
 }
@@ -315,7 +407,7 @@ PyObject* PyFloat::sub(PyObject* other) {
     if (other->is_float()) {
         return new PyFloat(value_ - static_cast<PyFloat*>(other)->value());
     } else if (other->is_int()) {
-        return new PyFloat(value_ - static_cast<PyInt*>(other)->value());
+        return new PyFloat(value_ - static_cast<PyInt*>(other)->as_double());
     }
     return PyObject::sub(other);
 }
@@ -324,7 +416,7 @@ PyObject* PyFloat::mul(PyObject* other) {
     if (other->is_float()) {
         return new PyFloat(value_ * static_cast<PyFloat*>(other)->value());
     } else if (other->is_int()) {
-        return new PyFloat(value_ * static_cast<PyInt*>(other)->value());
+        return new PyFloat(value_ * static_cast<PyInt*>(other)->as_double());
     }
     return PyObject::mul(other);
 }
@@ -334,7 +426,7 @@ PyObject* PyFloat::div(PyObject* other) {
     if (other->is_float()) {
         divisor = static_cast<PyFloat*>(other)->value();
     } else if (other->is_int()) {
-        divisor = static_cast<PyInt*>(other)->value();
+        divisor = static_cast<PyInt*>(other)->as_double();
     } else {
         return PyObject::div(other);
     }
@@ -349,7 +441,7 @@ PyObject* PyFloat::eq(PyObject* other) {
     if (other->is_float()) {
         return PyBool::get(value_ == static_cast<PyFloat*>(other)->value());
     } else if (other->is_int()) {
-        return PyBool::get(value_ == static_cast<PyInt*>(other)->value());
+        return PyBool::get(value_ == static_cast<PyInt*>(other)->as_double());
     }
     return PyBool::get(false);
 }
@@ -358,7 +450,7 @@ PyObject* PyFloat::lt(PyObject* other) {
     if (other->is_float()) {
         return PyBool::get(value_ < static_cast<PyFloat*>(other)->value());
     } else if (other->is_int()) {
-        return PyBool::get(value_ < static_cast<PyInt*>(other)->value());
+        return PyBool::get(value_ < static_cast<PyInt*>(other)->as_double());
     }
     return PyObject::lt(other);
 }
@@ -375,34 +467,77 @@ bool PyFloat::to_bool() const {
     return value_ != 0.0;
 }
 
+int64_t PyFloat::hash() const {
+    // Equal numbers hash equally: 2.0 like 2
+    if (value_ == std::trunc(value_) && std::fabs(value_) < 9.2e18) {
+        return static_cast<int64_t>(value_);
+    }
+    return static_cast<int64_t>(std::hash<double>{}(value_));
+}
+
 // ============================================================================
 // PyString Implementation
 // ============================================================================
 
+// Takes the builder's text if no other string shares it, otherwise copies
+// this string's prefix out of it
+void PyString::flatten() const {
+    if (builder_.use_count() == 1) {
+        builder_->resize(length_);
+        value_ = std::move(*builder_);
+    } else {
+        value_.assign(builder_->data(), length_);
+    }
+    builder_.reset();
+}
+
 PyObject* PyString::add(PyObject* other) {
-    if (other->is_string()) {
-        return new PyString(value_ + static_cast<PyString*>(other)->value());
+    if (!other->is_string()) {
+        throw std::runtime_error("TypeError: can only concatenate str (not \"" +
+                               std::string(typeid(*other).name()) + "\") to str");
+    }
+
+    auto* str = static_cast<PyString*>(other);
+    size_t length = length_ + str->length_;
+    if (length < BUILDER_MIN_LENGTH) {
+        std::string result;
+        result.reserve(length);
+        result.append(text());
+        result.append(str->text());
+        return new PyString(result);
+    }
+
+    // This is the newest string of its builder: append in place
+    if (builder_ && builder_->size() == length_) {
+        if (str->builder_ == builder_) {
+            std::string piece(str->text());  // Would move under the append
+            builder_->append(piece);
+        } else {
+            builder_->append(str->text());
+        }
+        return new PyString(builder_, length);
     }
-    throw std::runtime_error("TypeError: can only concatenate str (not \"" +
-                           std::string(typeid(*other).name()) + "\") to str");
+
+    auto builder = std::make_shared<std::string>();
+    builder->reserve(length * 2);
+    builder->append(text());
+    builder->append(str->text());
+    return new PyString(std::move(builder), length);
 }
 
 PyObject* PyString::mul(PyObject* other) {
     if (other->is_int()) {
-        int64_t count = static_cast<PyInt*>(other)->value();
-        std::string result;
-        result.reserve(value_.size() * count);
-        for (int64_t i = 0; i < count; i++) {
-            result += value_;
-        }
-        return new PyString(result);
+        return new PyString(repeat(text(), repeat_count(static_cast<PyInt*>(other))));
     }
     throw std::runtime_error("TypeError: can't multiply sequence by non-int");
 }
 
 PyObject* PyString::eq(PyObject* other) {
+    if (other == this) return PyBool::get(true);
     if (other->is_string()) {
-        return PyBool::get(value_ == static_cast<PyString*>(other)->value());
+        auto* str = static_cast<PyString*>(other);
+        if (interned_ && str->interned_) return PyBool::get(false);
+        return PyBool::get(text() == str->text());
     }
     return PyBool::get(false);
 }
@@ -412,32 +547,32 @@ PyObject* PyString::get_item(PyObject* key) {
         throw std::runtime_error("TypeError: string indices must be integers");
     }
 
-    int64_t index = static_cast<PyInt*>(key)->value();
+    int64_t index = static_cast<PyInt*>(key)->as_index();
     if (index < 0) {
-        index += value_.size();
+        index += length_;
     }
 
-    if (index < 0 || index >= static_cast<int64_t>(value_.size())) {
+    if (index < 0 || index >= static_cast<int64_t>(length_)) {
         throw std::runtime_error("IndexError: string index out of range");
     }
 
-    return new PyString(std::string(1, value_[index]));
+    return new PyString(std::string(1, value()[index]));
 }
 
 std::string PyString::to_string() const {
-    return value_;
+    return value();
 }
 
 bool PyString::to_bool() const {
-    return !value_.empty();
-}
-
-size_t PyString::length() const {
-    return value_.size();
+    return length_ != 0;
 }
 
 int64_t PyString::hash() const {
-    return std::hash<std::string>{}(value_);
+    if (!hashed_) {
+        hash_ = static_cast<int64_t>(std::hash<std::string>{}(value()));
+        hashed_ = true;
+    }
+    return hash_;
 }
 
 // ============================================================================
@@ -473,7 +608,7 @@ PyObject* PyList::get_item(PyObject* key) {
         throw std::runtime_error("TypeError: list indices must be integers");
     }
 
-    int64_t index = static_cast<PyInt*>(key)->value();
+    int64_t index = static_cast<PyInt*>(key)->as_index();
     if (index < 0) {
         index += items_.size();
     }
@@ -490,7 +625,7 @@ void PyList::set_item(PyObject* key, PyObject* value) {
         throw std::runtime_error("TypeError: list indices must be integers");
     }
 
-    int64_t index = static_cast<PyInt*>(key)->value();
+    int64_t index = static_cast<PyInt*>(key)->as_index();
     if (index < 0) {
         index += items_.size();
     }
@@ -525,62 +660,95 @@ size_t PyList::length() const {
 // PyDict Implementation
 // ============================================================================
 
-void PyDict::set(const std::string& key, PyObject* value) {
-    auto it = items_.find(key);
-    if (it != items_.end()) {
-        PyObject* old = it->second;
-        it->second = value;
-        if (value) value->incref();
+bool PyKeyEqual::operator()(PyObject* a, PyObject* b) const {
+    if (a == b) return true;
+    if (a->is_string() && b->is_string()) {
+        auto* sa = static_cast<PyString*>(a);
+        auto* sb = static_cast<PyString*>(b);
+        if (sa->is_interned() && sb->is_interned()) return false;
+        return sa->value() == sb->value();
+    }
+    return a->eq(b)->to_bool();
+}
+
+bool PyKeyEqual::operator()(PyObject* a, std::string_view b) const {
+    return a->is_string() && static_cast<PyString*>(a)->value() == b;
+}
+
+static void check_hashable(PyObject* key) {
+    if (key->is_list() || key->is_dict()) {
+        throw std::runtime_error(std::string("TypeError: unhashable type: '") +
+                                 (key->is_list() ? "list" : "dict") + "'");
+    }
+}
+
+void PyDict::set(PyObject* key, PyObject* value) {
+    check_hashable(key);
+    if (value) value->incref();
+
+    if (PyObject** existing = items_.find(key)) {
+        PyObject* old = *existing;
+        *existing = value;
         if (old) old->decref();
-    } else {
-        items_[key] = value;
-        if (value) value->incref();
+        return;
     }
+
+    key->incref();
+    items_.insert_or_assign(key, value);
 }
 
-PyObject* PyDict::get(const std::string& key) const {
-    auto it = items_.find(key);
-    if (it != items_.end()) {
-        return it->second;
+void PyDict::set(std::string_view key, PyObject* value) {
+    if (value) value->incref();
+
+    if (PyObject** existing = items_.find(key)) {
+        PyObject* old = *existing;
+        *existing = value;
+        if (old) old->decref();
+        return;
     }
-    return nullptr;
+
+    // The dict holds the only reference to the new key
+    items_.insert_or_assign(static_cast<PyObject*>(new PyString(std::string(key))), value);
+}
+
+PyObject* PyDict::get(PyObject* key) const {
+    PyObject* const* value = items_.find(key);
+    return value ? *value : nullptr;
+}
+
+PyObject* PyDict::get(std::string_view key) const {
+    PyObject* const* value = items_.find(key);
+    return value ? *value : nullptr;
 }
 
 PyObject* PyDict::get_item(PyObject* key) {
-    std::string key_str;
-    if (key->is_string()) {
-        key_str = static_cast<PyString*>(key)->value();
-    } else {
-        key_str = key->to_string();
-    }
+    check_hashable(key);
 
-    PyObject* value = get(key_str);
+    PyObject* value = get(key);
     if (!value) {
-        throw std::runtime_error("KeyError: '" + key_str + "'");
+        throw std::runtime_error("KeyError: '" + key->to_string() + "'");
     }
     return value;
 }
 
 void PyDict::set_item(PyObject* key, PyObject* value) {
-    std::string key_str;
-    if (key->is_string()) {
-        key_str = static_cast<PyString*>(key)->value();
-    } else {
-        key_str = key->to_string();
-    }
-
-    set(key_str, value);
+    set(key, value);
 }
 
 std::string PyDict::to_string() const {
     std::ostringstream oss;
     oss << "{";
     bool first = true;
-    for (const auto& [key, value] : items_) {
+    for (const auto& entry : items_) {
         if (!first) oss << ", ";
-        oss << "'" << key << "': ";
-        if (value) {
-            oss << value->to_string();
+        if (entry.key->is_string()) {
+            oss << "'" << entry.key->to_string() << "'";
+        } else {
+            oss << entry.key->to_string();
+        }
+        oss << ": ";
+        if (entry.value) {
+            oss << entry.value->to_string();
         } else {
             oss << "None";
         }
@@ -598,4 +766,285 @@ size_t PyDict::length() const {
     return items_.size();
 }
 
+// ============================================================================
+// PyFunction Implementation
+// ============================================================================
+
+void PyFunction::arity_error(size_t nargs) const {
+    throw std::runtime_error("TypeError: " + name_ + "() takes " + std::to_string(arity_) +
+                             " positional argument" + (arity_ == 1 ? "" : "s") + " but " +
+                             std::to_string(nargs) + (nargs == 1 ? " was" : " were") + " given");
+}
+
+PyObject* PyFunction::vectorcall_fixed0(PyFunction* self, PyObject* const* args, size_t nargs) {
+    if (nargs != 0) self->arity_error(nargs);
+    return self->direct_.call0();
+}
+
+PyObject* PyFunction::vectorcall_fixed1(PyFunction* self, PyObject* const* args, size_t nargs) {
+    if (nargs != 1) self->arity_error(nargs);
+    return self->direct_.call1(args[0]);
+}
+
+PyObject* PyFunction::vectorcall_fixed2(PyFunction* self, PyObject* const* args, size_t nargs) {
+    if (nargs != 2) self->arity_error(nargs);
+    return self->direct_.call2(args[0], args[1]);
+}
+
+PyObject* PyFunction::vectorcall_fixed3(PyFunction* self, PyObject* const* args, size_t nargs) {
+    if (nargs != 3) self->arity_error(nargs);
+    return self->direct_.call3(args[0], args[1], args[2]);
+}
+
+PyObject* PyFunction::vectorcall_native(PyFunction* self, PyObject* const* args, size_t nargs) {
+    return self->native_(args, nargs);
+}
+
+// ============================================================================
+// Shapes, Classes and Instances
+// ============================================================================
+
+static uint32_t next_shape_id() {
+    static std::atomic<uint32_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+Shape::Shape(Shape* parent, std::string_view name)
+    : id_(next_shape_id()), size_(parent ? parent->size_ + 1 : 0), parent_(parent), name_(name) {
+    if (!parent) return;
+    if (size_ <= LINEAR_LOOKUP_MAX) {
+        names_ = parent->names_;
+        names_.push_back(name_);
+        return;
+    }
+    if (parent->size_ > LINEAR_LOOKUP_MAX) {
+        slots_ = parent->slots_;
+    } else {
+        for (uint32_t i = 0; i < parent->size_; i++) slots_.insert_or_assign(parent->names_[i], i);
+    }
+    slots_.insert_or_assign(std::string_view(name_), parent->size_);
+}
+
+Shape* Shape::with(std::string_view name) {
+    for (auto& next : transitions_) {
+        if (next->name_ == name) return next.get();
+    }
+    transitions_.push_back(std::unique_ptr<Shape>(new Shape(this, name)));
+    return transitions_.back().get();
+}
+
+void PyClass::resolve_methods() {
+    resolved_.clear();
+    for (auto& [name, method] : methods_) {
+        resolved_.insert_or_assign(std::string_view(name), method.get());
+    }
+    for (auto& base : bases_) {
+        if (base->resolved_epoch_ != method_epoch_) base->resolve_methods();
+        for (auto& entry : base->resolved_) {
+            if (!resolved_.contains(entry.key)) resolved_.insert_or_assign(entry.key, entry.value);
+        }
+    }
+    resolved_epoch_ = method_epoch_;
+}
+
+PyObject* PyClass::call(PyObject** args, size_t nargs) {
+    auto* instance = new PyInstance(shared_from_this());
+    if (PyFunction* init = get_method("__init__")) {
+        std::vector<PyObject*> init_args;
+        init_args.reserve(nargs + 1);
+        init_args.push_back(instance);
+        init_args.insert(init_args.end(), args, args + nargs);
+        PyObject* result = init->vectorcall(init_args.data(), init_args.size());
+        if (result) result->decref();
+    }
+    return instance;
+}
+
+PyInstance::~PyInstance() {
+    for (PyObject* value : slots_) {
+        if (value) value->decref();
+    }
+}
+
+[[noreturn]] static void attribute_error(const PyClass* cls, std::string_view name) {
+    throw std::runtime_error("AttributeError: '" + cls->name() + "' object has no attribute '" +
+                             std::string(name) + "'");
+}
+
+PyObject* PyInstance::get_attr(std::string_view name) {
+    int32_t slot = shape_->lookup(name);
+    if (slot >= 0) return slots_[slot];
+    if (PyFunction* method = class_->get_method(name)) return method;
+    attribute_error(class_.get(), name);
+}
+
+void PyInstance::set_attr(std::string_view name, PyObject* value) {
+    if (value) value->incref();
+
+    int32_t slot = shape_->lookup(name);
+    if (slot >= 0) {
+        PyObject* old = slots_[slot];
+        slots_[slot] = value;
+        if (old) old->decref();
+        return;
+    }
+    shape_ = shape_->with(name);
+    slots_.push_back(value);
+}
+
+AttrCache::Entry AttrCache::lookup(PyInstance* obj, std::string_view name) {
+    uint32_t shape_id = obj->shape()->id();
+    uint64_t epoch = PyClass::method_epoch();
+    for (size_t i = 0; i < used; i++) {
+        const Entry& entry = entries[i];
+        if (entry.shape_id == shape_id && (entry.slot >= 0 || entry.epoch == epoch)) return entry;
+    }
+
+    Entry entry;
+    entry.shape_id = shape_id;
+    entry.slot = obj->shape()->lookup(name);
+    if (entry.slot < 0) {
+        entry.method = obj->get_class()->get_method(name);
+        if (!entry.method) return Entry();
+        entry.epoch = epoch;
+    }
+
+    // Replace this shape's stale method entry, else take a free one
+    for (size_t i = 0; i < used; i++) {
+        if (entries[i].shape_id == shape_id) {
+            entries[i] = entry;
+            return entry;
+        }
+    }
+    if (used < ENTRIES) {
+        entries[used++] = entry;
+    } else {
+        megamorphic = true;
+    }
+    return entry;
+}
+
+PyObject* AttrCache::load_slow(PyInstance* obj, std::string_view name) {
+    Entry entry = lookup(obj, name);
+    if (entry.slot >= 0) return obj->slot(entry.slot);
+    if (entry.method) return entry.method;
+    attribute_error(obj->get_class(), name);
+}
+
+PyObject* AttrCache::call_method_slow(PyInstance* obj, std::string_view name,
+                                      PyObject* const* args, size_t nargs) {
+    Entry entry = lookup(obj, name);
+    if (entry.slot >= 0) {
+        PyObject* field = obj->slot(entry.slot);
+        if (!field) throw std::runtime_error("TypeError: 'NoneType' object is not callable");
+        return field->call(const_cast<PyObject**>(args), nargs);
+    }
+    if (entry.method) return call_bound(entry.method, obj, args, nargs);
+    attribute_error(obj->get_class(), name);
+}
+
+PyObject* AttrCache::call_bound_many(PyFunction* method, PyObject* self,
+                                     PyObject* const* args, size_t nargs) {
+    std::vector<PyObject*> bound;
+    bound.reserve(nargs + 1);
+    bound.push_back(self);
+    bound.insert(bound.end(), args, args + nargs);
+    return method->vectorcall(bound.data(), bound.size());
+}
+
+// ============================================================================
+// PyGenerator Implementation
+// ============================================================================
+
+PyGenerator::~PyGenerator() {
+    // A value yielded but never handed out is still ours
+    if (frame_) {
+        if (PyObject* pending = frame_.promise().yielded) pending->decref();
+        frame_.destroy();
+    }
+}
+
+PyObject* PyGenerator::resume(PyObject* sent) {
+    if (state_ == State::RUNNING) {
+        throw std::runtime_error("ValueError: generator already executing");
+    }
+    if (state_ == State::COMPLETED) {
+        throw std::runtime_error("StopIteration");
+    }
+
+    Body::promise_type& promise = frame_.promise();
+    promise.yielded = nullptr;
+    promise.sent = sent;
+    state_ = State::RUNNING;
+    try {
+        frame_.resume();
+    } catch (...) {
+        state_ = State::COMPLETED;
+        throw;
+    }
+    promise.sent = nullptr;
+
+    if (frame_.done()) {
+        state_ = State::COMPLETED;
+        throw std::runtime_error("StopIteration");
+    }
+    state_ = State::SUSPENDED;
+    PyObject* value = promise.yielded;
+    promise.yielded = nullptr;
+    return value;
+}
+
+PyObject* PyGenerator::next() {
+    return resume(PyNone::instance());
+}
+
+PyObject* PyGenerator::send(PyObject* value) {
+    if (state_ == State::CREATED && value != PyNone::instance()) {
+        throw std::runtime_error("TypeError: can't send non-None value to a just-started generator");
+    }
+    return resume(value);
+}
+
+// ============================================================================
+// InternTable Implementation
+// ============================================================================
+
+InternTable::~InternTable() {
+    // Anything still holding a string no longer gets the pointer fast path
+    for (auto& entry : strings_) {
+        entry.value->interned_ = false;
+        entry.value->decref();
+    }
+}
+
+PyString* InternTable::intern(std::string_view text) {
+    if (PyString** found = strings_.find(text)) return *found;
+
+    auto* str = new PyString(std::string(text));
+    str->interned_ = true;
+    strings_.insert_or_assign(std::string_view(str->value_), str);
+    return str;
+}
+
+PyString* InternTable::intern(PyString* str) {
+    if (str->interned_) return str;
+    if (PyString** found = strings_.find(std::string_view(str->value()))) return *found;
+
+    str->incref();
+    str->interned_ = true;
+    strings_.insert_or_assign(std::string_view(str->value_), str);
+    return str;
+}
+
+InternTable& InternTable::current() {
+    if (InternSlot* slot = current_intern_slot) {
+        if (!*slot) {
+            *slot = InternSlot(new InternTable(), [](InternTable* table) { delete table; });
+        }
+        return **slot;
+    }
+    static thread_local InternTable table;
+    return table;
+}
+
 } // namespace pyvm::runtime
\ No newline at end of file
@@ -1,12 +1,34 @@
 
 #include <iostream>
 #include <cstdint>
+#include <cstddef>
+#include <cstdlib>
 #include <vector>
 #include <unordered_map>
 #include <string>
 #include <memory>
 #include <cstring>
 #include <atomic>  // for std::atomic
+#include <string_view>
+#include <new>
+#include <mutex>
+#include <algorithm>
+#include <type_traits>
+#include "../../include/runtime/actor_gc.h"
+#include "../../include/runtime/compact_dict.h"
+#include "../../include/runtime/list_kernels.h"
+#include "../../include/runtime/sort.h"
+
+using aithon::runtime::ActorAllocator;
+using aithon::runtime::CompactDict;
+using aithon::runtime::gc_alloc_pinned;
+using aithon::runtime::gc_free;
+using aithon::runtime::list_kernels;
+using aithon::runtime::parallel_merge_sort;
+using aithon::runtime::parallel_workers;
+using aithon::runtime::pdq_sort;
+using aithon::runtime::radix_sort;
+
 // ============================================================================
 // Runtime Data Structures
 // ============================================================================
@@ -41,54 +63,762 @@ struct RuntimeValue {
     }
 };
 
-// List structure (heap-allocated)
+// Runtime objects and everything they own live in the current actor's
+// heap (see gc_alloc_pinned); outside an actor they fall back to malloc
+template<typename T>
+static T* runtime_new() {
+    void* mem = gc_alloc_pinned(sizeof(T));
+    if (!mem) throw std::bad_alloc();
+    return new (mem) T();
+}
+
+template<typename T>
+static void runtime_delete(T* obj) {
+    obj->~T();
+    gc_free(obj);
+}
+
+// ============================================================================
+// Runtime Strings
+// ============================================================================
+
+// Text of a long string, shared by the strings and substrings made from it
+struct StringBuffer {
+    uint32_t refcount;
+    int64_t capacity;   // Bytes of text data can hold, not counting the NUL
+    char data[];
+};
+
+static StringBuffer* buffer_alloc(int64_t capacity) {
+    auto* buffer = static_cast<StringBuffer*>(gc_alloc_pinned(sizeof(StringBuffer) + capacity + 1));
+    if (!buffer) throw std::bad_alloc();
+    buffer->refcount = 1;
+    buffer->capacity = capacity;
+    return buffer;
+}
+
+// Immutable string with its length and a cached hash. Up to INLINE_CAPACITY
+// bytes are stored in the object itself; longer text lives in a shared
+// StringBuffer. Compiled code emits its literals in this layout (see
+// LLVMCodeGen::runtime_string_type) with data pointing at constant storage.
+struct RuntimeString {
+    static constexpr int64_t INLINE_CAPACITY = 23;
+
+    enum Flags : uint32_t {
+        INLINE   = 1,   // Text in chars
+        IMMORTAL = 2,   // Never freed, refcount unused
+        INTERNED = 4,   // The canonical copy of its text
+        BUILDER  = 8,   // Being extended in place (runtime_string_append)
+    };
+
+    const char* data;       // NUL-terminated, except for shared substrings
+    int64_t length;
+    mutable uint64_t hash;  // 0 until first needed
+    uint32_t refcount;
+    uint32_t flags;
+    union {
+        StringBuffer* buffer;   // Null when data is constant storage
+        char chars[INLINE_CAPACITY + 1];
+    };
+
+    std::string_view view() const { return {data, static_cast<size_t>(length)}; }
+
+    uint64_t get_hash() const {
+        if (hash == 0) {
+            uint64_t h = std::hash<std::string_view>{}(view());
+            hash = h ? h : 1;
+        }
+        return hash;
+    }
+};
+
+static_assert(offsetof(RuntimeString, chars) == 32, "must match codegen's RuntimeString type");
+static_assert(sizeof(RuntimeString) == 56, "must match codegen's RuntimeString type");
+
+// A string of the given length whose text the caller fills in
+static RuntimeString* string_alloc(int64_t length, char** text) {
+    auto* str = static_cast<RuntimeString*>(gc_alloc_pinned(sizeof(RuntimeString)));
+    if (!str) throw std::bad_alloc();
+    str->length = length;
+    str->hash = 0;
+    str->refcount = 1;
+
+    if (length <= RuntimeString::INLINE_CAPACITY) {
+        str->flags = RuntimeString::INLINE;
+        *text = str->chars;
+    } else {
+        StringBuffer* buffer = buffer_alloc(length);
+        str->flags = 0;
+        str->buffer = buffer;
+        *text = buffer->data;
+    }
+    (*text)[length] = '\0';
+    str->data = *text;
+    return str;
+}
+
+static RuntimeString* string_new(const char* data, int64_t length) {
+    char* text;
+    RuntimeString* str = string_alloc(length, &text);
+    memcpy(text, data, length);
+    return str;
+}
+
+static void string_retain(RuntimeString* str) {
+    if (!(str->flags & RuntimeString::IMMORTAL)) str->refcount++;
+}
+
+static void string_release(RuntimeString* str) {
+    if ((str->flags & RuntimeString::IMMORTAL) || --str->refcount > 0) return;
+    if (!(str->flags & RuntimeString::INLINE) && str->buffer && --str->buffer->refcount == 0) {
+        gc_free(str->buffer);
+    }
+    gc_free(str);
+}
+
+static bool string_equals(const RuntimeString* a, const RuntimeString* b) {
+    if (a == b) return true;
+    if (a->flags & b->flags & RuntimeString::INTERNED) return false;
+    if (a->length != b->length) return false;
+    if (a->hash && b->hash && a->hash != b->hash) return false;
+    return memcmp(a->data, b->data, a->length) == 0;
+}
+
+struct RuntimeStringHash {
+    size_t operator()(const RuntimeString* str) const { return str->get_hash(); }
+};
+
+struct RuntimeStringEqual {
+    bool operator()(const RuntimeString* a, const RuntimeString* b) const {
+        return string_equals(a, b);
+    }
+};
+
+// Canonical strings, shared process-wide. Compiled modules intern their
+// literals at load time; interned strings are immortal, and two of them
+// are equal only if they are the same object.
+struct InternTable {
+    std::mutex mutex;
+    CompactDict<RuntimeString*, RuntimeString*, RuntimeStringHash, RuntimeStringEqual> strings;
+};
+
+// Function-local so module constructors can intern before main; never
+// destroyed, like the strings it holds
+static InternTable& intern_table() {
+    static auto* table = new InternTable();
+    return *table;
+}
+
+// How a list stores its elements. A list whose elements all have one type
+// keeps them unboxed in a flat array; the first element of another type
+// converts it to RuntimeValues for good.
+enum class ListKind : uint8_t {
+    EMPTY,
+    INT,        // int64_t
+    FLOAT,      // double
+    BOOL,       // bool
+    STRING,     // RuntimeString*, one reference each
+    GENERIC     // RuntimeValue
+};
+
+// Element type <-> storage kind and boxed form
+template<typename T> struct ListSlot;
+
+template<> struct ListSlot<int64_t> {
+    static constexpr ListKind kind = ListKind::INT;
+    static constexpr ValueType type = ValueType::INT;
+    static int64_t unbox(const RuntimeValue& val) { return val.data.int_val; }
+    static RuntimeValue box(int64_t value) {
+        RuntimeValue val;
+        val.type = type;
+        val.data.int_val = value;
+        return val;
+    }
+};
+
+template<> struct ListSlot<double> {
+    static constexpr ListKind kind = ListKind::FLOAT;
+    static constexpr ValueType type = ValueType::FLOAT;
+    static double unbox(const RuntimeValue& val) { return val.data.float_val; }
+    static RuntimeValue box(double value) {
+        RuntimeValue val;
+        val.type = type;
+        val.data.float_val = value;
+        return val;
+    }
+};
+
+template<> struct ListSlot<bool> {
+    static constexpr ListKind kind = ListKind::BOOL;
+    static constexpr ValueType type = ValueType::BOOL;
+    static bool unbox(const RuntimeValue& val) { return val.data.bool_val; }
+    static RuntimeValue box(bool value) {
+        RuntimeValue val;
+        val.type = type;
+        val.data.bool_val = value;
+        return val;
+    }
+};
+
+template<> struct ListSlot<RuntimeString*> {
+    static constexpr ListKind kind = ListKind::STRING;
+    static constexpr ValueType type = ValueType::STRING;
+    static RuntimeString* unbox(const RuntimeValue& val) {
+        return static_cast<RuntimeString*>(val.data.ptr_val);
+    }
+    static RuntimeValue box(RuntimeString* value) {
+        RuntimeValue val;
+        val.type = type;
+        val.data.ptr_val = value;
+        return val;
+    }
+};
+
+// A boxed element as a T where Python's numeric tower allows it: a bool
+// counts as an int, and an int or bool as a float. False otherwise.
+template<typename T>
+static bool unbox_as(const RuntimeValue& val, T& out) {
+    if (val.type == ListSlot<T>::type) {
+        out = ListSlot<T>::unbox(val);
+        return true;
+    }
+    if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, double>) {
+        if (val.type == ValueType::BOOL) {
+            out = val.data.bool_val ? 1 : 0;
+            return true;
+        }
+    }
+    if constexpr (std::is_same_v<T, double>) {
+        if (val.type == ValueType::INT) {
+            out = static_cast<double>(val.data.int_val);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void release_string_value(const RuntimeValue& val) {
+    if (val.type == ValueType::STRING && val.data.ptr_val) {
+        string_release(static_cast<RuntimeString*>(val.data.ptr_val));
+    }
+}
+
+// Out of line so the bounds checks that call it stay small
+[[gnu::noinline, gnu::cold]] static void list_index_error() {
+    std::cerr << "IndexError: list index out of range\n";
+}
+
+// List structure (heap-allocated). Compiled code reads data, length and
+// kind directly (runtime_list_type in codegen), so the layout is fixed.
+// Holds a reference to each string element.
 struct RuntimeList {
-    std::vector<RuntimeValue> items;
+    void* data = nullptr;
+    int64_t length = 0;
+    int64_t capacity = 0;
+    ListKind kind = ListKind::EMPTY;
 
     RuntimeList() = default;
+    RuntimeList(const RuntimeList&) = delete;
+    RuntimeList& operator=(const RuntimeList&) = delete;
+
+    ~RuntimeList() {
+        if (kind == ListKind::STRING) {
+            for (int64_t i = 0; i < length; i++) string_release(items<RuntimeString*>()[i]);
+        } else if (kind == ListKind::GENERIC) {
+            for (int64_t i = 0; i < length; i++) release_string_value(items<RuntimeValue>()[i]);
+        }
+        gc_free(data);
+    }
+
+    template<typename T>
+    T* items() const { return static_cast<T*>(data); }
 
-    void append(const RuntimeValue& val) {
-        items.push_back(val);
+    static size_t element_size(ListKind kind) {
+        switch (kind) {
+            case ListKind::INT:    return sizeof(int64_t);
+            case ListKind::FLOAT:  return sizeof(double);
+            case ListKind::BOOL:   return sizeof(bool);
+            case ListKind::STRING: return sizeof(RuntimeString*);
+            default:               return sizeof(RuntimeValue);
+        }
     }
 
-    RuntimeValue get(size_t index) {
-        if (index >= items.size()) {
-            std::cerr << "IndexError: list index out of range\n";
-            RuntimeValue err;
-            err.type = ValueType::NONE;
-            return err;
+    void reserve(int64_t needed) {
+        if (needed <= capacity) return;
+        int64_t new_capacity = std::max<int64_t>({needed, capacity * 2, 8});
+        size_t size = element_size(kind);
+        void* new_data = gc_alloc_pinned(new_capacity * size);
+        if (!new_data) throw std::bad_alloc();
+        if (data) {
+            memcpy(new_data, data, length * size);
+            gc_free(data);
+        }
+        data = new_data;
+        capacity = new_capacity;
+    }
+
+    // Boxes every element; from here on the list is heterogeneous
+    void make_generic() {
+        if (kind == ListKind::GENERIC) return;
+        if (length == 0) {
+            gc_free(data);
+            data = nullptr;
+            capacity = 0;
+            kind = ListKind::GENERIC;
+            return;
+        }
+
+        auto* boxed = static_cast<RuntimeValue*>(gc_alloc_pinned(capacity * sizeof(RuntimeValue)));
+        if (!boxed) throw std::bad_alloc();
+        for (int64_t i = 0; i < length; i++) boxed[i] = get(i);
+        gc_free(data);
+        data = boxed;
+        kind = ListKind::GENERIC;
+    }
+
+    template<typename T>
+    void append(T value) {
+        if (kind == ListKind::EMPTY) kind = ListSlot<T>::kind;
+        if (kind != ListSlot<T>::kind) {
+            append_value(ListSlot<T>::box(value));
+            return;
+        }
+        if (length == capacity) reserve(length + 1);
+        items<T>()[length++] = value;
+    }
+
+    void append_value(const RuntimeValue& val) {
+        make_generic();
+        if (length == capacity) reserve(length + 1);
+        items<RuntimeValue>()[length++] = val;
+    }
+
+    // Replaces an element, releasing it if it is a string. Takes over a
+    // string value's reference.
+    template<typename T>
+    void set(int64_t index, T value) {
+        if (kind == ListSlot<T>::kind) {
+            if constexpr (std::is_same_v<T, RuntimeString*>) string_release(items<T>()[index]);
+            items<T>()[index] = value;
+            return;
+        }
+        make_generic();
+        release_string_value(items<RuntimeValue>()[index]);
+        items<RuntimeValue>()[index] = ListSlot<T>::box(value);
+    }
+
+    // Python indexing: negative counts from the end. Reports out of range.
+    bool check_index(int64_t& index) const {
+        if (index < 0) index += length;
+        if (index < 0 || index >= length) [[unlikely]] {
+            list_index_error();
+            return false;
+        }
+        return true;
+    }
+
+    // Element at a checked index, boxed
+    RuntimeValue get(int64_t index) const {
+        switch (kind) {
+            case ListKind::INT:     return ListSlot<int64_t>::box(items<int64_t>()[index]);
+            case ListKind::FLOAT:   return ListSlot<double>::box(items<double>()[index]);
+            case ListKind::BOOL:    return ListSlot<bool>::box(items<bool>()[index]);
+            case ListKind::STRING:  return ListSlot<RuntimeString*>::box(items<RuntimeString*>()[index]);
+            case ListKind::GENERIC: return items<RuntimeValue>()[index];
+            default:                return RuntimeValue();
+        }
+    }
+
+    // Element at a checked index as a T (see unbox_as), or fallback if it
+    // is not one
+    template<typename T>
+    T get_as(int64_t index, T fallback) const {
+        if (kind == ListSlot<T>::kind) return items<T>()[index];
+        if (kind == ListKind::GENERIC) {
+            T value;
+            if (unbox_as(items<RuntimeValue>()[index], value)) return value;
         }
-        return items[index];
+        return fallback;
     }
 
     size_t size() const {
-        return items.size();
+        return static_cast<size_t>(length);
     }
 };
 
-// Dictionary structure (heap-allocated)
+static_assert(offsetof(RuntimeList, data) == 0 && offsetof(RuntimeList, length) == 8 &&
+              offsetof(RuntimeList, kind) == 24, "codegen reads RuntimeList fields by offset");
+
+// The list's Ts as a flat array for the kernels: its own storage when it
+// keeps them unboxed, else its elements converted (see unbox_as) and
+// copied out - a mixed int and float list gathers as floats. An element
+// that does not convert is a TypeError for name(): false, and no data.
+template<typename T>
+static bool list_elements(const RuntimeList* list, const char* name, const T*& data,
+                          int64_t& n, std::vector<T, ActorAllocator<T>>& scratch) {
+    if (list->kind == ListSlot<T>::kind) {
+        data = list->items<T>();
+        n = list->length;
+        return true;
+    }
+    for (int64_t i = 0; i < list->length; i++) {
+        T value;
+        if (!unbox_as(list->get(i), value)) {
+            std::cerr << "TypeError: unsupported list element type for " << name << "()\n";
+            return false;
+        }
+        scratch.push_back(value);
+    }
+    data = scratch.data();
+    n = static_cast<int64_t>(scratch.size());
+    return true;
+}
+
+// sum(): 0 after a TypeError
+template<typename T, typename Sum>
+static T list_sum(void* list_ptr, Sum sum) {
+    if (!list_ptr) return T();
+    std::vector<T, ActorAllocator<T>> scratch;
+    const T* data;
+    int64_t n;
+    if (!list_elements(static_cast<RuntimeList*>(list_ptr), "sum", data, n, scratch)) return T();
+    return sum(data, n);
+}
+
+// An int sum, or an OverflowError (giving 0) if it does not fit in an
+// int64 - compiled code's ints cannot promote to a BigInt
+static int64_t checked_sum(const int64_t* data, int64_t n) {
+    bool overflow = false;
+    int64_t sum = list_kernels().sum_i64(data, n, &overflow);
+    if (!overflow) return sum;
+
+    // A partial sum overflowed, but the total may fit - and then equals
+    // the wrapped sum
+    __int128 exact = 0;
+    for (int64_t i = 0; i < n; i++) exact += data[i];
+    if (exact < INT64_MIN || exact > INT64_MAX) {
+        std::cerr << "OverflowError: integer overflow in sum()\n";
+        return 0;
+    }
+    return sum;
+}
+
+// min()/max(): an empty list is a ValueError and gives 0, as does a
+// TypeError
+template<typename T>
+static T list_extreme(void* list_ptr, const char* name,
+                      T (*kernel)(const T*, int64_t)) {
+    if (!list_ptr) return T();
+    std::vector<T, ActorAllocator<T>> scratch;
+    const T* data;
+    int64_t n;
+    if (!list_elements(static_cast<RuntimeList*>(list_ptr), name, data, n, scratch)) return T();
+    if (n == 0) {
+        std::cerr << "ValueError: " << name << "() arg is an empty sequence\n";
+        return T();
+    }
+    return kernel(data, n);
+}
+
+// Index of the first element equal to value, or -1. Generic lists are
+// searched in place, since gathering would lose the positions.
+template<typename T>
+static int64_t list_find(const RuntimeList* list, T value,
+                         int64_t (*kernel)(const T*, int64_t, T)) {
+    if (list->kind == ListSlot<T>::kind) return kernel(list->items<T>(), list->length, value);
+    if (list->kind == ListKind::GENERIC) {
+        for (int64_t i = 0; i < list->length; i++) {
+            T element;
+            if (unbox_as(list->items<RuntimeValue>()[i], element) && element == value) return i;
+        }
+    }
+    return -1;
+}
+
+// Number of elements equal to value. Like list_find, elements of other
+// types are never equal rather than errors.
+template<typename T>
+static int64_t list_count(const RuntimeList* list, T value,
+                          int64_t (*kernel)(const T*, int64_t, T)) {
+    if (list->kind == ListSlot<T>::kind) return kernel(list->items<T>(), list->length, value);
+    int64_t count = 0;
+    if (list->kind == ListKind::GENERIC) {
+        for (int64_t i = 0; i < list->length; i++) {
+            T element;
+            if (unbox_as(list->items<RuntimeValue>()[i], element) && element == value) count++;
+        }
+    }
+    return count;
+}
+
+// Whether data[i] + value, or data[i] * value, fits an int64 for every i.
+// Both are monotonic in data[i], so the smallest and largest decide.
+static bool add_fits(const int64_t* data, int64_t n, int64_t value) {
+    if (n == 0 || value == 0) return true;
+    int64_t extreme = value > 0 ? list_kernels().max_i64(data, n) : list_kernels().min_i64(data, n);
+    int64_t result;
+    return !__builtin_add_overflow(extreme, value, &result);
+}
+
+static bool mul_fits(const int64_t* data, int64_t n, int64_t value) {
+    if (n == 0 || value == 0 || value == 1) return true;
+    int64_t result;
+    return !__builtin_mul_overflow(list_kernels().min_i64(data, n), value, &result) &&
+           !__builtin_mul_overflow(list_kernels().max_i64(data, n), value, &result);
+}
+
+// New list of element op value, for a list whose elements are all Ts. If
+// given, fits checks the operands first; false is an OverflowError.
+template<typename T>
+static RuntimeList* list_map(const RuntimeList* list, T value,
+                             void (*kernel)(const T*, int64_t, T, T*),
+                             bool (*fits)(const T*, int64_t, T) = nullptr) {
+    std::vector<T, ActorAllocator<T>> scratch;
+    const T* source = list->items<T>();
+    if (list->kind != ListSlot<T>::kind && list->kind != ListKind::EMPTY) {
+        for (int64_t i = 0; i < list->length; i++) {
+            T element;
+            if (!unbox_as(list->get(i), element)) {
+                std::cerr << "TypeError: unsupported operand type(s) for list element\n";
+                return nullptr;
+            }
+            scratch.push_back(element);
+        }
+        source = scratch.data();
+    }
+    if (fits && !fits(source, list->length, value)) {
+        std::cerr << "OverflowError: integer overflow\n";
+        return nullptr;
+    }
+
+    auto* result = runtime_new<RuntimeList>();
+    if (list->length == 0) return result;
+    result->kind = ListSlot<T>::kind;
+    result->reserve(list->length);
+    kernel(source, list->length, value, result->items<T>());
+    result->length = list->length;
+    return result;
+}
+
+// ============================================================================
+// List Sorting
+// ============================================================================
+
+// Lists at least this long are sorted across the scheduler's workers,
+// when there are any
+static constexpr int64_t PARALLEL_SORT_MIN = 1 << 20;
+
+// Sorts n Ts with sort_run(begin, end, scratch), or in parallel runs merged
+// back together for huge lists. Scratch holds n Ts and is only set up if
+// sort_run wants it or the sort goes parallel; it comes from the caller's
+// heap, since the workers have none.
+template<typename T, typename Less, typename SortRun>
+static void sort_items(T* data, int64_t n, Less less, SortRun sort_run, bool run_uses_scratch) {
+    std::vector<T, ActorAllocator<T>> scratch;
+    if (n >= PARALLEL_SORT_MIN && parallel_workers() > 1) {
+        scratch.resize(n);
+        parallel_merge_sort(data, static_cast<size_t>(n), scratch.data(), less, sort_run);
+        return;
+    }
+    if (run_uses_scratch) scratch.resize(n);
+    sort_run(data, data + n, scratch.data());
+}
+
+// NaNs go after every number, so the order stays a strict weak one. Equal
+// floats (0.0 and -0.0) may trade places.
+static bool float_less(double a, double b) {
+    return a < b || (b != b && a == a);
+}
+
+// Byte order of UTF-8 is code point order, which is Python's
+static bool string_less(const RuntimeString* a, const RuntimeString* b) {
+    return a->view() < b->view();
+}
+
+static bool is_number(const RuntimeValue& val) {
+    return val.type == ValueType::INT || val.type == ValueType::FLOAT || val.type == ValueType::BOOL;
+}
+
+static const char* value_type_name(ValueType type) {
+    switch (type) {
+        case ValueType::INT:    return "int";
+        case ValueType::FLOAT:  return "float";
+        case ValueType::STRING: return "str";
+        case ValueType::BOOL:   return "bool";
+        case ValueType::LIST:   return "list";
+        case ValueType::DICT:   return "dict";
+        default:                return "NoneType";
+    }
+}
+
+// Ints and bools compare exactly; once a float is involved both sides
+// compare as doubles
+static bool value_less(const RuntimeValue& a, const RuntimeValue& b) {
+    if (a.type == ValueType::STRING) {
+        return string_less(static_cast<RuntimeString*>(a.data.ptr_val),
+                           static_cast<RuntimeString*>(b.data.ptr_val));
+    }
+    auto as_int = [](const RuntimeValue& val) {
+        return val.type == ValueType::BOOL ? int64_t(val.data.bool_val) : val.data.int_val;
+    };
+    auto as_double = [&](const RuntimeValue& val) {
+        return val.type == ValueType::FLOAT ? val.data.float_val : double(as_int(val));
+    };
+    if (a.type != ValueType::FLOAT && b.type != ValueType::FLOAT) return as_int(a) < as_int(b);
+    return float_less(as_double(a), as_double(b));
+}
+
+// A generic list sorts if its elements are all numbers or all strings;
+// anything else is a TypeError, like comparing them would be
+static bool list_orderable(const RuntimeList* list) {
+    const auto* items = list->items<RuntimeValue>();
+    for (int64_t i = 0; i < list->length; i++) {
+        const RuntimeValue& a = items[0];
+        const RuntimeValue& b = items[i];
+        bool ok = a.type == ValueType::STRING ? b.type == ValueType::STRING
+                                              : is_number(a) && is_number(b);
+        if (!ok) {
+            std::cerr << "TypeError: '<' not supported between instances of '"
+                      << value_type_name(b.type) << "' and '" << value_type_name(a.type) << "'\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Boxed elements sort as (value, position) pairs: no two compare equal,
+// so the unstable sorts give Python's stable order
+struct SortItem {
+    RuntimeValue value;
+    int64_t index;
+};
+
+static void sort_generic(RuntimeList* list) {
+    auto* items = list->items<RuntimeValue>();
+    int64_t n = list->length;
+    std::vector<SortItem, ActorAllocator<SortItem>> keyed(n);
+    for (int64_t i = 0; i < n; i++) keyed[i] = {items[i], i};
+
+    auto less = [](const SortItem& a, const SortItem& b) {
+        if (value_less(a.value, b.value)) return true;
+        if (value_less(b.value, a.value)) return false;
+        return a.index < b.index;
+    };
+    sort_items(keyed.data(), n, less,
+               [less](SortItem* begin, SortItem* end, SortItem*) { pdq_sort(begin, end, less); },
+               false);
+    for (int64_t i = 0; i < n; i++) items[i] = keyed[i].value;
+}
+
+static void reverse_list(RuntimeList* list) {
+    int64_t n = list->length;
+    switch (list->kind) {
+        case ListKind::INT:     std::reverse(list->items<int64_t>(), list->items<int64_t>() + n); break;
+        case ListKind::FLOAT:   std::reverse(list->items<double>(), list->items<double>() + n); break;
+        case ListKind::BOOL:    std::reverse(list->items<bool>(), list->items<bool>() + n); break;
+        case ListKind::STRING:  std::reverse(list->items<RuntimeString*>(), list->items<RuntimeString*>() + n); break;
+        case ListKind::GENERIC: std::reverse(list->items<RuntimeValue>(), list->items<RuntimeValue>() + n); break;
+        default: break;
+    }
+}
+
+// list.sort(): unboxed ints by radix, bools by counting, the rest by
+// pdqsort. Descending is a stable ascending sort between two reversals,
+// which keeps equal elements in their original order as Python does.
+static void sort_list(RuntimeList* list, bool reverse) {
+    int64_t n = list->length;
+    if (n < 2) return;
+    if (list->kind == ListKind::GENERIC && !list_orderable(list)) return;
+
+    if (reverse) reverse_list(list);
+    switch (list->kind) {
+        case ListKind::INT:
+            sort_items(list->items<int64_t>(), n, [](int64_t a, int64_t b) { return a < b; },
+                       [](int64_t* begin, int64_t* end, int64_t* scratch) {
+                           radix_sort(begin, end - begin, scratch);
+                       },
+                       true);
+            break;
+        case ListKind::FLOAT:
+            sort_items(list->items<double>(), n, float_less,
+                       [](double* begin, double* end, double*) { pdq_sort(begin, end, float_less); },
+                       false);
+            break;
+        case ListKind::BOOL: {
+            bool* items = list->items<bool>();
+            int64_t falses = std::count(items, items + n, false);
+            std::fill(items, items + falses, false);
+            std::fill(items + falses, items + n, true);
+            break;
+        }
+        case ListKind::STRING:
+            sort_items(list->items<RuntimeString*>(), n, string_less,
+                       [](RuntimeString** begin, RuntimeString** end, RuntimeString**) {
+                           pdq_sort(begin, end, string_less);
+                       },
+                       false);
+            break;
+        case ListKind::GENERIC:
+            sort_generic(list);
+            break;
+        default:
+            break;
+    }
+    if (reverse) reverse_list(list);
+}
+
+// New list with the same elements, holding its own string references
+static RuntimeList* list_copy(const RuntimeList* list) {
+    auto* copy = runtime_new<RuntimeList>();
+    if (list->length == 0) return copy;
+    copy->kind = list->kind;
+    copy->reserve(list->length);
+    memcpy(copy->data, list->data, list->length * RuntimeList::element_size(list->kind));
+    copy->length = list->length;
+    for (int64_t i = 0; i < copy->length; i++) {
+        if (copy->kind == ListKind::STRING) {
+            string_retain(copy->items<RuntimeString*>()[i]);
+        } else if (copy->kind == ListKind::GENERIC) {
+            const RuntimeValue& val = copy->items<RuntimeValue>()[i];
+            if (val.type == ValueType::STRING) string_retain(static_cast<RuntimeString*>(val.data.ptr_val));
+        }
+    }
+    return copy;
+}
+
+// Dictionary structure (heap-allocated). Holds a reference to each key.
 struct RuntimeDict {
-    std::unordered_map<std::string, RuntimeValue> items;
+    CompactDict<RuntimeString*, RuntimeValue, RuntimeStringHash, RuntimeStringEqual,
+                ActorAllocator<std::pair<RuntimeString* const, RuntimeValue>>> items;
 
     RuntimeDict() = default;
 
-    void set(const std::string& key, const RuntimeValue& val) {
-        items[key] = val;
+    // Takes over val's reference, releasing the value it replaces
+    void set(RuntimeString* key, const RuntimeValue& val) {
+        if (RuntimeValue* existing = items.find(key)) {
+            if (existing->type == ValueType::STRING && existing->data.ptr_val) {
+                string_release(static_cast<RuntimeString*>(existing->data.ptr_val));
+            }
+            *existing = val;
+            return;
+        }
+        string_retain(key);
+        items.insert_or_assign(key, val);
     }
 
-    RuntimeValue get(const std::string& key) {
-        auto it = items.find(key);
-        if (it == items.end()) {
-            std::cerr << "KeyError: '" << key << "'\n";
+    RuntimeValue get(const RuntimeString* key) {
+        const RuntimeValue* val = items.find(key);
+        if (!val) {
+            std::cerr << "KeyError: '" << key->view() << "'\n";
             RuntimeValue err;
             err.type = ValueType::NONE;
             return err;
         }
-        return it->second;
+        return *val;
     }
 
-    bool has_key(const std::string& key) const {
-        return items.find(key) != items.end();
+    bool has_key(const RuntimeString* key) const {
+        return items.contains(key);
     }
 };
 
@@ -108,9 +838,9 @@ void runtime_print_float(double value) {
     std::cout << value << std::endl;
 }
 
-void runtime_print_string(const char* str) {
+void runtime_print_string(void* str) {
     if (str) {
-        std::cout << str << std::endl;
+        std::cout << static_cast<RuntimeString*>(str)->view() << std::endl;
     }
 }
 
@@ -118,6 +848,18 @@ void runtime_print_bool(bool value) {
     std::cout << (value ? "True" : "False") << std::endl;
 }
 
+// --- Integers ---
+
+// Compiled code's checked + - * branch here on overflow (codegen's
+// codegen_checked_int_op): its ints are unboxed i64s, so there is no
+// BigInt to promote to. _Exit, not exit: on a scheduler worker, static
+// destructors would run under the other workers' feet.
+[[noreturn, gnu::cold]] void runtime_int_overflow() {
+    std::cerr << "OverflowError: integer overflow\n";
+    std::cout.flush();
+    std::_Exit(1);
+}
+
 void runtime_print_value(RuntimeValue* val) {
     if (!val) {
         std::cout << "None" << std::endl;
@@ -133,7 +875,7 @@ void runtime_print_value(RuntimeValue* val) {
             break;
         case ValueType::STRING:
             if (val->data.ptr_val) {
-                std::cout << static_cast<char*>(val->data.ptr_val) << std::endl;
+                std::cout << static_cast<RuntimeString*>(val->data.ptr_val)->view() << std::endl;
             }
             break;
         case ValueType::BOOL:
@@ -151,67 +893,367 @@ void runtime_print_value(RuntimeValue* val) {
     }
 }
 
+// --- String Functions ---
+
+// Functions returning a string hand the caller a reference; containers take
+// their own on insert and return borrowed strings.
+
+void* runtime_string_new(const char* data, int64_t length) {
+    return string_new(data, length);
+}
+
+void* runtime_string_from_cstr(const char* str) {
+    return string_new(str, static_cast<int64_t>(strlen(str)));
+}
+
+int64_t runtime_string_length(void* str) {
+    return static_cast<RuntimeString*>(str)->length;
+}
+
+// Not NUL-terminated for substrings; use runtime_string_length
+const char* runtime_string_data(void* str) {
+    return static_cast<RuntimeString*>(str)->data;
+}
+
+int64_t runtime_string_hash(void* str) {
+    return static_cast<int64_t>(static_cast<RuntimeString*>(str)->get_hash());
+}
+
+bool runtime_string_equals(void* a, void* b) {
+    return string_equals(static_cast<RuntimeString*>(a), static_cast<RuntimeString*>(b));
+}
+
+void* runtime_string_concat(void* a_ptr, void* b_ptr) {
+    auto* a = static_cast<RuntimeString*>(a_ptr);
+    auto* b = static_cast<RuntimeString*>(b_ptr);
+
+    char* text;
+    RuntimeString* result = string_alloc(a->length + b->length, &text);
+    memcpy(text, a->data, a->length);
+    memcpy(text + a->length, b->data, b->length);
+    return result;
+}
+
+// str[start:end], clamped. Long results share the source's text.
+void* runtime_string_substring(void* str_ptr, int64_t start, int64_t end) {
+    auto* str = static_cast<RuntimeString*>(str_ptr);
+    start = std::clamp<int64_t>(start, 0, str->length);
+    end = std::clamp<int64_t>(end, start, str->length);
+    int64_t length = end - start;
+
+    if (length <= RuntimeString::INLINE_CAPACITY || (str->flags & RuntimeString::INLINE)) {
+        return string_new(str->data + start, length);
+    }
+
+    auto* result = static_cast<RuntimeString*>(gc_alloc_pinned(sizeof(RuntimeString)));
+    if (!result) throw std::bad_alloc();
+    result->data = str->data + start;
+    result->length = length;
+    result->hash = 0;
+    result->refcount = 1;
+    result->flags = 0;
+    result->buffer = str->buffer;  // Null for constant storage, which never goes away
+    if (result->buffer) result->buffer->refcount++;
+    return result;
+}
+
+// s + x for a loop that only ever extends s (s = s + x). The first append
+// copies s into a BUILDER string with room to spare; later appends write
+// into it in place, doubling the room when it runs out, so building a
+// string in a loop is linear instead of quadratic. Does not take over s.
+void* runtime_string_append(void* s_ptr, void* x_ptr) {
+    auto* s = static_cast<RuntimeString*>(s_ptr);
+    auto* x = static_cast<RuntimeString*>(x_ptr);
+    int64_t length = s->length + x->length;
+
+    bool owned = (s->flags & RuntimeString::BUILDER) && s->refcount == 1 &&
+                 s->buffer->refcount == 1;
+    if (owned && length <= s->buffer->capacity) {
+        memcpy(s->buffer->data + s->length, x->data, x->length);
+        s->buffer->data[length] = '\0';
+        s->length = length;
+        s->hash = 0;
+        return s;
+    }
+
+    StringBuffer* buffer = buffer_alloc(std::max<int64_t>(length * 2, 64));
+    memcpy(buffer->data, s->data, s->length);
+    memcpy(buffer->data + s->length, x->data, x->length);
+    buffer->data[length] = '\0';
+
+    if (owned) {
+        gc_free(s->buffer);
+    } else {
+        s = static_cast<RuntimeString*>(gc_alloc_pinned(sizeof(RuntimeString)));
+        if (!s) throw std::bad_alloc();
+        s->refcount = 1;
+        s->flags = RuntimeString::BUILDER;
+    }
+    s->buffer = buffer;
+    s->data = buffer->data;
+    s->length = length;
+    s->hash = 0;
+    return s;
+}
+
+// Ends a run of appends; the string is an ordinary immutable one again
+void runtime_string_seal(void* str) {
+    auto* s = static_cast<RuntimeString*>(str);
+    if (s && (s->flags & RuntimeString::BUILDER)) s->flags &= ~RuntimeString::BUILDER;
+}
+
+void runtime_string_retain(void* str) {
+    if (str) string_retain(static_cast<RuntimeString*>(str));
+}
+
+void runtime_string_release(void* str) {
+    if (str) string_release(static_cast<RuntimeString*>(str));
+}
+
+// Canonical copy of str; compiled modules run their literals through this
+// at load. Borrowed - interned strings are never freed.
+void* runtime_string_intern(void* str_ptr) {
+    auto* str = static_cast<RuntimeString*>(str_ptr);
+    if (str->flags & RuntimeString::INTERNED) return str;
+
+    InternTable& table = intern_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    str->get_hash();  // Computed before the string can be shared
+    if (RuntimeString** found = table.strings.find(str)) return *found;
+
+    // Literals become canonical in place; anything else is copied out of
+    // the actor's heap first
+    RuntimeString* canonical = str;
+    if (!(str->flags & RuntimeString::IMMORTAL)) {
+        canonical = static_cast<RuntimeString*>(::operator new(sizeof(RuntimeString)));
+        *canonical = *str;
+        canonical->flags = 0;
+        if (str->length <= RuntimeString::INLINE_CAPACITY) {
+            canonical->flags = RuntimeString::INLINE;
+            memcpy(canonical->chars, str->data, str->length);
+            canonical->chars[str->length] = '\0';
+            canonical->data = canonical->chars;
+        } else {
+            auto* text = static_cast<char*>(::operator new(str->length + 1));
+            memcpy(text, str->data, str->length);
+            text[str->length] = '\0';
+            canonical->data = text;
+            canonical->buffer = nullptr;
+        }
+    }
+    canonical->flags |= RuntimeString::IMMORTAL | RuntimeString::INTERNED;
+
+    table.strings.insert_or_assign(canonical, canonical);
+    return canonical;
+}
+
 // --- List Functions ---
 
 // Create a new list on the heap
 void* runtime_list_create() {
-    return new RuntimeList();
+    return runtime_new<RuntimeList>();
 }
 
 // Append an integer to list
 void runtime_list_append_int(void* list_ptr, int64_t value) {
     if (!list_ptr) return;
+    static_cast<RuntimeList*>(list_ptr)->append(value);
+}
+
+void runtime_list_append_float(void* list_ptr, double value) {
+    if (!list_ptr) return;
+    static_cast<RuntimeList*>(list_ptr)->append(value);
+}
+
+void runtime_list_append_bool(void* list_ptr, bool value) {
+    if (!list_ptr) return;
+    static_cast<RuntimeList*>(list_ptr)->append(value);
+}
+
+// Append a string to list - shared, not copied
+void runtime_list_append_string(void* list_ptr, void* str) {
+    if (!list_ptr || !str) return;
+
+    auto* string = static_cast<RuntimeString*>(str);
+    string_retain(string);
+    static_cast<RuntimeList*>(list_ptr)->append(string);
+}
+
+// Get string from list - borrowed
+void* runtime_list_get_string(void* list_ptr, int64_t index) {
+    if (!list_ptr) return nullptr;
 
     auto* list = static_cast<RuntimeList*>(list_ptr);
-    RuntimeValue val;
-    val.type = ValueType::INT;
-    val.data.int_val = value;
-    list->append(val);
+    if (!list->check_index(index)) return nullptr;
+    return list->get_as<RuntimeString*>(index, nullptr);
+}
+
+// Get integer from list. Compiled code reads int lists inline and only
+// calls this for other kinds and out-of-range or negative indexes.
+int64_t runtime_list_get_int(void* list_ptr, int64_t index) {
+    if (!list_ptr) return 0;
+
+    auto* list = static_cast<RuntimeList*>(list_ptr);
+    if (!list->check_index(index)) return 0;
+    return list->get_as<int64_t>(index, 0);
+}
+
+double runtime_list_get_float(void* list_ptr, int64_t index) {
+    if (!list_ptr) return 0.0;
+
+    auto* list = static_cast<RuntimeList*>(list_ptr);
+    if (!list->check_index(index)) return 0.0;
+    return list->get_as<double>(index, 0.0);
 }
 
-// Append a string to list
-void runtime_list_append_string(void* list_ptr, const char* str) {
+bool runtime_list_get_bool(void* list_ptr, int64_t index) {
+    if (!list_ptr) return false;
+
+    auto* list = static_cast<RuntimeList*>(list_ptr);
+    if (!list->check_index(index)) return false;
+    return list->get_as<bool>(index, false);
+}
+
+// list[index] = value
+void runtime_list_set_int(void* list_ptr, int64_t index, int64_t value) {
     if (!list_ptr) return;
 
     auto* list = static_cast<RuntimeList*>(list_ptr);
-    RuntimeValue val;
-    val.type = ValueType::STRING;
+    if (!list->check_index(index)) return;
+    list->set(index, value);
+}
 
-    // Duplicate string
-    size_t len = strlen(str);
-    char* str_copy = new char[len + 1];
-    strcpy(str_copy, str);
+void runtime_list_set_float(void* list_ptr, int64_t index, double value) {
+    if (!list_ptr) return;
 
-    val.data.ptr_val = str_copy;
-    list->append(val);
+    auto* list = static_cast<RuntimeList*>(list_ptr);
+    if (!list->check_index(index)) return;
+    list->set(index, value);
 }
 
-// Get item from list (returns string for now - simplified)
-const char* runtime_list_get_string(void* list_ptr, const int64_t index) {
-    if (!list_ptr) return nullptr;
+void runtime_list_set_string(void* list_ptr, int64_t index, void* str) {
+    if (!list_ptr || !str) return;
 
     auto* list = static_cast<RuntimeList*>(list_ptr);
-    RuntimeValue val = list->get(static_cast<size_t>(index));
+    if (!list->check_index(index)) return;
+    auto* string = static_cast<RuntimeString*>(str);
+    string_retain(string);
+    list->set(index, string);
+}
 
-    if (val.type == ValueType::STRING && val.data.ptr_val) {
-        return static_cast<const char*>(val.data.ptr_val);
-    }
+// Elements of an int list, or null once it holds anything else. Valid
+// until the list next grows or changes kind.
+int64_t* runtime_list_int_data(void* list_ptr) {
+    auto* list = static_cast<RuntimeList*>(list_ptr);
+    if (!list || list->kind != ListKind::INT) return nullptr;
+    return list->items<int64_t>();
+}
 
-    return nullptr;
+double* runtime_list_float_data(void* list_ptr) {
+    auto* list = static_cast<RuntimeList*>(list_ptr);
+    if (!list || list->kind != ListKind::FLOAT) return nullptr;
+    return list->items<double>();
+}
+
+// --- List Aggregates ---
+// Int and float lists run the vectorized kernels (list_kernels.h) over
+// their storage; lists that went generic gather their ints or floats first,
+// ints promoting to float when the float variant is asked for, and any
+// other element a TypeError.
+
+int64_t runtime_list_sum_int(void* list_ptr) {
+    return list_sum<int64_t>(list_ptr, checked_sum);
+}
+
+double runtime_list_sum_float(void* list_ptr) {
+    return list_sum<double>(list_ptr, list_kernels().sum_f64);
+}
+
+int64_t runtime_list_min_int(void* list_ptr) {
+    return list_extreme(list_ptr, "min", list_kernels().min_i64);
+}
+
+int64_t runtime_list_max_int(void* list_ptr) {
+    return list_extreme(list_ptr, "max", list_kernels().max_i64);
+}
+
+double runtime_list_min_float(void* list_ptr) {
+    return list_extreme(list_ptr, "min", list_kernels().min_f64);
 }
 
-// Get integer from list
-int64_t runtime_list_get_int(void* list_ptr, const int64_t index) {
+double runtime_list_max_float(void* list_ptr) {
+    return list_extreme(list_ptr, "max", list_kernels().max_f64);
+}
+
+// list.count(value)
+int64_t runtime_list_count_int(void* list_ptr, int64_t value) {
     if (!list_ptr) return 0;
+    return list_count(static_cast<RuntimeList*>(list_ptr), value, list_kernels().count_i64);
+}
 
-    auto* list = static_cast<RuntimeList*>(list_ptr);
-    RuntimeValue val = list->get(static_cast<size_t>(index));
+int64_t runtime_list_count_float(void* list_ptr, double value) {
+    if (!list_ptr) return 0;
+    return list_count(static_cast<RuntimeList*>(list_ptr), value, list_kernels().count_f64);
+}
 
-    if (val.type == ValueType::INT) {
-        return val.data.int_val;
-    }
+// list.index(value); a missing value is a ValueError and gives -1
+int64_t runtime_list_index_int(void* list_ptr, int64_t value) {
+    if (!list_ptr) return -1;
+    int64_t index = list_find(static_cast<RuntimeList*>(list_ptr), value, list_kernels().find_i64);
+    if (index < 0) std::cerr << "ValueError: " << value << " is not in list\n";
+    return index;
+}
 
-    return 0;
+int64_t runtime_list_index_float(void* list_ptr, double value) {
+    if (!list_ptr) return -1;
+    int64_t index = list_find(static_cast<RuntimeList*>(list_ptr), value, list_kernels().find_f64);
+    if (index < 0) std::cerr << "ValueError: " << value << " is not in list\n";
+    return index;
+}
+
+// value in list
+bool runtime_list_contains_int(void* list_ptr, int64_t value) {
+    return list_ptr && list_find(static_cast<RuntimeList*>(list_ptr), value, list_kernels().find_i64) >= 0;
+}
+
+bool runtime_list_contains_float(void* list_ptr, double value) {
+    return list_ptr && list_find(static_cast<RuntimeList*>(list_ptr), value, list_kernels().find_f64) >= 0;
+}
+
+// Element-wise arithmetic with a scalar, into a new list; int results
+// that overflow are an OverflowError
+void* runtime_list_add_int(void* list_ptr, int64_t value) {
+    if (!list_ptr) return nullptr;
+    return list_map(static_cast<RuntimeList*>(list_ptr), value, list_kernels().add_i64, add_fits);
+}
+
+void* runtime_list_mul_int(void* list_ptr, int64_t value) {
+    if (!list_ptr) return nullptr;
+    return list_map(static_cast<RuntimeList*>(list_ptr), value, list_kernels().mul_i64, mul_fits);
+}
+
+void* runtime_list_add_float(void* list_ptr, double value) {
+    if (!list_ptr) return nullptr;
+    return list_map(static_cast<RuntimeList*>(list_ptr), value, list_kernels().add_f64);
+}
+
+void* runtime_list_mul_float(void* list_ptr, double value) {
+    if (!list_ptr) return nullptr;
+    return list_map(static_cast<RuntimeList*>(list_ptr), value, list_kernels().mul_f64);
+}
+
+// list.sort() and sorted(). An unorderable list (mixed strings and
+// numbers, None, containers) is a TypeError and stays as it was.
+void runtime_list_sort(void* list_ptr, bool reverse) {
+    if (!list_ptr) return;
+    sort_list(static_cast<RuntimeList*>(list_ptr), reverse);
+}
+
+void* runtime_list_sorted(void* list_ptr, bool reverse) {
+    if (!list_ptr) return nullptr;
+    RuntimeList* result = list_copy(static_cast<RuntimeList*>(list_ptr));
+    sort_list(result, reverse);
+    return result;
 }
 
 // Get list size
@@ -226,77 +1268,62 @@ int64_t runtime_list_len(void* list_ptr) {
     return runtime_list_size(list_ptr);
 }
 
-// Free list
+// Free list, releasing its strings
 void runtime_list_free(void* list_ptr) {
     if (!list_ptr) return;
-
-    auto* list = static_cast<RuntimeList*>(list_ptr);
-
-    // Free string data
-    for (const auto& item : list->items) {
-        if (item.type == ValueType::STRING && item.data.ptr_val) {
-            delete[] static_cast<char*>(item.data.ptr_val);
-        }
-    }
-
-    delete list;
+    runtime_delete(static_cast<RuntimeList*>(list_ptr));
 }
 
 // --- Dictionary Functions ---
 
 // Create a new dictionary on the heap
 void* runtime_dict_create() {
-    return new RuntimeDict();
+    return runtime_new<RuntimeDict>();
 }
 
-// Set string value in dict
-void runtime_dict_set_string(void* dict_ptr, const char* key, const char* value) {
+// Set string value in dict - shared, not copied
+void runtime_dict_set_string(void* dict_ptr, void* key, void* value) {
     if (!dict_ptr || !key || !value) return;
 
     auto* dict = static_cast<RuntimeDict*>(dict_ptr);
     RuntimeValue val;
     val.type = ValueType::STRING;
-
-    // Duplicate string
-    size_t len = strlen(value);
-    char* str_copy = new char[len + 1];
-    strcpy(str_copy, value);
-
-    val.data.ptr_val = str_copy;
-    dict->set(std::string(key), val);
+    string_retain(static_cast<RuntimeString*>(value));
+    val.data.ptr_val = value;
+    dict->set(static_cast<RuntimeString*>(key), val);
 }
 
 // Set integer value in dict
-void runtime_dict_set_int(void* dict_ptr, const char* key, int64_t value) {
+void runtime_dict_set_int(void* dict_ptr, void* key, int64_t value) {
     if (!dict_ptr || !key) return;
 
     auto* dict = static_cast<RuntimeDict*>(dict_ptr);
     RuntimeValue val;
     val.type = ValueType::INT;
     val.data.int_val = value;
-    dict->set(std::string(key), val);
+    dict->set(static_cast<RuntimeString*>(key), val);
 }
 
 // Get string from dict
-const char* runtime_dict_get_string(void* dict_ptr, const char* key) {
+void* runtime_dict_get_string(void* dict_ptr, void* key) {
     if (!dict_ptr || !key) return nullptr;
 
     auto* dict = static_cast<RuntimeDict*>(dict_ptr);
-    RuntimeValue val = dict->get(std::string(key));
+    RuntimeValue val = dict->get(static_cast<RuntimeString*>(key));
 
     if (val.type == ValueType::STRING && val.data.ptr_val) {
-        return static_cast<const char*>(val.data.ptr_val);
+        return val.data.ptr_val;
     }
 
     return nullptr;
 }
 
 // Get integer from dict
-int64_t runtime_dict_get_int(void* dict_ptr, const char* key) {
+int64_t runtime_dict_get_int(void* dict_ptr, void* key) {
     if (!dict_ptr || !key) return 0;
 
     auto* dict = static_cast<RuntimeDict*>(dict_ptr);
-    RuntimeValue val = dict->get(std::string(key));
+    RuntimeValue val = dict->get(static_cast<RuntimeString*>(key));
 
     if (val.type == ValueType::INT) {
         return val.data.int_val;
@@ -306,11 +1333,11 @@ int64_t runtime_dict_get_int(void* dict_ptr, const char* key) {
 }
 
 // Check if key exists in dict
-bool runtime_dict_has_key(void* dict_ptr, const char* key) {
+bool runtime_dict_has_key(void* dict_ptr, void* key) {
     if (!dict_ptr || !key) return false;
 
     auto* dict = static_cast<RuntimeDict*>(dict_ptr);
-    return dict->has_key(std::string(key));
+    return dict->has_key(static_cast<RuntimeString*>(key));
 }
 
 // Free dictionary
@@ -319,14 +1346,15 @@ void runtime_dict_free(void* dict_ptr) {
 
     auto* dict = static_cast<RuntimeDict*>(dict_ptr);
 
-    // Free string data
-    for (auto& pair : dict->items) {
-        if (pair.second.type == ValueType::STRING && pair.second.data.ptr_val) {
-            delete[] static_cast<char*>(pair.second.data.ptr_val);
+    // Release keys and strings
+    for (auto& entry : dict->items) {
+        string_release(entry.key);
+        if (entry.value.type == ValueType::STRING && entry.value.data.ptr_val) {
+            string_release(static_cast<RuntimeString*>(entry.value.data.ptr_val));
         }
     }
 
-    delete dict;
+    runtime_delete(dict);
 }
 
 
@@ -342,10 +1370,10 @@ void runtime_list_print(void* list_ptr) {
     const auto* list = static_cast<RuntimeList*>(list_ptr);
 
     std::cout << "[";
-    for (size_t i = 0; i < list->items.size(); i++) {
+    for (int64_t i = 0; i < list->length; i++) {
         if (i > 0) std::cout << ", ";
 
-        auto& item = list->items[i];
+        RuntimeValue item = list->get(i);
 
         // Print based on type
         switch (item.type) {
@@ -357,7 +1385,7 @@ void runtime_list_print(void* list_ptr) {
                 break;
             case ValueType::STRING:
                 if (item.data.ptr_val) {
-                    std::cout << "\"" << static_cast<char*>(item.data.ptr_val) << "\"";
+                    std::cout << "\"" << static_cast<RuntimeString*>(item.data.ptr_val)->view() << "\"";
                 }
                 break;
             case ValueType::BOOL:
@@ -387,11 +1415,13 @@ void runtime_dict_print(void* dict_ptr) {
 
     std::cout << "{";
     bool first = true;
-    for (const auto& [key, value] : dict->items) {
+    for (const auto& entry : dict->items) {
+        const auto& key = entry.key;
+        const auto& value = entry.value;
         if (!first) std::cout << ", ";
         first = false;
 
-        std::cout << "\"" << key << "\": ";
+        std::cout << "\"" << key->view() << "\": ";
 
         // Print value based on type
         switch (value.type) {
@@ -403,7 +1433,7 @@ void runtime_dict_print(void* dict_ptr) {
                 break;
             case ValueType::STRING:
                 if (value.data.ptr_val) {
-                    std::cout << "\"" << static_cast<char*>(value.data.ptr_val) << "\"";
+                    std::cout << "\"" << static_cast<RuntimeString*>(value.data.ptr_val)->view() << "\"";
                 }
                 break;
             case ValueType::BOOL:
@@ -585,38 +1615,416 @@ public:
 
 */
 
+} // extern "C"
+
 // ============================================================================
 // HeapObject — base structure for all heap-allocated class objects
 // ============================================================================
 
+// One field. Compiled code lays a class out as a struct of its header and
+// one typed slot per declared field (i64, double, ptr; bool takes the
+// whole word) and accesses fields with plain loads and stores; the
+// runtime_class_*_field helpers below are for dynamic access by index.
+union FieldSlot {
+    int64_t i;
+    double  f;
+    void*   p;
+};
+static_assert(sizeof(FieldSlot) == 8, "Codegen assumes one 64-bit word per field");
+
+// Biased reference counting: almost every object is only ever touched by
+// the actor (or, outside actors, the thread) that created it, which counts
+// in biased_count without atomics. runtime_share hands an object that
+// escapes its owner over to shared_count; every later retain/release is
+// atomic. An owner whose count drops to zero also merges, so references
+// taken by other threads keep the object alive.
 struct HeapObject {
-    std::atomic<int64_t> ref_count;  // atomic for thread safety
+    std::atomic<uintptr_t> owner;         // Owner token, 0 once shared
+    int64_t              biased_count;    // Owner thread only
+    std::atomic<int64_t> shared_count;    // (count << 1) | merged bit
+    bool                 in_actor_heap;   // Allocated from an actor's collector
+    std::atomic<uint8_t> gc_flags;        // GC_BUFFERED / GC_FREED / GC_HELD
     const char*          class_name;
     int64_t              num_fields;
-    void*                fields[];   // flexible array member (C99)
+    const uint8_t*       pointer_map;     // Per field: 1 if it holds an object; null if none do
+    FieldSlot            fields[];        // Flexible array member, one slot per field
+};
+
+// Codegen mirrors this as %HeapObject.header { i64, i64, i64, i8, i8, ptr, i64, ptr }
+static_assert(offsetof(HeapObject, fields) == 56, "Header layout changed; update LLVMCodeGen::heap_object_header_type");
+
+static constexpr int64_t SHARED_ONE = 2;
+static constexpr int64_t SHARED_MERGED = 1;
+
+// An object in a cycle-candidate buffer must stay allocated until the
+// buffer is processed, even if its count reaches zero meanwhile
+static constexpr uint8_t GC_BUFFERED = 1;
+static constexpr uint8_t GC_FREED = 2;
+
+// A shared object in an actor's heap keeps that heap alive (ActorGC::hold)
+// until it is freed, even if the actor dies first
+static constexpr uint8_t GC_HELD = 4;
+
+// Candidates queued before an allocation collects cycles on the spot;
+// actors are normally collected earlier, while idle, by the scheduler
+static constexpr size_t CYCLE_CANDIDATE_LIMIT = 10000;
+
+// Actors migrate between workers, so inside one the actor is the owner
+static uintptr_t current_owner_token() {
+    static thread_local char thread_token;
+    if (aithon::runtime::current_actor_gc) {
+        return reinterpret_cast<uintptr_t>(aithon::runtime::current_actor_gc);
+    }
+    return reinterpret_cast<uintptr_t>(&thread_token);
+}
+
+static size_t heap_object_size(const HeapObject* obj) {
+    return sizeof(HeapObject) + obj->num_fields * sizeof(FieldSlot);
+}
+
+// Visit the objects referenced from obj's object fields
+template<typename Fn>
+static void for_each_child(HeapObject* obj, Fn&& fn) {
+    if (!obj->pointer_map) return;
+    for (int64_t i = 0; i < obj->num_fields; i++) {
+        if (obj->pointer_map[i] && obj->fields[i].p) {
+            fn(static_cast<HeapObject*>(obj->fields[i].p));
+        }
+    }
+}
+
+// ============================================================================
+// Object statistics — counted per thread so the free path stays
+// uncontended; readers sum the live threads and those that have exited
+// ============================================================================
+
+struct ObjectCounters {
+    std::atomic<uint64_t> objects_allocated{0};
+    std::atomic<uint64_t> objects_freed{0};
+    std::atomic<uint64_t> bytes_allocated{0};
+    std::atomic<uint64_t> bytes_freed{0};
+    std::atomic<uint64_t> cycle_collections{0};
+    std::atomic<uint64_t> cycle_objects_freed{0};
+};
+
+struct ObjectCounterRegistry {
+    std::mutex mutex;
+    std::vector<ObjectCounters*> live;
+    ObjectCounters retired;
+
+    static ObjectCounterRegistry& instance() {
+        static auto* registry = new ObjectCounterRegistry();  // Outlives every thread
+        return *registry;
+    }
+
+    template<typename Fn>
+    void for_each(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(mutex);
+        fn(retired);
+        for (ObjectCounters* counters : live) fn(*counters);
+    }
+};
+
+// Only the owning thread writes its counters
+static void bump(std::atomic<uint64_t>& counter, uint64_t n) {
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+static void retire(std::atomic<uint64_t>& into, const std::atomic<uint64_t>& from) {
+    into.fetch_add(from.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+struct ThreadObjectCounters : ObjectCounters {
+    ThreadObjectCounters() {
+        auto& registry = ObjectCounterRegistry::instance();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.live.push_back(this);
+    }
+
+    ~ThreadObjectCounters() {
+        auto& registry = ObjectCounterRegistry::instance();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        retire(registry.retired.objects_allocated, objects_allocated);
+        retire(registry.retired.objects_freed, objects_freed);
+        retire(registry.retired.bytes_allocated, bytes_allocated);
+        retire(registry.retired.bytes_freed, bytes_freed);
+        retire(registry.retired.cycle_collections, cycle_collections);
+        retire(registry.retired.cycle_objects_freed, cycle_objects_freed);
+        std::erase(registry.live, this);
+    }
+};
+
+static ObjectCounters& thread_counters() {
+    static thread_local ThreadObjectCounters counters;
+    return counters;
+}
+
+// ============================================================================
+// Freeing
+// ============================================================================
+
+static void deallocate_heap_object(HeapObject* obj) {
+    aithon::runtime::ActorGC* held = nullptr;
+    if (obj->gc_flags.load(std::memory_order_relaxed) & GC_HELD) {
+        held = aithon::runtime::ActorGC::owner_of(obj);
+    }
+
+    // An actor-heap object whose last reference died on another thread is
+    // queued to its owner, which reuses the block at its next quantum
+    gc_free(obj);
+
+    // May free the heap of an actor that has already died
+    if (held) {
+        held->unhold();
+    }
+}
+
+// The object is dead; its memory goes now unless a cycle-candidate buffer
+// still points at it, in which case processing the buffer frees it
+static void reclaim_heap_object(HeapObject* obj) {
+    ObjectCounters& counters = thread_counters();
+    bump(counters.objects_freed, 1);
+    bump(counters.bytes_freed, heap_object_size(obj));
+
+    if (obj->gc_flags.fetch_or(GC_FREED, std::memory_order_acq_rel) & GC_BUFFERED) {
+        return;
+    }
+    deallocate_heap_object(obj);
+}
+
+// Objects released outside actors wait here for cycle detection
+struct ThreadCycleCandidates {
+    std::vector<void*> objects;
+
+    ~ThreadCycleCandidates() {
+        // The thread's objects can no longer be traced; hand each one back
+        // to its count, freeing those that already died
+        for (void* ptr : objects) {
+            auto* obj = static_cast<HeapObject*>(ptr);
+            if (obj->gc_flags.fetch_and(GC_HELD, std::memory_order_acq_rel) & GC_FREED) {
+                deallocate_heap_object(obj);
+            }
+        }
+    }
 };
 
+static thread_local ThreadCycleCandidates thread_cycle_candidates;
+
+static size_t pending_cycle_candidates() {
+    if (aithon::runtime::current_actor_gc) {
+        return aithon::runtime::current_actor_gc->cycle_candidates();
+    }
+    return thread_cycle_candidates.objects.size();
+}
+
+// Called by the owner when a release leaves the count above zero: the
+// remaining references may all come from a garbage cycle
+static void buffer_cycle_candidate(HeapObject* obj) {
+    if (!obj->pointer_map || (obj->gc_flags.load(std::memory_order_relaxed) & GC_BUFFERED)) {
+        return;  // No object fields, or already queued
+    }
+
+    obj->gc_flags.fetch_or(GC_BUFFERED, std::memory_order_relaxed);
+    if (aithon::runtime::current_actor_gc) {
+        aithon::runtime::current_actor_gc->add_cycle_candidate(obj);
+    } else {
+        thread_cycle_candidates.objects.push_back(obj);
+    }
+}
+
+// Drop one reference; true when it was the last
+static bool drop_reference(HeapObject* obj) {
+    if (obj->owner.load(std::memory_order_relaxed) == current_owner_token()) {
+        if (--obj->biased_count > 0) {
+            buffer_cycle_candidate(obj);
+            return false;
+        }
+
+        // Owner is done - merge. If no other thread holds a reference the
+        // object is dead, otherwise the last shared release frees it.
+        obj->owner.store(0, std::memory_order_relaxed);
+        int64_t old_shared = obj->shared_count.fetch_add(SHARED_MERGED, std::memory_order_acq_rel);
+        return old_shared == 0;
+    }
+
+    int64_t old_shared = obj->shared_count.fetch_sub(SHARED_ONE, std::memory_order_acq_rel);
+    // Last reference, and the owner has already merged
+    return old_shared == SHARED_ONE + SHARED_MERGED;
+}
+
+// Free obj and everything only it kept alive. Releasing a field can free
+// its target in turn; those are queued instead of recursed into, so no
+// chain of objects is too long to free.
+static void free_heap_object(HeapObject* obj) {
+    if (!obj->pointer_map) {
+        reclaim_heap_object(obj);
+        return;
+    }
+
+    static thread_local std::vector<HeapObject*> dead;
+    size_t base = dead.size();
+    dead.push_back(obj);
+    while (dead.size() > base) {
+        HeapObject* next = dead.back();
+        dead.pop_back();
+        for_each_child(next, [](HeapObject* child) {
+            if (drop_reference(child)) dead.push_back(child);
+        });
+        reclaim_heap_object(next);
+    }
+}
+
+// ============================================================================
+// Cycle collection — trial deletion. Every reference from inside the
+// candidates' subgraph is subtracted from a scratch copy of the counts;
+// objects left without an outside reference, direct or through a
+// reachable object, are garbage cycles. Only objects the caller owns are
+// traced: their counts cannot change underneath it, and anything shared
+// is treated as referenced from outside.
+// ============================================================================
+
+static constexpr int64_t TRIAL_REACHABLE = INT64_MIN;
+
+static size_t collect_cycles(std::vector<void*>& candidates) {
+    uintptr_t self = current_owner_token();
+    auto owned = [self](HeapObject* obj) {
+        return obj->owner.load(std::memory_order_relaxed) == self;
+    };
+    auto total_count = [](HeapObject* obj) {
+        return obj->biased_count + (obj->shared_count.load(std::memory_order_acquire) >> 1);
+    };
+
+    std::unordered_map<HeapObject*, int64_t> trial;
+    std::vector<HeapObject*> stack;
+
+    // Take the objects off the buffer. Ones that died while queued are
+    // freed now; shared ones go back to their atomic counts.
+    for (void* ptr : candidates) {
+        auto* obj = static_cast<HeapObject*>(ptr);
+        if (!owned(obj)) {
+            if (obj->gc_flags.fetch_and(GC_HELD, std::memory_order_acq_rel) & GC_FREED) {
+                deallocate_heap_object(obj);
+            }
+            continue;
+        }
+        obj->gc_flags.fetch_and(GC_HELD, std::memory_order_relaxed);
+        if (trial.emplace(obj, total_count(obj)).second) {
+            stack.push_back(obj);
+        }
+    }
+
+    // Subtract internal references. An object other threads also point
+    // to is not traced: its fields may change underneath us, and leaving
+    // its children's counts alone keeps them alive.
+    while (!stack.empty()) {
+        HeapObject* obj = stack.back();
+        stack.pop_back();
+        if (obj->shared_count.load(std::memory_order_relaxed) >> 1 != 0) continue;
+
+        for_each_child(obj, [&](HeapObject* child) {
+            if (!owned(child)) return;
+            auto [it, inserted] = trial.emplace(child, total_count(child));
+            if (inserted) stack.push_back(child);
+            it->second--;
+        });
+    }
+
+    // Everything reachable from an object with outside references is live
+    for (auto& [obj, refs] : trial) {
+        if (refs != 0) stack.push_back(obj);
+    }
+    while (!stack.empty()) {
+        HeapObject* obj = stack.back();
+        stack.pop_back();
+        auto it = trial.find(obj);
+        if (it->second == TRIAL_REACHABLE) continue;
+        it->second = TRIAL_REACHABLE;
+
+        for_each_child(obj, [&](HeapObject* child) {
+            auto child_it = trial.find(child);
+            if (child_it != trial.end() && child_it->second != TRIAL_REACHABLE) {
+                stack.push_back(child);
+            }
+        });
+    }
+
+    std::vector<HeapObject*> garbage;
+    for (auto& [obj, refs] : trial) {
+        if (refs == 0) garbage.push_back(obj);
+    }
+
+    // References between garbage objects die with them; live objects never
+    // point into the garbage, so releasing the rest cannot free any of it
+    for (HeapObject* obj : garbage) {
+        for_each_child(obj, [&](HeapObject* child) {
+            auto it = trial.find(child);
+            if (it != trial.end() && it->second == 0) return;
+            if (drop_reference(child)) free_heap_object(child);
+        });
+    }
+    for (HeapObject* obj : garbage) {
+        reclaim_heap_object(obj);
+    }
+
+    ObjectCounters& counters = thread_counters();
+    bump(counters.cycle_collections, 1);
+    bump(counters.cycle_objects_freed, garbage.size());
+    return garbage.size();
+}
+
+// Let actor collectors run cycle detection on their own candidates
+static const bool cycle_collector_installed = [] {
+    aithon::runtime::ActorGC::set_cycle_collector(collect_cycles);
+    return true;
+}();
+
+static size_t collect_current_cycles() {
+    if (aithon::runtime::current_actor_gc) {
+        return aithon::runtime::current_actor_gc->collect_cycles();
+    }
+
+    std::vector<void*> candidates;
+    candidates.swap(thread_cycle_candidates.objects);
+    return collect_cycles(candidates);
+}
+
+extern "C" {
+
 // ============================================================================
 // runtime_class_create — allocate class object on heap
 // ============================================================================
 
-void* runtime_class_create(const char* class_name, int64_t num_fields) {
+void* runtime_class_create(const char* class_name, int64_t num_fields,
+                           const uint8_t* pointer_map) {
+    if (pending_cycle_candidates() >= CYCLE_CANDIDATE_LIMIT) {
+        collect_current_cycles();
+    }
+
     // Allocate: sizeof(HeapObject) + space for fields
-    size_t size = sizeof(HeapObject) + (num_fields * sizeof(void*));
-    auto* obj = static_cast<HeapObject*>(std::malloc(size));
+    size_t size = sizeof(HeapObject) + (num_fields * sizeof(FieldSlot));
+    auto* obj = static_cast<HeapObject*>(gc_alloc_pinned(size));
 
     if (!obj) {
         std::cerr << "ERROR: Failed to allocate class object: " << class_name << "\n";
         std::exit(1);
     }
 
-    // Initialize
-    obj->ref_count.store(1);  // starts with ref_count=1
+    // Initialize - the creating thread holds the first reference
+    new (&obj->owner) std::atomic<uintptr_t>(current_owner_token());
+    obj->biased_count = 1;
+    new (&obj->shared_count) std::atomic<int64_t>(0);
+    obj->in_actor_heap = aithon::runtime::current_actor_gc && aithon::runtime::current_actor_gc->owns(obj);
+    new (&obj->gc_flags) std::atomic<uint8_t>(0);
     obj->class_name = class_name;
     obj->num_fields = num_fields;
+    obj->pointer_map = pointer_map;
 
     // Zero-initialize all fields
-    std::memset(obj->fields, 0, num_fields * sizeof(void*));
+    std::memset(obj->fields, 0, num_fields * sizeof(FieldSlot));
+
+    ObjectCounters& counters = thread_counters();
+    bump(counters.objects_allocated, 1);
+    bump(counters.bytes_allocated, size);
 
     return obj;
 }
@@ -629,11 +2037,55 @@ void* runtime_retain(void* ptr) {
     if (!ptr) return nullptr;
 
     auto* obj = static_cast<HeapObject*>(ptr);
-    obj->ref_count.fetch_add(1, std::memory_order_relaxed);
+    if (obj->owner.load(std::memory_order_relaxed) == current_owner_token()) {
+        obj->biased_count++;
+    } else {
+        obj->shared_count.fetch_add(SHARED_ONE, std::memory_order_relaxed);
+    }
 
     return ptr;  // return same pointer
 }
 
+// ============================================================================
+// runtime_share — called by the owner before an object escapes to another
+// actor or thread; moves its references, and those of every object it
+// reaches, to the atomic counts
+// ============================================================================
+
+static bool share_one(HeapObject* obj) {
+    if (obj->owner.load(std::memory_order_relaxed) != current_owner_token()) {
+        return false;  // Already shared
+    }
+
+    obj->owner.store(0, std::memory_order_relaxed);
+    obj->shared_count.fetch_add(obj->biased_count * SHARED_ONE + SHARED_MERGED,
+                                std::memory_order_release);
+    obj->biased_count = 0;
+
+    // Other actors may now outlive this one and still reach the object
+    if (obj->in_actor_heap) {
+        obj->gc_flags.fetch_or(GC_HELD, std::memory_order_relaxed);
+        aithon::runtime::ActorGC::owner_of(obj)->hold();
+    }
+    return true;
+}
+
+void runtime_share(void* ptr) {
+    if (!ptr) return;
+
+    auto* obj = static_cast<HeapObject*>(ptr);
+    if (!share_one(obj) || !obj->pointer_map) return;
+
+    std::vector<HeapObject*> pending{obj};
+    while (!pending.empty()) {
+        HeapObject* next = pending.back();
+        pending.pop_back();
+        for_each_child(next, [&pending](HeapObject* child) {
+            if (share_one(child)) pending.push_back(child);
+        });
+    }
+}
+
 // ============================================================================
 // runtime_release — decrement reference count, free if reaches zero
 // ============================================================================
@@ -642,15 +2094,61 @@ void runtime_release(void* ptr) {
     if (!ptr) return;
 
     auto* obj = static_cast<HeapObject*>(ptr);
-    int64_t old_count = obj->ref_count.fetch_sub(1, std::memory_order_acq_rel);
+    if (drop_reference(obj)) {
+        free_heap_object(obj);
+    }
+}
 
-    if (old_count == 1) {
-        // ref_count reached 0 → deallocate
+// ============================================================================
+// Cycle collection and statistics
+// ============================================================================
 
-        // TODO: Release fields that are also heap objects
-        // For now, simple free
-        std::free(obj);
-    }
+// Collect garbage cycles among the calling actor's (or thread's) objects
+// now; returns the number of objects freed
+int64_t runtime_collect_cycles() {
+    return static_cast<int64_t>(collect_current_cycles());
+}
+
+uint64_t runtime_objects_freed() {
+    uint64_t freed = 0;
+    ObjectCounterRegistry::instance().for_each([&](const ObjectCounters& c) {
+        freed += c.objects_freed.load(std::memory_order_relaxed);
+    });
+    return freed;
+}
+
+// Bytes of objects whose last reference has not been released - live
+// objects while the program runs, leaks once it is done
+uint64_t runtime_leaked_bytes() {
+    uint64_t allocated = 0, freed = 0;
+    ObjectCounterRegistry::instance().for_each([&](const ObjectCounters& c) {
+        allocated += c.bytes_allocated.load(std::memory_order_relaxed);
+        freed += c.bytes_freed.load(std::memory_order_relaxed);
+    });
+    return allocated - std::min(allocated, freed);
+}
+
+void runtime_print_gc_stats() {
+    uint64_t objects_allocated = 0, objects_freed = 0;
+    uint64_t bytes_allocated = 0, bytes_freed = 0;
+    uint64_t cycle_collections = 0, cycle_objects_freed = 0;
+    ObjectCounterRegistry::instance().for_each([&](const ObjectCounters& c) {
+        objects_allocated += c.objects_allocated.load(std::memory_order_relaxed);
+        objects_freed += c.objects_freed.load(std::memory_order_relaxed);
+        bytes_allocated += c.bytes_allocated.load(std::memory_order_relaxed);
+        bytes_freed += c.bytes_freed.load(std::memory_order_relaxed);
+        cycle_collections += c.cycle_collections.load(std::memory_order_relaxed);
+        cycle_objects_freed += c.cycle_objects_freed.load(std::memory_order_relaxed);
+    });
+
+    std::cout << "=== Runtime Object Stats ===\n";
+    std::cout << "Objects allocated: " << objects_allocated << "\n";
+    std::cout << "Objects freed: " << objects_freed << "\n";
+    std::cout << "Bytes allocated: " << bytes_allocated << "\n";
+    std::cout << "Bytes freed: " << bytes_freed << "\n";
+    std::cout << "Leaked bytes: " << bytes_allocated - std::min(bytes_allocated, bytes_freed) << "\n";
+    std::cout << "Cycle collections: " << cycle_collections << "\n";
+    std::cout << "Objects freed from cycles: " << cycle_objects_freed << "\n";
 }
 
 // ============================================================================
@@ -662,8 +2160,7 @@ void runtime_class_set_field_int(void* ptr, int64_t field_idx, int64_t value) {
     auto* obj = static_cast<HeapObject*>(ptr);
     if (field_idx < 0 || field_idx >= obj->num_fields) return;
 
-    // Store int as void* (type-punning)
-    obj->fields[field_idx] = reinterpret_cast<void*>(value);
+    obj->fields[field_idx].i = value;
 }
 
 void runtime_class_set_field_float(void* ptr, int64_t field_idx, double value) {
@@ -671,10 +2168,7 @@ void runtime_class_set_field_float(void* ptr, int64_t field_idx, double value) {
     auto* obj = static_cast<HeapObject*>(ptr);
     if (field_idx < 0 || field_idx >= obj->num_fields) return;
 
-    // Store double as void* (type-punning via union)
-    union { double d; void* p; } u{};
-    u.d = value;
-    obj->fields[field_idx] = u.p;
+    obj->fields[field_idx].f = value;
 }
 
 void runtime_class_set_field_bool(void* ptr, int64_t field_idx, bool value) {
@@ -682,7 +2176,7 @@ void runtime_class_set_field_bool(void* ptr, int64_t field_idx, bool value) {
     auto* obj = static_cast<HeapObject*>(ptr);
     if (field_idx < 0 || field_idx >= obj->num_fields) return;
 
-    obj->fields[field_idx] = reinterpret_cast<void*>(static_cast<uintptr_t>(value));
+    obj->fields[field_idx].i = value;  // Whole word, as compiled code stores it
 }
 
 void runtime_class_set_field_ptr(void* ptr, int64_t field_idx, void* value) {
@@ -690,19 +2184,25 @@ void runtime_class_set_field_ptr(void* ptr, int64_t field_idx, void* value) {
     auto* obj = static_cast<HeapObject*>(ptr);
     if (field_idx < 0 || field_idx >= obj->num_fields) return;
 
-    // If the new value is also a heap object, retain it
-    // (Assumes all ptr fields are heap objects — refine later)
+    // Only object fields are counted; strings and collections are stored as is
+    if (!obj->pointer_map || !obj->pointer_map[field_idx]) {
+        obj->fields[field_idx].p = value;
+        return;
+    }
+
     if (value) {
         runtime_retain(value);
+        // Whatever a foreign or shared object points to is shared as well
+        if (obj->owner.load(std::memory_order_relaxed) != current_owner_token()) {
+            runtime_share(value);
+        }
     }
 
-    // Release old value if it was a heap object
-    void* old_value = obj->fields[field_idx];
+    void* old_value = obj->fields[field_idx].p;
+    obj->fields[field_idx].p = value;
     if (old_value) {
         runtime_release(old_value);
     }
-
-    obj->fields[field_idx] = value;
 }
 
 // ============================================================================
@@ -714,7 +2214,7 @@ int64_t runtime_class_get_field_int(void* ptr, int64_t field_idx) {
     auto* obj = static_cast<HeapObject*>(ptr);
     if (field_idx < 0 || field_idx >= obj->num_fields) return 0;
 
-    return reinterpret_cast<int64_t>(obj->fields[field_idx]);
+    return obj->fields[field_idx].i;
 }
 
 double runtime_class_get_field_float(void* ptr, int64_t field_idx) {
@@ -722,9 +2222,7 @@ double runtime_class_get_field_float(void* ptr, int64_t field_idx) {
     auto* obj = static_cast<HeapObject*>(ptr);
     if (field_idx < 0 || field_idx >= obj->num_fields) return 0.0;
 
-    union { void* p; double d; } u{};
-    u.p = obj->fields[field_idx];
-    return u.d;
+    return obj->fields[field_idx].f;
 }
 
 bool runtime_class_get_field_bool(void* ptr, int64_t field_idx) {
@@ -732,7 +2230,7 @@ bool runtime_class_get_field_bool(void* ptr, int64_t field_idx) {
     auto* obj = static_cast<HeapObject*>(ptr);
     if (field_idx < 0 || field_idx >= obj->num_fields) return false;
 
-    return static_cast<bool>(reinterpret_cast<uintptr_t>(obj->fields[field_idx]));
+    return obj->fields[field_idx].i != 0;
 }
 
 void* runtime_class_get_field_ptr(void* ptr, int64_t field_idx) {
@@ -740,7 +2238,7 @@ void* runtime_class_get_field_ptr(void* ptr, int64_t field_idx) {
     auto* obj = static_cast<HeapObject*>(ptr);
     if (field_idx < 0 || field_idx >= obj->num_fields) return nullptr;
 
-    return obj->fields[field_idx];
+    return obj->fields[field_idx].p;
 }
 
 
@@ -9,6 +9,26 @@ Scheduler* global_scheduler = nullptr;
 
 Scheduler::Worker::Worker() : rng(std::random_device{}()) {}
 
+struct Scheduler::ParallelJob {
+    ParallelTask task;
+    void* ctx;
+    size_t count;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    
+    // Claims and runs tasks until none are left; false if it got none
+    bool run() {
+        bool ran = false;
+        size_t i;
+        while ((i = next.fetch_add(1, std::memory_order_relaxed)) < count) {
+            task(ctx, i);
+            done.fetch_add(1, std::memory_order_release);
+            ran = true;
+        }
+        return ran;
+    }
+};
+
 Scheduler::Scheduler(size_t num_threads) {
     if (num_threads == 0) {
         num_threads = std::thread::hardware_concurrency();
@@ -26,6 +46,15 @@ Scheduler::Scheduler(size_t num_threads) {
     }
     
     global_scheduler = this;
+    
+    parallel_runner_ = {
+        [](void* self, ParallelTask task, void* ctx, size_t count) {
+            static_cast<Scheduler*>(self)->run_parallel(task, ctx, count);
+        },
+        this, num_workers_
+    };
+    const ParallelRunner* expected = nullptr;
+    parallel_runner.compare_exchange_strong(expected, &parallel_runner_);
 }
 
 Scheduler::~Scheduler() {
@@ -67,22 +96,74 @@ bool Scheduler::send_message(int from_pid, int to_pid, void* data, size_t size)
     }
     
     Message msg(data, size, from_pid);
-    bool sent = to_actor->send(std::move(msg));
+    bool woken = false;
+    bool sent = to_actor->send(std::move(msg), &woken);
     
     if (sent) {
         total_messages_sent_.fetch_add(1, std::memory_order_relaxed);
         
-        // If actor was waiting, it's now runnable - wake workers
-        if (to_actor->state() == ActorState::RUNNABLE) {
-            for (size_t i = 0; i < num_workers_; ++i) {
-                workers_[i]->queue_cv.notify_one();
-            }
+        // If actor was waiting, it's now runnable - requeue it. A wake
+        // during its last quantum is left to that quantum's worker.
+        if (woken) {
+            enqueue_actor(to_actor, to_actor->home_worker());
         }
     }
     
     return sent;
 }
 
+size_t Scheduler::send_many(int from_pid, const std::vector<OutgoingMessage>& batch) {
+    if (batch.empty()) return 0;
+    
+    // Group by destination, preserving per-destination order
+    struct Group {
+        int to_pid;
+        ActorProcess* actor;
+        std::vector<Message> messages;
+    };
+    std::vector<Group> groups;
+    std::unordered_map<int, size_t> group_index;
+    
+    for (const auto& out : batch) {
+        auto [it, inserted] = group_index.try_emplace(out.to_pid, groups.size());
+        if (inserted) {
+            groups.push_back(Group{out.to_pid, nullptr, {}});
+        }
+        groups[it->second].messages.emplace_back(out.data, out.size, from_pid);
+    }
+    
+    // Resolve every destination under a single registry lock
+    {
+        std::lock_guard<std::mutex> lock(actors_mutex_);
+        for (auto& group : groups) {
+            auto it = actors_.find(group.to_pid);
+            if (it != actors_.end() && it->second->is_alive()) {
+                group.actor = it->second.get();
+            }
+        }
+    }
+    
+    size_t delivered = 0;
+    std::vector<ActorProcess*> woken_actors;
+    
+    for (auto& group : groups) {
+        if (!group.actor) continue;  // Actor doesn't exist or is dead
+        
+        bool woken = false;
+        delivered += group.actor->send_batch(group.messages, &woken);
+        if (woken) {
+            woken_actors.push_back(group.actor);
+        }
+    }
+    
+    total_messages_sent_.fetch_add(delivered, std::memory_order_relaxed);
+    total_batches_sent_.fetch_add(1, std::memory_order_relaxed);
+    
+    wake_actors(woken_actors);
+    
+    return delivered;
+}
+
 void Scheduler::kill_actor(int pid) {
     std::lock_guard<std::mutex> lock(actors_mutex_);
     auto it = actors_.find(pid);
@@ -91,6 +172,139 @@ void Scheduler::kill_actor(int pid) {
     }
 }
 
+size_t Scheduler::hibernate(int pid) {
+    ActorProcess* actor = get_actor(pid);
+    if (!actor) return 0;
+    
+    std::vector<ActorProcess*> woken;
+    size_t released = hibernate_actor(actor, woken);
+    wake_actors(woken);
+    return released;
+}
+
+size_t Scheduler::hibernate_actor(ActorProcess* actor, std::vector<ActorProcess*>& woken) {
+    size_t released = 0;
+    bool woke = false;
+    if (actor->hibernate(&released, &woke)) {
+        total_hibernations_.fetch_add(1, std::memory_order_relaxed);
+        hibernation_bytes_reclaimed_.fetch_add(released, std::memory_order_relaxed);
+    }
+    if (woke) {
+        woken.push_back(actor);
+    }
+    return released;
+}
+
+void Scheduler::hibernate_idle_actors() {
+    uint64_t idle_limit = hibernate_after_ms_.load(std::memory_order_relaxed);
+    if (idle_limit == 0) return;
+    
+    // One worker scans per interval
+    uint64_t now = ActorProcess::get_monotonic_time();
+    uint64_t last = last_hibernate_scan_.load(std::memory_order_relaxed);
+    if (now - last < HIBERNATE_SCAN_INTERVAL_MS ||
+        !last_hibernate_scan_.compare_exchange_strong(last, now)) {
+        return;
+    }
+    
+    std::vector<ActorProcess*> idle;
+    {
+        std::lock_guard<std::mutex> lock(actors_mutex_);
+        for (const auto& [pid, actor] : actors_) {
+            if (actor->state() == ActorState::WAITING && !actor->is_hibernated() &&
+                now - actor->idle_since() >= idle_limit) {
+                idle.push_back(actor.get());
+            }
+        }
+    }
+    
+    std::vector<ActorProcess*> woken;
+    for (ActorProcess* actor : idle) {
+        hibernate_actor(actor, woken);
+    }
+    wake_actors(woken);
+}
+
+void Scheduler::govern_memory() {
+    // One worker scans per interval
+    uint64_t now = ActorProcess::get_monotonic_time();
+    uint64_t last = last_governor_scan_.load(std::memory_order_relaxed);
+    if (now - last < GOVERNOR_SCAN_INTERVAL_MS ||
+        !last_governor_scan_.compare_exchange_strong(last, now)) {
+        return;
+    }
+    
+    std::vector<ActorProcess*> actors;
+    {
+        std::lock_guard<std::mutex> lock(actors_mutex_);
+        actors.reserve(actors_.size());
+        for (const auto& [pid, actor] : actors_) {
+            if (actor->is_alive()) {
+                actors.push_back(actor.get());
+            }
+        }
+    }
+    
+    // Waiting actors are the only ones that can be collected from here
+    struct Candidate {
+        ActorProcess* actor;
+        HeapUsage usage;
+    };
+    std::vector<Candidate> waiting;
+    size_t footprint = 0;
+    for (ActorProcess* actor : actors) {
+        HeapUsage usage = actor->heap_usage();
+        footprint += usage.reserved + usage.runtime_reserved;
+        if (actor->state() == ActorState::WAITING &&
+            (usage.used > 0 || usage.runtime_used > 0 || actor->cycle_candidates() > 0)) {
+            waiting.push_back({actor, usage});
+        }
+    }
+    
+    // Fullest first - they are the closest to collecting mid-quantum
+    std::sort(waiting.begin(), waiting.end(), [](const Candidate& a, const Candidate& b) {
+        return a.usage.used * b.usage.max > b.usage.used * a.usage.max;
+    });
+    
+    size_t budget = memory_budget_.load(std::memory_order_relaxed);
+    size_t runs = 0;
+    std::vector<ActorProcess*> woken;
+    
+    for (const Candidate& c : waiting) {
+        if (runs == GOVERNOR_MAX_COLLECTIONS) break;
+        
+        // Bytes allocated since the last collection bound the garbage
+        size_t fresh = c.usage.used - std::min(c.usage.used, c.usage.live_after_gc);
+        bool over_budget = budget > 0 && footprint > budget && !c.actor->is_hibernated();
+        bool pressured = (c.usage.used >= c.usage.max * GOVERNOR_PRESSURE &&
+                          fresh >= c.usage.used * GOVERNOR_MIN_GARBAGE) ||
+                         c.usage.runtime_pressure;
+        bool cyclic = c.actor->cycle_candidates() >= GOVERNOR_CYCLE_CANDIDATES;
+        if (!over_budget && !pressured && !cyclic) continue;
+        
+        size_t reclaimed = 0;
+        if (over_budget) {
+            // Over budget: shrink the whole heap, not just its garbage
+            reclaimed = hibernate_actor(c.actor, woken);
+            footprint -= std::min(footprint, reclaimed);
+        } else {
+            bool woke = false;
+            if (!c.actor->collect_idle(&reclaimed, &woke)) continue;
+            if (woke) woken.push_back(c.actor);
+            HeapUsage after = c.actor->heap_usage();
+            footprint -= std::min(footprint, c.usage.reserved + c.usage.runtime_reserved -
+                                             after.reserved - after.runtime_reserved);
+        }
+        
+        runs++;
+        governor_collections_.fetch_add(1, std::memory_order_relaxed);
+        governor_bytes_reclaimed_.fetch_add(reclaimed, std::memory_order_relaxed);
+    }
+    
+    memory_footprint_.store(footprint, std::memory_order_relaxed);
+    wake_actors(woken);
+}
+
 ActorProcess* Scheduler::get_actor(int pid) {
     std::lock_guard<std::mutex> lock(actors_mutex_);
     auto it = actors_.find(pid);
@@ -103,6 +317,9 @@ ActorProcess* Scheduler::get_actor(int pid) {
 void Scheduler::shutdown() {
     system_running_.store(false, std::memory_order_release);
     
+    const ParallelRunner* installed = &parallel_runner_;
+    parallel_runner.compare_exchange_strong(installed, nullptr);
+    
     // Wake all workers
     for (auto& worker : workers_) {
         worker->running.store(false, std::memory_order_release);
@@ -162,12 +379,33 @@ size_t Scheduler::num_alive_actors() const {
     return count;
 }
 
+size_t Scheduler::num_hibernated_actors() const {
+    std::lock_guard<std::mutex> lock(
+        const_cast<std::mutex&>(actors_mutex_)
+    );
+    size_t count = 0;
+    for (const auto& [pid, actor] : actors_) {
+        if (actor->is_hibernated()) {
+            count++;
+        }
+    }
+    return count;
+}
+
 void Scheduler::dump_stats() const {
     std::cout << "\n=== Scheduler Statistics ===\n";
     std::cout << "Total actors spawned: " << total_actors_spawned_.load() << "\n";
     std::cout << "Current actors: " << num_actors() << "\n";
     std::cout << "Alive actors: " << num_alive_actors() << "\n";
     std::cout << "Total messages sent: " << total_messages_sent_.load() << "\n";
+    std::cout << "Batched sends: " << total_batches_sent_.load() << "\n";
+    std::cout << "Hibernated actors: " << num_hibernated_actors()
+              << " (" << total_hibernations_.load() << " hibernations)\n";
+    std::cout << "Bytes reclaimed by hibernation: " << hibernation_bytes_reclaimed_.load() << "\n";
+    std::cout << "Heap footprint: " << memory_footprint_.load() << " bytes (budget "
+              << memory_budget_.load() << ")\n";
+    std::cout << "Governor collections: " << governor_collections_.load()
+              << " (" << governor_bytes_reclaimed_.load() << " bytes reclaimed)\n";
     std::cout << "Total reductions: " << total_reductions_.load() << "\n";
     std::cout << "Workers: " << num_workers_ << "\n";
     
@@ -182,17 +420,15 @@ void Scheduler::worker_loop(size_t worker_id) {
     Worker& worker = *workers_[worker_id];
     
     while (worker.running.load(std::memory_order_acquire)) {
+        if (help_parallel()) continue;
+        
         ActorProcess* actor = get_next_actor(worker_id);
         
         if (actor) {
-            // Execute one quantum
-            bool should_reschedule = actor->execute_quantum();
-            
-            if (should_reschedule && actor->is_alive()) {
-                // Put back in queue if still runnable
-                if (actor->state() == ActorState::RUNNABLE) {
-                    schedule_actor(actor->pid(), worker_id);
-                }
+            // Execute one quantum; put it back in the queue if it is still
+            // runnable, or was woken while it ran
+            if (actor->execute_quantum()) {
+                schedule_actor(actor->pid(), worker_id);
             }
             
             total_reductions_.fetch_add(REDUCTIONS_PER_SLICE, std::memory_order_relaxed);
@@ -203,13 +439,18 @@ void Scheduler::worker_loop(size_t worker_id) {
             }
             
         } else {
-            // No work - wait or steal
+            // No work - use the idle time to collect and shrink idle
+            // actors, then wait
+            govern_memory();
+            hibernate_idle_actors();
+            
             std::unique_lock<std::mutex> lock(worker.queue_mutex);
             worker.queue_cv.wait_for(
                 lock,
                 std::chrono::milliseconds(10),
-                [&worker] { 
+                [this, &worker] { 
                     return worker.queue_size.load(std::memory_order_relaxed) > 0 || 
+                           parallel_open_.load(std::memory_order_relaxed) ||
                            !worker.running.load(std::memory_order_acquire);
                 }
             );
@@ -217,6 +458,52 @@ void Scheduler::worker_loop(size_t worker_id) {
     }
 }
 
+void Scheduler::run_parallel(ParallelTask task, void* ctx, size_t count) {
+    // One job at a time: a second caller, or a task starting a job of its
+    // own, runs its tasks inline
+    std::unique_lock<std::mutex> owner(parallel_mutex_, std::try_to_lock);
+    if (!owner.owns_lock()) {
+        for (size_t i = 0; i < count; i++) task(ctx, i);
+        return;
+    }
+    
+    ParallelJob job{task, ctx, count};
+    parallel_job_.store(&job);
+    parallel_open_.store(true, std::memory_order_release);
+    for (auto& worker : workers_) {
+        // Taking the lock orders the stores before the worker's wait check
+        { std::lock_guard<std::mutex> lock(worker->queue_mutex); }
+        worker->queue_cv.notify_one();
+    }
+    
+    job.run();
+    parallel_open_.store(false, std::memory_order_relaxed);
+    while (job.done.load(std::memory_order_acquire) < count) {
+        std::this_thread::yield();
+    }
+    
+    // Retract the job, then wait out workers that may still hold it
+    parallel_job_.store(nullptr);
+    while (parallel_helpers_.load() > 0) {
+        std::this_thread::yield();
+    }
+}
+
+bool Scheduler::help_parallel() {
+    if (!parallel_open_.load(std::memory_order_relaxed)) return false;
+    
+    // Announce before loading, so a retracting owner either waits for us
+    // or we see the null
+    parallel_helpers_.fetch_add(1);
+    bool ran = false;
+    if (ParallelJob* job = parallel_job_.load()) {
+        ran = job->run();
+        parallel_open_.store(false, std::memory_order_relaxed);
+    }
+    parallel_helpers_.fetch_sub(1);
+    return ran;
+}
+
 ActorProcess* Scheduler::get_next_actor(size_t worker_id) {
     Worker& worker = *workers_[worker_id];
     std::lock_guard<std::mutex> lock(worker.queue_mutex);
@@ -244,6 +531,13 @@ void Scheduler::schedule_actor(int pid, size_t worker_id) {
     
     if (!actor) return;
     
+    enqueue_actor(actor, worker_id);
+}
+
+void Scheduler::enqueue_actor(ActorProcess* actor, size_t worker_id) {
+    if (worker_id >= num_workers_) worker_id = 0;
+    actor->set_home_worker(worker_id);
+    
     Worker& worker = *workers_[worker_id];
     {
         std::lock_guard<std::mutex> lock(worker.queue_mutex);
@@ -253,6 +547,32 @@ void Scheduler::schedule_actor(int pid, size_t worker_id) {
     worker.queue_cv.notify_one();
 }
 
+void Scheduler::wake_actors(const std::vector<ActorProcess*>& woken) {
+    if (woken.empty()) return;
+    
+    // Bucket by home worker so each worker is locked and notified once
+    std::vector<std::vector<ActorProcess*>> per_worker(num_workers_);
+    for (ActorProcess* actor : woken) {
+        size_t worker_id = actor->home_worker();
+        if (worker_id >= num_workers_) worker_id = 0;
+        per_worker[worker_id].push_back(actor);
+    }
+    
+    for (size_t i = 0; i < num_workers_; ++i) {
+        if (per_worker[i].empty()) continue;
+        
+        Worker& worker = *workers_[i];
+        {
+            std::lock_guard<std::mutex> lock(worker.queue_mutex);
+            for (ActorProcess* actor : per_worker[i]) {
+                worker.run_queue.push_back(actor);
+            }
+            worker.queue_size.fetch_add(per_worker[i].size(), std::memory_order_relaxed);
+        }
+        worker.queue_cv.notify_one();
+    }
+}
+
 size_t Scheduler::choose_worker() {
     size_t min_size = SIZE_MAX;
     size_t chosen = 0;
@@ -0,0 +1,299 @@
+#include "runtime/value.h"
+#include <cmath>
+#include <functional>
+
+namespace aithon::runtime {
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+namespace {
+
+// Numeric view of a value: ints that fit an int64 - inline or boxed - and
+// bools as integers, floats as doubles. BigInts are left to PyInt.
+struct Number {
+    bool is_float;
+    int64_t i;
+    double f;
+
+    double as_double() const { return is_float ? f : static_cast<double>(i); }
+};
+
+bool to_number(Value v, Number& n) {
+    if (v.is_double()) {
+        n = {true, 0, v.as_double()};
+    } else if (v.is_small_int() ||
+               (v.is_int() && !static_cast<PyInt*>(v.as_object())->is_big())) {
+        n = {false, v.as_int(), 0.0};
+    } else if (v.is_bool()) {
+        n = {false, v.as_bool() ? 1 : 0, 0.0};
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// A PyObject for either operand of a heap-object operation; inline values
+// are boxed for the duration of the call
+class Boxed {
+    PyObject* obj_;
+    bool owned_;
+
+public:
+    explicit Boxed(Value v) : obj_(nullptr), owned_(false) {
+        if (v.is_object()) {
+            obj_ = v.as_object();
+        } else if (v.is_none()) {
+            obj_ = PyNone::instance();
+        } else if (v.is_bool()) {
+            obj_ = PyBool::get(v.as_bool());
+        } else if (v.is_double()) {
+            obj_ = new PyFloat(v.as_double());
+            owned_ = true;
+        } else {
+            obj_ = new PyInt(v.as_int());
+            owned_ = true;
+        }
+    }
+
+    ~Boxed() { if (owned_) obj_->decref(); }
+
+    Boxed(const Boxed&) = delete;
+    Boxed& operator=(const Boxed&) = delete;
+
+    PyObject* get() const { return obj_; }
+};
+
+// A result from PyObject, unboxed where it has an inline form. Operations
+// hand back new objects, except the None and bool singletons.
+Value from_result(PyObject* obj) {
+    if (obj->is_none()) return Value::none();
+    if (obj->is_bool()) return Value::from_bool(static_cast<PyBool*>(obj)->value());
+
+    if (obj->is_float()) {
+        Value v = Value::from_double(static_cast<PyFloat*>(obj)->value());
+        obj->decref();
+        return v;
+    }
+    if (obj->is_int() && !static_cast<PyInt*>(obj)->is_big()) {
+        int64_t value = static_cast<PyInt*>(obj)->value();
+        if (value >= Value::SMALL_INT_MIN && value <= Value::SMALL_INT_MAX) {
+            obj->decref();
+            return Value::from_int(value);
+        }
+    }
+    return Value::from_object(obj);
+}
+
+template<typename Op>
+Value object_op(Value a, Value b, Op op) {
+    Boxed x(a), y(b);
+    return from_result(op(x.get(), y.get()));
+}
+
+// a % b with the sign of b, as Python's float modulo; b is non-zero
+double float_mod(double a, double b) {
+    double result = std::fmod(a, b);
+    if (result == 0.0) return std::copysign(0.0, b);
+    return (result < 0.0) != (b < 0.0) ? result + b : result;
+}
+
+}
+
+// ============================================================================
+// Arithmetic
+// ============================================================================
+
+Value Value::add_slow(Value other) const {
+    Number a, b;
+    if (!to_number(*this, a) || !to_number(other, b)) {
+        return object_op(*this, other, [](PyObject* x, PyObject* y) { return x->add(y); });
+    }
+
+    if (a.is_float || b.is_float) return from_double(a.as_double() + b.as_double());
+    int64_t result;
+    if (__builtin_add_overflow(a.i, b.i, &result)) {
+        return from_object(new PyInt(BigInt(a.i) + BigInt(b.i)));
+    }
+    return from_int(result);
+}
+
+Value Value::sub_slow(Value other) const {
+    Number a, b;
+    if (!to_number(*this, a) || !to_number(other, b)) {
+        return object_op(*this, other, [](PyObject* x, PyObject* y) { return x->sub(y); });
+    }
+
+    if (a.is_float || b.is_float) return from_double(a.as_double() - b.as_double());
+    int64_t result;
+    if (__builtin_sub_overflow(a.i, b.i, &result)) {
+        return from_object(new PyInt(BigInt(a.i) - BigInt(b.i)));
+    }
+    return from_int(result);
+}
+
+Value Value::mul_slow(Value other) const {
+    Number a, b;
+    if (!to_number(*this, a) || !to_number(other, b)) {
+        return object_op(*this, other, [](PyObject* x, PyObject* y) { return x->mul(y); });
+    }
+
+    if (a.is_float || b.is_float) return from_double(a.as_double() * b.as_double());
+    int64_t result;
+    if (__builtin_mul_overflow(a.i, b.i, &result)) {
+        return from_object(new PyInt(BigInt(a.i) * BigInt(b.i)));
+    }
+    return from_int(result);
+}
+
+Value Value::div(Value other) const {
+    Number a, b;
+    if (!to_number(*this, a) || !to_number(other, b)) {
+        return object_op(*this, other, [](PyObject* x, PyObject* y) { return x->div(y); });
+    }
+
+    // True division - always a float
+    double divisor = b.as_double();
+    if (divisor == 0.0) {
+        throw std::runtime_error(b.is_float ? "ZeroDivisionError: float division by zero"
+                                            : "ZeroDivisionError: division by zero");
+    }
+    return from_double(a.as_double() / divisor);
+}
+
+Value Value::mod(Value other) const {
+    Number a, b;
+    if (!to_number(*this, a) || !to_number(other, b)) {
+        return object_op(*this, other, [](PyObject* x, PyObject* y) { return x->mod(y); });
+    }
+
+    if (a.is_float || b.is_float) {
+        if (b.as_double() == 0.0) {
+            throw std::runtime_error("ZeroDivisionError: float modulo");
+        }
+        return from_double(float_mod(a.as_double(), b.as_double()));
+    }
+
+    if (b.i == 0) {
+        throw std::runtime_error("ZeroDivisionError: integer modulo by zero");
+    }
+    return from_int(floor_mod(a.i, b.i));
+}
+
+Value Value::pow(Value other) const {
+    Number a, b;
+    if (!to_number(*this, a) || !to_number(other, b)) {
+        return object_op(*this, other, [](PyObject* x, PyObject* y) { return x->pow(y); });
+    }
+
+    // Negative exponents give a float, as in Python, and zero has none
+    if (a.is_float || b.is_float || b.i < 0) {
+        if (a.as_double() == 0.0 && b.as_double() < 0.0) {
+            throw std::runtime_error("ZeroDivisionError: 0.0 cannot be raised to a negative power");
+        }
+        return from_double(std::pow(a.as_double(), b.as_double()));
+    }
+
+    int64_t result;
+    if (!checked_pow(a.i, b.i, result)) {
+        return from_object(new PyInt(BigInt(a.i).pow(b.i)));
+    }
+    return from_int(result);
+}
+
+Value Value::neg() const {
+    if (is_double()) return from_double(-as_double());
+
+    Number n;
+    if (!to_number(*this, n)) {
+        return from_result(Boxed(*this).get()->neg());
+    }
+    if (n.i == INT64_MIN) return from_object(new PyInt(-BigInt(n.i)));
+    return from_int(-n.i);
+}
+
+// ============================================================================
+// Comparisons
+// ============================================================================
+
+Value Value::ne(Value other) const { return compare_slow(other, CompareOp::NE); }
+Value Value::le(Value other) const { return compare_slow(other, CompareOp::LE); }
+Value Value::gt(Value other) const { return compare_slow(other, CompareOp::GT); }
+Value Value::ge(Value other) const { return compare_slow(other, CompareOp::GE); }
+
+Value Value::compare_slow(Value other, CompareOp op) const {
+    Number a, b;
+    if (to_number(*this, a) && to_number(other, b)) {
+        // Compare as doubles only when one side is a float
+        auto compare = [op](auto x, auto y) {
+            switch (op) {
+                case CompareOp::EQ: return x == y;
+                case CompareOp::NE: return x != y;
+                case CompareOp::LT: return x < y;
+                case CompareOp::LE: return x <= y;
+                case CompareOp::GT: return x > y;
+                case CompareOp::GE: return x >= y;
+            }
+            return false;
+        };
+        if (a.is_float || b.is_float) return from_bool(compare(a.as_double(), b.as_double()));
+        return from_bool(compare(a.i, b.i));
+    }
+
+    // None only equals None
+    if (is_none() || other.is_none()) {
+        if (op == CompareOp::EQ) return from_bool(bits_ == other.bits_);
+        if (op == CompareOp::NE) return from_bool(bits_ != other.bits_);
+    }
+
+    return object_op(*this, other, [op](PyObject* x, PyObject* y) {
+        switch (op) {
+            case CompareOp::EQ: return x->eq(y);
+            case CompareOp::NE: return x->ne(y);
+            case CompareOp::LT: return x->lt(y);
+            case CompareOp::LE: return x->le(y);
+            case CompareOp::GT: return x->gt(y);
+            case CompareOp::GE: return x->ge(y);
+        }
+        return x->eq(y);
+    });
+}
+
+// ============================================================================
+// Conversions
+// ============================================================================
+
+std::string Value::to_string() const {
+    if (is_small_int()) return std::to_string(small_int());
+    if (is_double()) return std::to_string(as_double());
+    if (is_bool()) return as_bool() ? "True" : "False";
+    if (is_none()) return "None";
+    return as_object()->to_string();
+}
+
+bool Value::to_bool() const {
+    if (is_small_int()) return small_int() != 0;
+    if (is_double()) return as_double() != 0.0;
+    if (is_bool()) return as_bool();
+    if (is_none()) return false;
+    return as_object()->to_bool();
+}
+
+int64_t Value::hash() const {
+    if (is_small_int()) return small_int();
+    if (is_bool()) return as_bool() ? 1 : 0;
+
+    // Equal numbers hash equally: 2.0 like 2
+    if (is_double()) {
+        double value = as_double();
+        if (value == std::trunc(value) && std::fabs(value) < 9.2e18) {
+            return static_cast<int64_t>(value);
+        }
+        return static_cast<int64_t>(std::hash<double>{}(value));
+    }
+    if (is_none()) return static_cast<int64_t>(NONE_BITS);
+    return as_object()->hash();
+}
+
+}
@@ -0,0 +1,294 @@
+#include "runtime/actor_gc.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <thread>
+
+using namespace aithon::runtime;
+
+// Two-slot reference object: every word is a pointer (has_refs)
+struct Pair {
+    void* first;
+    void* second;
+};
+
+static int64_t* new_int(ActorGC& gc, int64_t value) {
+    auto* p = static_cast<int64_t*>(gc.allocate(sizeof(int64_t)));
+    *p = value;
+    return p;
+}
+
+void test_minor_copy() {
+    std::cout << "\n=== Test: Nursery Copy ===\n";
+    
+    ActorGC gc;
+    
+    // Rooted chain of pairs: first = next pair, second = boxed int
+    Pair* list = nullptr;
+    gc.add_root(reinterpret_cast<void**>(&list));
+    for (int64_t i = 0; i < 100; i++) {
+        gc.allocate(64);  // Garbage
+        auto* pair = static_cast<Pair*>(gc.allocate(sizeof(Pair), 0, true));
+        pair->first = list;
+        pair->second = nullptr;
+        list = pair;
+        pair->second = new_int(gc, i);
+    }
+    
+    Pair* before = list;
+    gc.collect_young();
+    
+    assert(list != before);  // Moved to the survivor space
+    int64_t expected = 99;
+    for (Pair* p = list; p; p = static_cast<Pair*>(p->first)) {
+        assert(*static_cast<int64_t*>(p->second) == expected--);
+    }
+    assert(expected == -1);
+    assert(gc.statistics().bytes_freed > 0);
+    
+    gc.remove_root(reinterpret_cast<void**>(&list));
+    std::cout << "Test passed!\n";
+}
+
+void test_promotion() {
+    std::cout << "\n=== Test: Promotion by Age ===\n";
+    
+    ActorGC gc;
+    
+    int64_t* value = new_int(gc, 42);
+    gc.add_root(reinterpret_cast<void**>(&value));
+    
+    for (int i = 0; i < 3; i++) {
+        assert(gc.is_young(value));
+        gc.collect_young();
+    }
+    
+    assert(!gc.is_young(value));
+    assert(gc.statistics().promotions == 1);
+    assert(*value == 42);
+    
+    gc.remove_root(reinterpret_cast<void**>(&value));
+    std::cout << "Test passed!\n";
+}
+
+void test_card_barrier() {
+    std::cout << "\n=== Test: Card Table Barrier ===\n";
+    
+    ActorGC gc;
+    
+    // Old object whose only reference to a young object is a field
+    auto* holder = static_cast<Pair*>(gc.allocate_old(sizeof(Pair), 0, true));
+    holder->first = nullptr;
+    holder->second = nullptr;
+    gc.add_root(reinterpret_cast<void**>(&holder));
+    
+    int64_t* young = new_int(gc, 7);
+    holder->second = young;
+    gc.write_barrier(&holder->second, young);
+    
+    gc.collect_young();
+    
+    assert(holder->second != young);  // Updated through the dirty card
+    assert(*static_cast<int64_t*>(holder->second) == 7);
+    assert(gc.statistics().cards_scanned == 1);
+    
+    // Still points into the nursery, so the card stays dirty
+    gc.collect_young();
+    assert(*static_cast<int64_t*>(holder->second) == 7);
+    assert(gc.statistics().cards_scanned == 2);
+    
+    gc.dump_state();
+    gc.remove_root(reinterpret_cast<void**>(&holder));
+    std::cout << "Test passed!\n";
+}
+
+void test_free_list_reuse() {
+    std::cout << "\n=== Test: Old Generation Free Lists ===\n";
+    
+    ActorGC gc;
+    
+    // Interleave long-lived and short-lived old objects
+    std::vector<int64_t*> keep(64, nullptr);
+    std::vector<int64_t*> drop(64, nullptr);
+    for (size_t i = 0; i < keep.size(); i++) {
+        keep[i] = static_cast<int64_t*>(gc.allocate_old(48));
+        *keep[i] = static_cast<int64_t>(i);
+        drop[i] = static_cast<int64_t*>(gc.allocate_old(48));
+        gc.add_root(reinterpret_cast<void**>(&keep[i]));
+    }
+    
+    int64_t* first = keep[0];
+    gc.collect_full();
+    
+    // Survivors stay put; the holes between them are listed
+    assert(keep[0] == first);
+    assert(gc.statistics().old_free_bytes > 0);
+    
+    // Same-sized allocations reuse the holes instead of growing the heap;
+    // the last dead object was at the end and went back to the bump pointer
+    for (size_t i = 0; i < drop.size(); i++) {
+        drop[i] = static_cast<int64_t*>(gc.allocate_old(48));
+    }
+    assert(gc.statistics().free_list_allocations == drop.size() - 1);
+    assert(gc.statistics().old_free_bytes == 0);
+    
+    for (size_t i = 0; i < keep.size(); i++) {
+        assert(*keep[i] == static_cast<int64_t>(i));
+        gc.remove_root(reinterpret_cast<void**>(&keep[i]));
+    }
+    std::cout << "Test passed!\n";
+}
+
+void test_large_objects() {
+    std::cout << "\n=== Test: Large Object Space ===\n";
+    
+    ActorGC gc;
+    
+    auto* big = static_cast<Pair*>(gc.allocate(64 * 1024, 0, true));
+    assert(!gc.is_young(big));
+    assert(gc.statistics().large_objects_allocated == 1);
+    gc.add_root(reinterpret_cast<void**>(&big));
+    
+    // Large objects are traced on every minor GC but never copied
+    int64_t* young = new_int(gc, 11);
+    big->first = young;
+    gc.collect_young();
+    assert(big->first != young);
+    assert(*static_cast<int64_t*>(big->first) == 11);
+    
+    Pair* before = big;
+    gc.collect_full();
+    assert(big == before);
+    assert(gc.statistics().large_bytes > 0);
+    
+    gc.remove_root(reinterpret_cast<void**>(&big));
+    gc.collect_full();
+    assert(gc.statistics().large_bytes == 0);
+    
+    std::cout << "Test passed!\n";
+}
+
+void test_pinned_runtime_alloc() {
+    std::cout << "\n=== Test: Pinned Runtime Allocation ===\n";
+    
+    // Outside actor context the runtime falls back to malloc
+    void* plain = gc_alloc_pinned(64);
+    assert(plain && !current_actor_gc);
+    gc_free(plain);
+    
+    std::unique_ptr<ActorGC> actor_gc;
+    {
+        ActorGCScope scope(actor_gc);
+        assert(!actor_gc);  // Created on first allocation
+        
+        auto* value = static_cast<int64_t*>(gc_alloc_pinned(sizeof(int64_t)));
+        *value = 99;
+        assert(actor_gc && actor_gc->owns(value));
+        
+        // Unrooted, but pinned: survives and stays put
+        auto* big = static_cast<uint8_t*>(gc_alloc_pinned(64 * 1024));
+        actor_gc->collect_full();
+        assert(*value == 99);
+        assert(actor_gc->statistics().pinned_bytes >= 64 * 1024);
+        
+        // Freed blocks are reused
+        gc_free(value);
+        gc_free(big);
+        assert(actor_gc->statistics().pinned_bytes == 0);
+        assert(actor_gc->statistics().large_bytes == 0);
+        gc_alloc_pinned(sizeof(int64_t));
+        assert(actor_gc->statistics().free_list_allocations == 1);
+    }
+    assert(!current_actor_gc);
+    
+    std::cout << "Test passed!\n";
+}
+
+void test_remote_free() {
+    std::cout << "\n=== Test: Frees From Other Threads ===\n";
+    
+    std::unique_ptr<ActorGC> actor_gc;
+    void* small;
+    void* big;
+    {
+        ActorGCScope scope(actor_gc);
+        small = gc_alloc_pinned(48);
+        big = gc_alloc_pinned(64 * 1024);
+    }
+    assert(actor_gc->statistics().pinned_bytes >= 64 * 1024 + 48);
+    
+    // Another thread, and this one outside the actor, only queue the free
+    std::thread([small] { gc_free(small); }).join();
+    gc_free(big);
+    assert(actor_gc->statistics().pinned_bytes >= 64 * 1024 + 48);
+    
+    // The owner takes the blocks back when it next runs
+    {
+        ActorGCScope scope(actor_gc);
+        assert(actor_gc->statistics().pinned_bytes == 0);
+        assert(actor_gc->statistics().large_bytes == 0);
+    }
+    
+    std::cout << "Test passed!\n";
+}
+
+void test_shadow_stack_roots() {
+    std::cout << "\n=== Test: Shadow Stack Roots ===\n";
+    
+    // Frame laid out the way LLVM's shadow-stack lowering pushes it
+    static const ShadowStackFrameMap map = {2, 0};
+    struct {
+        ShadowStackEntry* next;
+        const ShadowStackFrameMap* map;
+        void* roots[2];
+    } frame = {llvm_gc_root_chain, &map, {nullptr, nullptr}};
+    llvm_gc_root_chain = reinterpret_cast<ShadowStackEntry*>(&frame);
+    
+    ActorGC gc;
+    gc.set_root_scanner(visit_shadow_stack_roots);
+    
+    const char* literal = "not a heap object";
+    int64_t* value = new_int(gc, 5);
+    frame.roots[0] = value;
+    frame.roots[1] = const_cast<char*>(literal);
+    
+    // The local is found and updated without being registered
+    gc.collect_young();
+    assert(frame.roots[0] != value);
+    assert(*static_cast<int64_t*>(frame.roots[0]) == 5);
+    assert(frame.roots[1] == literal);
+    
+    gc.collect_full();
+    assert(*static_cast<int64_t*>(frame.roots[0]) == 5);
+    
+    // Other threads, and actors entered from here, see only their own frames
+    std::thread([] { assert(!llvm_gc_root_chain); }).join();
+    std::unique_ptr<ActorGC> actor_gc;
+    {
+        ActorGCScope scope(actor_gc);
+        assert(!llvm_gc_root_chain);
+    }
+    assert(llvm_gc_root_chain == reinterpret_cast<ShadowStackEntry*>(&frame));
+    
+    llvm_gc_root_chain = frame.next;
+    std::cout << "Test passed!\n";
+}
+
+int main() {
+    std::cout << "Running Actor GC Tests\n";
+    std::cout << "======================\n";
+    
+    test_minor_copy();
+    test_promotion();
+    test_card_barrier();
+    test_free_list_reuse();
+    test_large_objects();
+    test_pinned_runtime_alloc();
+    test_remote_free();
+    test_shadow_stack_roots();
+    
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -1,6 +1,10 @@
 #include "runtime/actor_process.h"
 #include <iostream>
 #include <cassert>
+#include <cstring>
+#include <cstddef>
+#include <atomic>
+#include <thread>
 
 using namespace aithon::runtime;
 
@@ -22,6 +26,99 @@ void test_heap() {
     std::cout << "Test passed!\n";
 }
 
+void test_heap_growth() {
+    std::cout << "\n=== Test: Heap Growth ===\n";
+    
+    ActorHeap heap(64 * 1024, 4 * 1024);  // 4KB initial, 64KB max
+    assert(heap.total() == 0);            // Nothing reserved until first use
+    
+    for (int i = 0; i < 100; i++) {
+        void* ptr = heap.allocate(256);
+        assert(ptr != nullptr);
+        std::memset(ptr, i, 256);
+    }
+    
+    assert(heap.num_segments() > 1);
+    assert(heap.growth_events() == heap.num_segments());
+    assert(heap.total() <= heap.max_size());
+    
+    // Larger than the per-actor maximum
+    assert(heap.allocate(128 * 1024) == nullptr);
+    
+    heap.dump_stats();
+    
+    std::cout << "Test passed!\n";
+}
+
+struct ListNode {
+    ListNode* next;
+    int64_t value;
+};
+
+void test_gc_roots() {
+    std::cout << "\n=== Test: Precise GC Roots ===\n";
+    
+    uint32_t node_type = ActorHeap::register_type({"ListNode", {offsetof(ListNode, next)}, false});
+    ActorHeap heap(64 * 1024, 4 * 1024);
+    
+    // Build a rooted list of 50 nodes with garbage in between
+    ListNode* list = nullptr;
+    HeapRoot list_root(heap, &list);
+    for (int64_t i = 0; i < 50; ++i) {
+        heap.allocate(64);  // Garbage
+        auto* node = static_cast<ListNode*>(heap.allocate(sizeof(ListNode), node_type));
+        node->next = list;
+        node->value = i;
+        list = node;
+    }
+    
+    ListNode* old_head = list;
+    size_t before = heap.used();
+    heap.collect_garbage();
+    
+    assert(heap.used() < before);
+    assert(heap.collections() == 1);
+    assert(list != old_head);  // Survivors moved and the root was updated
+    
+    int64_t expected = 49;
+    for (ListNode* node = list; node; node = node->next) {
+        assert(node->value == expected--);
+    }
+    assert(expected == -1);
+    
+    // Unrooting the list makes all of it garbage
+    list = nullptr;
+    heap.collect_garbage();
+    assert(heap.used() == 0);
+    
+    heap.dump_stats();
+    
+    std::cout << "Test passed!\n";
+}
+
+void test_gc_mailbox_roots() {
+    std::cout << "\n=== Test: GC Keeps Queued Messages ===\n";
+    
+    ActorProcess actor(1, 64 * 1024);
+    
+    for (int i = 0; i < 3; ++i) {
+        actor.allocate(512);  // Garbage ahead of the payloads
+        Message m(&i, sizeof(i), 0);
+        assert(actor.send(std::move(m)));
+    }
+    
+    actor.heap().collect_garbage();
+    assert(actor.heap().bytes_reclaimed() >= 3 * 512);
+    
+    for (int i = 0; i < 3; ++i) {
+        Message* received = actor.receive();
+        assert(received != nullptr);
+        assert(*static_cast<int*>(received->payload) == i);
+    }
+    
+    std::cout << "Test passed!\n";
+}
+
 void test_mailbox() {
     std::cout << "\n=== Test: Actor Mailbox ===\n";
     
@@ -74,13 +171,63 @@ void test_actor_lifecycle() {
     std::cout << "Test passed!\n";
 }
 
+struct ParkedQuantum {
+    std::atomic<bool> parked{false};
+    std::atomic<bool> sent{false};
+    int received = 0;
+};
+
+void park_then_linger(ActorProcess* self, void* args) {
+    auto* quantum = static_cast<ParkedQuantum*>(args);
+    while (self->receive()) quantum->received++;
+    
+    // WAITING, but the quantum is not over until we return
+    if (!quantum->parked.exchange(true)) {
+        while (!quantum->sent.load()) std::this_thread::yield();
+    }
+}
+
+void test_wake_during_quantum() {
+    std::cout << "\n=== Test: Wake During Quantum ===\n";
+    
+    ActorProcess actor(1);
+    ParkedQuantum quantum;
+    actor.set_behavior(park_then_linger);
+    actor.set_initial_args(&quantum);
+    
+    bool requeue = false;
+    std::thread worker([&] { requeue = actor.execute_quantum(); });
+    while (!quantum.parked.load()) std::this_thread::yield();
+    
+    // The worker still holds the run token: the sender must not queue the
+    // actor, and the worker requeues it once its quantum ends
+    int value = 7;
+    bool woken = true;
+    assert(actor.send(Message(&value, sizeof(value), 0), &woken));
+    assert(!woken);
+    assert(!actor.hibernate());
+    quantum.sent.store(true);
+    worker.join();
+    assert(requeue && actor.state() == ActorState::RUNNABLE);
+    
+    // Run by the token's holder, it takes the message and parks again
+    assert(!actor.execute_quantum());
+    assert(quantum.received == 1 && actor.state() == ActorState::WAITING);
+    
+    std::cout << "Test passed!\n";
+}
+
 int main() {
     std::cout << "Running Actor Tests\n";
     std::cout << "===================\n";
     
     test_heap();
+    test_heap_growth();
+    test_gc_roots();
+    test_gc_mailbox_roots();
     test_mailbox();
     test_actor_lifecycle();
+    test_wake_during_quantum();
     
     std::cout << "\nAll tests passed!\n";
     return 0;
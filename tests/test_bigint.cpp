@@ -0,0 +1,256 @@
+#include "runtime/bigint.h"
+#include "runtime/value.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace aithon::runtime;
+
+// BigInt arithmetic against known values and identities, and PyInt and
+// Value promoting to it on int64 overflow and demoting back
+
+static BigInt big(const char* digits) {
+    return BigInt::from_string(digits);
+}
+
+static BigInt random_big(std::mt19937_64& rng, size_t limbs) {
+    BigInt result;
+    BigInt base = BigInt(int64_t(1) << 32);
+    for (size_t i = 0; i < limbs; i++) {
+        result = result * base + BigInt(static_cast<int64_t>(rng() & 0xFFFFFFFF));
+    }
+    return rng() & 1 ? -result : result;
+}
+
+static bool raises(const char* error, void (*fn)()) {
+    try {
+        fn();
+    } catch (const std::runtime_error& e) {
+        return std::string(e.what()).rfind(error, 0) == 0;
+    }
+    return false;
+}
+
+void test_conversions() {
+    std::cout << "\n=== Test: Conversions ===\n";
+
+    assert(BigInt().to_string() == "0" && BigInt().is_zero());
+    assert(BigInt(-42).to_string() == "-42");
+    assert(BigInt(INT64_MIN).to_string() == "-9223372036854775808");
+    assert(BigInt(INT64_MIN).fits_int64() && BigInt(INT64_MIN).to_int64() == INT64_MIN);
+    assert(BigInt(INT64_MAX).to_int64() == INT64_MAX);
+
+    const char* digits = "-123456789012345678901234567890123456789000000000";
+    assert(big(digits).to_string() == digits);
+    assert(big("+0").to_string() == "0" && !big("-0").is_negative());
+    assert(big("000123").to_string() == "123");
+
+    // Just past either end of int64
+    assert(!big("9223372036854775808").fits_int64());
+    assert(!big("-9223372036854775809").fits_int64());
+    assert(big("-9223372036854775808").fits_int64());
+
+    assert(big("18446744073709551616").to_double() == 18446744073709551616.0);
+    assert(big("-1000000000000000000000").to_double() == -1e21);
+    // 2^64 + 1 rounds to the nearest double, 2^64
+    assert(big("18446744073709551617").to_double() == 18446744073709551616.0);
+
+    assert(raises("ValueError", [] { BigInt::from_string("12a"); }));
+    assert(raises("ValueError", [] { BigInt::from_string("-"); }));
+    assert(raises("OverflowError", [] { BigInt(10).pow(400).to_double(); }));
+    std::cout << "Test passed!\n";
+}
+
+void test_arithmetic() {
+    std::cout << "\n=== Test: Arithmetic ===\n";
+
+    BigInt a = big("340282366920938463463374607431768211456");   // 2^128
+    BigInt b = big("18446744073709551616");                      // 2^64
+    assert((a + b).to_string() == "340282366920938463481821351505477763072");
+    assert((b - a).to_string() == "-340282366920938463444927863358058659840");
+    assert((a - a).is_zero() && !(a - a).is_negative());
+    assert((b * b).compare(a) == 0);
+    assert((-b * b).compare(-a) == 0);
+    assert(BigInt(2).pow(128).compare(a) == 0);
+    assert(BigInt(-3).pow(3).to_int64() == -27);
+    assert(BigInt(7).pow(0).to_int64() == 1);
+
+    // 30!
+    BigInt factorial(1);
+    for (int64_t i = 2; i <= 30; i++) factorial = factorial * BigInt(i);
+    assert(factorial.to_string() == "265252859812191058636308480000000");
+
+    assert(a.compare(b) > 0 && b.compare(a) < 0);
+    assert((-a).compare(-b) < 0);
+    assert(BigInt(-1).compare(BigInt()) < 0);
+    std::cout << "Test passed!\n";
+}
+
+void test_division() {
+    std::cout << "\n=== Test: Division ===\n";
+
+    // Rounds toward negative infinity; the remainder takes the divisor's sign
+    struct Case { int64_t a, b, q, r; };
+    for (Case c : {Case{7, 3, 2, 1}, Case{-7, 3, -3, 2}, Case{7, -3, -3, -2},
+                   Case{-7, -3, 2, -1}, Case{6, -3, -2, 0}}) {
+        BigInt q, r;
+        BigInt::divmod(BigInt(c.a), BigInt(c.b), q, r);
+        assert(q.to_int64() == c.q && r.to_int64() == c.r);
+        assert(floor_mod(c.a, c.b) == c.r);
+    }
+    assert(floor_mod(INT64_MIN, -1) == 0);
+
+    BigInt q, r;
+    BigInt::divmod(big("265252859812191058636308480000000"), big("87178291200"), q, r);
+    assert(q.to_string() == "3042648073975910400000" && r.is_zero());  // 30! / 14!
+
+    // q b + r == a and |r| < |b| for random multi-limb operands
+    std::mt19937_64 rng(7);
+    for (int i = 0; i < 200; i++) {
+        BigInt x = random_big(rng, 1 + rng() % 12);
+        BigInt y = random_big(rng, 1 + rng() % 6);
+        if (y.is_zero()) continue;
+        BigInt::divmod(x, y, q, r);
+        assert((q * y + r).compare(x) == 0);
+        assert(r.is_zero() || r.is_negative() == y.is_negative());
+        assert((r.is_negative() ? -r : r).compare(y.is_negative() ? -y : y) < 0);
+    }
+
+    assert(raises("ZeroDivisionError", [] {
+        BigInt q, r;
+        BigInt::divmod(BigInt(1), BigInt(), q, r);
+    }));
+    std::cout << "Test passed!\n";
+}
+
+void test_karatsuba() {
+    std::cout << "\n=== Test: Karatsuba ===\n";
+
+    // Balanced, lopsided and just-over-threshold sizes agree with schoolbook
+    std::mt19937_64 rng(42);
+    const size_t t = BigInt::KARATSUBA_THRESHOLD;
+    size_t sizes[][2] = {{t, t}, {t + 1, t}, {2 * t + 3, 2 * t}, {5 * t, t}, {7 * t + 5, 3 * t + 1}};
+    for (auto& size : sizes) {
+        BigInt x = random_big(rng, size[0]);
+        BigInt y = random_big(rng, size[1]);
+        BigInt product = x * y;
+        assert(product.compare(BigInt::mul_schoolbook(x, y)) == 0);
+        assert(product.compare(y * x) == 0);
+
+        BigInt q, r;
+        BigInt::divmod(product, y, q, r);
+        assert(q.compare(x) == 0 && r.is_zero());
+    }
+
+    // All-ones limbs carry the whole way through the middle term
+    BigInt ones = BigInt(2).pow(32 * 3 * t) - BigInt(1);
+    assert((ones * ones).compare(BigInt::mul_schoolbook(ones, ones)) == 0);
+    std::cout << "Test passed!\n";
+}
+
+void test_pyint_promotion() {
+    std::cout << "\n=== Test: PyInt Promotion ===\n";
+
+    auto* max = new PyInt(INT64_MAX);
+    auto* one = new PyInt(1);
+
+    // Overflow goes to a BigInt...
+    auto* past = static_cast<PyInt*>(max->add(one));
+    assert(past->is_big() && past->to_string() == "9223372036854775808");
+
+    // ...and a result back in range comes back as an int64
+    auto* back = static_cast<PyInt*>(past->sub(one));
+    assert(!back->is_big() && back->value() == INT64_MAX);
+    assert(past->gt(max) == PyBool::get(true));
+
+    auto* square = static_cast<PyInt*>(past->mul(past));
+    assert(square->to_string() == "85070591730234615865843651857942052864");
+    auto* two = new PyInt(2);
+    auto* exponent = new PyInt(126);
+    auto* power = static_cast<PyInt*>(two->pow(exponent));
+    assert(power->eq(square) == PyBool::get(true) && power->hash() == square->hash());
+
+    auto* neg_min = static_cast<PyInt*>(PyInt(INT64_MIN).neg());
+    assert(neg_min->is_big() && neg_min->eq(past) == PyBool::get(true));
+
+    // Python's modulo
+    auto* three = new PyInt(3);
+    auto* mod = static_cast<PyInt*>(PyInt(-7).mod(three));
+    assert(mod->value() == 2);
+    auto* big_mod = static_cast<PyInt*>(past->mod(three));
+    assert(!big_mod->is_big() && big_mod->value() == 2);   // 2^63 % 3
+
+    // Powers that overflow int64 are exact, unlike a double pow
+    exponent->decref();
+    exponent = new PyInt(40);
+    auto* exact = static_cast<PyInt*>(three->pow(exponent));
+    assert(exact->to_string() == "12157665459056928801");
+
+    bool caught = false;
+    try {
+        PyList list;
+        list.append(one);
+        list.get_item(past);
+    } catch (const std::runtime_error& e) {
+        caught = std::string(e.what()).rfind("IndexError", 0) == 0;
+    }
+    assert(caught);
+
+    for (PyInt* obj : {max, one, past, back, square, two, exponent, power, neg_min,
+                       three, mod, big_mod, exact}) {
+        obj->decref();
+    }
+    std::cout << "Test passed!\n";
+}
+
+void test_value_promotion() {
+    std::cout << "\n=== Test: Value Promotion ===\n";
+
+    // Past int64 the boxed PyInt holds a BigInt
+    Value largest = Value::from_int(INT64_MAX);
+    Value past = largest.add(Value::from_int(1));
+    assert(past.is_object() && past.to_string() == "9223372036854775808");
+
+    Value back = past.sub(Value::from_int(1));
+    assert(back.is_int() && back.as_int() == INT64_MAX);
+    assert(past.gt(largest).as_bool() && past.ne(back).as_bool());
+
+    Value product = largest.mul(largest);
+    assert(product.to_string() == "85070591730234615847396907784232501249");
+    Value power = Value::from_int(10).pow(Value::from_int(30));
+    assert(power.to_string() == "1000000000000000000000000000000");
+    Value reduced = power.mod(Value::from_int(7));
+    assert(reduced.is_small_int() && reduced.as_int() == 1);
+
+    Value smallest = Value::from_int(INT64_MIN);
+    Value negated = smallest.neg();
+    assert(negated.eq(past).as_bool());
+
+    // Small ints leaving the small range still take the inline fast path
+    // out and come back boxed as int64s
+    Value edge = Value::from_int(Value::SMALL_INT_MAX).mul(Value::from_int(4));
+    assert(edge.is_object() && edge.as_int() == Value::SMALL_INT_MAX * 4);
+    Value low = Value::from_int(Value::SMALL_INT_MIN).sub(Value::from_int(1));
+    assert(low.is_object() && low.as_int() == Value::SMALL_INT_MIN - 1);
+
+    for (Value v : {largest, past, back, product, power, smallest, negated, edge, low}) v.release();
+    std::cout << "Test passed!\n";
+}
+
+int main() {
+    std::cout << "Running BigInt Tests\n";
+    std::cout << "====================\n";
+
+    test_conversions();
+    test_arithmetic();
+    test_division();
+    test_karatsuba();
+    test_pyint_promotion();
+    test_value_promotion();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
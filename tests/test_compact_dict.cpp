@@ -0,0 +1,157 @@
+#include "runtime/compact_dict.h"
+#include "runtime/pyobject.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace aithon::runtime;
+
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view str) const { return std::hash<std::string_view>{}(str); }
+};
+
+using StringDict = CompactDict<std::string, int64_t, StringHash, std::equal_to<>>;
+
+// Every key lands in the same probe chain
+struct CollidingHash {
+    size_t operator()(int64_t) const { return 7; }
+};
+
+void test_insert_and_find() {
+    std::cout << "\n=== Test: Insert and Find ===\n";
+
+    StringDict dict;
+    assert(dict.insert_or_assign(std::string("one"), 1).second);
+    assert(dict.insert_or_assign(std::string("two"), 2).second);
+    assert(!dict.insert_or_assign(std::string("one"), 10).second);  // Overwrite
+
+    assert(dict.size() == 2);
+    assert(*dict.find(std::string_view("one")) == 10);
+    assert(*dict.find("two") == 2);
+    assert(!dict.find("three"));
+    assert(dict.contains(std::string_view("two")));
+    std::cout << "Test passed!\n";
+}
+
+void test_insertion_order() {
+    std::cout << "\n=== Test: Insertion Order ===\n";
+
+    StringDict dict;
+    for (int64_t i = 0; i < 1000; i++) {
+        dict.insert_or_assign("key" + std::to_string(i), i);
+    }
+
+    // Erasing leaves the rest in order, through resizes too
+    for (int64_t i = 0; i < 1000; i += 2) {
+        assert(dict.erase("key" + std::to_string(i)));
+    }
+    assert(!dict.erase(std::string_view("key0")));
+    for (int64_t i = 1000; i < 2000; i++) {
+        dict.insert_or_assign("key" + std::to_string(i), i);
+    }
+
+    std::vector<int64_t> seen;
+    for (const auto& entry : dict) seen.push_back(entry.value);
+
+    assert(dict.size() == 1500);
+    assert(seen.size() == 1500);
+    for (size_t i = 0; i < 500; i++) assert(seen[i] == static_cast<int64_t>(2 * i + 1));
+    for (size_t i = 500; i < 1500; i++) assert(seen[i] == static_cast<int64_t>(i + 500));
+    std::cout << "Test passed!\n";
+}
+
+void test_erase_last_then_grow() {
+    std::cout << "\n=== Test: Erase Last, Then Grow ===\n";
+
+    // The entries ahead of the erased one stay where they are when the
+    // resize compacts the rest
+    StringDict dict;
+    dict.insert_or_assign(std::string("alpha"), 1);
+    dict.insert_or_assign(std::string("beta"), 2);
+    dict.insert_or_assign(std::string("gamma"), 3);
+    assert(dict.erase(std::string_view("gamma")));
+    for (int64_t i = 0; i < 20; i++) {
+        dict.insert_or_assign("key" + std::to_string(i), i);
+    }
+
+    assert(dict.size() == 22);
+    assert(*dict.find("alpha") == 1 && *dict.find("beta") == 2);
+    assert(!dict.find("gamma"));
+
+    std::vector<std::string> keys;
+    for (const auto& entry : dict) keys.push_back(entry.key);
+    assert(keys[0] == "alpha" && keys[1] == "beta" && keys[2] == "key0" && keys[21] == "key19");
+    std::cout << "Test passed!\n";
+}
+
+void test_collisions() {
+    std::cout << "\n=== Test: Colliding Hashes ===\n";
+
+    CompactDict<int64_t, int64_t, CollidingHash> dict;
+    for (int64_t i = 0; i < 100; i++) dict.insert_or_assign(i, i * i);
+
+    // Erased slots in the middle of the chain must not end the probe
+    for (int64_t i = 0; i < 100; i += 3) dict.erase(i);
+    for (int64_t i = 0; i < 100; i++) {
+        const int64_t* value = dict.find(i);
+        assert((i % 3 == 0) == (value == nullptr));
+        if (value) assert(*value == i * i);
+    }
+    std::cout << "Test passed!\n";
+}
+
+void test_pydict_keys() {
+    std::cout << "\n=== Test: PyDict Keys ===\n";
+
+    auto* dict = new PyDict();
+    auto* value = new PyInt(30);
+
+    // str keys, by object or by string_view
+    dict->set("age", value);
+    auto* key = new PyString("age");
+    assert(dict->get(key) == value);
+    assert(dict->get_item(key) == value);
+    assert(dict->contains(std::string_view("age")));
+
+    // Any hashable key; 2 and 2.0 are the same key
+    auto* two = new PyInt(2);
+    auto* two_f = new PyFloat(2.0);
+    dict->set(two, value);
+    assert(dict->get(two_f) == value);
+    assert(dict->length() == 2);
+    assert(dict->to_string() == "{'age': 30, 2: 30}");
+
+    bool caught = false;
+    auto* list = new PyList();
+    try {
+        dict->set(list, value);
+    } catch (const std::runtime_error& e) {
+        caught = std::string(e.what()).find("unhashable") != std::string::npos;
+    }
+    assert(caught);
+
+    list->decref();
+    two->decref();
+    two_f->decref();
+    key->decref();
+    value->decref();
+    dict->decref();
+    std::cout << "Test passed!\n";
+}
+
+int main() {
+    std::cout << "Running CompactDict Tests\n";
+    std::cout << "=========================\n";
+
+    test_insert_and_find();
+    test_insertion_order();
+    test_erase_last_then_grow();
+    test_collisions();
+    test_pydict_keys();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "runtime/pyobject.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+using namespace aithon::runtime;
+
+// PyFunction calls: fixed-arity functions, variadic vectorcall functions
+// and std::function closures, through every entry point
+
+static int64_t int_of(PyObject* obj) {
+    return static_cast<PyInt*>(obj)->value();
+}
+
+static PyObject* answer() { return new PyInt(42); }
+static PyObject* negate(PyObject* a) { return new PyInt(-int_of(a)); }
+static PyObject* subtract(PyObject* a, PyObject* b) { return new PyInt(int_of(a) - int_of(b)); }
+static PyObject* mul_add(PyObject* a, PyObject* b, PyObject* c) {
+    return new PyInt(int_of(a) * int_of(b) + int_of(c));
+}
+
+// Result is a new reference; the test drops it once checked
+static int64_t take_int(PyObject* result) {
+    int64_t value = int_of(result);
+    result->decref();
+    return value;
+}
+
+void test_fixed_arity() {
+    std::cout << "\n=== Test: Fixed Arity ===\n";
+
+    auto* f0 = new PyFunction("answer", answer);
+    auto* f1 = new PyFunction("negate", negate);
+    auto* f2 = new PyFunction("subtract", subtract);
+    auto* f3 = new PyFunction("mul_add", mul_add);
+    assert(f0->arity() == 0 && f1->arity() == 1 && f2->arity() == 2 && f3->arity() == 3);
+
+    auto* a = new PyInt(7);
+    auto* b = new PyInt(3);
+    auto* c = new PyInt(1);
+    assert(take_int(f0->call0()) == 42);
+    assert(take_int(f1->call1(a)) == -7);
+    assert(take_int(f2->call2(a, b)) == 4);
+    assert(take_int(f3->call3(a, b, c)) == 22);
+
+    // The same functions through vectorcall; arguments stay borrowed
+    PyObject* args[] = {a, b, c};
+    assert(take_int(f2->vectorcall(args, 2)) == 4);
+    assert(take_int(f3->call(args, 3)) == 22);
+    assert(a->refcount() == 1 && b->refcount() == 1);
+
+    // A mismatched count is a TypeError
+    bool caught = false;
+    try {
+        f2->call1(a);
+    } catch (const std::runtime_error& e) {
+        caught = true;
+        assert(std::string(e.what()) ==
+               "TypeError: subtract() takes 2 positional arguments but 1 was given");
+    }
+    assert(caught);
+
+    for (PyObject* obj : {static_cast<PyObject*>(f0), static_cast<PyObject*>(f1),
+                          static_cast<PyObject*>(f2), static_cast<PyObject*>(f3),
+                          static_cast<PyObject*>(a), static_cast<PyObject*>(b),
+                          static_cast<PyObject*>(c)}) {
+        obj->decref();
+    }
+    std::cout << "Test passed!\n";
+}
+
+void test_variadic() {
+    std::cout << "\n=== Test: Variadic Vectorcall ===\n";
+
+    auto* sum = new PyFunction("sum", [](PyFunction*, PyObject* const* args, size_t nargs) -> PyObject* {
+        int64_t total = 0;
+        for (size_t i = 0; i < nargs; i++) total += int_of(args[i]);
+        return new PyInt(total);
+    });
+    assert(sum->arity() == -1);
+
+    auto* a = new PyInt(5);
+    auto* b = new PyInt(6);
+    PyObject* args[] = {a, b, a, b};
+    assert(take_int(sum->vectorcall(args, 4)) == 22);
+    assert(take_int(sum->vectorcall(nullptr, 0)) == 0);
+
+    // The fixed-arity entry points fall back to vectorcall
+    assert(take_int(sum->call1(a)) == 5);
+    assert(take_int(sum->call3(a, b, a)) == 16);
+
+    sum->decref();
+    a->decref();
+    b->decref();
+    std::cout << "Test passed!\n";
+}
+
+void test_native_closure() {
+    std::cout << "\n=== Test: Native Closure ===\n";
+
+    int64_t calls = 0;
+    auto* counter = new PyFunction("counter", PyFunction::NativeFn(
+        [&calls](PyObject* const* args, size_t nargs) -> PyObject* {
+            calls++;
+            return new PyInt(static_cast<int64_t>(nargs));
+        }));
+
+    auto* a = new PyInt(1);
+    assert(take_int(counter->call0()) == 0);
+    assert(take_int(counter->call2(a, a)) == 2);
+    assert(calls == 2);
+
+    counter->decref();
+    a->decref();
+    std::cout << "Test passed!\n";
+}
+
+int main() {
+    std::cout << "Running Function Call Tests\n";
+    std::cout << "===========================\n";
+
+    test_fixed_arity();
+    test_variadic();
+    test_native_closure();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
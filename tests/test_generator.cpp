@@ -0,0 +1,193 @@
+#include "runtime/pyobject.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+using namespace aithon::runtime;
+
+// PyGenerator: coroutine bodies resumed by next() and send(), running to
+// StopIteration, and frames destroyed part way through
+
+static int64_t int_of(PyObject* obj) {
+    return static_cast<PyInt*>(obj)->value();
+}
+
+static int64_t take_int(PyObject* result) {
+    int64_t value = int_of(result);
+    result->decref();
+    return value;
+}
+
+static bool stops(PyGenerator* gen) {
+    try {
+        gen->next();
+    } catch (const std::runtime_error& e) {
+        return std::string(e.what()) == "StopIteration";
+    }
+    return false;
+}
+
+static PyGenerator::Body count_to(int64_t n) {
+    for (int64_t i = 0; i < n; i++) co_yield new PyInt(i);
+}
+
+// Yields the running total of everything sent in
+static PyGenerator::Body accumulate() {
+    int64_t total = 0;
+    for (;;) {
+        PyObject* sent = co_yield new PyInt(total);
+        if (sent->type() == PyType::INT) total += int_of(sent);
+    }
+}
+
+struct Guard {
+    int* destroyed;
+    ~Guard() { ++*destroyed; }
+};
+
+static PyGenerator::Body guarded(int* destroyed) {
+    Guard guard{destroyed};
+    co_yield new PyInt(1);
+    co_yield new PyInt(2);
+}
+
+static PyGenerator::Body failing() {
+    co_yield new PyInt(1);
+    throw std::runtime_error("ValueError: bad item");
+}
+
+static PyGenerator* reentrant_gen = nullptr;
+
+static PyGenerator::Body reentrant() {
+    reentrant_gen->next();
+    co_return;
+}
+
+void test_next() {
+    std::cout << "\n=== Test: next() ===\n";
+
+    auto* gen = new PyGenerator(count_to(3));
+    assert(gen->state() == PyGenerator::State::CREATED);
+    assert(take_int(gen->next()) == 0);
+    assert(gen->state() == PyGenerator::State::SUSPENDED);
+    assert(take_int(gen->next()) == 1);
+    assert(take_int(gen->next()) == 2);
+    assert(stops(gen));
+    assert(gen->state() == PyGenerator::State::COMPLETED);
+
+    // Stays finished
+    assert(stops(gen));
+    gen->decref();
+
+    auto* empty = new PyGenerator(count_to(0));
+    assert(stops(empty));
+    empty->decref();
+    std::cout << "Test passed!\n";
+}
+
+void test_send() {
+    std::cout << "\n=== Test: send() ===\n";
+
+    auto* gen = new PyGenerator(accumulate());
+
+    // Only None can start a generator
+    auto* five = new PyInt(5);
+    bool caught = false;
+    try {
+        gen->send(five);
+    } catch (const std::runtime_error& e) {
+        caught = true;
+        assert(std::string(e.what()) ==
+               "TypeError: can't send non-None value to a just-started generator");
+    }
+    assert(caught);
+    assert(gen->state() == PyGenerator::State::CREATED);
+
+    assert(take_int(gen->next()) == 0);
+    assert(take_int(gen->send(five)) == 5);
+    auto* two = new PyInt(2);
+    assert(take_int(gen->send(two)) == 7);
+    assert(take_int(gen->next()) == 7);
+    assert(five->refcount() == 1 && two->refcount() == 1);
+
+    gen->decref();
+    five->decref();
+    two->decref();
+    std::cout << "Test passed!\n";
+}
+
+void test_frame_lifetime() {
+    std::cout << "\n=== Test: Frame Lifetime ===\n";
+
+    // Dropped half way: the frame and its locals go with the generator
+    int destroyed = 0;
+    auto* gen = new PyGenerator(guarded(&destroyed));
+    assert(take_int(gen->next()) == 1);
+    assert(destroyed == 0);
+    gen->decref();
+    assert(destroyed == 1);
+
+    // Run to the end: locals die when the body returns
+    destroyed = 0;
+    gen = new PyGenerator(guarded(&destroyed));
+    assert(take_int(gen->next()) == 1);
+    assert(take_int(gen->next()) == 2);
+    assert(stops(gen));
+    assert(destroyed == 1);
+    gen->decref();
+    assert(destroyed == 1);
+
+    // Never started
+    destroyed = 0;
+    gen = new PyGenerator(guarded(&destroyed));
+    gen->decref();
+    assert(destroyed == 0);
+    std::cout << "Test passed!\n";
+}
+
+void test_errors() {
+    std::cout << "\n=== Test: Errors ===\n";
+
+    // An exception from the body reaches the caller and ends the generator
+    auto* gen = new PyGenerator(failing());
+    assert(take_int(gen->next()) == 1);
+    bool caught = false;
+    try {
+        gen->next();
+    } catch (const std::runtime_error& e) {
+        caught = true;
+        assert(std::string(e.what()) == "ValueError: bad item");
+    }
+    assert(caught);
+    assert(gen->state() == PyGenerator::State::COMPLETED);
+    assert(stops(gen));
+    gen->decref();
+
+    // A body cannot resume itself
+    reentrant_gen = new PyGenerator(reentrant());
+    caught = false;
+    try {
+        reentrant_gen->next();
+    } catch (const std::runtime_error& e) {
+        caught = true;
+        assert(std::string(e.what()) == "ValueError: generator already executing");
+    }
+    assert(caught);
+    reentrant_gen->decref();
+    std::cout << "Test passed!\n";
+}
+
+int main() {
+    std::cout << "Running Generator Tests\n";
+    std::cout << "=======================\n";
+
+    test_next();
+    test_send();
+    test_frame_lifetime();
+    test_errors();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,279 @@
+#include "runtime/actor_gc.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+using namespace aithon::runtime;
+
+extern "C" {
+    void* runtime_class_create(const char* class_name, int64_t num_fields,
+                               const uint8_t* pointer_map);
+    void* runtime_retain(void* ptr);
+    void runtime_release(void* ptr);
+    void runtime_share(void* ptr);
+    void runtime_class_set_field_int(void* ptr, int64_t field_idx, int64_t value);
+    void runtime_class_set_field_bool(void* ptr, int64_t field_idx, bool value);
+    int64_t runtime_class_get_field_int(void* ptr, int64_t field_idx);
+    double runtime_class_get_field_float(void* ptr, int64_t field_idx);
+    bool runtime_class_get_field_bool(void* ptr, int64_t field_idx);
+    void runtime_class_set_field_ptr(void* ptr, int64_t field_idx, void* value);
+    void* runtime_class_get_field_ptr(void* ptr, int64_t field_idx);
+    int64_t runtime_collect_cycles();
+    uint64_t runtime_objects_freed();
+    uint64_t runtime_leaked_bytes();
+    void runtime_print_gc_stats();
+}
+
+// class Node: next: Node, value: int, label: str
+static const uint8_t NODE_MAP[] = {1, 0, 0};
+
+static void* new_node(int64_t value) {
+    void* node = runtime_class_create("Node", 3, NODE_MAP);
+    runtime_class_set_field_int(node, 1, value);
+    return node;
+}
+
+// Link a -> b; the field holds its own reference
+static void link(void* a, void* b) {
+    runtime_class_set_field_ptr(a, 0, b);
+}
+
+// class Point: x: int, y: float, visible: bool - as codegen lays it out,
+// %class.Point = { %HeapObject.header, i64, double, i64 }
+struct PointLayout {
+    uint64_t header[7];
+    int64_t x;
+    double y;
+    int64_t visible;
+};
+
+void test_typed_field_layout() {
+    std::cout << "\n=== Test: Typed Field Layout ===\n";
+
+    void* obj = runtime_class_create("Point", 3, nullptr);
+    auto* point = static_cast<PointLayout*>(obj);
+
+    // Inline stores are what the by-index helpers read...
+    point->x = -42;
+    point->y = 2.5;
+    point->visible = 1;
+    assert(runtime_class_get_field_int(obj, 0) == -42);
+    assert(runtime_class_get_field_float(obj, 1) == 2.5);
+    assert(runtime_class_get_field_bool(obj, 2));
+
+    // ...and the other way around
+    runtime_class_set_field_int(obj, 0, 7);
+    runtime_class_set_field_bool(obj, 2, false);
+    assert(point->x == 7);
+    assert(point->visible == 0);
+
+    runtime_release(obj);
+    std::cout << "Test passed!\n";
+}
+
+void test_deep_chain() {
+    std::cout << "\n=== Test: Deep Chain Release ===\n";
+
+    uint64_t leaked = runtime_leaked_bytes();
+    uint64_t freed = runtime_objects_freed();
+
+    // Far longer than recursive release could survive
+    const int64_t length = 1'000'000;
+    void* head = new_node(0);
+    void* tail = head;
+    for (int64_t i = 1; i < length; i++) {
+        void* node = new_node(i);
+        link(tail, node);
+        runtime_release(node);  // The chain owns it now
+        tail = node;
+    }
+
+    runtime_release(head);
+
+    assert(runtime_objects_freed() - freed == length);
+    assert(runtime_leaked_bytes() == leaked);
+    std::cout << "Test passed!\n";
+}
+
+void test_untracked_fields() {
+    std::cout << "\n=== Test: Untracked Pointer Fields ===\n";
+
+    uint64_t leaked = runtime_leaked_bytes();
+
+    // A string literal in a str field is stored, never counted
+    void* node = new_node(1);
+    runtime_class_set_field_ptr(node, 2, const_cast<char*>("label"));
+    runtime_class_set_field_ptr(node, 2, nullptr);
+    runtime_release(node);
+
+    assert(runtime_leaked_bytes() == leaked);
+    std::cout << "Test passed!\n";
+}
+
+void test_cycle_collection() {
+    std::cout << "\n=== Test: Cycle Collection ===\n";
+
+    uint64_t leaked = runtime_leaked_bytes();
+    runtime_collect_cycles();
+
+    // a <-> b, plus c -> a from outside the cycle
+    void* a = new_node(1);
+    void* b = new_node(2);
+    void* c = new_node(3);
+    link(a, b);
+    link(b, a);
+    link(c, a);
+    runtime_release(a);
+    runtime_release(b);
+
+    // c still reaches the cycle
+    assert(runtime_collect_cycles() == 0);
+    assert(runtime_class_get_field_ptr(runtime_class_get_field_ptr(c, 0), 0) == b);
+
+    // Dropping c frees it; its reference into the cycle is the last outside one
+    runtime_release(c);
+    assert(runtime_leaked_bytes() > leaked);
+    assert(runtime_collect_cycles() == 2);
+    assert(runtime_leaked_bytes() == leaked);
+
+    // A self-loop is a cycle too
+    void* self = new_node(4);
+    link(self, self);
+    runtime_release(self);
+    assert(runtime_collect_cycles() == 1);
+    assert(runtime_leaked_bytes() == leaked);
+
+    std::cout << "Test passed!\n";
+}
+
+void test_actor_cycles() {
+    std::cout << "\n=== Test: Actor Cycle Collection ===\n";
+
+    uint64_t leaked = runtime_leaked_bytes();
+    std::unique_ptr<ActorGC> slot;
+
+    {
+        ActorGCScope scope(slot);
+
+        // A ring the actor drops all its references to
+        void* first = new_node(0);
+        void* prev = first;
+        for (int64_t i = 1; i < 100; i++) {
+            void* node = new_node(i);
+            link(prev, node);
+            runtime_release(node);
+            prev = node;
+        }
+        link(prev, first);
+        runtime_release(first);
+    }
+
+    // The scheduler collects parked actors the same way
+    assert(slot && slot->cycle_candidates() > 0);
+    {
+        ActorGCScope scope(slot);
+        assert(slot->collect_cycles() == 100);
+    }
+    assert(slot->cycle_candidates() == 0);
+    assert(runtime_leaked_bytes() == leaked);
+    std::cout << "Test passed!\n";
+}
+
+void test_shared_graph() {
+    std::cout << "\n=== Test: Shared Graph Release ===\n";
+
+    uint64_t leaked = runtime_leaked_bytes();
+
+    void* head = new_node(0);
+    void* next = new_node(1);
+    link(head, next);
+    runtime_release(next);
+
+    // Sharing the head shares what it reaches; the last release - on
+    // another thread - frees both
+    runtime_share(head);
+    std::thread([head] { runtime_release(head); }).join();
+
+    assert(runtime_leaked_bytes() == leaked);
+    std::cout << "Test passed!\n";
+}
+
+void test_remote_release() {
+    std::cout << "\n=== Test: Release on Another Thread ===\n";
+
+    std::unique_ptr<ActorGC> slot;
+    void* node;
+    {
+        ActorGCScope scope(slot);
+        node = new_node(1);
+        runtime_share(node);
+    }
+    size_t pinned = slot->statistics().pinned_bytes;
+
+    // The last reference dies elsewhere; the block goes back to the actor
+    // when it next runs instead of waiting for the actor to die
+    std::thread([node] { runtime_release(node); }).join();
+    {
+        ActorGCScope scope(slot);
+        assert(slot->statistics().pinned_bytes < pinned);
+    }
+    std::cout << "Test passed!\n";
+}
+
+void test_shared_outlives_actor() {
+    std::cout << "\n=== Test: Shared Object Outlives Its Actor ===\n";
+
+    uint64_t leaked = runtime_leaked_bytes();
+    std::unique_ptr<ActorGC> slot;
+    void* head;
+    {
+        ActorGCScope scope(slot);
+        head = new_node(7);
+        void* next = new_node(8);
+        link(head, next);
+        runtime_release(next);
+        runtime_share(head);
+    }
+
+    // Another actor takes a reference, then the creator drops its own and
+    // dies; the heap stays while the other actor can still reach it
+    std::thread([head] { runtime_retain(head); }).join();
+    {
+        ActorGCScope scope(slot);
+        runtime_release(head);
+    }
+    ActorGC::retire(std::move(slot));
+
+    std::thread([head] {
+        assert(runtime_class_get_field_int(head, 1) == 7);
+        void* next = runtime_class_get_field_ptr(head, 0);
+        assert(runtime_class_get_field_int(next, 1) == 8);
+
+        // The last release frees the objects and the dead actor's heap
+        runtime_release(head);
+    }).join();
+
+    assert(runtime_leaked_bytes() == leaked);
+    std::cout << "Test passed!\n";
+}
+
+int main() {
+    std::cout << "Running HeapObject Tests\n";
+    std::cout << "========================\n";
+
+    test_typed_field_layout();
+    test_deep_chain();
+    test_untracked_fields();
+    test_cycle_collection();
+    test_actor_cycles();
+    test_shared_graph();
+    test_remote_release();
+    test_shared_outlives_actor();
+
+    runtime_print_gc_stats();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include "runtime/pyobject.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <string>
+
+using namespace aithon::runtime;
+
+extern "C" {
+    void* runtime_string_from_cstr(const char* str);
+    void* runtime_string_intern(void* str);
+    bool runtime_string_equals(void* a, void* b);
+    void runtime_string_release(void* str);
+    void* runtime_dict_create();
+    void runtime_dict_set_int(void* dict_ptr, void* key, int64_t value);
+    int64_t runtime_dict_get_int(void* dict_ptr, void* key);
+    void runtime_dict_free(void* dict_ptr);
+}
+
+void test_intern_table() {
+    std::cout << "\n=== Test: Intern Table ===\n";
+
+    InternTable table;
+    PyString* name = table.intern("name");
+    assert(name->is_interned());
+    assert(table.intern(std::string_view("name")) == name);
+    assert(table.intern("other") != name);
+    assert(table.size() == 2);
+
+    // An equal string maps to the canonical copy and stays uninterned
+    auto* copy = new PyString("name");
+    assert(table.intern(copy) == name);
+    assert(!copy->is_interned());
+
+    // A new string becomes the canonical copy itself
+    auto* fresh = new PyString("fresh");
+    assert(table.intern(fresh) == fresh);
+    assert(fresh->is_interned());
+    assert(table.intern("fresh") == fresh);
+
+    copy->decref();
+    fresh->decref();  // The table keeps its own reference
+    assert(table.intern("fresh")->value() == "fresh");
+    std::cout << "Test passed!\n";
+}
+
+void test_equality_and_hash() {
+    std::cout << "\n=== Test: Equality and Hash ===\n";
+
+    InternTable table;
+    PyString* a = table.intern("alpha");
+    PyString* b = table.intern("beta");
+    auto* plain = new PyString("alpha");
+
+    assert(a->eq(a)->to_bool());
+    assert(!a->eq(b)->to_bool());
+    assert(a->eq(plain)->to_bool());
+    assert(plain->eq(a)->to_bool());
+
+    // Cached hash matches the string_view hash dict lookups use
+    assert(a->hash() == plain->hash());
+    assert(a->hash() == a->hash());
+    assert(static_cast<size_t>(a->hash()) == PyKeyHash{}(std::string_view("alpha")));
+
+    auto* dict = new PyDict();
+    auto* value = new PyInt(1);
+    dict->set(a, value);
+    assert(dict->get(plain) == value);
+    assert(dict->get(std::string_view("alpha")) == value);
+    assert(!dict->get(b));
+
+    value->decref();
+    dict->decref();
+    plain->decref();
+    std::cout << "Test passed!\n";
+}
+
+void test_intern_scope() {
+    std::cout << "\n=== Test: Intern Scope ===\n";
+
+    PyString* outside = InternTable::current().intern("shared");
+
+    InternSlot first(nullptr, nullptr);
+    InternSlot second(nullptr, nullptr);
+    PyString* in_first;
+    {
+        InternScope scope(first);
+        in_first = InternTable::current().intern("shared");
+        assert(first && first->size() == 1);
+        assert(in_first != outside);
+        assert(InternTable::current().intern("shared") == in_first);
+
+        // Scopes nest
+        {
+            InternScope inner(second);
+            assert(InternTable::current().intern("shared") != in_first);
+        }
+        assert(&InternTable::current() == first.get());
+    }
+    assert(InternTable::current().intern("shared") == outside);
+    assert(second && second->size() == 1);
+    std::cout << "Test passed!\n";
+}
+
+void test_runtime_interning() {
+    std::cout << "\n=== Test: Runtime String Interning ===\n";
+
+    void* text = runtime_string_from_cstr("counter");
+    void* same = runtime_string_from_cstr("counter");
+    void* a = runtime_string_intern(text);
+    void* b = runtime_string_intern(same);
+    assert(a == b);
+    assert(a != text);
+    assert(runtime_string_intern(a) == a);
+
+    void* other_text = runtime_string_from_cstr("other");
+    void* other = runtime_string_intern(other_text);
+    assert(other != a);
+    assert(!runtime_string_equals(a, other));
+    assert(runtime_string_equals(a, text));
+
+    // Interned and plain keys find the same entry
+    void* dict = runtime_dict_create();
+    runtime_dict_set_int(dict, a, 42);
+    assert(runtime_dict_get_int(dict, text) == 42);
+    runtime_dict_set_int(dict, same, 7);
+    assert(runtime_dict_get_int(dict, a) == 7);
+    runtime_dict_free(dict);
+
+    runtime_string_release(text);
+    runtime_string_release(same);
+    runtime_string_release(other_text);
+    std::cout << "Test passed!\n";
+}
+
+int main() {
+    std::cout << "Running String Interning Tests\n";
+    std::cout << "==============================\n";
+
+    test_intern_table();
+    test_equality_and_hash();
+    test_intern_scope();
+    test_runtime_interning();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include "runtime/list_kernels.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Every instruction set's list kernels against the scalar ones, over
+// lengths that leave every possible tail, and the list C API on top
+
+using namespace aithon::runtime;
+
+extern "C" {
+    void* runtime_list_create();
+    void runtime_list_append_int(void* list_ptr, int64_t value);
+    void runtime_list_append_float(void* list_ptr, double value);
+    void runtime_list_append_string(void* list_ptr, void* str);
+    int64_t runtime_list_get_int(void* list_ptr, int64_t index);
+    double runtime_list_get_float(void* list_ptr, int64_t index);
+    void runtime_list_set_float(void* list_ptr, int64_t index, double value);
+    int64_t runtime_list_size(void* list_ptr);
+    int64_t* runtime_list_int_data(void* list_ptr);
+    void runtime_list_free(void* list_ptr);
+    int64_t runtime_list_sum_int(void* list_ptr);
+    double runtime_list_sum_float(void* list_ptr);
+    int64_t runtime_list_min_int(void* list_ptr);
+    int64_t runtime_list_max_int(void* list_ptr);
+    double runtime_list_min_float(void* list_ptr);
+    double runtime_list_max_float(void* list_ptr);
+    int64_t runtime_list_count_int(void* list_ptr, int64_t value);
+    int64_t runtime_list_index_int(void* list_ptr, int64_t value);
+    int64_t runtime_list_index_float(void* list_ptr, double value);
+    bool runtime_list_contains_int(void* list_ptr, int64_t value);
+    void* runtime_list_add_int(void* list_ptr, int64_t value);
+    void* runtime_list_mul_int(void* list_ptr, int64_t value);
+    void* runtime_list_mul_float(void* list_ptr, double value);
+
+    void* runtime_string_from_cstr(const char* str);
+    void runtime_string_release(void* str);
+}
+
+static std::vector<const ListKernels*> available_kernels() {
+    std::vector<const ListKernels*> kernels;
+    for (SimdLevel level : {SimdLevel::NEON, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (const ListKernels* k = list_kernels_for(level)) kernels.push_back(k);
+    }
+    return kernels;
+}
+
+void test_int_kernels() {
+    std::cout << "\n=== Test: Int Kernels ===\n";
+
+    const ListKernels& ref = *list_kernels_for(SimdLevel::SCALAR);
+    std::mt19937_64 rng(42);
+
+    for (const ListKernels* k : available_kernels()) {
+        std::cout << "  " << k->name << "\n";
+        for (int64_t n = 0; n <= 70; n++) {
+            std::vector<int64_t> data(n);
+            for (auto& x : data) x = static_cast<int64_t>(rng() % 64) - 32;
+            if (n > 5) {
+                data[n / 2] = std::numeric_limits<int64_t>::max();
+                data[n / 3] = std::numeric_limits<int64_t>::min();
+            }
+            int64_t needle = n > 0 ? data[n - 1] : 7;
+
+            // Same wrapped sum; both see the overflow when the total does
+            // not fit, wherever their partial sums overflowed
+            bool overflow = false, ref_overflow = false;
+            assert(k->sum_i64(data.data(), n, &overflow) == ref.sum_i64(data.data(), n, &ref_overflow));
+            __int128 exact = 0;
+            for (int64_t x : data) exact += x;
+            if (exact > std::numeric_limits<int64_t>::max() || exact < std::numeric_limits<int64_t>::min()) {
+                assert(overflow && ref_overflow);
+            }
+            if (n <= 5) assert(!overflow && !ref_overflow);
+            assert(k->count_i64(data.data(), n, needle) == ref.count_i64(data.data(), n, needle));
+            assert(k->find_i64(data.data(), n, needle) == ref.find_i64(data.data(), n, needle));
+            assert(k->find_i64(data.data(), n, 1000) == -1);
+            if (n > 0) {
+                assert(k->min_i64(data.data(), n) == ref.min_i64(data.data(), n));
+                assert(k->max_i64(data.data(), n) == ref.max_i64(data.data(), n));
+            }
+
+            // Wrapping arithmetic, including in place
+            std::vector<int64_t> got(n), want(n);
+            for (int64_t factor : {int64_t(3), int64_t(-7), int64_t(0x100000001)}) {
+                k->mul_i64(data.data(), n, factor, got.data());
+                ref.mul_i64(data.data(), n, factor, want.data());
+                assert(got == want);
+            }
+            k->add_i64(data.data(), n, -5, got.data());
+            ref.add_i64(data.data(), n, -5, want.data());
+            assert(got == want);
+            k->add_i64(data.data(), n, 1, data.data());
+            assert(n < 1 || data[0] == want[0] + 6);
+        }
+    }
+    std::cout << "Test passed!\n";
+}
+
+void test_float_kernels() {
+    std::cout << "\n=== Test: Float Kernels ===\n";
+
+    const ListKernels& ref = *list_kernels_for(SimdLevel::SCALAR);
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+
+    for (const ListKernels* k : available_kernels()) {
+        std::cout << "  " << k->name << "\n";
+        for (int64_t n = 0; n <= 70; n++) {
+            std::vector<double> data(n);
+            for (auto& x : data) x = std::round(dist(rng));  // Integral: exact sums
+            double needle = n > 0 ? data[n / 2] : 0.5;
+
+            assert(k->sum_f64(data.data(), n) == ref.sum_f64(data.data(), n));
+            assert(k->count_f64(data.data(), n, needle) == ref.count_f64(data.data(), n, needle));
+            assert(k->find_f64(data.data(), n, needle) == ref.find_f64(data.data(), n, needle));
+            if (n > 0) {
+                assert(k->min_f64(data.data(), n) == ref.min_f64(data.data(), n));
+                assert(k->max_f64(data.data(), n) == ref.max_f64(data.data(), n));
+            }
+
+            std::vector<double> got(n), want(n);
+            k->mul_f64(data.data(), n, 0.25, got.data());
+            ref.mul_f64(data.data(), n, 0.25, want.data());
+            assert(got == want);
+            k->add_f64(data.data(), n, 1.5, got.data());
+            ref.add_f64(data.data(), n, 1.5, want.data());
+            assert(got == want);
+        }
+    }
+    std::cout << "Test passed!\n";
+}
+
+void test_list_aggregates() {
+    std::cout << "\n=== Test: List Aggregates ===\n";
+    std::cout << "  selected: " << list_kernels().name << "\n";
+
+    void* list = runtime_list_create();
+    for (int64_t i = 1; i <= 1000; i++) runtime_list_append_int(list, i % 10 == 0 ? -i : i);
+
+    assert(runtime_list_sum_int(list) == 500500 - 2 * 50500);
+    assert(runtime_list_min_int(list) == -1000);
+    assert(runtime_list_max_int(list) == 999);
+    assert(runtime_list_count_int(list, 5) == 1);
+    assert(runtime_list_index_int(list, -20) == 19);
+    assert(runtime_list_contains_int(list, 999));
+    assert(!runtime_list_contains_int(list, 1000));
+    assert(runtime_list_index_int(list, 1000) == -1);
+
+    void* doubled = runtime_list_mul_int(list, 2);
+    assert(runtime_list_int_data(doubled));
+    assert(runtime_list_size(doubled) == 1000);
+    assert(runtime_list_get_int(doubled, 9) == -20);
+    void* shifted = runtime_list_add_int(doubled, 1);
+    assert(runtime_list_get_int(shifted, 0) == 3);
+
+    // A generic list: the string is a TypeError for the aggregates and the
+    // arithmetic, but search just never matches it and keeps positions
+    void* name = runtime_string_from_cstr("x");
+    runtime_list_append_string(list, name);
+    runtime_string_release(name);
+    runtime_list_append_int(list, 5);
+    assert(!runtime_list_int_data(list));
+    assert(runtime_list_sum_int(list) == 0);
+    assert(runtime_list_max_int(list) == 0);
+    assert(runtime_list_min_float(list) == 0.0);
+    assert(runtime_list_count_int(list, 5) == 2);
+    assert(runtime_list_index_int(list, 5) == 4);
+    assert(runtime_list_mul_int(list, 2) == nullptr);
+
+    // Empty lists
+    void* empty = runtime_list_create();
+    assert(runtime_list_sum_int(empty) == 0);
+    assert(runtime_list_max_int(empty) == 0);  // ValueError
+    void* empty_doubled = runtime_list_mul_int(empty, 2);
+    assert(runtime_list_size(empty_doubled) == 0);
+
+    void* floats = runtime_list_create();
+    for (int i = 0; i < 100; i++) runtime_list_append_float(floats, i * 0.5);
+    assert(runtime_list_sum_float(floats) == 2475.0);
+    assert(runtime_list_max_float(floats) == 49.5);
+    assert(runtime_list_index_float(floats, 10.0) == 20);
+    void* halved = runtime_list_mul_float(floats, 0.5);
+    assert(runtime_list_get_float(halved, 99) == 24.75);
+
+    // xs = [1, 2, 3]; xs[2] = 10.5 - the ints promote to float alongside it
+    void* mixed = runtime_list_create();
+    for (int64_t i = 1; i <= 3; i++) runtime_list_append_int(mixed, i);
+    runtime_list_set_float(mixed, 2, 10.5);
+    assert(!runtime_list_int_data(mixed));
+    assert(runtime_list_sum_float(mixed) == 13.5);
+    assert(runtime_list_max_float(mixed) == 10.5);
+    assert(runtime_list_min_float(mixed) == 1.0);
+    assert(runtime_list_index_float(mixed, 2.0) == 1);
+    assert(runtime_list_get_float(mixed, 0) == 1.0);
+    void* scaled = runtime_list_mul_float(mixed, 2.0);
+    assert(runtime_list_get_float(scaled, 1) == 4.0 && runtime_list_get_float(scaled, 2) == 21.0);
+
+    // Int results past int64 are an OverflowError, not a wrapped value
+    const int64_t top = std::numeric_limits<int64_t>::max();
+    void* large = runtime_list_create();
+    for (int i = 0; i < 40; i++) runtime_list_append_int(large, top / 16);
+    assert(runtime_list_sum_int(large) == 0);
+    assert(runtime_list_mul_int(large, 17) == nullptr);
+    assert(runtime_list_mul_int(large, -17) == nullptr);
+    assert(runtime_list_add_int(large, top) == nullptr);
+    void* sixteen = runtime_list_mul_int(large, 16);
+    assert(runtime_list_get_int(sixteen, 0) == top / 16 * 16);
+
+    // Lanes of +max and -max overflow in the vector kernels, but the total
+    // fits
+    void* cancelling = runtime_list_create();
+    for (int i = 0; i < 64; i++) runtime_list_append_int(cancelling, i % 2 ? -top : top);
+    runtime_list_append_int(cancelling, 7);
+    assert(runtime_list_sum_int(cancelling) == 7);
+
+    for (void* l : {list, doubled, shifted, empty, empty_doubled, floats, halved, mixed, scaled,
+                    large, sixteen, cancelling}) {
+        runtime_list_free(l);
+    }
+    std::cout << "Test passed!\n";
+}
+
+int main() {
+    std::cout << "Running List Kernel Tests\n";
+    std::cout << "=========================\n";
+
+    test_int_kernels();
+    test_float_kernels();
+    test_list_aggregates();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
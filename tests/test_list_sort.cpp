@@ -0,0 +1,299 @@
+#include "runtime/sort.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <cmath>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+using namespace aithon::runtime;
+
+// Sorting: the algorithms in sort.h, and sort()/sorted() through the C API
+// compiled code uses
+
+extern "C" {
+    void* runtime_list_create();
+    void runtime_list_append_int(void* list_ptr, int64_t value);
+    void runtime_list_append_float(void* list_ptr, double value);
+    void runtime_list_append_bool(void* list_ptr, bool value);
+    void runtime_list_append_string(void* list_ptr, void* str);
+    int64_t runtime_list_get_int(void* list_ptr, int64_t index);
+    double runtime_list_get_float(void* list_ptr, int64_t index);
+    bool runtime_list_get_bool(void* list_ptr, int64_t index);
+    void* runtime_list_get_string(void* list_ptr, int64_t index);
+    int64_t runtime_list_len(void* list_ptr);
+    void runtime_list_free(void* list_ptr);
+    void runtime_list_sort(void* list_ptr, bool reverse);
+    void* runtime_list_sorted(void* list_ptr, bool reverse);
+    void* runtime_string_from_cstr(const char* str);
+    const char* runtime_string_data(void* str);
+    void runtime_string_release(void* str);
+}
+
+// Inputs that trip up naive quicksorts
+static std::vector<std::vector<int64_t>> patterns(size_t n, std::mt19937_64& rng) {
+    std::vector<std::vector<int64_t>> inputs(7, std::vector<int64_t>(n));
+    for (size_t i = 0; i < n; i++) {
+        inputs[0][i] = static_cast<int64_t>(rng());                    // Random, full range
+        inputs[1][i] = static_cast<int64_t>(rng() % 16) - 8;           // Few distinct values
+        inputs[2][i] = static_cast<int64_t>(i);                        // Sorted
+        inputs[3][i] = static_cast<int64_t>(n - i);                    // Reversed
+        inputs[4][i] = 7;                                              // All equal
+        inputs[5][i] = static_cast<int64_t>(i % 2 ? i : n - i);        // Organ pipe-ish
+        inputs[6][i] = i % 64 == 0 ? static_cast<int64_t>(rng()) : static_cast<int64_t>(i);  // Nearly sorted
+    }
+    return inputs;
+}
+
+void test_pdq_sort() {
+    std::cout << "\n=== Test: Pattern-Defeating Quicksort ===\n";
+
+    std::mt19937_64 rng(42);
+    auto less = [](int64_t a, int64_t b) { return a < b; };
+    for (size_t n : {0, 1, 2, 23, 24, 25, 129, 1000, 100000}) {
+        for (auto& input : patterns(n, rng)) {
+            auto expected = input;
+            std::sort(expected.begin(), expected.end());
+            pdq_sort(input.data(), input.data() + n, less);
+            assert(input == expected);
+        }
+    }
+
+    // Descending through the comparison, strings by value
+    std::vector<std::string> words = {"pear", "apple", "fig", "banana", "apple", "kiwi"};
+    pdq_sort(words.data(), words.data() + words.size(),
+             [](const std::string& a, const std::string& b) { return a > b; });
+    assert((words == std::vector<std::string>{"pear", "kiwi", "fig", "banana", "apple", "apple"}));
+    std::cout << "Test passed!\n";
+}
+
+void test_radix_sort() {
+    std::cout << "\n=== Test: Radix Sort ===\n";
+
+    std::mt19937_64 rng(7);
+    for (size_t n : {0, 1, 255, 256, 257, 5000, 200000}) {
+        for (auto& input : patterns(n, rng)) {
+            auto expected = input;
+            std::sort(expected.begin(), expected.end());
+            std::vector<int64_t> scratch(n);
+            radix_sort(input.data(), n, scratch.data());
+            assert(input == expected);
+        }
+    }
+
+    // Extremes and signs
+    std::vector<int64_t> edges;
+    for (int i = 0; i < 300; i++) {
+        edges.push_back(i % 3 == 0 ? INT64_MIN + i : i % 3 == 1 ? INT64_MAX - i : -i);
+    }
+    auto expected = edges;
+    std::sort(expected.begin(), expected.end());
+    std::vector<int64_t> scratch(edges.size());
+    radix_sort(edges.data(), edges.size(), scratch.data());
+    assert(edges == expected);
+    std::cout << "Test passed!\n";
+}
+
+// Runs jobs on plain threads, standing in for the scheduler
+static void thread_runner(void*, ParallelTask task, void* ctx, size_t count) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < count; i++) threads.emplace_back(task, ctx, i);
+    for (auto& thread : threads) thread.join();
+}
+
+void test_parallel_merge_sort() {
+    std::cout << "\n=== Test: Parallel Merge Sort ===\n";
+
+    const ParallelRunner runner{thread_runner, nullptr, 6};
+    parallel_runner.store(&runner);
+    assert(parallel_workers() == 6);
+
+    std::mt19937_64 rng(3);
+    for (size_t n : {0, 1, 5, 1000, 300001}) {
+        for (auto& input : patterns(n, rng)) {
+            auto expected = input;
+            std::sort(expected.begin(), expected.end());
+            std::vector<int64_t> scratch(n);
+            parallel_merge_sort(input.data(), n, scratch.data(),
+                                [](int64_t a, int64_t b) { return a < b; },
+                                [](int64_t* begin, int64_t* end, int64_t* chunk_scratch) {
+                                    radix_sort(begin, end - begin, chunk_scratch);
+                                });
+            assert(input == expected);
+        }
+    }
+
+    // Stable: equal keys keep their order across runs and merges
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < 50000; i++) pairs.push_back({static_cast<int>(rng() % 100), i});
+    std::vector<std::pair<int, int>> scratch(pairs.size());
+    auto by_key = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+    parallel_merge_sort(pairs.data(), pairs.size(), scratch.data(), by_key,
+                        [&](auto* begin, auto* end, auto*) { std::stable_sort(begin, end, by_key); });
+    for (size_t i = 1; i < pairs.size(); i++) {
+        assert(pairs[i - 1].first < pairs[i].first ||
+               (pairs[i - 1].first == pairs[i].first && pairs[i - 1].second < pairs[i].second));
+    }
+
+    parallel_runner.store(nullptr);
+    std::cout << "Test passed!\n";
+}
+
+void test_sort_unboxed_lists() {
+    std::cout << "\n=== Test: Sort Unboxed Lists ===\n";
+
+    std::mt19937_64 rng(11);
+    void* ints = runtime_list_create();
+    std::vector<int64_t> expected;
+    for (int i = 0; i < 10000; i++) {
+        int64_t value = static_cast<int64_t>(rng() % 2001) - 1000;
+        runtime_list_append_int(ints, value);
+        expected.push_back(value);
+    }
+    std::vector<int64_t> original = expected;
+    std::sort(expected.begin(), expected.end());
+
+    // sorted() leaves its argument alone
+    void* copy = runtime_list_sorted(ints, false);
+    for (int64_t i = 0; i < 10000; i++) assert(runtime_list_get_int(ints, i) == original[i]);
+    runtime_list_sort(ints, false);
+    for (int64_t i = 0; i < 10000; i++) {
+        assert(runtime_list_get_int(ints, i) == expected[i]);
+        assert(runtime_list_get_int(copy, i) == expected[i]);
+    }
+    runtime_list_sort(ints, true);
+    for (int64_t i = 0; i < 10000; i++) assert(runtime_list_get_int(ints, i) == expected[9999 - i]);
+
+    // NaN goes last instead of scrambling the order
+    void* floats = runtime_list_create();
+    for (double value : {2.5, double(NAN), -1.0, 0.5, -7.25}) runtime_list_append_float(floats, value);
+    runtime_list_sort(floats, false);
+    assert(runtime_list_get_float(floats, 0) == -7.25);
+    assert(runtime_list_get_float(floats, 1) == -1.0);
+    assert(runtime_list_get_float(floats, 3) == 2.5);
+    assert(std::isnan(runtime_list_get_float(floats, 4)));
+
+    void* bools = runtime_list_create();
+    for (bool value : {true, false, true, false, false}) runtime_list_append_bool(bools, value);
+    runtime_list_sort(bools, true);
+    assert(runtime_list_get_bool(bools, 0) && runtime_list_get_bool(bools, 1));
+    assert(!runtime_list_get_bool(bools, 2) && !runtime_list_get_bool(bools, 4));
+
+    runtime_list_free(ints);
+    runtime_list_free(copy);
+    runtime_list_free(floats);
+    runtime_list_free(bools);
+    std::cout << "Test passed!\n";
+}
+
+void test_sort_strings() {
+    std::cout << "\n=== Test: Sort Strings ===\n";
+
+    void* words = runtime_list_create();
+    for (const char* word : {"pear", "apple", "Zebra", "fig", "", "apples"}) {
+        void* str = runtime_string_from_cstr(word);
+        runtime_list_append_string(words, str);
+        runtime_string_release(str);
+    }
+
+    // The copy holds its own references
+    void* sorted = runtime_list_sorted(words, false);
+    runtime_list_free(words);
+    const char* expected[] = {"", "Zebra", "apple", "apples", "fig", "pear"};
+    for (int64_t i = 0; i < 6; i++) {
+        assert(std::string(runtime_string_data(runtime_list_get_string(sorted, i))) == expected[i]);
+    }
+    runtime_list_free(sorted);
+    std::cout << "Test passed!\n";
+}
+
+void test_sort_generic() {
+    std::cout << "\n=== Test: Sort Mixed Numbers ===\n";
+
+    // Ints, floats and bools compare by value; equal ones keep their order
+    // both ways, as with Python's stable sort
+    void* mixed = runtime_list_create();
+    runtime_list_append_int(mixed, 3);
+    runtime_list_append_float(mixed, 1.0);
+    runtime_list_append_bool(mixed, true);
+    runtime_list_append_float(mixed, -0.5);
+    runtime_list_append_int(mixed, 1);
+    runtime_list_append_bool(mixed, false);
+
+    runtime_list_sort(mixed, false);
+    assert(runtime_list_get_bool(mixed, 1) == false);      // False
+    assert(runtime_list_get_float(mixed, 0) == -0.5);
+    assert(runtime_list_get_float(mixed, 2) == 1.0);       // 1.0, True, 1
+    assert(runtime_list_get_bool(mixed, 3) == true);
+    assert(runtime_list_get_int(mixed, 4) == 1);
+    assert(runtime_list_get_int(mixed, 5) == 3);
+
+    runtime_list_sort(mixed, true);
+    assert(runtime_list_get_int(mixed, 0) == 3);
+    assert(runtime_list_get_float(mixed, 1) == 1.0);       // Still 1.0, True, 1
+    assert(runtime_list_get_bool(mixed, 2) == true);
+    assert(runtime_list_get_int(mixed, 3) == 1);
+    assert(runtime_list_get_float(mixed, 5) == -0.5);
+
+    // Strings and numbers don't compare: TypeError, list unchanged
+    void* unorderable = runtime_list_create();
+    void* str = runtime_string_from_cstr("a");
+    runtime_list_append_int(unorderable, 2);
+    runtime_list_append_string(unorderable, str);
+    runtime_list_append_int(unorderable, 1);
+    runtime_list_sort(unorderable, false);
+    assert(runtime_list_get_int(unorderable, 0) == 2);
+    assert(runtime_list_get_string(unorderable, 1) == str);
+    assert(runtime_list_get_int(unorderable, 2) == 1);
+
+    runtime_string_release(str);
+    runtime_list_free(mixed);
+    runtime_list_free(unorderable);
+    std::cout << "Test passed!\n";
+}
+
+void test_parallel_list_sort() {
+    std::cout << "\n=== Test: Parallel List Sort ===\n";
+
+    const ParallelRunner runner{thread_runner, nullptr, 4};
+    parallel_runner.store(&runner);
+
+    std::mt19937_64 rng(5);
+    const int64_t n = 1 << 21;
+    void* ints = runtime_list_create();
+    void* floats = runtime_list_create();
+    for (int64_t i = 0; i < n; i++) {
+        runtime_list_append_int(ints, static_cast<int64_t>(rng()));
+        runtime_list_append_float(floats, static_cast<double>(rng() % 100000) / 7);
+    }
+    runtime_list_sort(ints, false);
+    runtime_list_sort(floats, true);
+    for (int64_t i = 1; i < n; i++) {
+        assert(runtime_list_get_int(ints, i - 1) <= runtime_list_get_int(ints, i));
+        assert(runtime_list_get_float(floats, i - 1) >= runtime_list_get_float(floats, i));
+    }
+
+    parallel_runner.store(nullptr);
+    runtime_list_free(ints);
+    runtime_list_free(floats);
+    std::cout << "Test passed!\n";
+}
+
+int main() {
+    std::cout << "Running List Sort Tests\n";
+    std::cout << "=======================\n";
+
+    test_pdq_sort();
+    test_radix_sort();
+    test_parallel_merge_sort();
+    test_sort_unboxed_lists();
+    test_sort_strings();
+    test_sort_generic();
+    test_parallel_list_sort();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
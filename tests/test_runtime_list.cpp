@@ -0,0 +1,148 @@
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <string>
+
+// Runtime lists through the C API compiled code uses: unboxed storage for
+// lists of one element type, and the switch to boxed values on a mixed
+// insert
+
+extern "C" {
+    void* runtime_list_create();
+    void runtime_list_append_int(void* list_ptr, int64_t value);
+    void runtime_list_append_float(void* list_ptr, double value);
+    void runtime_list_append_bool(void* list_ptr, bool value);
+    void runtime_list_append_string(void* list_ptr, void* str);
+    int64_t runtime_list_get_int(void* list_ptr, int64_t index);
+    double runtime_list_get_float(void* list_ptr, int64_t index);
+    bool runtime_list_get_bool(void* list_ptr, int64_t index);
+    void* runtime_list_get_string(void* list_ptr, int64_t index);
+    void runtime_list_set_int(void* list_ptr, int64_t index, int64_t value);
+    void runtime_list_set_float(void* list_ptr, int64_t index, double value);
+    void runtime_list_set_string(void* list_ptr, int64_t index, void* str);
+    int64_t* runtime_list_int_data(void* list_ptr);
+    double* runtime_list_float_data(void* list_ptr);
+    int64_t runtime_list_size(void* list_ptr);
+    void runtime_list_free(void* list_ptr);
+
+    void* runtime_string_from_cstr(const char* str);
+    const char* runtime_string_data(void* str);
+    void runtime_string_release(void* str);
+}
+
+void test_int_list() {
+    std::cout << "\n=== Test: Int List ===\n";
+
+    void* list = runtime_list_create();
+    for (int64_t i = 0; i < 1000; i++) runtime_list_append_int(list, i * 3);
+    assert(runtime_list_size(list) == 1000);
+
+    // Stored as a flat int64_t array
+    int64_t* data = runtime_list_int_data(list);
+    assert(data);
+    assert(data[10] == 30 && data[999] == 2997);
+    assert(!runtime_list_float_data(list));
+
+    assert(runtime_list_get_int(list, 5) == 15);
+    assert(runtime_list_get_int(list, -1) == 2997);
+
+    runtime_list_set_int(list, -2, 7);
+    assert(runtime_list_int_data(list)[998] == 7);
+
+    // Out of range reads report an error and give 0
+    assert(runtime_list_get_int(list, 1000) == 0);
+    assert(runtime_list_get_int(list, -1001) == 0);
+
+    runtime_list_free(list);
+    std::cout << "Test passed!\n";
+}
+
+void test_float_and_bool_lists() {
+    std::cout << "\n=== Test: Float and Bool Lists ===\n";
+
+    void* floats = runtime_list_create();
+    runtime_list_append_float(floats, 1.5);
+    runtime_list_append_float(floats, -2.25);
+    assert(runtime_list_float_data(floats)[1] == -2.25);
+    runtime_list_set_float(floats, 0, 4.0);
+    assert(runtime_list_get_float(floats, 0) == 4.0);
+
+    void* flags = runtime_list_create();
+    runtime_list_append_bool(flags, true);
+    runtime_list_append_bool(flags, false);
+    assert(runtime_list_get_bool(flags, 0));
+    assert(!runtime_list_get_bool(flags, 1));
+    assert(!runtime_list_int_data(flags));
+
+    runtime_list_free(floats);
+    runtime_list_free(flags);
+    std::cout << "Test passed!\n";
+}
+
+void test_mixed_insert() {
+    std::cout << "\n=== Test: Mixed Insert ===\n";
+
+    void* list = runtime_list_create();
+    for (int64_t i = 0; i < 20; i++) runtime_list_append_int(list, i);
+
+    // The first non-int element boxes the whole list
+    void* name = runtime_string_from_cstr("twenty");
+    runtime_list_append_string(list, name);
+    assert(!runtime_list_int_data(list));
+    assert(runtime_list_size(list) == 21);
+    assert(runtime_list_get_int(list, 19) == 19);
+    assert(runtime_list_get_string(list, 20) == name);
+
+    // Reading an element as the wrong type gives the default
+    assert(runtime_list_get_string(list, 0) == nullptr);
+    assert(runtime_list_get_int(list, 20) == 0);
+
+    // Setting works element by element, releasing replaced strings
+    runtime_list_append_float(list, 0.5);
+    assert(runtime_list_get_float(list, 21) == 0.5);
+    runtime_list_set_int(list, 20, 42);
+    assert(runtime_list_get_int(list, 20) == 42);
+    runtime_list_set_string(list, 0, name);
+    runtime_string_release(name);
+    assert(std::string(runtime_string_data(runtime_list_get_string(list, 0))) == "twenty");
+
+    runtime_list_free(list);
+    std::cout << "Test passed!\n";
+}
+
+void test_string_list() {
+    std::cout << "\n=== Test: String List ===\n";
+
+    void* a = runtime_string_from_cstr("a");
+    void* b = runtime_string_from_cstr("b");
+
+    void* list = runtime_list_create();
+    runtime_list_append_string(list, a);
+    runtime_list_append_string(list, a);
+    runtime_list_set_string(list, 1, b);
+    assert(runtime_list_get_string(list, 0) == a);
+    assert(runtime_list_get_string(list, 1) == b);
+
+    // Turning a string list generic keeps its references
+    runtime_list_append_int(list, 3);
+    runtime_string_release(a);
+    runtime_string_release(b);
+    assert(std::string(runtime_string_data(runtime_list_get_string(list, 1))) == "b");
+    assert(runtime_list_get_int(list, 2) == 3);
+
+    runtime_list_free(list);
+    std::cout << "Test passed!\n";
+}
+
+int main() {
+    std::cout << "Running Runtime List Tests\n";
+    std::cout << "==========================\n";
+
+    test_int_list();
+    test_float_and_bool_lists();
+    test_mixed_insert();
+    test_string_list();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// Runtime strings through the C API compiled code uses
+
+extern "C" {
+    void* runtime_string_new(const char* data, int64_t length);
+    void* runtime_string_from_cstr(const char* str);
+    int64_t runtime_string_length(void* str);
+    const char* runtime_string_data(void* str);
+    int64_t runtime_string_hash(void* str);
+    bool runtime_string_equals(void* a, void* b);
+    void* runtime_string_concat(void* a, void* b);
+    void* runtime_string_substring(void* str, int64_t start, int64_t end);
+    void runtime_string_release(void* str);
+
+    void* runtime_list_create();
+    void runtime_list_append_string(void* list_ptr, void* str);
+    void* runtime_list_get_string(void* list_ptr, int64_t index);
+    void runtime_list_free(void* list_ptr);
+    void* runtime_dict_create();
+    void runtime_dict_set_string(void* dict_ptr, void* key, void* value);
+    void* runtime_dict_get_string(void* dict_ptr, void* key);
+    bool runtime_dict_has_key(void* dict_ptr, void* key);
+    void runtime_dict_free(void* dict_ptr);
+}
+
+static bool stored_inline(void* str) {
+    auto* text = runtime_string_data(str);
+    return text >= static_cast<char*>(str) && text < static_cast<char*>(str) + 64;
+}
+
+static std::string text_of(void* str) {
+    return std::string(runtime_string_data(str), runtime_string_length(str));
+}
+
+void test_small_and_long() {
+    std::cout << "\n=== Test: Small and Long Strings ===\n";
+
+    void* small = runtime_string_from_cstr("hello");
+    assert(runtime_string_length(small) == 5);
+    assert(stored_inline(small));
+    assert(std::strcmp(runtime_string_data(small), "hello") == 0);
+
+    std::string long_text(100, 'x');
+    void* large = runtime_string_new(long_text.data(), long_text.size());
+    assert(runtime_string_length(large) == 100);
+    assert(!stored_inline(large));
+    assert(text_of(large) == long_text);
+
+    // Embedded NULs are part of the text
+    void* binary = runtime_string_new("a\0b", 3);
+    assert(runtime_string_length(binary) == 3);
+
+    void* empty = runtime_string_new("", 0);
+    assert(runtime_string_length(empty) == 0);
+
+    runtime_string_release(small);
+    runtime_string_release(large);
+    runtime_string_release(binary);
+    runtime_string_release(empty);
+    std::cout << "Test passed!\n";
+}
+
+void test_equality_and_hash() {
+    std::cout << "\n=== Test: Equality and Hash ===\n";
+
+    void* a = runtime_string_from_cstr("key");
+    void* b = runtime_string_from_cstr("key");
+    void* c = runtime_string_from_cstr("kez");
+    assert(runtime_string_equals(a, b));
+    assert(!runtime_string_equals(a, c));
+    assert(runtime_string_hash(a) == runtime_string_hash(b));
+    assert(runtime_string_hash(a) == runtime_string_hash(a));  // Cached
+
+    runtime_string_release(a);
+    runtime_string_release(b);
+    runtime_string_release(c);
+    std::cout << "Test passed!\n";
+}
+
+void test_concat_and_substring() {
+    std::cout << "\n=== Test: Concat and Substring ===\n";
+
+    void* hello = runtime_string_from_cstr("Hello, ");
+    void* world = runtime_string_from_cstr("World");
+    void* greeting = runtime_string_concat(hello, world);
+    assert(text_of(greeting) == "Hello, World");
+    assert(stored_inline(greeting));
+
+    std::string long_text = std::string(40, 'a') + std::string(40, 'b');
+    void* large = runtime_string_new(long_text.data(), long_text.size());
+
+    // Long substrings share the source's text; short ones are copied inline
+    void* tail = runtime_string_substring(large, 10, 80);
+    assert(runtime_string_data(tail) == runtime_string_data(large) + 10);
+    assert(text_of(tail) == long_text.substr(10));
+    void* piece = runtime_string_substring(large, 38, 42);
+    assert(stored_inline(piece));
+    assert(text_of(piece) == "aabb");
+
+    // The shared text outlives the string it came from
+    runtime_string_release(large);
+    assert(text_of(tail) == long_text.substr(10));
+
+    // Out-of-range bounds clamp
+    void* clamped = runtime_string_substring(greeting, -5, 100);
+    assert(text_of(clamped) == "Hello, World");
+
+    runtime_string_release(hello);
+    runtime_string_release(world);
+    runtime_string_release(greeting);
+    runtime_string_release(tail);
+    runtime_string_release(piece);
+    runtime_string_release(clamped);
+    std::cout << "Test passed!\n";
+}
+
+void test_containers_share_strings() {
+    std::cout << "\n=== Test: Containers Share Strings ===\n";
+
+    void* name = runtime_string_from_cstr("name");
+    void* value = runtime_string_from_cstr("Alice");
+
+    void* list = runtime_list_create();
+    runtime_list_append_string(list, value);
+    assert(runtime_list_get_string(list, 0) == value);
+
+    void* dict = runtime_dict_create();
+    runtime_dict_set_string(dict, name, value);
+    void* lookup = runtime_string_from_cstr("name");
+    assert(runtime_dict_has_key(dict, lookup));
+    assert(runtime_dict_get_string(dict, lookup) == value);
+
+    // Overwriting releases the old value
+    void* other = runtime_string_from_cstr("Bob");
+    runtime_dict_set_string(dict, lookup, other);
+    assert(runtime_dict_get_string(dict, name) == other);
+
+    // The containers hold their own references
+    runtime_string_release(name);
+    runtime_string_release(value);
+    runtime_string_release(other);
+    runtime_string_release(lookup);
+    assert(text_of(runtime_list_get_string(list, 0)) == "Alice");
+
+    runtime_list_free(list);
+    runtime_dict_free(dict);
+    std::cout << "Test passed!\n";
+}
+
+int main() {
+    std::cout << "Running Runtime String Tests\n";
+    std::cout << "============================\n";
+
+    test_small_and_long();
+    test_equality_and_hash();
+    test_concat_and_substring();
+    test_containers_share_strings();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -2,6 +2,11 @@
 #include "runtime/actor_process.h"
 #include <iostream>
 #include <cassert>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <thread>
 
 using namespace aithon::runtime;
 
@@ -65,12 +70,278 @@ void test_messaging() {
     std::cout << "Test passed!\n";
 }
 
+std::atomic<int> batch_received{0};
+
+void drain_behavior(ActorProcess* self, void* args) {
+    while (Message* msg = self->receive()) {
+        int value = *static_cast<int*>(msg->payload);
+        assert(value == batch_received.load() % 4);  // Per-destination order kept
+        batch_received.fetch_add(1);
+    }
+}
+
+void test_send_many() {
+    std::cout << "\n=== Test: Batched Send ===\n";
+    Scheduler scheduler(2);
+    
+    int pid = scheduler.spawn(drain_behavior);
+    
+    int values[4] = {0, 1, 2, 3};
+    std::vector<Scheduler::OutgoingMessage> batch;
+    for (int round = 0; round < 8; round++) {
+        for (int& v : values) {
+            batch.push_back({pid, &v, sizeof(v)});
+        }
+    }
+    batch.push_back({12345, &values[0], sizeof(int)});  // Unknown actor is skipped
+    
+    size_t delivered = scheduler.send_many(-1, batch);
+    assert(delivered == 32);
+    
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    assert(batch_received.load() == 32);
+    
+    scheduler.dump_stats();
+    scheduler.shutdown();
+    std::cout << "Test passed!\n";
+}
+
+std::atomic<int> quanta_running{0};
+std::atomic<bool> quanta_overlapped{false};
+std::atomic<int> stress_received{0};
+
+void exclusive_behavior(ActorProcess* self, void* args) {
+    // A second worker running the actor while the first finishes its
+    // quantum would show up here
+    if (quanta_running.fetch_add(1) != 0) quanta_overlapped.store(true);
+    while (self->receive()) {
+        stress_received.fetch_add(1);
+    }
+    
+    // Parked but still on this worker's stack - give the senders and the
+    // other workers the chance to run it
+    std::this_thread::yield();
+    quanta_running.fetch_sub(1);
+}
+
+void test_many_senders() {
+    std::cout << "\n=== Test: Many Senders, One Receiver ===\n";
+    Scheduler scheduler(4);
+    
+    int pid = scheduler.spawn(exclusive_behavior);
+    
+    // Every wake races the receiver parking and leaving its quantum
+    const int senders = 8, per_sender = 5000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < senders; t++) {
+        threads.emplace_back([&scheduler, pid, t] {
+            for (int i = 0; i < per_sender; i++) {
+                int value = t * per_sender + i;
+                while (!scheduler.send_message(-1, pid, &value, sizeof(value))) {
+                    std::this_thread::yield();  // Heap full until the actor collects
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    
+    for (int i = 0; i < 500 && stress_received.load() < senders * per_sender; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    assert(stress_received.load() == senders * per_sender);
+    assert(!quanta_overlapped.load());
+    
+    scheduler.shutdown();
+    std::cout << "Test passed!\n";
+}
+
+std::atomic<int64_t> running_total{0};
+
+void counting_behavior(ActorProcess* self, void* args) {
+    // The running total lives on the actor's heap, reachable from the
+    // continuation, so it has to survive hibernation
+    if (!self->continuation()) {
+        auto* total = static_cast<int64_t*>(self->allocate(sizeof(int64_t)));
+        *total = 0;
+        self->set_continuation(total);
+    }
+    
+    while (Message* msg = self->receive()) {
+        auto* total = static_cast<int64_t*>(self->continuation());
+        *total += static_cast<unsigned char*>(msg->payload)[0];
+        running_total.store(*total);
+    }
+}
+
+static void wait_for_total(int64_t expected) {
+    for (int i = 0; i < 200 && running_total.load() != expected; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    assert(running_total.load() == expected);
+}
+
+void test_hibernate() {
+    std::cout << "\n=== Test: Hibernation ===\n";
+    Scheduler scheduler(2);
+    scheduler.set_hibernate_after(0);  // Explicit hibernation first
+    
+    int pid = scheduler.spawn(counting_behavior, nullptr, 4 * 1024 * 1024);
+    ActorProcess* actor = scheduler.get_actor(pid);
+    
+    std::vector<unsigned char> payload(64 * 1024, 1);
+    for (int i = 0; i < 8; i++) {
+        scheduler.send_message(-1, pid, payload.data(), payload.size());
+    }
+    wait_for_total(8);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    
+    size_t before = actor->heap().total();
+    size_t released = scheduler.hibernate(pid);
+    std::cout << "Hibernated: " << before << " -> " << actor->heap().total() << " bytes\n";
+    assert(released > 0);
+    assert(actor->is_hibernated());
+    assert(actor->heap().total() <= ActorHeap::DEFAULT_INITIAL_SIZE);
+    
+    // The next message re-expands the heap; the total survived the move
+    scheduler.send_message(-1, pid, payload.data(), payload.size());
+    wait_for_total(9);
+    assert(!actor->is_hibernated());
+    
+    // Idle policy
+    scheduler.set_hibernate_after(50);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    assert(actor->is_hibernated());
+    
+    scheduler.dump_stats();
+    scheduler.shutdown();
+    std::cout << "Test passed!\n";
+}
+
+void test_gc_governor() {
+    std::cout << "\n=== Test: GC Governor ===\n";
+    Scheduler scheduler(2);
+    scheduler.set_hibernate_after(0);
+    running_total.store(0);
+    
+    // Half the heap in dead payloads: below the point where receive()
+    // collects, above the governor's pressure mark
+    int pid = scheduler.spawn(counting_behavior, nullptr, 1024 * 1024);
+    ActorProcess* actor = scheduler.get_actor(pid);
+    
+    std::vector<unsigned char> payload(64 * 1024, 1);
+    for (int i = 0; i < 9; i++) {
+        scheduler.send_message(-1, pid, payload.data(), payload.size());
+    }
+    wait_for_total(9);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    
+    assert(scheduler.governor_collections() >= 1);
+    assert(actor->heap_usage().used < payload.size());
+    assert(!actor->is_hibernated());
+    
+    // Over budget, waiting actors are shrunk outright
+    scheduler.set_memory_budget(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    assert(actor->is_hibernated());
+    
+    // Still live after both
+    scheduler.send_message(-1, pid, payload.data(), payload.size());
+    wait_for_total(10);
+    
+    scheduler.dump_stats();
+    scheduler.shutdown();
+    std::cout << "Test passed!\n";
+}
+
+void runtime_garbage_behavior(ActorProcess* self, void* args) {
+    // Most of the nursery in dead objects, allocated the way compiled code
+    // does; the first pinned allocation creates the collector
+    while (self->receive()) {
+        if (!self->runtime_gc()) gc_alloc_pinned(sizeof(int64_t));
+        for (int i = 0; i < 6000; i++) gc_alloc(64);
+        running_total.fetch_add(1);
+    }
+}
+
+void test_runtime_heap_governor() {
+    std::cout << "\n=== Test: GC Governor, Runtime Heap ===\n";
+    Scheduler scheduler(2);
+    scheduler.set_hibernate_after(0);
+    running_total.store(0);
+    
+    int pid = scheduler.spawn(runtime_garbage_behavior, nullptr);
+    ActorProcess* actor = scheduler.get_actor(pid);
+    unsigned char byte = 1;
+    scheduler.send_message(-1, pid, &byte, 1);
+    wait_for_total(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    
+    // The nursery was collected while the actor waited, and the collector's
+    // generations count towards the footprint
+    HeapUsage usage = actor->heap_usage();
+    assert(!usage.runtime_pressure && usage.runtime_used < 64 * 1024);
+    assert(actor->runtime_gc()->statistics().young_collections >= 1);
+    assert(scheduler.memory_footprint() >= usage.runtime_reserved);
+    
+    scheduler.shutdown();
+    std::cout << "Test passed!\n";
+}
+
+void test_parallel_jobs() {
+    std::cout << "\n=== Test: Parallel Jobs ===\n";
+    assert(parallel_workers() == 1);
+    
+    {
+        Scheduler scheduler(4);
+        assert(parallel_workers() == 4);
+        
+        // Every index runs exactly once, spread over several threads
+        std::vector<std::atomic<int>> hits(10000);
+        std::mutex threads_mutex;
+        std::vector<std::thread::id> threads;
+        parallel_for(hits.size(), [&](size_t i) {
+            hits[i].fetch_add(1);
+            if (i % 100 == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                std::lock_guard<std::mutex> lock(threads_mutex);
+                if (std::find(threads.begin(), threads.end(), std::this_thread::get_id()) == threads.end()) {
+                    threads.push_back(std::this_thread::get_id());
+                }
+            }
+        });
+        for (auto& hit : hits) assert(hit.load() == 1);
+        std::cout << "Job ran on " << threads.size() << " threads\n";
+        
+        // A job started from inside a task runs inline
+        std::atomic<int> inner{0};
+        parallel_for(4, [&](size_t) {
+            parallel_for(4, [&](size_t) { inner.fetch_add(1); });
+        });
+        assert(inner.load() == 16);
+        
+        scheduler.shutdown();
+        assert(parallel_workers() == 1);
+    }
+    
+    // Without a scheduler, jobs run on the caller
+    int sum = 0;
+    parallel_for(5, [&](size_t i) { sum += static_cast<int>(i); });
+    assert(sum == 10);
+    std::cout << "Test passed!\n";
+}
+
 int main() {
     std::cout << "Running Scheduler Tests\n";
     std::cout << "========================\n";
     
     test_spawn();
     test_messaging();
+    test_send_many();
+    test_many_senders();
+    test_hibernate();
+    test_gc_governor();
+    test_runtime_heap_governor();
+    test_parallel_jobs();
     
     std::cout << "\nAll tests passed!\n";
     return 0;
@@ -0,0 +1,230 @@
+#include "runtime/pyobject.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace aithon::runtime;
+
+// Hidden classes (shapes) for instance attributes, method resolution
+// through the bases, and the inline caches on top of both
+
+static int64_t int_of(PyObject* obj) {
+    return static_cast<PyInt*>(obj)->value();
+}
+
+static PyObject* get_x(PyObject* self) {
+    PyObject* x = static_cast<PyInstance*>(self)->get_attr("x");
+    x->incref();
+    return x;
+}
+
+static PyObject* add_to_x(PyObject* self, PyObject* n) {
+    return new PyInt(int_of(static_cast<PyInstance*>(self)->get_attr("x")) + int_of(n));
+}
+
+static PyObject* base_name(PyObject*) { return new PyString("base"); }
+static PyObject* derived_name(PyObject*) { return new PyString("derived"); }
+
+static std::shared_ptr<PyClass> point_class() {
+    auto cls = std::make_shared<PyClass>("Point");
+    cls->add_method("get_x", std::make_shared<PyFunction>("get_x", get_x));
+    cls->add_method("add_to_x", std::make_shared<PyFunction>("add_to_x", add_to_x));
+    return cls;
+}
+
+void test_shapes() {
+    std::cout << "\n=== Test: Shapes ===\n";
+
+    auto cls = point_class();
+    auto* a = new PyInstance(cls);
+    auto* b = new PyInstance(cls);
+    assert(a->shape() == cls->root_shape() && a->shape()->size() == 0);
+
+    auto* one = new PyInt(1);
+    auto* two = new PyInt(2);
+
+    // Same attributes in the same order: same shape
+    a->set_attr("x", one);
+    a->set_attr("y", two);
+    b->set_attr("x", two);
+    b->set_attr("y", one);
+    assert(a->shape() == b->shape());
+    assert(a->shape()->size() == 2);
+    assert(a->shape()->lookup("x") == 0 && a->shape()->lookup("y") == 1);
+    assert(a->shape()->lookup("z") == -1);
+    assert(a->shape()->parent()->parent() == cls->root_shape());
+
+    // Another order is another shape
+    auto* c = new PyInstance(cls);
+    c->set_attr("y", one);
+    c->set_attr("x", one);
+    assert(c->shape() != a->shape());
+    assert(c->shape()->lookup("x") == 1);
+
+    // Overwriting keeps the shape and releases the old value
+    Shape* before = a->shape();
+    a->set_attr("x", two);
+    assert(a->shape() == before);
+    assert(int_of(a->get_attr("x")) == 2);
+    assert(one->refcount() == 4);   // Ours, b.y, c.y, c.x
+
+    // Fields, then methods; anything else is an AttributeError
+    assert(a->get_attr("get_x") == cls->get_method("get_x"));
+    bool caught = false;
+    try {
+        a->get_attr("missing");
+    } catch (const std::runtime_error& e) {
+        caught = true;
+        assert(std::string(e.what()) == "AttributeError: 'Point' object has no attribute 'missing'");
+    }
+    assert(caught);
+
+    // Wide instances switch the shape to a table
+    auto* wide = new PyInstance(cls);
+    for (int i = 0; i < 20; i++) wide->set_attr("f" + std::to_string(i), i % 2 ? one : two);
+    assert(wide->shape()->size() == 20);
+    for (int i = 0; i < 20; i++) {
+        assert(wide->shape()->lookup("f" + std::to_string(i)) == i);
+        assert(int_of(wide->get_attr("f" + std::to_string(i))) == (i % 2 ? 1 : 2));
+    }
+    assert(wide->shape()->lookup("f20") == -1);
+    wide->decref();
+
+    a->decref();
+    b->decref();
+    c->decref();
+    assert(one->refcount() == 1 && two->refcount() == 1);
+    one->decref();
+    two->decref();
+    std::cout << "Test passed!\n";
+}
+
+void test_method_resolution() {
+    std::cout << "\n=== Test: Method Resolution ===\n";
+
+    auto base = std::make_shared<PyClass>("Base");
+    base->add_method("name", std::make_shared<PyFunction>("name", base_name));
+    base->add_method("base_only", std::make_shared<PyFunction>("base_only", base_name));
+    auto derived = std::make_shared<PyClass>("Derived");
+    derived->add_base(base);
+    derived->add_method("name", std::make_shared<PyFunction>("name", derived_name));
+
+    assert(derived->get_method("name") != base->get_method("name"));
+    assert(derived->get_method("base_only") == base->get_method("base_only"));
+    assert(!derived->get_method("missing"));
+
+    // A method added to a base later is seen by the subclass
+    uint64_t epoch = PyClass::method_epoch();
+    base->add_method("late", std::make_shared<PyFunction>("late", base_name));
+    assert(PyClass::method_epoch() != epoch);
+    assert(derived->get_method("late") == base->get_method("late"));
+
+    // Calling the class creates an instance and runs __init__
+    auto cls = point_class();
+    cls->add_method("__init__", std::make_shared<PyFunction>("__init__",
+        [](PyObject* self, PyObject* x) -> PyObject* {
+            static_cast<PyInstance*>(self)->set_attr("x", x);
+            PyObject* none = PyNone::instance();
+            none->incref();
+            return none;
+        }));
+    auto* seven = new PyInt(7);
+    PyObject* args[] = {seven};
+    auto* point = static_cast<PyInstance*>(cls->call(args, 1));
+    assert(int_of(point->get_attr("x")) == 7);
+
+    point->decref();
+    seven->decref();
+    std::cout << "Test passed!\n";
+}
+
+void test_inline_caches() {
+    std::cout << "\n=== Test: Inline Caches ===\n";
+
+    auto cls = point_class();
+    auto* one = new PyInt(1);
+    auto* ten = new PyInt(10);
+
+    // Five instances, five shapes: x first, then 0..4 extra fields
+    PyInstance* points[5];
+    const char* extra[] = {"a", "b", "c", "d"};
+    for (int i = 0; i < 5; i++) {
+        points[i] = new PyInstance(cls);
+        points[i]->set_attr("x", i == 0 ? ten : one);
+        for (int j = 0; j < i; j++) points[i]->set_attr(extra[j], one);
+    }
+
+    // Monomorphic: one entry, then hits
+    AttrCache field;
+    assert(int_of(field.load(points[0], "x")) == 10);
+    assert(field.used == 1 && field.entries[0].slot == 0);
+    assert(int_of(field.load(points[0], "x")) == 10);
+    assert(field.used == 1);
+
+    // Polymorphic up to ENTRIES shapes, then megamorphic and still right
+    for (int i = 1; i < 5; i++) assert(int_of(field.load(points[i], "x")) == 1);
+    assert(field.used == AttrCache::ENTRIES);
+    assert(field.megamorphic);
+    assert(int_of(field.load(points[4], "x")) == 1);
+
+    // Method calls get self first
+    AttrCache method;
+    PyObject* arg = one;
+    PyObject* result = method.call_method(points[0], "add_to_x", &arg, 1);
+    assert(int_of(result) == 11);
+    result->decref();
+    assert(method.used == 1 && method.entries[0].slot == -1);
+    arg = ten;
+    result = method.call_method(points[0], "add_to_x", &arg, 1);
+    assert(int_of(result) == 20);
+    result->decref();
+
+    // Redefining a method invalidates cached entries
+    cls->add_method("add_to_x", std::make_shared<PyFunction>("add_to_x",
+        [](PyObject* self, PyObject* n) -> PyObject* { return new PyInt(-int_of(n)); }));
+    arg = one;
+    result = method.call_method(points[0], "add_to_x", &arg, 1);
+    assert(int_of(result) == -1);
+    result->decref();
+    assert(method.used == 1);
+
+    // A field of the same name shadows the method, on its new shape
+    auto* shadowed = new PyInstance(cls);
+    auto* answer = new PyFunction("answer", []() -> PyObject* { return new PyInt(42); });
+    shadowed->set_attr("get_x", answer);
+    answer->decref();
+    AttrCache call_get_x;
+    result = call_get_x.call_method(shadowed, "get_x", nullptr, 0);
+    assert(int_of(result) == 42);
+    result->decref();
+
+    AttrCache missing;
+    bool caught = false;
+    try {
+        missing.load(points[0], "nope");
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught && missing.used == 0);
+
+    for (auto* point : points) point->decref();
+    shadowed->decref();
+    one->decref();
+    ten->decref();
+    std::cout << "Test passed!\n";
+}
+
+int main() {
+    std::cout << "Running Shape and Inline Cache Tests\n";
+    std::cout << "====================================\n";
+
+    test_shapes();
+    test_method_resolution();
+    test_inline_caches();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
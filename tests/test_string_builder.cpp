@@ -0,0 +1,184 @@
+#include "runtime/pyobject.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <string>
+
+// Concatenation that accumulates in a shared builder, and the in-place
+// append compiled loops use for s = s + x
+
+using namespace aithon::runtime;
+
+extern "C" {
+    void* runtime_string_from_cstr(const char* str);
+    int64_t runtime_string_length(void* str);
+    const char* runtime_string_data(void* str);
+    int64_t runtime_string_hash(void* str);
+    void* runtime_string_concat(void* a, void* b);
+    void* runtime_string_append(void* s, void* x);
+    void runtime_string_seal(void* str);
+    void runtime_string_release(void* str);
+}
+
+static std::string text_of(void* str) {
+    return std::string(runtime_string_data(str), runtime_string_length(str));
+}
+
+void test_short_concat() {
+    std::cout << "\n=== Test: Short Concatenation ===\n";
+
+    auto* a = new PyString("Hello, ");
+    auto* b = new PyString("World");
+    auto* c = static_cast<PyString*>(a->add(b));
+    assert(!c->is_pending());
+    assert(c->value() == "Hello, World");
+
+    a->decref();
+    b->decref();
+    c->decref();
+    std::cout << "Test passed!\n";
+}
+
+void test_builder_accumulates() {
+    std::cout << "\n=== Test: Builder Accumulates ===\n";
+
+    std::string expected;
+    auto* piece = new PyString("abcdefghij");
+    PyObject* s = new PyString("");
+    for (int i = 0; i < 1000; i++) {
+        PyObject* next = s->add(piece);
+        s->decref();
+        s = next;
+        expected += "abcdefghij";
+    }
+
+    auto* str = static_cast<PyString*>(s);
+    assert(str->is_pending());
+    assert(str->length() == expected.size());
+    assert(str->to_bool());
+
+    // Reads that need the text flatten it once
+    assert(str->value() == expected);
+    assert(!str->is_pending());
+    assert(str->to_string() == expected);
+
+    piece->decref();
+    s->decref();
+    std::cout << "Test passed!\n";
+}
+
+void test_builder_sharing() {
+    std::cout << "\n=== Test: Builder Sharing ===\n";
+
+    auto* base = new PyString(std::string(300, 'x'));
+    auto* a = new PyString("a");
+    auto* b = new PyString("b");
+
+    // s is built on a builder; t extends it in place, u must not clobber t
+    auto* s = static_cast<PyString*>(base->add(a));
+    auto* t = static_cast<PyString*>(s->add(a));
+    auto* u = static_cast<PyString*>(s->add(b));
+    assert(s->value() == std::string(300, 'x') + "a");
+    assert(t->value() == std::string(300, 'x') + "aa");
+    assert(u->value() == std::string(300, 'x') + "ab");
+
+    // A string added to itself while pending
+    auto* v = static_cast<PyString*>(base->add(b));
+    auto* w = static_cast<PyString*>(v->add(v));
+    std::string vv = std::string(300, 'x') + "b";
+    assert(w->value() == vv + vv);
+
+    // Equality and hashing see the full text of pending strings
+    auto* x = static_cast<PyString*>(base->add(a));
+    auto* y = static_cast<PyString*>(base->add(a));
+    assert(x->is_pending() && y->is_pending());
+    assert(x->eq(y)->to_bool());
+    assert(x->hash() == y->hash());
+    assert(x->hash() == s->hash());
+    auto* minus_one = new PyInt(-1);
+    auto* last = static_cast<PyString*>(x->get_item(minus_one));
+    assert(last->value() == "a");
+    minus_one->decref();
+
+    for (PyString* str : {base, a, b, s, t, u, v, w, x, y, last}) str->decref();
+    std::cout << "Test passed!\n";
+}
+
+void test_repeat() {
+    std::cout << "\n=== Test: Repeat ===\n";
+
+    auto* ab = new PyString("ab");
+    auto* three = new PyInt(3);
+    auto* zero = new PyInt(0);
+
+    auto* r = static_cast<PyString*>(ab->mul(three));
+    assert(r->value() == "ababab");
+    auto* l = static_cast<PyString*>(three->mul(ab));
+    assert(l->value() == "ababab");
+    auto* e = static_cast<PyString*>(ab->mul(zero));
+    assert(e->value().empty());
+
+    auto* big = new PyInt(1001);
+    auto* long_repeat = static_cast<PyString*>(ab->mul(big));
+    assert(long_repeat->length() == 2002);
+    assert(long_repeat->value().substr(1996) == "ababab");
+
+    for (PyObject* obj : std::initializer_list<PyObject*>{ab, three, zero, r, l, e, big, long_repeat}) {
+        obj->decref();
+    }
+    std::cout << "Test passed!\n";
+}
+
+void test_runtime_append() {
+    std::cout << "\n=== Test: Runtime Append ===\n";
+
+    void* start = runtime_string_from_cstr("start:");
+    void* piece = runtime_string_from_cstr("0123456789");
+
+    // The first append copies; the source is left alone
+    void* s = runtime_string_append(start, piece);
+    assert(s != start);
+    assert(text_of(start) == "start:");
+
+    std::string expected = "start:0123456789";
+    for (int i = 0; i < 1000; i++) {
+        void* next = runtime_string_append(s, piece);
+        assert(next == s);  // In place
+        s = next;
+        expected += "0123456789";
+    }
+    assert(text_of(s) == expected);
+    assert(runtime_string_data(s)[expected.size()] == '\0');
+
+    // Sealed, it is immutable again: appending copies
+    runtime_string_seal(s);
+    int64_t hash = runtime_string_hash(s);
+    void* more = runtime_string_append(s, piece);
+    assert(more != s);
+    assert(text_of(s) == expected);
+    assert(runtime_string_hash(s) == hash);
+    assert(text_of(more) == expected + "0123456789");
+    runtime_string_seal(more);
+
+    // Matches plain concatenation
+    void* concat = runtime_string_concat(s, piece);
+    assert(text_of(concat) == text_of(more));
+    assert(runtime_string_hash(concat) == runtime_string_hash(more));
+
+    for (void* str : {start, piece, s, more, concat}) runtime_string_release(str);
+    std::cout << "Test passed!\n";
+}
+
+int main() {
+    std::cout << "Running String Builder Tests\n";
+    std::cout << "============================\n";
+
+    test_short_concat();
+    test_builder_accumulates();
+    test_builder_sharing();
+    test_repeat();
+    test_runtime_append();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include "runtime/value.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <string>
+
+using namespace aithon::runtime;
+
+void test_inline_values() {
+    std::cout << "\n=== Test: Inline Values ===\n";
+
+    Value i = Value::from_int(-42);
+    assert(i.is_small_int() && i.is_int() && !i.is_object());
+    assert(i.as_int() == -42);
+
+    Value f = Value::from_double(-2.5);
+    assert(f.is_double() && !f.is_int());
+    assert(f.as_double() == -2.5);
+
+    // Infinities and NaN stay doubles
+    assert(Value::from_double(-INFINITY).is_double());
+    Value nan = Value::from_double(-std::nan(""));
+    assert(nan.is_double() && std::isnan(nan.as_double()));
+
+    assert(Value::from_bool(true).as_bool());
+    assert(!Value::from_bool(false).to_bool());
+    assert(Value().is_none());
+    assert(Value::none().to_string() == "None");
+
+    // The edges of the small range
+    assert(Value::from_int(Value::SMALL_INT_MAX).is_small_int());
+    assert(Value::from_int(Value::SMALL_INT_MIN).as_int() == Value::SMALL_INT_MIN);
+    std::cout << "Test passed!\n";
+}
+
+void test_arithmetic() {
+    std::cout << "\n=== Test: Arithmetic ===\n";
+
+    Value a = Value::from_int(10);
+    Value b = Value::from_int(20);
+    assert(a.add(b).as_int() == 30);
+    assert(a.sub(b).as_int() == -10);
+    assert(a.mul(b).as_int() == 200);
+    assert(b.div(a).as_double() == 2.0);
+    assert(b.mod(Value::from_int(7)).as_int() == 6);
+    assert(Value::from_int(2).pow(Value::from_int(10)).as_int() == 1024);
+    assert(Value::from_int(2).pow(Value::from_int(-1)).as_double() == 0.5);
+    assert(a.neg().as_int() == -10);
+
+    // Mixed int and float give a float; bools count as ints
+    Value mixed = a.add(Value::from_double(3.5));
+    assert(mixed.is_double() && mixed.as_double() == 13.5);
+    assert(Value::from_bool(true).add(Value::from_bool(true)).as_int() == 2);
+
+    // Float modulo takes the divisor's sign, as int modulo does
+    assert(Value::from_int(-7).mod(Value::from_double(3.0)).as_double() == 2.0);
+    assert(Value::from_double(7.0).mod(Value::from_double(-3.0)).as_double() == -2.0);
+    assert(Value::from_double(-7.5).mod(Value::from_double(-2.0)).as_double() == -1.5);
+    Value zero = Value::from_double(6.0).mod(Value::from_int(-3));
+    assert(zero.as_double() == 0.0 && std::signbit(zero.as_double()));
+
+    bool caught = false;
+    try {
+        a.div(Value::from_int(0));
+    } catch (const std::runtime_error& e) {
+        caught = std::string(e.what()).find("zero") != std::string::npos;
+    }
+    assert(caught);
+
+    // Zero to a negative power has no value
+    for (Value base : {Value::from_int(0), Value::from_double(0.0)}) {
+        for (Value exponent : {Value::from_int(-1), Value::from_double(-0.5)}) {
+            caught = false;
+            try {
+                base.pow(exponent);
+            } catch (const std::runtime_error& e) {
+                caught = std::string(e.what()).rfind("ZeroDivisionError", 0) == 0;
+            }
+            assert(caught);
+        }
+    }
+    assert(Value::from_int(0).pow(Value::from_int(0)).as_int() == 1);
+    std::cout << "Test passed!\n";
+}
+
+void test_overflow_promotion() {
+    std::cout << "\n=== Test: Overflow Promotion ===\n";
+
+    // Leaving the small range boxes the result...
+    Value max = Value::from_int(Value::SMALL_INT_MAX);
+    Value big = max.add(Value::from_int(1));
+    assert(big.is_object() && big.is_int());
+    assert(big.as_int() == Value::SMALL_INT_MAX + 1);
+
+    // ...and coming back unboxes it
+    Value back = big.sub(Value::from_int(1));
+    assert(back.is_small_int() && back.as_int() == Value::SMALL_INT_MAX);
+    Value again = max.add(Value::from_int(1));
+    assert(big.eq(again).as_bool());
+
+    Value square = big.mul(Value::from_int(1000));
+    assert(square.is_object() && square.as_int() == (Value::SMALL_INT_MAX + 1) * 1000);
+
+    // Past int64 the PyInt holds a BigInt
+    Value largest = Value::from_int(INT64_MAX);
+    Value past = largest.add(Value::from_int(1));
+    assert(past.is_int() && past.to_string() == "9223372036854775808");
+
+    big.release();
+    again.release();
+    square.release();
+    largest.release();
+    past.release();
+    std::cout << "Test passed!\n";
+}
+
+void test_comparisons() {
+    std::cout << "\n=== Test: Comparisons ===\n";
+
+    Value a = Value::from_int(10);
+    Value b = Value::from_int(20);
+    assert(a.lt(b).as_bool());
+    assert(b.gt(a).as_bool());
+    assert(a.le(Value::from_int(10)).as_bool());
+    assert(a.ge(Value::from_double(9.5)).as_bool());
+    assert(a.eq(Value::from_double(10.0)).as_bool());
+    assert(a.ne(b).as_bool());
+    assert(Value::none().eq(Value::none()).as_bool());
+    assert(!Value::none().eq(Value::from_int(0)).as_bool());
+
+    // NaN is not equal to itself
+    Value nan = Value::from_double(std::nan(""));
+    assert(!nan.eq(nan).as_bool());
+
+    // Equal numbers hash equally
+    assert(Value::from_int(2).hash() == Value::from_double(2.0).hash());
+    std::cout << "Test passed!\n";
+}
+
+void test_heap_objects() {
+    std::cout << "\n=== Test: Heap Objects ===\n";
+
+    Value hello = Value::from_object(new PyString("Hello"));
+    Value world = Value::from_object(new PyString(" World"));
+
+    Value greeting = hello.add(world);
+    assert(greeting.is_object() && greeting.to_string() == "Hello World");
+
+    // Inline operands are boxed for the object's own operation
+    Value repeated = hello.mul(Value::from_int(3));
+    assert(repeated.to_string() == "HelloHelloHello");
+    Value copy = Value::from_object(new PyString("Hello"));
+    assert(hello.eq(copy).as_bool());
+
+    copy.release();
+    greeting.release();
+    repeated.release();
+    hello.release();
+    world.release();
+    std::cout << "Test passed!\n";
+}
+
+int main() {
+    std::cout << "Running Value Tests\n";
+    std::cout << "===================\n";
+
+    test_inline_values();
+    test_arithmetic();
+    test_overflow_promotion();
+    test_comparisons();
+    test_heap_objects();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}